@@ -0,0 +1,323 @@
+#include "headless_application.h"
+
+#include "frame_buffer.h"
+#include "image_writer.h"
+#include "scene.h"
+#include "scene_factory.h"
+#include "stats.h"
+#include "tile_renderer.h"
+#include "work_stealing_pool.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+auto millisecondsSince(const Clock::time_point& startTime)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+}
+
+auto toMilliseconds(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// One entry of the --stats file. Mrays/s and Msamples/s are over the render time alone, so they can be compared
+// across builds and machines to catch regressions. Builds without stats count nothing and leave them out.
+auto sceneStatsToJson(
+    const std::string& sceneFile,
+    const Scene& scene,
+    double loadTime,
+    double encodeTime,
+    const RenderStatistics& statistics)
+{
+    auto counters = nlohmann::json::object();
+    for (size_t i = 0; i < statCount; ++i)
+    {
+        const auto stat = static_cast<Stat>(i);
+        counters[std::string(statName(stat))] = statistics.counters[stat];
+    }
+
+    auto tileMilliseconds = nlohmann::json::array();
+    for (const auto& timing : statistics.tiles)
+    {
+        tileMilliseconds.push_back(toMilliseconds(timing.duration));
+    }
+
+    auto entry = nlohmann::json{
+        {"scene", sceneFile},
+        {"width", scene.width()},
+        {"height", scene.height()},
+        {"threads", statistics.threadCount},
+        {"loadMilliseconds", loadTime},
+        {"renderMilliseconds", toMilliseconds(statistics.frameDuration)},
+        {"encodeMilliseconds", encodeTime},
+        {"counters", std::move(counters)},
+        {"tileMilliseconds", std::move(tileMilliseconds)}};
+
+    if constexpr (statsEnabled)
+    {
+        entry["megaraysPerSecond"] = millionsPerSecond(statistics, Stat::RaysCast);
+        entry["megasamplesPerSecond"] = millionsPerSecond(statistics, Stat::Samples);
+    }
+
+    return entry;
+}
+
+} // namespace
+
+class HeadlessApplication::AppImpl
+{
+public:
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    explicit AppImpl(int argc, char** argv) : m_arguments(argv, argv + argc)
+    {
+    }
+
+    auto parseCommandLineParameters()
+    {
+        for (size_t i = 1; i < m_arguments.size(); ++i)
+        {
+            const std::string_view argument(m_arguments[i]);
+
+            if (argument == headlessFlag)
+            {
+                continue;
+            }
+
+            if (argument == "--format" || argument == "--output" || argument == "--stats")
+            {
+                if (++i == m_arguments.size())
+                {
+                    m_lastError = std::string(argument) + " requires a value";
+                    return AppInit::InvalidCommandLineArguments;
+                }
+
+                if (argument == "--output")
+                {
+                    m_outputDirectory = m_arguments[i];
+                    continue;
+                }
+
+                if (argument == "--stats")
+                {
+                    m_statsFile = m_arguments[i];
+                    continue;
+                }
+
+                const auto format(imageFormatFromName(m_arguments[i]));
+                if (!format.has_value())
+                {
+                    m_lastError = "Unknown image format " + m_arguments[i];
+                    return AppInit::InvalidCommandLineArguments;
+                }
+
+                m_format = *format;
+                continue;
+            }
+
+            m_sceneFiles.push_back(m_arguments[i]);
+        }
+
+        if (m_sceneFiles.empty())
+        {
+            m_lastError = "No scene files given";
+            return AppInit::InvalidCommandLineArguments;
+        }
+
+        return AppInit::Succeeded;
+    }
+
+    auto loadScene(const std::string& sceneFile)
+    {
+        m_scene = createSceneFactory(sceneFile)->buildScene(sceneFile);
+
+        if (m_scene == nullptr)
+        {
+            return AppInit::CouldNotLoadScene;
+        }
+
+        if (m_frame == nullptr || m_frame->width() != m_scene->width() || m_frame->height() != m_scene->height())
+        {
+            m_frame = std::make_unique<FrameBuffer>(m_scene->resolution());
+        }
+
+        return AppInit::Succeeded;
+    }
+
+    [[nodiscard]] auto render() const
+    {
+        if (m_scene == nullptr)
+        {
+            return RenderStatistics{};
+        }
+
+        return m_renderer.render(*m_scene, *m_frame);
+    }
+
+    [[nodiscard]] auto writeFrame(const std::filesystem::path& outputFile) const
+    {
+        std::ofstream output(outputFile, std::ios::binary);
+        if (!output.is_open())
+        {
+            return false;
+        }
+
+        writeImage(*m_frame, m_format, output);
+        return output.good();
+    }
+
+    // Each scene is rendered to <output directory>/<scene file name><extension>
+    void renderAll()
+    {
+        for (const auto& sceneFile : m_sceneFiles)
+        {
+            const auto loadStartTime(Clock::now());
+            if (loadScene(sceneFile) == AppInit::CouldNotLoadScene)
+            {
+                reportFailure("Could not load scene file " + sceneFile);
+                continue;
+            }
+            const auto loadTime = millisecondsSince(loadStartTime);
+
+            const auto renderStartTime(Clock::now());
+            const auto statistics(render());
+            const auto renderTime = millisecondsSince(renderStartTime);
+
+            auto outputFile(m_outputDirectory / std::filesystem::path(sceneFile).filename());
+            outputFile.replace_extension(imageFormatExtension(m_format));
+
+            const auto encodeStartTime(Clock::now());
+            if (!writeFrame(outputFile))
+            {
+                reportFailure("Could not write image " + outputFile.string());
+                continue;
+            }
+            const auto encodeTime = millisecondsSince(encodeStartTime);
+
+            if (m_statsFile.has_value())
+            {
+                m_sceneStats.push_back(sceneStatsToJson(sceneFile, *m_scene, loadTime, encodeTime, statistics));
+            }
+
+            std::cout << sceneFile << " -> " << outputFile.string() << ": load " << loadTime << " ms, render "
+                      << renderTime << " ms, encode " << encodeTime << " ms\n"
+                      << statistics;
+        }
+
+        if (m_statsFile.has_value())
+        {
+            writeStats();
+        }
+    }
+
+    [[nodiscard]] const auto& lastError() const noexcept
+    {
+        return m_lastError;
+    }
+
+    [[nodiscard]] auto failureCount() const noexcept
+    {
+        return m_failureCount;
+    }
+
+private:
+    // Scenes that could not be loaded or written are left out
+    void writeStats()
+    {
+        const nlohmann::json stats{{"statsEnabled", statsEnabled}, {"scenes", m_sceneStats}};
+
+        std::ofstream output(*m_statsFile);
+        output << stats.dump(4) << "\n";
+        if (!output.good())
+        {
+            reportFailure("Could not write stats " + m_statsFile->string());
+        }
+    }
+
+    void reportFailure(std::string error)
+    {
+        std::cerr << error << "\n";
+        m_lastError = std::move(error);
+        ++m_failureCount;
+    }
+
+    std::vector<std::string> m_arguments;
+    std::vector<std::string> m_sceneFiles;
+    std::filesystem::path m_outputDirectory{"."};
+    ImageFormat m_format = ImageFormat::Png;
+    std::optional<std::filesystem::path> m_statsFile;
+    nlohmann::json m_sceneStats = nlohmann::json::array();
+
+    std::string m_lastError;
+    size_t m_failureCount = 0;
+
+    std::unique_ptr<Scene> m_scene = nullptr;
+    std::unique_ptr<FrameBuffer> m_frame = nullptr;
+
+    WorkStealingPool m_pool;
+    TileRenderer m_renderer{m_pool};
+};
+
+HeadlessApplication::HeadlessApplication(int argc, char** argv) : m_pAppData(std::make_unique<AppImpl>(argc, argv))
+{
+}
+
+HeadlessApplication::~HeadlessApplication() = default;
+
+bool HeadlessApplication::isRequested(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string_view(argv[i]) == headlessFlag) // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+AppInit HeadlessApplication::init()
+{
+    return m_pAppData->parseCommandLineParameters();
+}
+
+void HeadlessApplication::render() const
+{
+    static_cast<void>(m_pAppData->render());
+}
+
+void HeadlessApplication::run()
+{
+    m_pAppData->renderAll();
+}
+
+std::string HeadlessApplication::getLastError() const
+{
+    return m_pAppData->lastError();
+}
+
+bool HeadlessApplication::allScenesSucceeded() const noexcept
+{
+    return m_pAppData->failureCount() == 0;
+}
+
+} // namespace eyebeam
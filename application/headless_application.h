@@ -0,0 +1,48 @@
+#ifndef INCLUDED_HEADLESS_APPLICATION_H_
+#define INCLUDED_HEADLESS_APPLICATION_H_
+
+#include "application.h"
+
+#include <memory>
+#include <string>
+
+namespace eyebeam
+{
+
+// Renders every scene file given on the command line to an image without creating a window. Usage:
+//     eyebeam --headless [--format ppm|pfm|png] [--output <directory>] [--stats <file.json>] <pathToSceneFile>...
+class HeadlessApplication final : public Application
+{
+public:
+    static constexpr auto headlessFlag = "--headless";
+
+    explicit HeadlessApplication(int argc, char** argv);
+    ~HeadlessApplication();
+
+    HeadlessApplication(const HeadlessApplication&) = delete;
+    HeadlessApplication(HeadlessApplication&&) = delete;
+
+    HeadlessApplication& operator=(const HeadlessApplication&) = delete;
+    HeadlessApplication& operator=(HeadlessApplication&&) = delete;
+
+    // True when headlessFlag appears anywhere on the command line
+    [[nodiscard]] static bool isRequested(int argc, char** argv);
+
+    AppInit init() final;
+    void render() const final;
+    void run() final;
+
+    [[nodiscard]] std::string getLastError() const final;
+
+    // False when run() failed to load, render or write any of the scenes
+    [[nodiscard]] bool allScenesSucceeded() const noexcept;
+
+private:
+    class AppImpl;
+
+    std::unique_ptr<AppImpl> m_pAppData;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_HEADLESS_APPLICATION_H_
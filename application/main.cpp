@@ -1,13 +1,14 @@
 #include "application.h"
+#include "headless_application.h"
 #include "sdl_application.h"
 
 #include <iostream>
 
-// NOLINTNEXTLINE(bugprone-exception-escape)
-int main(int argc, char** argv)
+namespace
 {
-    eyebeam::SdlApplication app(argc, argv);
 
+int runApplication(eyebeam::Application& app, int argc, char** argv)
+{
     const auto initResult = app.init();
 
     switch (initResult)
@@ -20,10 +21,12 @@ int main(int argc, char** argv)
         return 1;
     case eyebeam::AppInit::CouldNotLoadScene:
         // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        std::cerr << "Could not load scene file " << argv[1] << "\n";
+        std::cerr << "Could not load scene file " << argv[argc - 1] << "\n";
         return 1;
     case eyebeam::AppInit::InvalidCommandLineArguments:
-        std::cerr << "Usage: eyebeam <pathToSceneFile>\n";
+        std::cerr << "Usage: eyebeam [--sampler independent|halton|sobol|bluenoise] <pathToSceneFile>\n"
+                  << "       eyebeam --headless [--format ppm|pfm|png] [--output <directory>] [--stats <file.json>] "
+                     "<pathToSceneFile>...\n";
         return 1;
     case eyebeam::AppInit::Succeeded:
         break;
@@ -33,3 +36,19 @@ int main(int argc, char** argv)
 
     return 0;
 }
+
+} // namespace
+
+// NOLINTNEXTLINE(bugprone-exception-escape)
+int main(int argc, char** argv)
+{
+    if (eyebeam::HeadlessApplication::isRequested(argc, argv))
+    {
+        eyebeam::HeadlessApplication app(argc, argv);
+        const auto result = runApplication(app, argc, argv);
+        return result != 0 || !app.allScenesSucceeded() ? 1 : 0;
+    }
+
+    eyebeam::SdlApplication app(argc, argv);
+    return runApplication(app, argc, argv);
+}
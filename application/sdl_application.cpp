@@ -1,15 +1,30 @@
 #include "sdl_application.h"
 
+#include "frame_buffer.h"
+#include "progressive_renderer.h"
 #include "scene.h"
-#include "scene_factory_json.h"
+#include "scene_factory.h"
+#include "stats.h"
+#include "tile.h"
+#include "tile_renderer.h"
+#include "work_stealing_pool.h"
+
+#include "sampler.h"
 
 #include <SDL2/SDL.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <iomanip>
+#include <iostream>
 #include <memory>
 #include <ratio>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 namespace eyebeam
 {
@@ -33,7 +48,9 @@ struct WindowDeleter
 enum class EventLoopResult
 {
     QuitApp,
-    ContinueLoop
+    ContinueLoop,
+    // The window contents were lost, so the whole surface must be presented again
+    RedrawWindow
 };
 
 auto pollForEvents(SDL_Event& event)
@@ -47,6 +64,12 @@ auto pollForEvents(SDL_Event& event)
         case SDL_QUIT:
             shouldQuit = EventLoopResult::QuitApp;
             break;
+        case SDL_WINDOWEVENT:
+            if (event.window.event == SDL_WINDOWEVENT_EXPOSED && shouldQuit != EventLoopResult::QuitApp)
+            {
+                shouldQuit = EventLoopResult::RedrawWindow;
+            }
+            break;
         case SDL_KEYUP:
             if (event.key.keysym.sym == SDLK_q)
             {
@@ -78,6 +101,82 @@ void yieldExtraLoopTime(const Clock::time_point& loopStartTime)
     }
 }
 
+auto toChannel(float value)
+{
+    constexpr auto maxChannel = 255.0F;
+    return static_cast<Uint8>(std::clamp(value, 0.0F, 1.0F) * maxChannel + 0.5F);
+}
+
+// Tonemaps the given tiles of frame into surface
+void copyTilesToSurface(const FrameBuffer& frame, const std::vector<Tile>& tiles, SDL_Surface* surface)
+{
+    const auto mustLock = SDL_MUSTLOCK(surface); // NOLINT(hicpp-signed-bitwise)
+    if (mustLock && SDL_LockSurface(surface) != 0)
+    {
+        return;
+    }
+
+    // Window surfaces are 32 bits per pixel on every platform we target
+    if (surface->format->BytesPerPixel == sizeof(Uint32))
+    {
+        for (const auto& tile : tiles)
+        {
+            const auto right = std::min(tile.x + tile.width, surface->w);
+            const auto bottom = std::min(tile.y + tile.height, surface->h);
+
+            for (int y = tile.y; y < bottom; ++y)
+            {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                auto* rowBytes = static_cast<Uint8*>(surface->pixels) + y * surface->pitch;
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                auto* row = reinterpret_cast<Uint32*>(rowBytes);
+                for (int x = tile.x; x < right; ++x)
+                {
+                    const auto& color = frame.at(x, y);
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    row[x] = SDL_MapRGB(
+                        surface->format, toChannel(color.red), toChannel(color.green), toChannel(color.blue));
+                }
+            }
+        }
+    }
+
+    if (mustLock)
+    {
+        SDL_UnlockSurface(surface);
+    }
+}
+
+// The title shows the progress of the render and, unless stats are compiled out, its throughput over the last update
+auto buildTitle(size_t completedPasses, const StatsSnapshot& counters, std::chrono::nanoseconds duration)
+{
+    std::ostringstream title;
+    title << "eyebeam - pass " << completedPasses << "/" << ProgressiveRenderer::defaultMaxSamples;
+
+    if constexpr (statsEnabled)
+    {
+        const auto microseconds = std::chrono::duration<double, std::micro>(duration).count();
+        const auto perMicrosecond = [&](Stat stat) { return static_cast<double>(counters[stat]) / microseconds; };
+        title << std::fixed << std::setprecision(1) << " - " << perMicrosecond(Stat::Samples) << " Msamples/s, "
+              << perMicrosecond(Stat::RaysCast) << " Mrays/s";
+    }
+
+    return title.str();
+}
+
+auto toRects(const std::vector<Tile>& tiles)
+{
+    std::vector<SDL_Rect> rects;
+    rects.reserve(tiles.size());
+
+    for (const auto& tile : tiles)
+    {
+        rects.push_back(SDL_Rect{tile.x, tile.y, tile.width, tile.height});
+    }
+
+    return rects;
+}
+
 } // namespace
 
 class SdlApplication::AppImpl
@@ -87,20 +186,34 @@ public:
     {
     }
 
-    [[nodiscard]] auto validateCommandLineParameters() const
+    // Accepts the scene file, optionally preceded by --sampler and the name of a sampler
+    auto parseCommandLineParameters()
     {
-        if (m_argc != 2)
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const std::vector<std::string_view> arguments(m_argv + 1, m_argv + m_argc);
+
+        if (arguments.size() == 3 && arguments[0] == "--sampler")
+        {
+            const auto samplerType(samplerTypeFromName(arguments[1]));
+            if (!samplerType.has_value())
+            {
+                return AppInit::InvalidCommandLineArguments;
+            }
+
+            m_samplerType = *samplerType;
+        }
+        else if (arguments.size() != 1)
         {
             return AppInit::InvalidCommandLineArguments;
         }
 
+        m_sceneFile = arguments.back();
         return AppInit::Succeeded;
     }
 
     auto loadScene()
     {
-        const SceneFactoryJson sceneFactory;
-        m_scene = sceneFactory.buildScene(m_argv[1]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        m_scene = createSceneFactory(m_sceneFile)->buildScene(m_sceneFile);
 
         if (m_scene == nullptr)
         {
@@ -128,23 +241,81 @@ public:
         return AppInit::Succeeded;
     }
 
-    auto render() const
+    void startRendering()
+    {
+        m_titleUpdateTime = Clock::now();
+        m_titleUpdateCounters = StatsSnapshot::collect();
+        m_renderer = std::make_unique<ProgressiveRenderer>(
+            *m_scene, m_pool, ProgressiveRenderer::defaultMaxSamples, TileRenderer::defaultTileSize, m_samplerType);
+    }
+
+    // Counters are merged from every thread, so the title is only updated once per interval
+    void updateTitle()
+    {
+        constexpr std::chrono::seconds titleUpdateInterval(1);
+
+        const auto now(Clock::now());
+        if (now - m_titleUpdateTime < titleUpdateInterval)
+        {
+            return;
+        }
+
+        const auto counters(StatsSnapshot::collect());
+        const auto title(buildTitle(
+            m_renderer->completedPasses(),
+            counters - m_titleUpdateCounters,
+            now - m_titleUpdateTime));
+        SDL_SetWindowTitle(m_window.get(), title.c_str());
+
+        m_titleUpdateTime = now;
+        m_titleUpdateCounters = counters;
+    }
+
+    // Only the tiles that gained samples since the last frame taken from the render thread are tonemapped and
+    // presented. Taking a frame never waits, so a slow render cannot stall event handling.
+    void render() const
     {
-        auto* const screenSurface = SDL_GetWindowSurface(m_window.get());
+        const auto changed(m_renderer->takeChangedTiles());
+        if (changed.empty())
+        {
+            return;
+        }
+
+        copyTilesToSurface(m_renderer->frame(), changed, SDL_GetWindowSurface(m_window.get()));
 
-        constexpr auto red = 0xFF;
-        constexpr auto green = 0xFF;
-        constexpr auto blue = 0xFF;
-        SDL_FillRect(screenSurface, nullptr, SDL_MapRGB(screenSurface->format, red, green, blue));
+        const auto rects(toRects(changed));
+        SDL_UpdateWindowSurfaceRects(m_window.get(), rects.data(), static_cast<int>(rects.size()));
+    }
+
+    void redrawWindow() const
+    {
         SDL_UpdateWindowSurface(m_window.get());
     }
 
+    [[nodiscard]] auto takeFirstPassStatistics() const
+    {
+        return m_renderer->takeFirstPassStatistics();
+    }
+
+    [[nodiscard]] auto handoffStatistics() const
+    {
+        return m_renderer->handoffStatistics();
+    }
+
 private:
     int m_argc;
     char** m_argv;
+    std::string_view m_sceneFile;
+    SamplerType m_samplerType = ProgressiveRenderer::defaultSamplerType;
 
     std::unique_ptr<SDL_Window, WindowDeleter> m_window = nullptr;
     std::unique_ptr<Scene> m_scene = nullptr;
+
+    WorkStealingPool m_pool;
+    std::unique_ptr<ProgressiveRenderer> m_renderer = nullptr;
+
+    Clock::time_point m_titleUpdateTime;
+    StatsSnapshot m_titleUpdateCounters;
 };
 
 SdlApplication::SdlApplication(int argc, char** argv) : m_pAppData(std::make_unique<AppImpl>(argc, argv))
@@ -162,7 +333,7 @@ SdlApplication::~SdlApplication()
 
 AppInit SdlApplication::init()
 {
-    if (m_pAppData->validateCommandLineParameters() == AppInit::InvalidCommandLineArguments)
+    if (m_pAppData->parseCommandLineParameters() == AppInit::InvalidCommandLineArguments)
     {
         return AppInit::InvalidCommandLineArguments;
     }
@@ -177,7 +348,13 @@ AppInit SdlApplication::init()
         return AppInit::InitSubsystemsFailed;
     }
 
-    return m_pAppData->createWindow();
+    if (m_pAppData->createWindow() == AppInit::WindowCreationFailed)
+    {
+        return AppInit::WindowCreationFailed;
+    }
+
+    m_pAppData->startRendering();
+    return AppInit::Succeeded;
 }
 
 void SdlApplication::render() const
@@ -194,9 +371,25 @@ void SdlApplication::run()
     {
         const auto loopStartTime(Clock::now());
         shouldContinue = pollForEvents(event);
-        render();
+
+        m_pAppData->render();
+        m_pAppData->updateTitle();
+        if (shouldContinue == EventLoopResult::RedrawWindow)
+        {
+            m_pAppData->redrawWindow();
+        }
+
+        // The first pass's tile timings are printed so that load imbalance shows up without a profiler
+        const auto statistics(m_pAppData->takeFirstPassStatistics());
+        if (statistics.has_value())
+        {
+            std::cout << *statistics;
+        }
+
         yieldExtraLoopTime(loopStartTime);
-    } while (shouldContinue == EventLoopResult::ContinueLoop);
+    } while (shouldContinue != EventLoopResult::QuitApp);
+
+    std::cout << m_pAppData->handoffStatistics();
 }
 
 std::string SdlApplication::getLastError() const
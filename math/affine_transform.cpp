@@ -0,0 +1,106 @@
+#include "affine_transform.h"
+
+#include "matrix4.h"
+#include "normal3.h"
+#include "ray3.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+using namespace impl;
+
+auto isAffine(const UnalignedMatrixStorage& m) noexcept
+{
+    return m[getIndexFromRowColumn(3, 0)] == 0.0F && m[getIndexFromRowColumn(3, 1)] == 0.0F &&
+           m[getIndexFromRowColumn(3, 2)] == 0.0F && m[getIndexFromRowColumn(3, 3)] == 1.0F;
+}
+
+auto truncate(const UnalignedMatrixStorage& m)
+{
+    if (!isAffine(m))
+    {
+        throw std::invalid_argument("AffineTransform constructed from a Transform that is not affine");
+    }
+
+    AffineMatrixStorage result;
+    std::copy(begin(m), begin(m) + result.size(), begin(result));
+    return result;
+}
+
+void printRows(std::ostream& os, const AffineMatrixStorage& m)
+{
+    for (size_t row = 0; row < 3; ++row)
+    {
+        os << "[ ";
+
+        for (size_t column = 0; column < 4; ++column)
+        {
+            os << m[getIndexFromRowColumn(row, column)] << ' ';
+        }
+
+        os << "]\n";
+    }
+
+    os << "[ 0 0 0 1 ]";
+}
+
+} // namespace
+
+AffineTransform::AffineTransform(const Transform& transform)
+    : m_matrix(truncate(transform.getTransformUnaligned().first))
+    , m_inverse(truncate(transform.getTransformUnaligned().second))
+{
+}
+
+// Normals are transformed by the transposed inverse, so the columns of the inverse are used as rows here. The
+// translation does not apply to normals.
+Normal3 AffineTransform::multiply(const Normal3& n) const noexcept
+{
+    return Normal3(Vector3(
+        m_inverse[getIndexFromRowColumn(0, 0)] * n.x() + m_inverse[getIndexFromRowColumn(1, 0)] * n.y() +
+            m_inverse[getIndexFromRowColumn(2, 0)] * n.z(),
+        m_inverse[getIndexFromRowColumn(0, 1)] * n.x() + m_inverse[getIndexFromRowColumn(1, 1)] * n.y() +
+            m_inverse[getIndexFromRowColumn(2, 1)] * n.z(),
+        m_inverse[getIndexFromRowColumn(0, 2)] * n.x() + m_inverse[getIndexFromRowColumn(1, 2)] * n.y() +
+            m_inverse[getIndexFromRowColumn(2, 2)] * n.z()));
+}
+
+Ray3 AffineTransform::multiply(const Ray3& r) const noexcept
+{
+    return Ray3(multiply(r.origin()), multiply(r.direction()), r.shutterTime());
+}
+
+bool AffineTransform::isIdentity() const
+{
+    return areEqual(m_matrix, buildIdentity()) && areEqual(m_inverse, buildIdentity());
+}
+
+bool operator==(const AffineTransform& lhs, const AffineTransform& rhs)
+{
+    return areEqual(lhs.m_matrix, rhs.m_matrix) && areEqual(lhs.m_inverse, rhs.m_inverse);
+}
+
+bool operator!=(const AffineTransform& lhs, const AffineTransform& rhs)
+{
+    return !(lhs == rhs);
+}
+
+std::ostream& operator<<(std::ostream& os, const AffineTransform& out)
+{
+    os << "AffineTransform:\n";
+    printRows(os, out.m_matrix);
+    os << "\n\nInverse:\n";
+    printRows(os, out.m_inverse);
+    return os;
+}
+
+} // namespace eyebeam
@@ -0,0 +1,214 @@
+#ifndef INCLUDED_AFFINE_TRANSFORM_H_
+#define INCLUDED_AFFINE_TRANSFORM_H_
+
+#include "components_packet.h"
+#include "matrix4.h"
+#include "normal3.h"
+#include "point3.h"
+#include "ray3.h"
+#include "ray3_packet.h"
+#include "simd_lanes.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <array>
+#include <iosfwd>
+
+namespace eyebeam
+{
+
+// The upper three rows of an affine matrix. The bottom row is always (0, 0, 0, 1) and is not stored.
+using AffineMatrixStorage = std::array<float, 12>;
+
+// A Transform whose matrices are known to be affine, which covers everything built from translate, scale, rotate and
+// lookAt. Dropping the bottom row saves a quarter of the storage, and points are transformed without computing the
+// fourth row or performing the homogeneous divide.
+class alignas(16) AffineTransform
+{
+public:
+    constexpr AffineTransform() noexcept : AffineTransform(buildIdentity(), buildIdentity())
+    {
+    }
+
+    constexpr AffineTransform(const AffineMatrixStorage& matrix, const AffineMatrixStorage& inverse) noexcept
+        : m_matrix(matrix)
+        , m_inverse(inverse)
+    {
+    }
+
+    // Throws std::invalid_argument when the bottom row of either matrix is not exactly (0, 0, 0, 1)
+    explicit AffineTransform(const Transform& transform);
+
+    [[nodiscard]] constexpr explicit operator Transform() const noexcept
+    {
+        return Transform(expand(m_matrix), expand(m_inverse));
+    }
+
+    [[nodiscard]] constexpr auto inverse() const noexcept
+    {
+        return AffineTransform(m_inverse, m_matrix);
+    }
+
+    [[nodiscard]] constexpr auto multiply(const Point3& p) const noexcept
+    {
+        using namespace impl;
+
+        std::array<float, 3> result = {0.0F};
+
+        for (size_t row = 0; row < 3; ++row)
+        {
+            result.at(row) = m_matrix.at(getIndexFromRowColumn(row, 0)) * p.x() +
+                             m_matrix.at(getIndexFromRowColumn(row, 1)) * p.y() +
+                             m_matrix.at(getIndexFromRowColumn(row, 2)) * p.z() +
+                             m_matrix.at(getIndexFromRowColumn(row, 3));
+        }
+
+        return Point3(result[0], result[1], result[2]);
+    }
+
+    [[nodiscard]] constexpr auto multiply(const Vector3& v) const noexcept
+    {
+        using namespace impl;
+
+        std::array<float, 3> result = {0.0F};
+
+        for (size_t row = 0; row < 3; ++row)
+        {
+            result.at(row) = m_matrix.at(getIndexFromRowColumn(row, 0)) * v.x() +
+                             m_matrix.at(getIndexFromRowColumn(row, 1)) * v.y() +
+                             m_matrix.at(getIndexFromRowColumn(row, 2)) * v.z();
+        }
+
+        return Vector3(result[0], result[1], result[2]);
+    }
+
+    [[nodiscard]] constexpr auto multiply(const AffineTransform& t) const noexcept
+    {
+        return AffineTransform(compose(m_matrix, t.m_matrix), compose(t.m_inverse, m_inverse));
+    }
+
+    [[nodiscard]] Normal3 multiply(const Normal3& n) const noexcept;
+    [[nodiscard]] Ray3 multiply(const Ray3& r) const noexcept;
+
+    template <size_t Width>
+    [[nodiscard]] auto multiply(const Point3Packet<Width>& p) const noexcept
+    {
+        Point3Packet<Width> result;
+        transformLanes<Width, true>(p.x, p.y, p.z, result.x, result.y, result.z);
+        return result;
+    }
+
+    template <size_t Width>
+    [[nodiscard]] auto multiply(const Vector3Packet<Width>& v) const noexcept
+    {
+        Vector3Packet<Width> result;
+        transformLanes<Width, false>(v.x, v.y, v.z, result.x, result.y, result.z);
+        return result;
+    }
+
+    template <size_t Width>
+    [[nodiscard]] auto multiply(const Ray3Packet<Width>& r) const noexcept
+    {
+        return Ray3Packet<Width>(multiply(r.origins()), multiply(r.directions()), r.shutterTimes());
+    }
+
+    [[nodiscard]] bool isIdentity() const;
+
+    friend bool operator==(const AffineTransform& lhs, const AffineTransform& rhs);
+    friend std::ostream& operator<<(std::ostream& os, const AffineTransform& out);
+
+private:
+    [[nodiscard]] static constexpr AffineMatrixStorage buildIdentity() noexcept
+    {
+        // clang-format off
+        return AffineMatrixStorage{
+            1.0F, 0.0F, 0.0F, 0.0F,
+            0.0F, 1.0F, 0.0F, 0.0F,
+            0.0F, 0.0F, 1.0F, 0.0F};
+        // clang-format on
+    }
+
+    [[nodiscard]] static constexpr UnalignedMatrixStorage expand(const AffineMatrixStorage& m) noexcept
+    {
+        UnalignedMatrixStorage result = {0.0F};
+
+        for (size_t i = 0; i < m.size(); ++i)
+        {
+            result.at(i) = m.at(i);
+        }
+
+        result.at(impl::getIndexFromRowColumn(3, 3)) = 1.0F;
+        return result;
+    }
+
+    // The implicit bottom rows only contribute the translation column of lhs
+    [[nodiscard]] static constexpr AffineMatrixStorage compose(
+        const AffineMatrixStorage& lhs,
+        const AffineMatrixStorage& rhs) noexcept
+    {
+        using namespace impl;
+
+        AffineMatrixStorage result = {0.0F};
+
+        for (size_t row = 0; row < 3; ++row)
+        {
+            for (size_t column = 0; column < 4; ++column)
+            {
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    result.at(getIndexFromRowColumn(row, column)) +=
+                        lhs.at(getIndexFromRowColumn(row, i)) * rhs.at(getIndexFromRowColumn(i, column));
+                }
+            }
+
+            result.at(getIndexFromRowColumn(row, 3)) += lhs.at(getIndexFromRowColumn(row, 3));
+        }
+
+        return result;
+    }
+
+    template <size_t Width, bool IsPoint>
+    void transformLanes(
+        const AlignedLaneStorage<Width>& x,
+        const AlignedLaneStorage<Width>& y,
+        const AlignedLaneStorage<Width>& z,
+        AlignedLaneStorage<Width>& resultX,
+        AlignedLaneStorage<Width>& resultY,
+        AlignedLaneStorage<Width>& resultZ) const noexcept
+    {
+        using Lanes = PacketLanes<Width>;
+        using namespace impl;
+
+        const std::array<AlignedLaneStorage<Width>*, 3> results = {&resultX, &resultY, &resultZ};
+
+        for (size_t lane = 0; lane < Width; lane += Lanes::width)
+        {
+            const auto laneX = Lanes::load(&x.data[lane]);
+            const auto laneY = Lanes::load(&y.data[lane]);
+            const auto laneZ = Lanes::load(&z.data[lane]);
+
+            for (size_t row = 0; row < 3; ++row)
+            {
+                const auto translation = IsPoint ? Lanes(m_matrix[getIndexFromRowColumn(row, 3)]) : Lanes(0.0F);
+
+                multiplyAdd(
+                    Lanes(m_matrix[getIndexFromRowColumn(row, 0)]),
+                    laneX,
+                    multiplyAdd(
+                        Lanes(m_matrix[getIndexFromRowColumn(row, 1)]),
+                        laneY,
+                        multiplyAdd(Lanes(m_matrix[getIndexFromRowColumn(row, 2)]), laneZ, translation)))
+                    .store(&results[row]->data[lane]);
+            }
+        }
+    }
+
+    AffineMatrixStorage m_matrix;
+    AffineMatrixStorage m_inverse;
+};
+
+bool operator!=(const AffineTransform& lhs, const AffineTransform& rhs);
+
+} // namespace eyebeam
+
+#endif // INCLUDED_AFFINE_TRANSFORM_H_
@@ -0,0 +1,121 @@
+#include "affine_transform.h"
+
+#include "random_generator.h"
+
+#include <benchmark/benchmark.h>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+auto generateRandomAffineTransform()
+{
+    return AffineTransform(Transform::translate(RandomGenerator::generateRandomVector3())
+                               .multiply(Transform::rotateAxisAngle(
+                                   RandomGenerator::generateRandomVector3(),
+                                   Radians(RandomGenerator::generateRandomFloat()))));
+}
+
+void benchmarkAffineTransformApplyToPoint(benchmark::State& state)
+{
+    const auto p(RandomGenerator::generateRandomPoint3());
+    const auto t(generateRandomAffineTransform());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto transformed(t.multiply(p));
+        benchmark::DoNotOptimize(transformed);
+    }
+}
+
+void benchmarkAffineTransformApplyToVector(benchmark::State& state)
+{
+    const auto v(RandomGenerator::generateRandomVector3());
+    const auto t(generateRandomAffineTransform());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto transformed(t.multiply(v));
+        benchmark::DoNotOptimize(transformed);
+    }
+}
+
+void benchmarkAffineTransformApplyToNormal(benchmark::State& state)
+{
+    const auto n(RandomGenerator::generateRandomNormal3());
+    const auto t(generateRandomAffineTransform());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto transformed(t.multiply(n));
+        benchmark::DoNotOptimize(transformed);
+    }
+}
+
+void benchmarkAffineTransformApplyToRay(benchmark::State& state)
+{
+    const auto r(RandomGenerator::generateRandomRay3());
+    const auto t(generateRandomAffineTransform());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto transformed(t.multiply(r));
+        benchmark::DoNotOptimize(transformed);
+    }
+}
+
+template <size_t Width>
+void benchmarkAffineTransformApplyToRayPacket(benchmark::State& state)
+{
+    Ray3Packet<Width> packet;
+    for (size_t lane = 0; lane < Width; ++lane)
+    {
+        packet.set(lane, RandomGenerator::generateRandomRay3());
+    }
+
+    const auto t(generateRandomAffineTransform());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto transformed(t.multiply(packet));
+        benchmark::DoNotOptimize(transformed);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * Width));
+}
+
+void benchmarkAffineTransformCompose(benchmark::State& state)
+{
+    const auto lhs(generateRandomAffineTransform());
+    const auto rhs(generateRandomAffineTransform());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto composed(lhs.multiply(rhs));
+        benchmark::DoNotOptimize(composed);
+    }
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkAffineTransformApplyToPoint);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkAffineTransformApplyToVector);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkAffineTransformApplyToNormal);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkAffineTransformApplyToRay);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkAffineTransformApplyToRayPacket, 8);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkAffineTransformCompose);
+
+} // namespace
+
+} // namespace eyebeam
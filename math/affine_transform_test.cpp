@@ -0,0 +1,192 @@
+#include "affine_transform.h"
+
+#include "random_generator.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+auto generateRandomAffineTransform()
+{
+    return Transform::translate(RandomGenerator::generateRandomVector3())
+        .multiply(Transform::rotateAxisAngle(
+            RandomGenerator::generateRandomVector3(),
+            Radians(RandomGenerator::generateRandomFloat())))
+        .multiply(Transform::scale(2.0F, 0.5F, 3.0F));
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, DefaultCtorResultsInIdentityTransform)
+{
+    // GIVEN:
+    constexpr AffineTransform t;
+
+    // WHEN:
+    const auto result = t.isIdentity();
+
+    // THEN:
+    EXPECT_TRUE(result);
+}
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, StoresThreeQuartersOfTransform)
+{
+    // GIVEN:
+    constexpr auto transformSize = sizeof(Transform);
+
+    // WHEN:
+    constexpr auto result = sizeof(AffineTransform);
+
+    // THEN:
+    EXPECT_EQ(transformSize * 3 / 4, result);
+}
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, ConversionToTransformRoundTrips)
+{
+    // GIVEN:
+    const auto t(generateRandomAffineTransform());
+
+    // WHEN:
+    const auto result(static_cast<Transform>(AffineTransform(t)));
+
+    // THEN:
+    EXPECT_EQ(t, result);
+}
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, CtorThrowsInvalidArgumentForProjectiveTransform)
+{
+    // GIVEN:
+    // clang-format off
+    const Matrix4 m(AlignedMatrixStorage{
+        1.0F, 0.0F, 0.0F, 0.0F,
+        0.0F, 1.0F, 0.0F, 0.0F,
+        0.0F, 0.0F, 1.0F, 0.0F,
+        0.0F, 0.0F, 1.0F, 0.0F
+    });
+    // clang-format on
+    const Transform t(m, Matrix4());
+
+    // WHEN:
+    // THEN:
+    EXPECT_THROW(AffineTransform{t}, std::invalid_argument);
+}
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, MultiplyPointMatchesTransform)
+{
+    // GIVEN:
+    const auto t(generateRandomAffineTransform());
+    const AffineTransform affine(t);
+    const auto p(RandomGenerator::generateRandomPoint3());
+
+    // WHEN:
+    const auto result(affine.multiply(p));
+
+    // THEN:
+    EXPECT_EQ(t.multiply(p), result);
+}
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, MultiplyVectorMatchesTransform)
+{
+    // GIVEN:
+    const auto t(generateRandomAffineTransform());
+    const AffineTransform affine(t);
+    const auto v(RandomGenerator::generateRandomVector3());
+
+    // WHEN:
+    const auto result(affine.multiply(v));
+
+    // THEN:
+    EXPECT_EQ(t.multiply(v), result);
+}
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, MultiplyNormalMatchesTransform)
+{
+    // GIVEN:
+    const auto t(generateRandomAffineTransform());
+    const AffineTransform affine(t);
+    const auto n(RandomGenerator::generateRandomNormal3());
+
+    // WHEN:
+    const auto result(affine.multiply(n));
+
+    // THEN:
+    EXPECT_EQ(t.multiply(n), result);
+}
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, MultiplyRayMatchesTransform)
+{
+    // GIVEN:
+    const auto t(generateRandomAffineTransform());
+    const AffineTransform affine(t);
+    const auto r(RandomGenerator::generateRandomRay3());
+
+    // WHEN:
+    const auto result(affine.multiply(r));
+
+    // THEN:
+    EXPECT_EQ(t.multiply(r), result);
+}
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, MultiplyRayPacketMatchesScalarMultiplyInEveryLane)
+{
+    // GIVEN:
+    const AffineTransform affine(generateRandomAffineTransform());
+    Ray3Packet<8> packet;
+    for (size_t lane = 0; lane < packet.width; ++lane)
+    {
+        packet.set(lane, RandomGenerator::generateRandomRay3());
+    }
+
+    // WHEN:
+    const auto result(affine.multiply(packet));
+
+    // THEN:
+    for (size_t lane = 0; lane < packet.width; ++lane)
+    {
+        EXPECT_EQ(affine.multiply(packet.get(lane)), result.get(lane));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, MultiplyComposesLikeTransform)
+{
+    // GIVEN:
+    const auto lhs(generateRandomAffineTransform());
+    const auto rhs(generateRandomAffineTransform());
+
+    // WHEN:
+    const auto result(AffineTransform(lhs).multiply(AffineTransform(rhs)));
+
+    // THEN:
+    EXPECT_EQ(AffineTransform(lhs.multiply(rhs)), result);
+}
+
+// NOLINTNEXTLINE
+TEST(AffineTransformTests, MultiplyByInverseResultsInIdentity)
+{
+    // GIVEN:
+    const AffineTransform t(generateRandomAffineTransform());
+
+    // WHEN:
+    const auto result(t.multiply(t.inverse()));
+
+    // THEN:
+    EXPECT_TRUE(result.isIdentity());
+}
+
+} // namespace eyebeam
@@ -0,0 +1,185 @@
+#include "animated_transform.h"
+
+#include "affine_transform.h"
+#include "bounds3.h"
+#include "matrix4.h"
+#include "point3.h"
+#include "quaternion.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+using impl::getIndexFromRowColumn;
+
+// Samples taken through each keyframe interval by motionBounds
+constexpr size_t boundsSamplesPerInterval = 16;
+
+[[nodiscard]] auto lerp(const Vector3& from, const Vector3& to, float t) noexcept
+{
+    return from * (1.0F - t) + to * t;
+}
+
+// Builds the matrix and its inverse straight from the pose, whose rotation inverts by transposing, rather than by
+// composing three transforms
+[[nodiscard]] AffineTransform toAffineTransform(
+    const Vector3& translation,
+    const Quaternion& rotation,
+    const Vector3& scale)
+{
+    const auto r(rotation.toTransform().getTransformUnaligned().first);
+    const std::array<float, 3> s{scale.x(), scale.y(), scale.z()};
+    const std::array<float, 3> t{translation.x(), translation.y(), translation.z()};
+
+    AffineMatrixStorage matrix{};
+    AffineMatrixStorage inverse{};
+    for (size_t row = 0; row < 3; ++row)
+    {
+        auto inverseTranslation = 0.0F;
+        for (size_t column = 0; column < 3; ++column)
+        {
+            matrix[getIndexFromRowColumn(row, column)] = r[getIndexFromRowColumn(row, column)] * s[column];
+            inverse[getIndexFromRowColumn(row, column)] = r[getIndexFromRowColumn(column, row)] / s[row];
+            inverseTranslation -= inverse[getIndexFromRowColumn(row, column)] * t[column];
+        }
+
+        matrix[getIndexFromRowColumn(row, 3)] = t[row];
+        inverse[getIndexFromRowColumn(row, 3)] = inverseTranslation;
+    }
+
+    return AffineTransform(matrix, inverse);
+}
+
+[[nodiscard]] auto maxAbsComponent(const Vector3& v) noexcept
+{
+    return std::max({std::abs(v.x()), std::abs(v.y()), std::abs(v.z())});
+}
+
+// How far any point of bounds can move per unit of shutter time while the pose goes from one keyframe to the next.
+// A point p is at translation + rotation * (scale * p), whose derivative is bounded by that of the translation, the
+// angle turned times the largest scaled distance from the origin and the change in scale times the distance.
+[[nodiscard]] float maxSpeed(const TransformKeyframe& from, const TransformKeyframe& to, const Bounds3& bounds)
+{
+    const auto farthestCorner = Vector3(
+        std::max(std::abs(bounds.min().x()), std::abs(bounds.max().x())),
+        std::max(std::abs(bounds.min().y()), std::abs(bounds.max().y())),
+        std::max(std::abs(bounds.min().z()), std::abs(bounds.max().z())));
+    const auto distance = length(farthestCorner);
+    const auto largestScale = std::max(maxAbsComponent(from.scale), maxAbsComponent(to.scale));
+
+    const auto perInterval = length(to.translation - from.translation) +
+                             angleBetween(from.rotation, to.rotation) * largestScale * distance +
+                             maxAbsComponent(to.scale - from.scale) * distance;
+    return perInterval / (to.shutterTime - from.shutterTime);
+}
+
+[[nodiscard]] auto transformCorners(const AffineTransform& t, const Bounds3& bounds)
+{
+    Bounds3 result;
+    for (size_t corner = 0; corner < 8; ++corner)
+    {
+        result.unite(t.multiply(Point3(
+            (corner & 1U) == 0 ? bounds.min().x() : bounds.max().x(),
+            (corner & 2U) == 0 ? bounds.min().y() : bounds.max().y(),
+            (corner & 4U) == 0 ? bounds.min().z() : bounds.max().z())));
+    }
+
+    return result;
+}
+
+} // namespace
+
+AnimatedTransform::AnimatedTransform(std::vector<TransformKeyframe> keyframes) : m_keyframes(std::move(keyframes))
+{
+    if (m_keyframes.empty())
+    {
+        throw std::invalid_argument("Animated transforms need at least one keyframe");
+    }
+
+    for (size_t i = 0; i < m_keyframes.size(); ++i)
+    {
+        if (i != 0 && !(m_keyframes[i].shutterTime > m_keyframes[i - 1].shutterTime))
+        {
+            throw std::invalid_argument("Keyframe shutter times must increase");
+        }
+
+        const auto& scale = m_keyframes[i].scale;
+        if (scale.x() == 0.0F || scale.y() == 0.0F || scale.z() == 0.0F)
+        {
+            throw std::invalid_argument("Keyframe scales cannot be zero");
+        }
+
+        m_keyframes[i].rotation = norm(m_keyframes[i].rotation);
+    }
+}
+
+AffineTransform AnimatedTransform::at(float shutterTime) const noexcept
+{
+    const auto& first = m_keyframes.front();
+    const auto& last = m_keyframes.back();
+    if (!(shutterTime > first.shutterTime))
+    {
+        return toAffineTransform(first.translation, first.rotation, first.scale);
+    }
+
+    if (!(shutterTime < last.shutterTime))
+    {
+        return toAffineTransform(last.translation, last.rotation, last.scale);
+    }
+
+    const auto next = std::upper_bound(
+        m_keyframes.begin(), m_keyframes.end(), shutterTime, [](float time, const TransformKeyframe& keyframe) {
+            return time < keyframe.shutterTime;
+        });
+    const auto& from = *(next - 1);
+    const auto& to = *next;
+    const auto t = (shutterTime - from.shutterTime) / (to.shutterTime - from.shutterTime);
+
+    return toAffineTransform(
+        lerp(from.translation, to.translation, t), slerp(from.rotation, to.rotation, t), lerp(from.scale, to.scale, t));
+}
+
+Bounds3 AnimatedTransform::motionBounds(const Bounds3& bounds) const
+{
+    auto result(transformCorners(at(0.0F), bounds));
+
+    for (size_t i = 0; i + 1 < m_keyframes.size(); ++i)
+    {
+        const auto& from = m_keyframes[i];
+        const auto& to = m_keyframes[i + 1];
+        const auto start = std::max(from.shutterTime, 0.0F);
+        const auto end = std::min(to.shutterTime, 1.0F);
+        if (!(start < end))
+        {
+            continue;
+        }
+
+        // Every time of the interval is within half a step of a sample
+        const auto step = (end - start) / static_cast<float>(boundsSamplesPerInterval);
+        const auto padding = 0.5F * step * maxSpeed(from, to, bounds);
+
+        for (size_t sample = 0; sample <= boundsSamplesPerInterval; ++sample)
+        {
+            const auto sampleBounds(transformCorners(at(start + step * static_cast<float>(sample)), bounds));
+            result.unite(Bounds3(
+                sampleBounds.min() + Vector3(-padding, -padding, -padding),
+                sampleBounds.max() + Vector3(padding, padding, padding)));
+        }
+    }
+
+    return result.unite(transformCorners(at(1.0F), bounds));
+}
+
+} // namespace eyebeam
@@ -0,0 +1,51 @@
+#ifndef INCLUDED_ANIMATED_TRANSFORM_H_
+#define INCLUDED_ANIMATED_TRANSFORM_H_
+
+#include "affine_transform.h"
+#include "bounds3.h"
+#include "quaternion.h"
+#include "vector3.h"
+
+#include <vector>
+
+namespace eyebeam
+{
+
+// The pose of a moving transform at one shutter time: a scale along each axis, then a rotation, then a translation
+struct TransformKeyframe
+{
+    float shutterTime;
+    Vector3 translation;
+    Quaternion rotation;
+    Vector3 scale;
+};
+
+// A transform that moves while the shutter is open. Between two keyframes the translation and scale are interpolated
+// linearly and the rotation by slerp, so a spinning object keeps its shape, and outside the keyframes the transform
+// holds still at the nearest one.
+class AnimatedTransform
+{
+public:
+    // Throws std::invalid_argument when there are no keyframes, when their shutter times do not increase or when a
+    // scale is zero
+    explicit AnimatedTransform(std::vector<TransformKeyframe> keyframes);
+
+    [[nodiscard]] const auto& keyframes() const noexcept
+    {
+        return m_keyframes;
+    }
+
+    [[nodiscard]] AffineTransform at(float shutterTime) const noexcept;
+
+    // Bounds that hold bounds at every shutter time from 0 to 1, so a hierarchy built over them once serves rays cast
+    // at any time. Poses are sampled through each keyframe interval and the gaps between them are covered by how far
+    // a corner can move between two samples, which keeps the bounds conservative even for fast rotations.
+    [[nodiscard]] Bounds3 motionBounds(const Bounds3& bounds) const;
+
+private:
+    std::vector<TransformKeyframe> m_keyframes;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_ANIMATED_TRANSFORM_H_
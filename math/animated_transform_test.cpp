@@ -0,0 +1,171 @@
+#include "animated_transform.h"
+
+#include "affine_transform.h"
+#include "random_generator.h"
+#include "transform.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+const TransformKeyframe start{
+    0.0F,
+    Vector3(1.0F, 2.0F, 3.0F),
+    Quaternion::rotateAxisAngle(Vector3(1.0F, 1.0F, 0.0F), Radians(0.5F)),
+    Vector3(1.0F, 2.0F, 1.0F)};
+
+const TransformKeyframe end{
+    1.0F,
+    Vector3(-4.0F, 2.0F, 0.0F),
+    Quaternion::rotateAxisAngle(Vector3(0.0F, 1.0F, 1.0F), Radians(2.5F)),
+    Vector3(2.0F, 2.0F, 0.5F)};
+
+auto toTransform(const TransformKeyframe& keyframe)
+{
+    return AffineTransform(Transform::translate(keyframe.translation)
+                               .multiply(keyframe.rotation.toTransform())
+                               .multiply(Transform::scale(keyframe.scale.x(), keyframe.scale.y(), keyframe.scale.z())));
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(AnimatedTransformTests, KeyframePosesComposeScaleRotationAndTranslation)
+{
+    // GIVEN:
+    const AnimatedTransform t({start, end});
+
+    // WHEN:
+    const auto atStart(t.at(0.0F));
+    const auto atEnd(t.at(1.0F));
+
+    // THEN:
+    EXPECT_EQ(toTransform(start), atStart);
+    EXPECT_EQ(toTransform(end), atEnd);
+}
+
+// NOLINTNEXTLINE
+TEST(AnimatedTransformTests, TransformHoldsStillOutsideTheKeyframes)
+{
+    // GIVEN:
+    auto later(start);
+    later.shutterTime = 0.25F;
+    auto earlier(end);
+    earlier.shutterTime = 0.75F;
+    const AnimatedTransform t({later, earlier});
+
+    // WHEN:
+    const auto beforeFirst(t.at(0.0F));
+    const auto afterLast(t.at(1.0F));
+
+    // THEN:
+    EXPECT_EQ(toTransform(start), beforeFirst);
+    EXPECT_EQ(toTransform(end), afterLast);
+}
+
+// NOLINTNEXTLINE
+TEST(AnimatedTransformTests, PosesBetweenKeyframesAreInterpolated)
+{
+    // GIVEN:
+    const AnimatedTransform t({start, end});
+
+    // WHEN:
+    const auto result(t.at(0.25F));
+
+    // THEN:
+    const TransformKeyframe expected{
+        0.25F,
+        Vector3(-0.25F, 2.0F, 2.25F),
+        slerp(start.rotation, end.rotation, 0.25F),
+        Vector3(1.25F, 2.0F, 0.875F)};
+    EXPECT_EQ(toTransform(expected), result);
+}
+
+// NOLINTNEXTLINE
+TEST(AnimatedTransformTests, InverseUndoesThePoseAtAnyTime)
+{
+    // GIVEN:
+    const AnimatedTransform t({start, end});
+    const auto p(RandomGenerator::generateRandomPoint3());
+
+    // WHEN:
+    const auto transform(t.at(0.6F));
+
+    // THEN:
+    EXPECT_EQ(p, transform.inverse().multiply(transform.multiply(p)));
+}
+
+// NOLINTNEXTLINE
+TEST(AnimatedTransformTests, MotionBoundsHoldTheBoundsAtEveryShutterTime)
+{
+    // GIVEN:
+    auto spinning(end);
+    spinning.rotation = Quaternion::rotateAxisAngle(Vector3(0.0F, 1.0F, 1.0F), Radians(3.0F));
+    const AnimatedTransform t({start, spinning});
+    const Bounds3 bounds(Point3(-1.0F, -0.5F, -2.0F), Point3(1.0F, 0.5F, 3.0F));
+
+    // WHEN:
+    const auto result(t.motionBounds(bounds));
+
+    // THEN:
+    for (int i = 0; i <= 1000; ++i)
+    {
+        const auto transform(t.at(static_cast<float>(i) / 1000.0F));
+        for (size_t corner = 0; corner < 8; ++corner)
+        {
+            const auto p(transform.multiply(Point3(
+                (corner & 1U) == 0 ? bounds.min().x() : bounds.max().x(),
+                (corner & 2U) == 0 ? bounds.min().y() : bounds.max().y(),
+                (corner & 4U) == 0 ? bounds.min().z() : bounds.max().z())));
+            EXPECT_LE(result.min().x(), p.x());
+            EXPECT_LE(result.min().y(), p.y());
+            EXPECT_LE(result.min().z(), p.z());
+            EXPECT_GE(result.max().x(), p.x());
+            EXPECT_GE(result.max().y(), p.y());
+            EXPECT_GE(result.max().z(), p.z());
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(AnimatedTransformTests, MotionBoundsOfAStillTransformAreTheTransformedBounds)
+{
+    // GIVEN:
+    const AnimatedTransform t({start});
+    const Bounds3 bounds(Point3(-1.0F, -1.0F, -1.0F), Point3(1.0F, 1.0F, 1.0F));
+
+    // WHEN:
+    const auto result(t.motionBounds(bounds));
+
+    // THEN:
+    Bounds3 expected;
+    for (size_t corner = 0; corner < 8; ++corner)
+    {
+        expected.unite(toTransform(start).multiply(Point3(
+            (corner & 1U) == 0 ? -1.0F : 1.0F, (corner & 2U) == 0 ? -1.0F : 1.0F, (corner & 4U) == 0 ? -1.0F : 1.0F)));
+    }
+
+    EXPECT_EQ(expected, result);
+}
+
+// NOLINTNEXTLINE
+TEST(AnimatedTransformTests, InvalidKeyframesThrow)
+{
+    // GIVEN:
+    auto flattened(end);
+    flattened.scale = Vector3(1.0F, 0.0F, 1.0F);
+
+    // THEN:
+    EXPECT_THROW(AnimatedTransform({}), std::invalid_argument);
+    EXPECT_THROW(AnimatedTransform({end, start}), std::invalid_argument);
+    EXPECT_THROW(AnimatedTransform({start, start}), std::invalid_argument);
+    EXPECT_THROW(AnimatedTransform({start, flattened}), std::invalid_argument);
+}
+
+} // namespace eyebeam
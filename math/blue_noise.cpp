@@ -0,0 +1,186 @@
+#include "blue_noise.h"
+
+#include "xoshiro128.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr size_t texelCount = blueNoiseTileSize * blueNoiseTileSize;
+constexpr size_t wrapMask = blueNoiseTileSize - 1;
+static_assert((blueNoiseTileSize & wrapMask) == 0, "The tile wraps around with a mask");
+
+// The spread of the Gaussian filter that measures how crowded a texel is, as recommended by Ulichney
+constexpr auto filterSigma = 1.5F;
+constexpr auto filterScale = -1.0F / (2.0F * filterSigma * filterSigma);
+constexpr size_t initialPointCount = texelCount / 10;
+constexpr std::uint64_t initialPatternSeed = 0xB1E;
+
+using Pattern = std::vector<std::uint8_t>;
+
+// The sum, at every texel, of a Gaussian centred on every set texel of a pattern, with distances wrapped around the
+// tile. Set texels with the most energy sit in the tightest clusters and unset ones with the least in the largest
+// voids.
+class EnergyField
+{
+public:
+    explicit EnergyField(const Pattern& pattern) : m_filter(), m_energy()
+    {
+        for (size_t y = 0; y < blueNoiseTileSize; ++y)
+        {
+            for (size_t x = 0; x < blueNoiseTileSize; ++x)
+            {
+                const auto dx = static_cast<float>(std::min(x, blueNoiseTileSize - x));
+                const auto dy = static_cast<float>(std::min(y, blueNoiseTileSize - y));
+                m_filter[y * blueNoiseTileSize + x] = std::exp((dx * dx + dy * dy) * filterScale);
+            }
+        }
+
+        for (size_t texel = 0; texel < texelCount; ++texel)
+        {
+            if (pattern[texel] != 0)
+            {
+                splat(texel, 1.0F);
+            }
+        }
+    }
+
+    void insert(Pattern& pattern, size_t texel)
+    {
+        pattern[texel] = 1;
+        splat(texel, 1.0F);
+    }
+
+    void remove(Pattern& pattern, size_t texel)
+    {
+        pattern[texel] = 0;
+        splat(texel, -1.0F);
+    }
+
+    [[nodiscard]] size_t tightestCluster(const Pattern& pattern) const
+    {
+        auto best = texelCount;
+        for (size_t texel = 0; texel < texelCount; ++texel)
+        {
+            if (pattern[texel] != 0 && (best == texelCount || m_energy[texel] > m_energy[best]))
+            {
+                best = texel;
+            }
+        }
+
+        return best;
+    }
+
+    [[nodiscard]] size_t largestVoid(const Pattern& pattern) const
+    {
+        auto best = texelCount;
+        for (size_t texel = 0; texel < texelCount; ++texel)
+        {
+            if (pattern[texel] == 0 && (best == texelCount || m_energy[texel] < m_energy[best]))
+            {
+                best = texel;
+            }
+        }
+
+        return best;
+    }
+
+private:
+    void splat(size_t texel, float sign)
+    {
+        const auto centreX = texel % blueNoiseTileSize;
+        const auto centreY = texel / blueNoiseTileSize;
+        for (size_t y = 0; y < blueNoiseTileSize; ++y)
+        {
+            const auto filterRow = ((y - centreY) & wrapMask) * blueNoiseTileSize;
+            for (size_t x = 0; x < blueNoiseTileSize; ++x)
+            {
+                m_energy[y * blueNoiseTileSize + x] += sign * m_filter[filterRow + ((x - centreX) & wrapMask)];
+            }
+        }
+    }
+
+    std::array<float, texelCount> m_filter;
+    std::array<float, texelCount> m_energy;
+};
+
+// Scatters points at random, then moves the point in the tightest cluster to the largest void until that would put
+// it back where it came from
+Pattern generateInitialPattern()
+{
+    Pattern pattern(texelCount, 0);
+    Xoshiro128Plus generator(initialPatternSeed);
+    for (size_t placed = 0; placed < initialPointCount;)
+    {
+        const auto texel = static_cast<size_t>(generator() >> 20U);
+        if (pattern[texel] == 0)
+        {
+            pattern[texel] = 1;
+            ++placed;
+        }
+    }
+
+    EnergyField field(pattern);
+    for (size_t i = 0; i < texelCount; ++i)
+    {
+        const auto cluster = field.tightestCluster(pattern);
+        field.remove(pattern, cluster);
+        const auto voidTexel = field.largestVoid(pattern);
+        field.insert(pattern, voidTexel);
+        if (voidTexel == cluster)
+        {
+            break;
+        }
+    }
+
+    return pattern;
+}
+
+BlueNoiseTile generateBlueNoiseTile()
+{
+    static_assert(texelCount == size_t{1} << 12U, "Initial points are drawn from the top 12 bits");
+
+    BlueNoiseTile ranks{};
+    const auto initial(generateInitialPattern());
+
+    // The initial points are ranked by removing the tightest cluster until none are left
+    auto pattern(initial);
+    EnergyField clusters(pattern);
+    for (auto rank = initialPointCount; rank > 0; --rank)
+    {
+        const auto cluster = clusters.tightestCluster(pattern);
+        clusters.remove(pattern, cluster);
+        ranks[cluster] = static_cast<std::uint16_t>(rank - 1);
+    }
+
+    // The rest are ranked by filling the largest void until the tile is full
+    pattern = initial;
+    EnergyField voids(pattern);
+    for (auto rank = initialPointCount; rank < texelCount; ++rank)
+    {
+        const auto voidTexel = voids.largestVoid(pattern);
+        voids.insert(pattern, voidTexel);
+        ranks[voidTexel] = static_cast<std::uint16_t>(rank);
+    }
+
+    return ranks;
+}
+
+} // namespace
+
+const BlueNoiseTile& blueNoiseTile()
+{
+    static const auto s_tile(generateBlueNoiseTile());
+    return s_tile;
+}
+
+} // namespace eyebeam
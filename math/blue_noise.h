@@ -0,0 +1,30 @@
+#ifndef INCLUDED_BLUE_NOISE_H_
+#define INCLUDED_BLUE_NOISE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace eyebeam
+{
+
+constexpr size_t blueNoiseTileSize = 64;
+
+using BlueNoiseTile = std::array<std::uint16_t, blueNoiseTileSize * blueNoiseTileSize>;
+
+// A blue noise dither array: the rank of every texel, such that the texels ranked below any threshold are spread
+// evenly over the tile with no low frequency clumps, and the tile wraps around seamlessly. It is generated with
+// Ulichney's void and cluster method on first use and shared by every thread afterwards.
+[[nodiscard]] const BlueNoiseTile& blueNoiseTile();
+
+// The rank of texel (x, y) mapped to the centre of its interval in [0, 1); x and y wrap around the tile
+[[nodiscard]] inline float blueNoiseValue(size_t x, size_t y)
+{
+    constexpr auto scale = 1.0F / static_cast<float>(blueNoiseTileSize * blueNoiseTileSize);
+    const auto rank = blueNoiseTile()[(y % blueNoiseTileSize) * blueNoiseTileSize + x % blueNoiseTileSize];
+    return (static_cast<float>(rank) + 0.5F) * scale;
+}
+
+} // namespace eyebeam
+
+#endif // INCLUDED_BLUE_NOISE_H_
@@ -0,0 +1 @@
+#include "borrowable_array.h"
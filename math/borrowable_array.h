@@ -0,0 +1,82 @@
+#ifndef INCLUDED_BORROWABLE_ARRAY_H_
+#define INCLUDED_BORROWABLE_ARRAY_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+// Read only elements that are either owned, or borrowed from memory that outlives the array such as a memory mapped
+// file. Borrowing lets large arrays be used in place instead of being copied.
+template <typename T>
+class BorrowableArray
+{
+public:
+    BorrowableArray() = default;
+
+    explicit BorrowableArray(std::vector<T> owned) noexcept : m_owned(std::move(owned))
+    {
+    }
+
+    BorrowableArray(const T* borrowed, size_t size) noexcept : m_borrowed(borrowed), m_borrowedSize(size)
+    {
+    }
+
+    [[nodiscard]] auto isBorrowed() const noexcept
+    {
+        return m_borrowed != nullptr;
+    }
+
+    [[nodiscard]] const T* data() const noexcept
+    {
+        return isBorrowed() ? m_borrowed : m_owned.data();
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return isBorrowed() ? m_borrowedSize : m_owned.size();
+    }
+
+    [[nodiscard]] auto empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    [[nodiscard]] const T& operator[](size_t index) const noexcept
+    {
+        return data()[index]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    [[nodiscard]] const T* begin() const noexcept
+    {
+        return data();
+    }
+
+    [[nodiscard]] const T* end() const noexcept
+    {
+        return data() + size(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    // Throws std::logic_error when the elements are borrowed, since they cannot be modified
+    [[nodiscard]] std::vector<T>& owned()
+    {
+        if (isBorrowed())
+        {
+            throw std::logic_error("Borrowed arrays cannot be modified");
+        }
+
+        return m_owned;
+    }
+
+private:
+    std::vector<T> m_owned;
+    const T* m_borrowed = nullptr;
+    size_t m_borrowedSize = 0;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_BORROWABLE_ARRAY_H_
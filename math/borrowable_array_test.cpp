@@ -0,0 +1,59 @@
+#include "borrowable_array.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// NOLINTNEXTLINE
+TEST(BorrowableArrayTests, borrowedArrayReadsTheBorrowedMemoryInPlace)
+{
+    // GIVEN:
+    const std::array<int, 3> memory = {1, 2, 3};
+
+    // WHEN:
+    const BorrowableArray<int> array(memory.data(), memory.size());
+
+    // THEN:
+    EXPECT_TRUE(array.isBorrowed());
+    EXPECT_EQ(array.data(), memory.data());
+    EXPECT_EQ(array.size(), 3U);
+    EXPECT_EQ(array[2], 3);
+}
+
+// NOLINTNEXTLINE
+TEST(BorrowableArrayTests, ownedArrayCanBeModified)
+{
+    // GIVEN:
+    BorrowableArray<int> array(std::vector<int>{1, 2});
+
+    // WHEN:
+    array.owned().push_back(3);
+
+    // THEN:
+    EXPECT_FALSE(array.isBorrowed());
+    EXPECT_EQ(std::vector<int>(array.begin(), array.end()), (std::vector<int>{1, 2, 3}));
+}
+
+// NOLINTNEXTLINE
+TEST(BorrowableArrayTests, modifyingBorrowedArrayThrows)
+{
+    // GIVEN:
+    const std::array<int, 1> memory = {1};
+    BorrowableArray<int> array(memory.data(), memory.size());
+
+    // WHEN:
+    // THEN:
+    EXPECT_THROW(static_cast<void>(array.owned()), std::logic_error);
+}
+
+} // namespace
+
+} // namespace eyebeam
@@ -0,0 +1,24 @@
+#include "bounds3.h"
+
+#include <ostream>
+
+namespace eyebeam
+{
+
+bool operator==(const Bounds3& lhs, const Bounds3& rhs)
+{
+    return lhs.min() == rhs.min() && lhs.max() == rhs.max();
+}
+
+bool operator!=(const Bounds3& lhs, const Bounds3& rhs)
+{
+    return !(lhs == rhs);
+}
+
+std::ostream& operator<<(std::ostream& os, const Bounds3& out)
+{
+    os << "Bounds3: " << out.min() << " to " << out.max();
+    return os;
+}
+
+} // namespace eyebeam
@@ -0,0 +1,131 @@
+#ifndef INCLUDED_BOUNDS3_H_
+#define INCLUDED_BOUNDS3_H_
+
+#include "point3.h"
+#include "vector3.h"
+
+#include <algorithm>
+#include <iosfwd>
+#include <limits>
+
+namespace eyebeam
+{
+
+// Axis aligned bounding box. The default box is empty, with its minimum above its maximum, so that the first unite()
+// replaces it.
+class Bounds3
+{
+public:
+    constexpr Bounds3() noexcept
+        : m_min(
+              std::numeric_limits<float>::infinity(),
+              std::numeric_limits<float>::infinity(),
+              std::numeric_limits<float>::infinity())
+        , m_max(
+              -std::numeric_limits<float>::infinity(),
+              -std::numeric_limits<float>::infinity(),
+              -std::numeric_limits<float>::infinity())
+    {
+    }
+
+    explicit constexpr Bounds3(const Point3& p) noexcept : m_min(p), m_max(p)
+    {
+    }
+
+    // The corners may be given in any order
+    constexpr Bounds3(const Point3& a, const Point3& b) noexcept
+        : m_min(std::min(a.x(), b.x()), std::min(a.y(), b.y()), std::min(a.z(), b.z()))
+        , m_max(std::max(a.x(), b.x()), std::max(a.y(), b.y()), std::max(a.z(), b.z()))
+    {
+    }
+
+    [[nodiscard]] constexpr const auto& min() const noexcept
+    {
+        return m_min;
+    }
+
+    [[nodiscard]] constexpr const auto& max() const noexcept
+    {
+        return m_max;
+    }
+
+    [[nodiscard]] constexpr auto isEmpty() const noexcept
+    {
+        return m_min.x() > m_max.x() || m_min.y() > m_max.y() || m_min.z() > m_max.z();
+    }
+
+    [[nodiscard]] constexpr auto diagonal() const noexcept
+    {
+        return Vector3(m_max.x() - m_min.x(), m_max.y() - m_min.y(), m_max.z() - m_min.z());
+    }
+
+    [[nodiscard]] constexpr auto centroid() const noexcept
+    {
+        return Point3(
+            0.5F * (m_min.x() + m_max.x()),
+            0.5F * (m_min.y() + m_max.y()),
+            0.5F * (m_min.z() + m_max.z()));
+    }
+
+    // Zero for empty boxes so that they never attract primitives when comparing split costs
+    [[nodiscard]] constexpr auto surfaceArea() const noexcept
+    {
+        if (isEmpty())
+        {
+            return 0.0F;
+        }
+
+        const auto d(diagonal());
+        return 2.0F * (d.x() * d.y() + d.y() * d.z() + d.z() * d.x());
+    }
+
+    // 0, 1 or 2 for the x, y or z axis
+    [[nodiscard]] constexpr auto maximumExtent() const noexcept
+    {
+        const auto d(diagonal());
+        if (d.x() > d.y() && d.x() > d.z())
+        {
+            return 0;
+        }
+
+        return d.y() > d.z() ? 1 : 2;
+    }
+
+    auto& unite(const Point3& p) noexcept
+    {
+        m_min = Point3(std::min(m_min.x(), p.x()), std::min(m_min.y(), p.y()), std::min(m_min.z(), p.z()));
+        m_max = Point3(std::max(m_max.x(), p.x()), std::max(m_max.y(), p.y()), std::max(m_max.z(), p.z()));
+        return *this;
+    }
+
+    auto& unite(const Bounds3& b) noexcept
+    {
+        m_min = Point3(
+            std::min(m_min.x(), b.m_min.x()),
+            std::min(m_min.y(), b.m_min.y()),
+            std::min(m_min.z(), b.m_min.z()));
+        m_max = Point3(
+            std::max(m_max.x(), b.m_max.x()),
+            std::max(m_max.y(), b.m_max.y()),
+            std::max(m_max.z(), b.m_max.z()));
+        return *this;
+    }
+
+private:
+    Point3 m_min;
+    Point3 m_max;
+};
+
+[[nodiscard]] inline auto unite(Bounds3 lhs, const Bounds3& rhs) noexcept
+{
+    return lhs.unite(rhs);
+}
+
+bool operator==(const Bounds3& lhs, const Bounds3& rhs);
+bool operator!=(const Bounds3& lhs, const Bounds3& rhs);
+
+std::ostream& operator<<(std::ostream& os, const Bounds3& out);
+
+} // namespace eyebeam
+
+#endif // INCLUDED_BOUNDS3_H_
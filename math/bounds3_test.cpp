@@ -0,0 +1,70 @@
+#include "bounds3.h"
+
+#include <gtest/gtest.h>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// NOLINTNEXTLINE
+TEST(Bounds3Tests, defaultConstructedBoundsAreEmptyWithZeroSurfaceArea)
+{
+    // GIVEN:
+    constexpr Bounds3 bounds;
+
+    // WHEN:
+    const auto isEmpty = bounds.isEmpty();
+    const auto area = bounds.surfaceArea();
+
+    // THEN:
+    EXPECT_TRUE(isEmpty);
+    EXPECT_EQ(area, 0.0F);
+}
+
+// NOLINTNEXTLINE
+TEST(Bounds3Tests, uniteWithEmptyBoundsLeavesBoundsUnchanged)
+{
+    // GIVEN:
+    const Bounds3 bounds(Point3(-1.0F, 0.0F, 2.0F), Point3(3.0F, 4.0F, 5.0F));
+
+    // WHEN:
+    const auto united(unite(bounds, Bounds3()));
+
+    // THEN:
+    EXPECT_EQ(united, bounds);
+}
+
+// NOLINTNEXTLINE
+TEST(Bounds3Tests, uniteWithPointsGrowsToEnclosePoints)
+{
+    // GIVEN:
+    Bounds3 bounds;
+
+    // WHEN:
+    bounds.unite(Point3(1.0F, -2.0F, 3.0F)).unite(Point3(-1.0F, 2.0F, 0.0F));
+
+    // THEN:
+    EXPECT_EQ(bounds.min(), Point3(-1.0F, -2.0F, 0.0F));
+    EXPECT_EQ(bounds.max(), Point3(1.0F, 2.0F, 3.0F));
+}
+
+// NOLINTNEXTLINE
+TEST(Bounds3Tests, surfaceAreaAndMaximumExtentOfBox)
+{
+    // GIVEN:
+    const Bounds3 bounds(Point3(0.0F, 0.0F, 0.0F), Point3(1.0F, 2.0F, 3.0F));
+
+    // WHEN:
+    const auto area = bounds.surfaceArea();
+    const auto axis = bounds.maximumExtent();
+
+    // THEN:
+    EXPECT_EQ(area, 22.0F);
+    EXPECT_EQ(axis, 2);
+}
+
+} // namespace
+
+} // namespace eyebeam
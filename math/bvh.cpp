@@ -0,0 +1,624 @@
+#include "bvh.h"
+
+#include "bounds3.h"
+#include "point3.h"
+#include "ray3.h"
+#include "vector3.h"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr size_t binCount = 16;
+
+// Beyond this depth the build switches to median splits, which halve the primitive count at every level and keep
+// the traversal stack from overflowing on degenerate input
+constexpr size_t maxSahDepth = 64;
+
+// The cost of visiting a node relative to intersecting one primitive
+constexpr float traversalCost = 1.0F;
+
+// Subtrees over fewer primitives than this are not worth the cost of starting a thread
+constexpr size_t minParallelSubtreeSize = 16384;
+
+using BuildPrimitive = detail::BvhBuildPrimitive;
+
+struct Bin
+{
+    Bounds3 bounds;
+    size_t count = 0;
+};
+
+using Bins = std::array<Bin, binCount>;
+
+[[nodiscard]] auto component(const Point3& p, int axis) noexcept
+{
+    return axis == 0 ? p.x() : (axis == 1 ? p.y() : p.z());
+}
+
+[[nodiscard]] auto component(const Vector3& v, int axis) noexcept
+{
+    return axis == 0 ? v.x() : (axis == 1 ? v.y() : v.z());
+}
+
+// Sorts primitives into equally sized bins along the axis of their centroid bounds
+class Binning
+{
+public:
+    Binning(const Bounds3& centroidBounds, int axis) noexcept
+        : m_axis(axis)
+        , m_centroidMin(component(centroidBounds.min(), axis))
+        , m_extent(component(centroidBounds.diagonal(), axis))
+        , m_binScale(static_cast<float>(binCount) / m_extent)
+    {
+    }
+
+    // Whether the centroids spread along the axis at all; binning is meaningless otherwise
+    [[nodiscard]] bool hasExtent() const noexcept
+    {
+        return m_extent > 0.0F;
+    }
+
+    [[nodiscard]] size_t binOf(const BuildPrimitive& primitive) const noexcept
+    {
+        const auto bin = static_cast<size_t>((primitive.centroid[m_axis] - m_centroidMin) * m_binScale);
+        return std::min(bin, binCount - 1);
+    }
+
+    void add(Bins& bins, const BuildPrimitive* first, const BuildPrimitive* last) const noexcept
+    {
+        for (const auto* primitive = first; primitive != last; ++primitive)
+        {
+            auto& bin = bins[binOf(*primitive)];
+            bin.bounds.unite(primitive->bounds);
+            ++bin.count;
+        }
+    }
+
+private:
+    int m_axis;
+    float m_centroidMin;
+    float m_extent;
+    float m_binScale;
+};
+
+struct SplitPlane
+{
+    // Primitives in this bin and the ones below it go to the first child
+    size_t plane = 0;
+    float cost = std::numeric_limits<float>::infinity();
+};
+
+// The plane between two bins with the lowest surface area heuristic cost
+SplitPlane chooseSplitPlane(const Bins& bins) noexcept
+{
+    // Sweeping from the right first means the left sweep can evaluate every split plane in one pass
+    std::array<float, binCount - 1> rightCosts{};
+    Bounds3 rightBounds;
+    size_t rightCount = 0;
+    for (auto plane = binCount - 1; plane > 0; --plane)
+    {
+        rightBounds.unite(bins[plane].bounds);
+        rightCount += bins[plane].count;
+        rightCosts[plane - 1] = static_cast<float>(rightCount) * rightBounds.surfaceArea();
+    }
+
+    SplitPlane best;
+    Bounds3 leftBounds;
+    size_t leftCount = 0;
+    for (size_t plane = 0; plane < binCount - 1; ++plane)
+    {
+        leftBounds.unite(bins[plane].bounds);
+        leftCount += bins[plane].count;
+        const auto cost = static_cast<float>(leftCount) * leftBounds.surfaceArea() + rightCosts[plane];
+        if (cost < best.cost)
+        {
+            best = SplitPlane{plane, cost};
+        }
+    }
+
+    return best;
+}
+
+size_t hardwareThreadCount() noexcept
+{
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+// Runs task(i) for every i below taskCount, on the calling thread and as many others as there are hardware threads
+template <typename Task>
+void runInParallel(size_t taskCount, const Task& task)
+{
+    std::atomic<size_t> next{0};
+    const auto work = [&] {
+        for (auto i = next++; i < taskCount; i = next++)
+        {
+            task(i);
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+    for (size_t i = 1; i < std::min(hardwareThreadCount(), taskCount); ++i)
+    {
+        workers.push_back(std::async(std::launch::async, work));
+    }
+
+    work();
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+}
+
+class BvhBuilder
+{
+public:
+    BvhBuilder(std::vector<BvhNode>& nodes, std::vector<std::uint32_t>& primitiveIndices, size_t parallelDepth)
+        : m_nodes(nodes)
+        , m_primitiveIndices(primitiveIndices)
+        , m_parallelDepth(parallelDepth)
+    {
+    }
+
+    void build(std::vector<BuildPrimitive>& primitives, size_t first, size_t last, size_t depth)
+    {
+        reserve(last - first);
+        buildNode(primitives, first, last, depth);
+    }
+
+    // Builds the hierarchy over primitives that are already partitioned at middle along axis, as if the root had been
+    // split there
+    void buildAroundSplit(std::vector<BuildPrimitive>& primitives, const Bounds3& bounds, int axis, size_t middle)
+    {
+        reserve(primitives.size());
+        m_nodes.emplace_back();
+        setBounds(m_nodes[0], bounds);
+        buildInterior(primitives, 0, middle, primitives.size(), 0, axis, 0);
+    }
+
+private:
+    size_t buildNode(std::vector<BuildPrimitive>& primitives, size_t first, size_t last, size_t depth)
+    {
+        const auto nodeIndex = m_nodes.size();
+        m_nodes.emplace_back();
+
+        Bounds3 bounds;
+        Bounds3 centroidBounds;
+        for (auto i = first; i < last; ++i)
+        {
+            bounds.unite(primitives[i].bounds);
+            const auto& centroid = primitives[i].centroid;
+            centroidBounds.unite(Point3(centroid[0], centroid[1], centroid[2]));
+        }
+
+        setBounds(m_nodes[nodeIndex], bounds);
+
+        const auto count = last - first;
+        if (count <= 1)
+        {
+            makeLeaf(primitives, first, last, nodeIndex);
+            return nodeIndex;
+        }
+
+        const auto axis = centroidBounds.maximumExtent();
+        const auto middle = split(primitives, first, last, depth, bounds, centroidBounds, axis);
+
+        if (middle == first)
+        {
+            makeLeaf(primitives, first, last, nodeIndex);
+            return nodeIndex;
+        }
+
+        buildInterior(primitives, first, middle, last, depth, axis, nodeIndex);
+        return nodeIndex;
+    }
+
+    void reserve(size_t count)
+    {
+        m_nodes.reserve(2 * count / Bvh::maxPrimitivesInLeaf + 1);
+        m_primitiveIndices.reserve(count);
+    }
+
+    void buildInterior(
+        std::vector<BuildPrimitive>& primitives,
+        size_t first,
+        size_t middle,
+        size_t last,
+        size_t depth,
+        int axis,
+        size_t nodeIndex)
+    {
+        const auto secondChild = depth < m_parallelDepth && last - first >= minParallelSubtreeSize
+                                     ? buildChildrenInParallel(primitives, first, middle, last, depth)
+                                     : buildChildren(primitives, first, middle, last, depth);
+
+        auto& node = m_nodes[nodeIndex];
+        node.offset = static_cast<std::uint32_t>(secondChild);
+        node.primitiveCount = 0;
+        node.axis = static_cast<std::uint8_t>(axis);
+    }
+
+    // Returns the index of the second child
+    size_t buildChildren(
+        std::vector<BuildPrimitive>& primitives,
+        size_t first,
+        size_t middle,
+        size_t last,
+        size_t depth)
+    {
+        buildNode(primitives, first, middle, depth + 1);
+        return buildNode(primitives, middle, last, depth + 1);
+    }
+
+    // The second subtree is built into arrays of its own on another thread while this one builds the first, then it is
+    // appended with its offsets moved past everything the first subtree added. The partitions the two threads perform
+    // touch disjoint ranges of primitives, so the result is the same as building both in turn.
+    size_t buildChildrenInParallel(
+        std::vector<BuildPrimitive>& primitives,
+        size_t first,
+        size_t middle,
+        size_t last,
+        size_t depth)
+    {
+        std::vector<BvhNode> secondNodes;
+        std::vector<std::uint32_t> secondPrimitiveIndices;
+        auto second = std::async(std::launch::async, [&] {
+            BvhBuilder(secondNodes, secondPrimitiveIndices, m_parallelDepth).build(primitives, middle, last, depth + 1);
+        });
+
+        buildNode(primitives, first, middle, depth + 1);
+        second.get();
+
+        const auto secondChild = m_nodes.size();
+        const auto primitiveOffset = static_cast<std::uint32_t>(m_primitiveIndices.size());
+        for (auto node : secondNodes)
+        {
+            node.offset += node.primitiveCount > 0 ? primitiveOffset : static_cast<std::uint32_t>(secondChild);
+            m_nodes.push_back(node);
+        }
+
+        m_primitiveIndices.insert(
+            m_primitiveIndices.end(), secondPrimitiveIndices.begin(), secondPrimitiveIndices.end());
+        return secondChild;
+    }
+
+    // Returns where the range was partitioned, or first when the primitives should stay together in a leaf
+    size_t split(
+        std::vector<BuildPrimitive>& primitives,
+        size_t first,
+        size_t last,
+        size_t depth,
+        const Bounds3& bounds,
+        const Bounds3& centroidBounds,
+        int axis)
+    {
+        const auto count = last - first;
+        const Binning binning(centroidBounds, axis);
+
+        if (!binning.hasExtent() || depth >= maxSahDepth)
+        {
+            return count <= Bvh::maxPrimitivesInLeaf ? first : splitAtMedian(primitives, first, last, axis);
+        }
+
+        Bins bins{};
+        binning.add(bins, primitives.data() + first, primitives.data() + last);
+        const auto best = chooseSplitPlane(bins);
+
+        const auto splitCost = traversalCost + best.cost / bounds.surfaceArea();
+        const auto leafCost = static_cast<float>(count);
+        if (count <= Bvh::maxPrimitivesInLeaf && !(splitCost < leafCost))
+        {
+            return first;
+        }
+
+        const auto middle = std::partition(
+            primitives.begin() + static_cast<std::ptrdiff_t>(first),
+            primitives.begin() + static_cast<std::ptrdiff_t>(last),
+            [&](const BuildPrimitive& primitive) { return binning.binOf(primitive) <= best.plane; });
+
+        const auto middleIndex = static_cast<size_t>(middle - primitives.begin());
+        if (middleIndex == first || middleIndex == last)
+        {
+            return splitAtMedian(primitives, first, last, axis);
+        }
+
+        return middleIndex;
+    }
+
+    static size_t splitAtMedian(std::vector<BuildPrimitive>& primitives, size_t first, size_t last, int axis)
+    {
+        const auto middle = first + (last - first) / 2;
+        std::nth_element(
+            primitives.begin() + static_cast<std::ptrdiff_t>(first),
+            primitives.begin() + static_cast<std::ptrdiff_t>(middle),
+            primitives.begin() + static_cast<std::ptrdiff_t>(last),
+            [axis](const BuildPrimitive& lhs, const BuildPrimitive& rhs) {
+                return lhs.centroid[axis] < rhs.centroid[axis];
+            });
+        return middle;
+    }
+
+    void makeLeaf(const std::vector<BuildPrimitive>& primitives, size_t first, size_t last, size_t nodeIndex)
+    {
+        auto& node = m_nodes[nodeIndex];
+        node.offset = static_cast<std::uint32_t>(m_primitiveIndices.size());
+        node.primitiveCount = static_cast<std::uint16_t>(last - first);
+        node.axis = 0;
+
+        for (auto i = first; i < last; ++i)
+        {
+            m_primitiveIndices.push_back(primitives[i].index);
+        }
+    }
+
+    static void setBounds(BvhNode& node, const Bounds3& bounds) noexcept
+    {
+        node.boundsMin = {bounds.min().x(), bounds.min().y(), bounds.min().z()};
+        node.boundsMax = {bounds.max().x(), bounds.max().y(), bounds.max().z()};
+    }
+
+    std::vector<BvhNode>& m_nodes;
+    std::vector<std::uint32_t>& m_primitiveIndices;
+    size_t m_parallelDepth;
+};
+
+// Splitting this many levels in parallel gives every hardware thread at least two subtrees, which evens out
+// unbalanced splits
+size_t chooseParallelDepth()
+{
+    const auto threadCount = hardwareThreadCount();
+
+    size_t depth = 1;
+    while ((size_t{1} << depth) < 2 * threadCount)
+    {
+        ++depth;
+    }
+
+    return depth;
+}
+
+void checkPrimitiveCount(size_t count)
+{
+    if (count > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::length_error("Bvh supports at most 2^32 - 1 primitives");
+    }
+}
+
+std::vector<BvhPrimitiveRun> gatherRun(const std::vector<Bounds3>& primitiveBounds)
+{
+    checkPrimitiveCount(primitiveBounds.size());
+
+    std::vector<BvhPrimitiveRun> runs(1);
+    runs[0].reserve(primitiveBounds.size());
+    for (const auto& bounds : primitiveBounds)
+    {
+        runs[0].add(bounds);
+    }
+
+    return runs;
+}
+
+} // namespace
+
+void BvhPrimitiveRun::reserve(size_t count)
+{
+    m_primitives.reserve(count);
+}
+
+void BvhPrimitiveRun::add(const Bounds3& bounds)
+{
+    const auto centroid(bounds.centroid());
+    m_primitives.push_back(detail::BvhBuildPrimitive{
+        bounds, {centroid.x(), centroid.y(), centroid.z()}, static_cast<std::uint32_t>(m_primitives.size())});
+    m_bounds.unite(bounds);
+    m_centroidBounds.unite(centroid);
+}
+
+Bvh::Bvh(const std::vector<Bounds3>& primitiveBounds) : Bvh(gatherRun(primitiveBounds))
+{
+}
+
+Bvh::Bvh(std::vector<BvhPrimitiveRun> runs)
+{
+    size_t count = 0;
+    Bounds3 bounds;
+    Bounds3 centroidBounds;
+    for (const auto& run : runs)
+    {
+        count += run.size();
+        bounds.unite(run.bounds());
+        centroidBounds.unite(run.centroidBounds());
+    }
+
+    checkPrimitiveCount(count);
+    if (count == 0)
+    {
+        return;
+    }
+
+    // The primitives of every run in turn, numbered from the first primitive of the first run. Each run is released
+    // once it is copied.
+    const auto concatenate = [&] {
+        std::vector<BuildPrimitive> primitives;
+        primitives.reserve(count);
+        for (auto& run : runs)
+        {
+            const auto runFirst = static_cast<std::uint32_t>(primitives.size());
+            for (auto primitive : run.m_primitives)
+            {
+                primitive.index += runFirst;
+                primitives.push_back(primitive);
+            }
+
+            run.m_primitives = {};
+        }
+
+        return primitives;
+    };
+
+    std::vector<BvhNode> nodes;
+    std::vector<std::uint32_t> primitiveIndices;
+    BvhBuilder builder(nodes, primitiveIndices, chooseParallelDepth());
+
+    // The root is split as the builder would split it, except that the primitives are binned where the runs hold them
+    // and partitioned stably while they are copied into one array, so the hierarchy does not depend on the runs
+    const auto axis = centroidBounds.maximumExtent();
+    const Binning binning(centroidBounds, axis);
+    if (count <= maxPrimitivesInLeaf || !binning.hasExtent())
+    {
+        auto primitives(concatenate());
+        builder.build(primitives, 0, count, 0);
+    }
+    else
+    {
+        std::vector<Bins> runBins(runs.size());
+        runInParallel(runs.size(), [&](size_t i) {
+            const auto& primitives = runs[i].m_primitives;
+            binning.add(runBins[i], primitives.data(), primitives.data() + primitives.size());
+        });
+
+        Bins bins{};
+        for (const auto& runBin : runBins)
+        {
+            for (size_t i = 0; i < binCount; ++i)
+            {
+                bins[i].bounds.unite(runBin[i].bounds);
+                bins[i].count += runBin[i].count;
+            }
+        }
+
+        const auto best = chooseSplitPlane(bins);
+        std::vector<size_t> leftCounts(runs.size());
+        std::transform(runBins.begin(), runBins.end(), leftCounts.begin(), [&](const Bins& runBin) {
+            size_t leftCount = 0;
+            for (size_t i = 0; i <= best.plane; ++i)
+            {
+                leftCount += runBin[i].count;
+            }
+
+            return leftCount;
+        });
+
+        const auto middle = std::accumulate(leftCounts.begin(), leftCounts.end(), size_t{0});
+        if (middle == 0 || middle == count)
+        {
+            // The builder falls back to a median split here too
+            auto primitives(concatenate());
+            builder.build(primitives, 0, count, 0);
+        }
+        else
+        {
+            // Where each run starts among all the primitives, among those going left and among those going right
+            std::vector<std::array<size_t, 3>> offsets(runs.size());
+            std::array<size_t, 3> offset{0, 0, middle};
+            for (size_t i = 0; i < runs.size(); ++i)
+            {
+                offsets[i] = offset;
+                offset[0] += runs[i].size();
+                offset[1] += leftCounts[i];
+                offset[2] += runs[i].size() - leftCounts[i];
+            }
+
+            std::vector<BuildPrimitive> primitives(count);
+            runInParallel(runs.size(), [&](size_t i) {
+                auto [runFirst, left, right] = offsets[i];
+                for (auto primitive : runs[i].m_primitives)
+                {
+                    primitive.index += static_cast<std::uint32_t>(runFirst);
+                    primitives[binning.binOf(primitive) <= best.plane ? left++ : right++] = primitive;
+                }
+
+                runs[i].m_primitives = {};
+            });
+
+            builder.buildAroundSplit(primitives, bounds, axis, middle);
+        }
+    }
+
+    m_nodes = BorrowableArray<BvhNode>(std::move(nodes));
+    m_primitiveIndices = BorrowableArray<std::uint32_t>(std::move(primitiveIndices));
+}
+
+bool Bvh::isWellFormed(size_t primitiveCount) const
+{
+    if (m_nodes.empty() != (primitiveCount == 0) ||
+        std::any_of(m_primitiveIndices.begin(), m_primitiveIndices.end(), [primitiveCount](std::uint32_t index) {
+            return index >= primitiveCount;
+        }))
+    {
+        return false;
+    }
+
+    // The second children still to be reached, each with its depth. A depth first walk that only ever steps to the
+    // next node reaches every node exactly once when the second child of each interior node follows the subtree of
+    // its first child.
+    std::vector<std::pair<std::uint32_t, size_t>> secondChildren;
+    size_t next = 0;
+    size_t depth = 0;
+    while (next < m_nodes.size())
+    {
+        const auto& node = m_nodes[next];
+        if (node.primitiveCount > 0)
+        {
+            const auto indexCount = m_primitiveIndices.size();
+            if (node.offset > indexCount || node.primitiveCount > indexCount - node.offset)
+            {
+                return false;
+            }
+
+            ++next;
+            if (secondChildren.empty())
+            {
+                break;
+            }
+
+            if (secondChildren.back().first != next)
+            {
+                return false;
+            }
+
+            depth = secondChildren.back().second;
+            secondChildren.pop_back();
+            continue;
+        }
+
+        if (node.axis > 2 || node.offset <= next + 1 || node.offset >= m_nodes.size() || depth >= traversalStackSize)
+        {
+            return false;
+        }
+
+        ++depth;
+        secondChildren.emplace_back(node.offset, depth);
+        ++next;
+    }
+
+    return next == m_nodes.size() && secondChildren.empty();
+}
+
+Bounds3 Bvh::bounds() const noexcept
+{
+    if (m_nodes.empty())
+    {
+        return Bounds3();
+    }
+
+    const auto& root = m_nodes[0];
+    return Bounds3(
+        Point3(root.boundsMin[0], root.boundsMin[1], root.boundsMin[2]),
+        Point3(root.boundsMax[0], root.boundsMax[1], root.boundsMax[2]));
+}
+
+} // namespace eyebeam
@@ -0,0 +1,264 @@
+#ifndef INCLUDED_BVH_H_
+#define INCLUDED_BVH_H_
+
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "ray3.h"
+#include "stats.h"
+#include "traversal_ray3.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+// One node of the flattened hierarchy. Nodes are stored depth first, so the first child of an interior node always
+// directly follows it and only the second child needs an offset. Two nodes fit in a cache line.
+struct alignas(32) BvhNode
+{
+    std::array<float, 3> boundsMin;
+    // Index of the first primitive for leaves, index of the second child for interior nodes
+    std::uint32_t offset;
+    std::array<float, 3> boundsMax;
+    // Zero for interior nodes
+    std::uint16_t primitiveCount;
+    // Axis the children were split along, used to visit the nearer child first
+    std::uint8_t axis;
+    std::uint8_t padding;
+};
+
+static_assert(sizeof(BvhNode) == 32, "BvhNode should be half a cache line");
+
+namespace detail
+{
+
+struct BvhBuildPrimitive
+{
+    Bounds3 bounds;
+    std::array<float, 3> centroid;
+    std::uint32_t index;
+};
+
+} // namespace detail
+
+// The bounds and centroids of a run of consecutive primitives, gathered ahead of a build. Runs of one primitive type
+// can be gathered on different threads as the primitives are produced, and each keeps the bounds of its centroids so
+// that the build starts from their union rather than from another pass over every primitive.
+class BvhPrimitiveRun
+{
+public:
+    void reserve(size_t count);
+    void add(const Bounds3& bounds);
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_primitives.size();
+    }
+
+    [[nodiscard]] const auto& bounds() const noexcept
+    {
+        return m_bounds;
+    }
+
+    [[nodiscard]] const auto& centroidBounds() const noexcept
+    {
+        return m_centroidBounds;
+    }
+
+private:
+    friend class Bvh;
+
+    // Indexed from the start of the run
+    std::vector<detail::BvhBuildPrimitive> m_primitives;
+    Bounds3 m_bounds;
+    Bounds3 m_centroidBounds;
+};
+
+// Bounding volume hierarchy over primitives that are only known through their bounds. Primitives are identified by
+// their index into the bounds the hierarchy was built from; intersecting them is left to the caller.
+class Bvh
+{
+public:
+    static constexpr size_t maxPrimitivesInLeaf = 4;
+
+    Bvh() = default;
+
+    // Builds the hierarchy with the surface area heuristic, evaluated at the boundaries of equally sized bins. The
+    // subtrees of large hierarchies are built on several threads; the result does not depend on how many.
+    explicit Bvh(const std::vector<Bounds3>& primitiveBounds);
+
+    // Builds the hierarchy over the primitives of every run in turn, which is the same hierarchy however the primitives
+    // are split into runs. The root is binned and partitioned across the runs in parallel, and each run is released
+    // once its primitives are partitioned. Primitive indices count from the first primitive of the first run.
+    explicit Bvh(std::vector<BvhPrimitiveRun> runs);
+
+    // Adopts a hierarchy built earlier, such as one stored in a compiled scene file. The arrays are trusted to form a
+    // valid hierarchy; check isWellFormed before traversing arrays from an untrusted source.
+    Bvh(BorrowableArray<BvhNode> nodes, BorrowableArray<std::uint32_t> primitiveIndices) noexcept
+        : m_nodes(std::move(nodes))
+        , m_primitiveIndices(std::move(primitiveIndices))
+    {
+    }
+
+    [[nodiscard]] const auto& nodes() const noexcept
+    {
+        return m_nodes;
+    }
+
+    // Primitive indices in leaf order. Leaf nodes refer to ranges of this array.
+    [[nodiscard]] const auto& primitiveIndices() const noexcept
+    {
+        return m_primitiveIndices;
+    }
+
+    [[nodiscard]] Bounds3 bounds() const noexcept;
+
+    // Whether traversal stays within the arrays: the nodes are laid out depth first as the build lays them out, with
+    // every node reached exactly once and no deeper than the traversal stack, interior nodes split along an axis, the
+    // leaves refer to ranges of primitiveIndices() and every primitive index is below primitiveCount. Takes one pass
+    // over the nodes and one over the primitive indices.
+    [[nodiscard]] bool isWellFormed(size_t primitiveCount) const;
+
+    // Finds the closest intersection along ray. intersectPrimitive(index, ray) returns the intersection of the ray with
+    // a primitive as std::optional<IntersectionInfo>, and hits are merged into closest with updateWithNewIntersection.
+    // Returns true when closest was updated. Nodes further away than closest are skipped.
+    template <typename IntersectPrimitive>
+    bool intersect(const Ray3& ray, IntersectionInfo& closest, IntersectPrimitive&& intersectPrimitive) const
+    {
+        auto hasHit = false;
+
+        traverse(ray, closest.getTime(), [&](std::uint32_t primitive, float& maxTime) {
+            const auto candidate(intersectPrimitive(primitive, ray));
+            if (candidate.has_value() && candidate->getTime() < closest.getTime())
+            {
+                closest.updateWithNewIntersection(*candidate);
+                maxTime = closest.getTime();
+                hasHit = true;
+            }
+
+            return false;
+        });
+
+        return hasHit;
+    }
+
+    // Returns true as soon as any primitive blocks the ray before maxTime, which is all a shadow ray needs.
+    // occludedByPrimitive(index, ray, maxTime) returns whether that primitive blocks the ray before maxTime.
+    template <typename OccludedByPrimitive>
+    bool isOccluded(const Ray3& ray, float maxTime, OccludedByPrimitive&& occludedByPrimitive) const
+    {
+        auto isBlocked = false;
+
+        traverse(ray, maxTime, [&](std::uint32_t primitive, float& nodeMaxTime) {
+            isBlocked = occludedByPrimitive(primitive, ray, nodeMaxTime);
+            return isBlocked;
+        });
+
+        return isBlocked;
+    }
+
+    // Visits every leaf whose bounds the ray enters within [ray.tMin(), ray.tMax()], nearest child first.
+    // visitLeaf(first, count, maxTime) receives the range [first, first + count) of primitiveIndices(), may shrink
+    // maxTime and stops the traversal by returning true. Callers that store their primitives in primitiveIndices()
+    // order can test a whole leaf at once. Callers that traverse several hierarchies with one ray build its
+    // TraversalRay3 once and pass it to each.
+    template <typename VisitLeaf>
+    void traverseLeaves(const TraversalRay3& traversalRay, VisitLeaf&& visitLeaf) const
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        // A local copy stays in registers, where the caller's could change under any store in the loop
+        const auto ray(traversalRay);
+        auto maxTime = ray.tMax();
+        ScopedStat<Stat::BvhNodesVisited> nodesVisited;
+
+        std::array<std::uint32_t, traversalStackSize> toVisit{};
+        size_t toVisitCount = 0;
+        std::uint32_t current = 0;
+
+        while (true)
+        {
+            const auto& node = m_nodes[current];
+            ++nodesVisited;
+
+            if (ray.intersects(node.boundsMin, node.boundsMax, maxTime))
+            {
+                if (node.primitiveCount > 0)
+                {
+                    if (visitLeaf(node.offset, static_cast<std::uint32_t>(node.primitiveCount), maxTime))
+                    {
+                        return;
+                    }
+                }
+                else if (ray.directionSigns()[node.axis] != 0)
+                {
+                    toVisit[toVisitCount++] = current + 1;
+                    current = node.offset;
+                    continue;
+                }
+                else
+                {
+                    toVisit[toVisitCount++] = node.offset;
+                    current = current + 1;
+                    continue;
+                }
+            }
+
+            if (toVisitCount == 0)
+            {
+                return;
+            }
+
+            current = toVisit[--toVisitCount];
+        }
+    }
+
+    // Visits every leaf whose bounds the ray enters before maxTime, as above
+    template <typename VisitLeaf>
+    void traverseLeaves(const Ray3& ray, float maxTime, VisitLeaf&& visitLeaf) const
+    {
+        traverseLeaves(TraversalRay3(ray, 0.0F, maxTime), std::forward<VisitLeaf>(visitLeaf));
+    }
+
+private:
+    // Enough for the depth limit of the build plus the median splits that follow it
+    static constexpr size_t traversalStackSize = 128;
+
+    // Visits every primitive in a leaf whose bounds the ray enters before maxTime. visitPrimitive may shrink maxTime
+    // and stops the traversal by returning true.
+    template <typename VisitPrimitive>
+    void traverse(const Ray3& ray, float maxTime, VisitPrimitive&& visitPrimitive) const
+    {
+        ScopedStat<Stat::PrimitiveTests> primitiveTests;
+
+        traverseLeaves(ray, maxTime, [&](std::uint32_t first, std::uint32_t count, float& leafMaxTime) {
+            for (auto i = first; i < first + count; ++i)
+            {
+                ++primitiveTests;
+                if (visitPrimitive(m_primitiveIndices[i], leafMaxTime))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        });
+    }
+
+    BorrowableArray<BvhNode> m_nodes;
+    BorrowableArray<std::uint32_t> m_primitiveIndices;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_BVH_H_
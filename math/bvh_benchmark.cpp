@@ -0,0 +1,124 @@
+#include "bvh.h"
+
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "point3.h"
+#include "ray3.h"
+#include "vector3.h"
+
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr size_t rayCount = 1024;
+
+auto generateBoxes(size_t count)
+{
+    std::mt19937 engine(1234);
+    std::uniform_real_distribution<float> position(-100.0F, 100.0F);
+    std::uniform_real_distribution<float> size(0.01F, 1.0F);
+
+    std::vector<Bounds3> boxes;
+    boxes.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Point3 corner(position(engine), position(engine), position(engine));
+        boxes.emplace_back(corner, corner + Vector3(size(engine), size(engine), size(engine)));
+    }
+
+    return boxes;
+}
+
+auto generateRays()
+{
+    std::mt19937 engine(5678);
+    std::uniform_real_distribution<float> direction(-1.0F, 1.0F);
+
+    std::vector<Ray3> rays;
+    rays.reserve(rayCount);
+    for (size_t i = 0; i < rayCount; ++i)
+    {
+        rays.emplace_back(Point3(), Vector3(direction(engine), direction(engine), direction(engine)));
+    }
+
+    return rays;
+}
+
+// Stands in for a real primitive test, so the traversal itself dominates the measurement
+auto hitBox(const Bounds3& box, const Ray3& ray)
+{
+    const auto centroid(box.centroid());
+    return std::optional<IntersectionInfo>(
+        IntersectionInfo(centroid, Normal3(0.0F, 0.0F, 1.0F), length(centroid - ray.origin())));
+}
+
+void benchmarkBvhBuild(benchmark::State& state)
+{
+    const auto boxes(generateBoxes(static_cast<size_t>(state.range(0))));
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const Bvh bvh(boxes);
+        benchmark::DoNotOptimize(bvh.nodes().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void benchmarkBvhClosestHit(benchmark::State& state)
+{
+    const auto boxes(generateBoxes(static_cast<size_t>(state.range(0))));
+    const Bvh bvh(boxes);
+    const auto rays(generateRays());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (const auto& ray : rays)
+        {
+            IntersectionInfo closest;
+            bvh.intersect(ray, closest, [&](std::uint32_t index, const Ray3& r) { return hitBox(boxes[index], r); });
+            benchmark::DoNotOptimize(closest);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(rayCount));
+}
+
+void benchmarkBvhAnyHit(benchmark::State& state)
+{
+    const auto boxes(generateBoxes(static_cast<size_t>(state.range(0))));
+    const Bvh bvh(boxes);
+    const auto rays(generateRays());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (const auto& ray : rays)
+        {
+            const auto isOccluded =
+                bvh.isOccluded(ray, 50.0F, [](std::uint32_t, const Ray3&, float) { return true; });
+            benchmark::DoNotOptimize(isOccluded);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(rayCount));
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkBvhBuild)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkBvhClosestHit)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkBvhAnyHit)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+} // namespace
+} // namespace eyebeam
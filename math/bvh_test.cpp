@@ -0,0 +1,416 @@
+#include "bvh.h"
+
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "point3.h"
+#include "ray3.h"
+#include "vector3.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+struct Sphere
+{
+    Point3 center;
+    float radius;
+};
+
+std::optional<IntersectionInfo> intersectSphere(const Sphere& sphere, const Ray3& ray)
+{
+    const auto toOrigin(ray.origin() - sphere.center);
+    const auto b = dot(toOrigin, ray.direction());
+    const auto c = lengthSquared(toOrigin) - sphere.radius * sphere.radius;
+    const auto discriminant = b * b - c;
+    if (discriminant < 0.0F)
+    {
+        return std::nullopt;
+    }
+
+    const auto root = std::sqrt(discriminant);
+    const auto time = -b - root > 0.0F ? -b - root : -b + root;
+    if (time <= 0.0F)
+    {
+        return std::nullopt;
+    }
+
+    const auto point(evaluate(ray, time));
+    return IntersectionInfo(point, Normal3(point - sphere.center), time);
+}
+
+auto generateSpheres(size_t count)
+{
+    std::mt19937 engine(1234);
+    std::uniform_real_distribution<float> position(-10.0F, 10.0F);
+    std::uniform_real_distribution<float> radius(0.05F, 0.5F);
+
+    std::vector<Sphere> spheres;
+    for (size_t i = 0; i < count; ++i)
+    {
+        spheres.push_back(Sphere{Point3(position(engine), position(engine), position(engine)), radius(engine)});
+    }
+
+    return spheres;
+}
+
+auto boundsOf(const std::vector<Sphere>& spheres)
+{
+    std::vector<Bounds3> bounds;
+    for (const auto& sphere : spheres)
+    {
+        const Vector3 extent(sphere.radius, sphere.radius, sphere.radius);
+        bounds.emplace_back(sphere.center + -extent, sphere.center + extent);
+    }
+
+    return bounds;
+}
+
+auto generateRays(size_t count)
+{
+    std::mt19937 engine(5678);
+    std::uniform_real_distribution<float> position(-12.0F, 12.0F);
+    std::uniform_real_distribution<float> direction(-1.0F, 1.0F);
+
+    std::vector<Ray3> rays;
+    for (size_t i = 0; i < count; ++i)
+    {
+        rays.emplace_back(
+            Point3(position(engine), position(engine), position(engine)),
+            Vector3(direction(engine), direction(engine), direction(engine)));
+    }
+
+    return rays;
+}
+
+// NOLINTNEXTLINE
+TEST(BvhTests, emptyHierarchyIsNeverIntersected)
+{
+    // GIVEN:
+    const Bvh bvh(std::vector<Bounds3>{});
+    const Ray3 ray(Point3(), Vector3(0.0F, 0.0F, 1.0F));
+    IntersectionInfo closest;
+
+    // WHEN:
+    const auto hasHit =
+        bvh.intersect(ray, closest, [](std::uint32_t, const Ray3&) { return std::optional<IntersectionInfo>(); });
+
+    // THEN:
+    EXPECT_FALSE(hasHit);
+    EXPECT_TRUE(bvh.nodes().empty());
+    EXPECT_TRUE(bvh.bounds().isEmpty());
+}
+
+// NOLINTNEXTLINE
+TEST(BvhTests, everyPrimitiveIsReferencedByExactlyOneSmallLeaf)
+{
+    // GIVEN:
+    const auto bounds(boundsOf(generateSpheres(1000)));
+
+    // WHEN:
+    const Bvh bvh(bounds);
+
+    // THEN:
+    std::vector<int> references(bounds.size(), 0);
+    for (const auto& node : bvh.nodes())
+    {
+        EXPECT_LE(node.primitiveCount, Bvh::maxPrimitivesInLeaf);
+        for (std::uint32_t i = 0; i < node.primitiveCount; ++i)
+        {
+            ++references[bvh.primitiveIndices()[node.offset + i]];
+        }
+    }
+
+    for (const auto count : references)
+    {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(BvhTests, rootBoundsEncloseAllPrimitives)
+{
+    // GIVEN:
+    const auto bounds(boundsOf(generateSpheres(100)));
+    Bounds3 expected;
+    for (const auto& b : bounds)
+    {
+        expected.unite(b);
+    }
+
+    // WHEN:
+    const Bvh bvh(bounds);
+
+    // THEN:
+    EXPECT_EQ(bvh.bounds(), expected);
+}
+
+// NOLINTNEXTLINE
+TEST(BvhTests, closestHitMatchesBruteForce)
+{
+    // GIVEN:
+    const auto spheres(generateSpheres(2000));
+    const Bvh bvh(boundsOf(spheres));
+    const auto intersectPrimitive = [&](std::uint32_t index, const Ray3& ray) {
+        return intersectSphere(spheres[index], ray);
+    };
+
+    for (const auto& ray : generateRays(500))
+    {
+        IntersectionInfo expected;
+        for (const auto& sphere : spheres)
+        {
+            const auto hit(intersectSphere(sphere, ray));
+            if (hit.has_value())
+            {
+                expected.updateWithNewIntersection(*hit);
+            }
+        }
+
+        // WHEN:
+        IntersectionInfo closest;
+        const auto hasHit = bvh.intersect(ray, closest, intersectPrimitive);
+
+        // THEN:
+        EXPECT_EQ(hasHit, isIntersecting(expected));
+        EXPECT_EQ(closest.getTime(), expected.getTime());
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(BvhTests, isOccludedMatchesBruteForce)
+{
+    // GIVEN:
+    const auto spheres(generateSpheres(2000));
+    const Bvh bvh(boundsOf(spheres));
+    constexpr auto maxTime = 5.0F;
+    const auto occludedByPrimitive = [&](std::uint32_t index, const Ray3& ray, float limit) {
+        const auto hit(intersectSphere(spheres[index], ray));
+        return hit.has_value() && hit->getTime() < limit;
+    };
+
+    for (const auto& ray : generateRays(500))
+    {
+        auto expected = false;
+        for (const auto& sphere : spheres)
+        {
+            const auto hit(intersectSphere(sphere, ray));
+            expected = expected || (hit.has_value() && hit->getTime() < maxTime);
+        }
+
+        // WHEN:
+        const auto isOccluded = bvh.isOccluded(ray, maxTime, occludedByPrimitive);
+
+        // THEN:
+        EXPECT_EQ(isOccluded, expected);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(BvhTests, hierarchyAdoptingBorrowedArraysFindsSameHits)
+{
+    // GIVEN:
+    const auto spheres(generateSpheres(500));
+    const Bvh built(boundsOf(spheres));
+    const auto intersectPrimitive = [&](std::uint32_t index, const Ray3& ray) {
+        return intersectSphere(spheres[index], ray);
+    };
+
+    // WHEN:
+    const Bvh adopted(
+        BorrowableArray<BvhNode>(built.nodes().data(), built.nodes().size()),
+        BorrowableArray<std::uint32_t>(built.primitiveIndices().data(), built.primitiveIndices().size()));
+
+    // THEN:
+    EXPECT_EQ(adopted.bounds(), built.bounds());
+    for (const auto& ray : generateRays(100))
+    {
+        IntersectionInfo expected;
+        built.intersect(ray, expected, intersectPrimitive);
+        IntersectionInfo closest;
+        adopted.intersect(ray, closest, intersectPrimitive);
+        EXPECT_EQ(closest.getTime(), expected.getTime());
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(BvhTests, onlyHierarchiesThatKeepTraversalInBoundsAreWellFormed)
+{
+    // GIVEN:
+    const Bvh built(boundsOf(generateSpheres(500)));
+    const std::vector<BvhNode> nodes(built.nodes().begin(), built.nodes().end());
+    const std::vector<std::uint32_t> indices(built.primitiveIndices().begin(), built.primitiveIndices().end());
+    ASSERT_EQ(0U, nodes[0].primitiveCount);
+    const auto firstLeaf = static_cast<size_t>(
+        std::find_if(nodes.begin(), nodes.end(), [](const BvhNode& node) { return node.primitiveCount > 0; }) -
+        nodes.begin());
+
+    const auto adopt = [](std::vector<BvhNode> adoptedNodes, std::vector<std::uint32_t> adoptedIndices) {
+        return Bvh(
+            BorrowableArray<BvhNode>(std::move(adoptedNodes)),
+            BorrowableArray<std::uint32_t>(std::move(adoptedIndices)));
+    };
+    const auto withNode = [&](size_t index, auto&& change) {
+        auto changed(nodes);
+        change(changed[index]);
+        return adopt(changed, indices);
+    };
+
+    // A chain of interior nodes deeper than any build produces, each with a leaf as its second child
+    std::vector<BvhNode> chain;
+    constexpr std::uint32_t chainDepth = 200;
+    for (std::uint32_t i = 0; i < chainDepth; ++i)
+    {
+        chain.push_back(BvhNode{{}, 2 * chainDepth - i, {}, 0, 0, 0});
+    }
+    chain.push_back(BvhNode{{}, 0, {}, 1, 0, 0});
+    chain.insert(chain.end(), chainDepth, BvhNode{{}, 0, {}, 1, 0, 0});
+
+    // WHEN:
+    // THEN:
+    EXPECT_TRUE(built.isWellFormed(500));
+    EXPECT_TRUE(Bvh().isWellFormed(0));
+    EXPECT_FALSE(Bvh().isWellFormed(1));
+    EXPECT_FALSE(built.isWellFormed(499));
+    EXPECT_FALSE(withNode(0, [&](BvhNode& node) { node.offset = static_cast<std::uint32_t>(nodes.size()); })
+                     .isWellFormed(500));
+    EXPECT_FALSE(withNode(0, [](BvhNode& node) { node.offset = 1; }).isWellFormed(500));
+    EXPECT_FALSE(withNode(0, [](BvhNode& node) { ++node.offset; }).isWellFormed(500));
+    EXPECT_FALSE(withNode(0, [](BvhNode& node) { node.axis = 3; }).isWellFormed(500));
+    EXPECT_FALSE(withNode(firstLeaf, [&](BvhNode& node) {
+                     node.offset = static_cast<std::uint32_t>(indices.size() - node.primitiveCount + 1);
+                 }).isWellFormed(500));
+    EXPECT_FALSE(adopt(std::vector<BvhNode>(nodes.begin(), nodes.end() - 1), indices).isWellFormed(500));
+    EXPECT_FALSE(adopt(chain, {0}).isWellFormed(1));
+}
+
+// NOLINTNEXTLINE
+TEST(BvhTests, coincidentPrimitivesStillBuildValidHierarchy)
+{
+    // GIVEN:
+    const std::vector<Bounds3> bounds(100, Bounds3(Point3(-1.0F, -1.0F, -1.0F), Point3(1.0F, 1.0F, 1.0F)));
+    const Ray3 ray(Point3(0.0F, 0.0F, -5.0F), Vector3(0.0F, 0.0F, 1.0F));
+
+    // WHEN:
+    const Bvh bvh(bounds);
+    size_t visited = 0;
+    bvh.isOccluded(ray, 10.0F, [&](std::uint32_t, const Ray3&, float) {
+        ++visited;
+        return false;
+    });
+
+    // THEN:
+    EXPECT_EQ(bvh.primitiveIndices().size(), bounds.size());
+    EXPECT_EQ(visited, bounds.size());
+}
+
+// NOLINTNEXTLINE
+TEST(BvhTests, subtreesBuiltInParallelAreSplicedConsistently)
+{
+    // GIVEN:
+    const auto bounds(boundsOf(generateSpheres(100000)));
+    const auto encloses = [](const BvhNode& outer, const BvhNode& inner) {
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            if (inner.boundsMin[axis] < outer.boundsMin[axis] || inner.boundsMax[axis] > outer.boundsMax[axis])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    // WHEN:
+    const Bvh bvh(bounds);
+
+    // THEN:
+    const auto& nodes = bvh.nodes();
+    std::vector<int> references(bounds.size(), 0);
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        const auto& node = nodes[i];
+        if (node.primitiveCount > 0)
+        {
+            for (std::uint32_t j = 0; j < node.primitiveCount; ++j)
+            {
+                ++references[bvh.primitiveIndices()[node.offset + j]];
+            }
+
+            continue;
+        }
+
+        ASSERT_GT(node.offset, i + 1);
+        ASSERT_LT(node.offset, nodes.size());
+        EXPECT_TRUE(encloses(node, nodes[i + 1]));
+        EXPECT_TRUE(encloses(node, nodes[node.offset]));
+    }
+
+    EXPECT_EQ(std::count(references.begin(), references.end(), 1), static_cast<std::ptrdiff_t>(bounds.size()));
+}
+
+// NOLINTNEXTLINE
+TEST(BvhTests, hierarchiesBuiltFromRunsDoNotDependOnWhereTheRunsEnd)
+{
+    // GIVEN: scattered primitives, and coincident ones that the root cannot be binned over
+    const auto scattered(boundsOf(generateSpheres(50000)));
+    const std::vector<Bounds3> coincident(100, Bounds3(Point3(-1.0F, -1.0F, -1.0F), Point3(1.0F, 1.0F, 1.0F)));
+    const auto splitIntoRuns = [](const std::vector<Bounds3>& bounds, const std::vector<size_t>& runEnds) {
+        std::vector<BvhPrimitiveRun> runs(runEnds.size());
+        size_t first = 0;
+        for (size_t i = 0; i < runEnds.size(); ++i)
+        {
+            for (auto j = first; j < runEnds[i]; ++j)
+            {
+                runs[i].add(bounds[j]);
+            }
+
+            first = runEnds[i];
+        }
+
+        return runs;
+    };
+
+    for (const auto* bounds : {&scattered, &coincident})
+    {
+        // WHEN:
+        const Bvh whole(*bounds);
+        const Bvh chunked(splitIntoRuns(*bounds, {0, 1, bounds->size() / 3, bounds->size() / 3, bounds->size()}));
+
+        // THEN:
+        ASSERT_EQ(whole.nodes().size(), chunked.nodes().size());
+        for (size_t i = 0; i < whole.nodes().size(); ++i)
+        {
+            const auto& expected = whole.nodes()[i];
+            const auto& actual = chunked.nodes()[i];
+            EXPECT_EQ(expected.boundsMin, actual.boundsMin);
+            EXPECT_EQ(expected.boundsMax, actual.boundsMax);
+            EXPECT_EQ(expected.offset, actual.offset);
+            EXPECT_EQ(expected.primitiveCount, actual.primitiveCount);
+            EXPECT_EQ(expected.axis, actual.axis);
+        }
+
+        EXPECT_TRUE(std::equal(
+            whole.primitiveIndices().begin(),
+            whole.primitiveIndices().end(),
+            chunked.primitiveIndices().begin(),
+            chunked.primitiveIndices().end()));
+        EXPECT_TRUE(chunked.isWellFormed(bounds->size()));
+    }
+}
+
+} // namespace
+
+} // namespace eyebeam
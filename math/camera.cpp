@@ -0,0 +1,46 @@
+#include "camera.h"
+
+#include "angle.h"
+#include "point3.h"
+#include "ray3.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <cmath>
+
+namespace eyebeam
+{
+
+Camera::Camera(const Transform& cameraToWorld, int width, int height, Radians verticalFieldOfView) noexcept
+    : m_cameraToWorld(cameraToWorld)
+    , m_width(width)
+    , m_height(height)
+    , m_verticalFieldOfView(verticalFieldOfView)
+    , m_position(cameraToWorld.multiply(Point3()))
+    , m_topLeft(cameraToWorld.multiply(cameraSpaceDirection(0.0F, 0.0F)))
+    , m_columnStep(cameraToWorld.multiply(cameraSpaceDirection(1.0F, 0.0F) - cameraSpaceDirection(0.0F, 0.0F)))
+    , m_rowStep(cameraToWorld.multiply(cameraSpaceDirection(0.0F, 1.0F) - cameraSpaceDirection(0.0F, 0.0F)))
+{
+}
+
+Camera::Camera(int width, int height) noexcept : Camera(Transform(), width, height)
+{
+}
+
+Ray3 Camera::generateRay(float x, float y, float shutterTime) const
+{
+    return m_cameraToWorld.multiply(Ray3(Point3(), cameraSpaceDirection(x, y), shutterTime));
+}
+
+// The image plane lies at z = 1, spanning the field of view vertically with square pixels. Image x grows to the
+// right, which is camera -x, and image y grows downwards.
+Vector3 Camera::cameraSpaceDirection(float x, float y) const noexcept
+{
+    const auto halfHeight = std::tan(m_verticalFieldOfView / 2.0F);
+    const auto pixelSize = 2.0F * halfHeight / static_cast<float>(m_height);
+    const auto halfWidth = pixelSize * static_cast<float>(m_width) / 2.0F;
+
+    return Vector3(halfWidth - x * pixelSize, halfHeight - y * pixelSize, 1.0F);
+}
+
+} // namespace eyebeam
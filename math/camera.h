@@ -0,0 +1,167 @@
+#ifndef INCLUDED_CAMERA_H_
+#define INCLUDED_CAMERA_H_
+
+#include "angle.h"
+#include "components_packet.h"
+#include "point3.h"
+#include "ray3.h"
+#include "ray3_packet.h"
+#include "simd_lanes.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace eyebeam
+{
+
+// Where within its pixel a camera ray passes, with (0.5, 0.5) at the centre of the pixel, and when in the shutter
+// interval it is cast
+struct CameraSample
+{
+    float offsetX;
+    float offsetY;
+    float shutterTime;
+};
+
+// A pinhole camera for an image of width x height pixels. Pixel coordinates are continuous, with (0, 0) at the top
+// left corner of the image and (0.5, 0.5) at the centre of its first pixel. The direction through any point of the
+// image is an affine function of its pixel coordinates, so the camera precomputes the direction through the top left
+// corner and the steps between neighbouring columns and rows, and rays for a block of pixels cost a few adds each
+// instead of a transform.
+class Camera
+{
+public:
+    static constexpr Degrees defaultVerticalFieldOfView{60.0F};
+
+    // cameraToWorld places a camera that looks down +z with +y up and +x to the left, as Transform::lookAt does
+    Camera(
+        const Transform& cameraToWorld,
+        int width,
+        int height,
+        Radians verticalFieldOfView = toRadians(defaultVerticalFieldOfView)) noexcept;
+
+    // A camera at the origin looking down +z
+    Camera(int width, int height) noexcept;
+
+    [[nodiscard]] const auto& cameraToWorld() const noexcept
+    {
+        return m_cameraToWorld;
+    }
+
+    [[nodiscard]] constexpr auto verticalFieldOfView() const noexcept
+    {
+        return m_verticalFieldOfView;
+    }
+
+    // The ray through the given point of the image at shutterTime, transformed from camera space one ray at a time
+    [[nodiscard]] Ray3 generateRay(float x, float y, float shutterTime = 0.0F) const;
+
+    // Fills packets with the rays through the pixels of [x, x + width) x [y, y + height). sampleAt(column, row)
+    // returns the CameraSample of pixel (column, row), so every pixel is jittered and cast at a time of its own. Each
+    // row of pixels starts a new packet, so packet row * packetsPerRow(width) + i holds the rays through pixels
+    // x + i * Width onwards of row y + row. The lanes of the last packet of a row that lie beyond the block hold rays
+    // through the pixels that follow it, which sampleAt is called for too. packets may use any allocator, such as a
+    // std::pmr one over a per thread arena.
+    template <size_t Width, typename SampleAt, typename Allocator>
+    void generateRays(
+        int x,
+        int y,
+        int width,
+        int height,
+        SampleAt&& sampleAt,
+        std::vector<Ray3Packet<Width>, Allocator>& packets) const;
+
+    template <size_t Width>
+    [[nodiscard]] static constexpr size_t packetsPerRow(int width) noexcept
+    {
+        return (static_cast<size_t>(width) + Width - 1) / Width;
+    }
+
+private:
+    [[nodiscard]] Vector3 cameraSpaceDirection(float x, float y) const noexcept;
+
+    Transform m_cameraToWorld;
+    int m_width;
+    int m_height;
+    Radians m_verticalFieldOfView;
+    Point3 m_position;
+    Vector3 m_topLeft;
+    Vector3 m_columnStep;
+    Vector3 m_rowStep;
+};
+
+template <size_t Width, typename SampleAt, typename Allocator>
+void Camera::generateRays(
+    int x,
+    int y,
+    int width,
+    int height,
+    SampleAt&& sampleAt,
+    std::vector<Ray3Packet<Width>, Allocator>& packets) const
+{
+    using Lanes = PacketLanes<Width>;
+
+    const auto perRow = packetsPerRow<Width>(width);
+    packets.resize(perRow * static_cast<size_t>(height));
+
+    Point3Packet<Width> origins;
+    Vector3Packet<Width> laneSteps;
+    for (size_t lane = 0; lane < Width; ++lane)
+    {
+        origins.set(lane, m_position);
+        laneSteps.set(lane, m_columnStep * static_cast<float>(lane));
+    }
+
+    const auto packetStep(m_columnStep * static_cast<float>(Width));
+    auto rowStart(m_topLeft + m_columnStep * static_cast<float>(x) + m_rowStep * static_cast<float>(y));
+
+    auto* packet = packets.data();
+    for (int row = 0; row < height; ++row)
+    {
+        auto packetStart(rowStart);
+        for (size_t i = 0; i < perRow; ++i)
+        {
+            AlignedLaneStorage<Width> offsetsX;
+            AlignedLaneStorage<Width> offsetsY;
+            AlignedLaneStorage<Width> shutterTimes;
+            const auto firstColumn = x + static_cast<int>(i * Width);
+            for (size_t lane = 0; lane < Width; ++lane)
+            {
+                const CameraSample sample = sampleAt(firstColumn + static_cast<int>(lane), y + row);
+                offsetsX.data[lane] = sample.offsetX;
+                offsetsY.data[lane] = sample.offsetY;
+                shutterTimes.data[lane] = sample.shutterTime;
+            }
+
+            // The corner of each pixel moved by its offset along the column and row steps
+            Vector3Packet<Width> directions;
+            for (size_t lane = 0; lane < Width; lane += Lanes::width)
+            {
+                const auto offsetX(Lanes::load(&offsetsX.data[lane]));
+                const auto offsetY(Lanes::load(&offsetsY.data[lane]));
+                const auto cornerX(Lanes(packetStart.x()) + Lanes::load(&laneSteps.x.data[lane]));
+                const auto cornerY(Lanes(packetStart.y()) + Lanes::load(&laneSteps.y.data[lane]));
+                const auto cornerZ(Lanes(packetStart.z()) + Lanes::load(&laneSteps.z.data[lane]));
+                multiplyAdd(offsetX, Lanes(m_columnStep.x()), multiplyAdd(offsetY, Lanes(m_rowStep.x()), cornerX))
+                    .store(&directions.x.data[lane]);
+                multiplyAdd(offsetX, Lanes(m_columnStep.y()), multiplyAdd(offsetY, Lanes(m_rowStep.y()), cornerY))
+                    .store(&directions.y.data[lane]);
+                multiplyAdd(offsetX, Lanes(m_columnStep.z()), multiplyAdd(offsetY, Lanes(m_rowStep.z()), cornerZ))
+                    .store(&directions.z.data[lane]);
+            }
+
+            *packet = Ray3Packet<Width>(origins, directions, shutterTimes);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            ++packet;
+            packetStart += packetStep;
+        }
+
+        rowStart += m_rowStep;
+    }
+}
+
+} // namespace eyebeam
+
+#endif // INCLUDED_CAMERA_H_
@@ -0,0 +1,94 @@
+#include "camera.h"
+
+#include "point3.h"
+#include "ray3_packet.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr int tileSize = 32;
+constexpr int imageSize = 1024;
+
+auto buildCamera()
+{
+    return Camera(
+        Transform::lookAt(Point3(-1.0F, 0.5F, -3.0F), Point3(0.0F, 0.0F, 0.0F), Vector3(0.0F, 1.0F, 0.0F)),
+        imageSize,
+        imageSize);
+}
+
+// Each ray transformed from camera space on its own, as a renderer without Camera::generateRays would
+template <size_t Width>
+void benchmarkCameraGenerateRayPerPixel(benchmark::State& state)
+{
+    const auto camera(buildCamera());
+    std::vector<Ray3Packet<Width>> packets(Camera::packetsPerRow<Width>(tileSize) * tileSize);
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        auto* packet = packets.data();
+        for (int y = 0; y < tileSize; ++y)
+        {
+            for (int x = 0; x < tileSize; x += static_cast<int>(Width))
+            {
+                for (size_t lane = 0; lane < Width; ++lane)
+                {
+                    const auto pixelX = static_cast<float>(x + static_cast<int>(lane)) + 0.5F;
+                    packet->set(lane, camera.generateRay(pixelX, static_cast<float>(y) + 0.5F));
+                }
+
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                ++packet;
+            }
+        }
+
+        benchmark::DoNotOptimize(packets.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * tileSize * tileSize);
+}
+
+template <size_t Width>
+void benchmarkCameraGenerateRaysForTile(benchmark::State& state)
+{
+    const auto camera(buildCamera());
+    std::vector<Ray3Packet<Width>> packets;
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        camera.generateRays(
+            0, 0, tileSize, tileSize, [](int, int) { return CameraSample{0.5F, 0.5F, 0.5F}; }, packets);
+
+        benchmark::DoNotOptimize(packets.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * tileSize * tileSize);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkCameraGenerateRayPerPixel, 8);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkCameraGenerateRaysForTile, 4);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkCameraGenerateRaysForTile, 8);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkCameraGenerateRaysForTile, 16);
+
+} // namespace
+
+} // namespace eyebeam
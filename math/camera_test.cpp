@@ -0,0 +1,139 @@
+#include "camera.h"
+
+#include "angle.h"
+#include "point3.h"
+#include "ray3.h"
+#include "ray3_packet.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+void expectNear(const Vector3& actual, const Vector3& expected)
+{
+    constexpr auto tolerance = 1.0e-5F;
+    EXPECT_NEAR(actual.x(), expected.x(), tolerance);
+    EXPECT_NEAR(actual.y(), expected.y(), tolerance);
+    EXPECT_NEAR(actual.z(), expected.z(), tolerance);
+}
+
+void expectNear(const Point3& actual, const Point3& expected)
+{
+    expectNear(actual - Point3(), expected - Point3());
+}
+
+// NOLINTNEXTLINE
+TEST(CameraTests, rayThroughImageCentreFollowsViewingDirection)
+{
+    // GIVEN:
+    const Point3 position(1.0F, 2.0F, -3.0F);
+    const Point3 target(4.0F, -1.0F, 2.0F);
+    const Camera camera(Transform::lookAt(position, target, Vector3(0.0F, 1.0F, 0.0F)), 64, 48);
+
+    // WHEN:
+    const auto ray(camera.generateRay(32.0F, 24.0F));
+
+    // THEN:
+    expectNear(ray.origin(), position);
+    expectNear(ray.direction(), norm(target - position));
+}
+
+// NOLINTNEXTLINE
+TEST(CameraTests, imageEdgesSpanFieldOfViewWithSquarePixels)
+{
+    // GIVEN:
+    const Camera camera(200, 100);
+    const auto halfHeight = std::tan(toRadians(Camera::defaultVerticalFieldOfView) / 2.0F);
+
+    // WHEN:
+    const auto top(camera.generateRay(100.0F, 0.0F));
+    const auto right(camera.generateRay(200.0F, 50.0F));
+
+    // THEN:
+    expectNear(top.direction(), norm(Vector3(0.0F, halfHeight, 1.0F)));
+    // Image x grows to the right, which is camera -x
+    expectNear(right.direction(), norm(Vector3(-2.0F * halfHeight, 0.0F, 1.0F)));
+}
+
+// NOLINTNEXTLINE
+TEST(CameraTests, widerFieldOfViewSpreadsRaysFurther)
+{
+    // GIVEN:
+    const Camera narrow(Transform(), 10, 10, toRadians(Degrees(30.0F)));
+    const Camera wide(Transform(), 10, 10, toRadians(Degrees(90.0F)));
+
+    // WHEN:
+    const auto narrowTop(narrow.generateRay(5.0F, 0.0F));
+    const auto wideTop(wide.generateRay(5.0F, 0.0F));
+
+    // THEN:
+    EXPECT_NEAR(std::atan2(narrowTop.direction().y(), narrowTop.direction().z()), toRadians(Degrees(15.0F)), 1.0e-5F);
+    EXPECT_NEAR(std::atan2(wideTop.direction().y(), wideTop.direction().z()), toRadians(Degrees(45.0F)), 1.0e-5F);
+}
+
+template <size_t Width>
+void expectPacketsMatchSingleRays()
+{
+    // GIVEN:
+    const Camera camera(
+        Transform::lookAt(Point3(0.0F, 1.0F, -5.0F), Point3(0.5F, 0.0F, 0.0F), Vector3(0.0F, 1.0F, 0.0F)),
+        640,
+        480,
+        toRadians(Degrees(50.0F)));
+    constexpr auto x = 100;
+    constexpr auto y = 200;
+    constexpr auto width = 13;
+    constexpr auto height = 5;
+    // Every pixel has a sample of its own
+    const auto sampleAt = [](int column, int row) {
+        return CameraSample{
+            static_cast<float>(column % 7) / 7.0F,
+            static_cast<float>(row % 3) / 3.0F,
+            static_cast<float>((column + row) % 5) / 5.0F};
+    };
+    std::vector<Ray3Packet<Width>> packets;
+
+    // WHEN:
+    camera.generateRays(x, y, width, height, sampleAt, packets);
+
+    // THEN:
+    const auto perRow = Camera::packetsPerRow<Width>(width);
+    ASSERT_EQ(packets.size(), perRow * height);
+    for (size_t row = 0; row < height; ++row)
+    {
+        for (size_t column = 0; column < perRow * Width; ++column)
+        {
+            const auto sample(sampleAt(static_cast<int>(x + column), static_cast<int>(y + row)));
+            const auto expected(camera.generateRay(
+                static_cast<float>(x + column) + sample.offsetX,
+                static_cast<float>(y + row) + sample.offsetY,
+                sample.shutterTime));
+            const auto actual(packets[row * perRow + column / Width].get(column % Width));
+            expectNear(actual.origin(), expected.origin());
+            expectNear(actual.direction(), expected.direction());
+            EXPECT_EQ(expected.shutterTime(), actual.shutterTime());
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(CameraTests, tilePacketsMatchSingleRays)
+{
+    expectPacketsMatchSingleRays<4>();
+    expectPacketsMatchSingleRays<8>();
+    expectPacketsMatchSingleRays<16>();
+}
+
+} // namespace
+
+} // namespace eyebeam
@@ -2,6 +2,7 @@
 #define INCLUDED_COMPONENTS_H_
 
 #include "constexpr_math.h"
+#include "simd.h"
 
 // NOLINTNEXTLINE
 #include <array>
@@ -76,7 +77,79 @@ public:
 protected:
     ~Components() = default;
 
+    // The arithmetic helpers below work on all four lanes at once. The w lane is left untouched by scaling so that
+    // points keep their homogeneous coordinate of one and directions keep zero.
+
+#if defined(EYEBEAM_SIMD_SSE)
+    void addComponents(const Components& rhs) noexcept
+    {
+        store(_mm_add_ps(load(), rhs.load()));
+    }
+
+    void subtractComponents(const Components& rhs) noexcept
+    {
+        store(_mm_sub_ps(load(), rhs.load()));
+    }
+
+    void scaleComponents(float scalar) noexcept
+    {
+        store(_mm_mul_ps(load(), _mm_setr_ps(scalar, scalar, scalar, 1.0F)));
+    }
+
+    void assignDifference(const Components& lhs, const Components& rhs) noexcept
+    {
+        store(_mm_sub_ps(lhs.load(), rhs.load()));
+    }
+#else
+    void addComponents(const Components& rhs) noexcept
+    {
+        x() += rhs.x();
+        y() += rhs.y();
+        z() += rhs.z();
+        w() += rhs.w();
+    }
+
+    void subtractComponents(const Components& rhs) noexcept
+    {
+        x() -= rhs.x();
+        y() -= rhs.y();
+        z() -= rhs.z();
+        w() -= rhs.w();
+    }
+
+    void scaleComponents(float scalar) noexcept
+    {
+        x() *= scalar;
+        y() *= scalar;
+        z() *= scalar;
+    }
+
+    void assignDifference(const Components& lhs, const Components& rhs) noexcept
+    {
+        x() = lhs.x() - rhs.x();
+        y() = lhs.y() - rhs.y();
+        z() = lhs.z() - rhs.z();
+        w() = lhs.w() - rhs.w();
+    }
+#endif
+
 private:
+#if defined(EYEBEAM_SIMD_SSE)
+    // Loads the lanes as two halves. Components are passed and returned across calls in two registers, and a single
+    // 16 byte load of a value spilled as two 8 byte halves cannot be store forwarded.
+    [[nodiscard]] __m128 load() const noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto* halves = reinterpret_cast<const double*>(m_components.data());
+        return _mm_castpd_ps(_mm_loadh_pd(_mm_load_sd(halves), halves + 1));
+    }
+
+    void store(__m128 values) noexcept
+    {
+        _mm_store_ps(m_components.data(), values);
+    }
+#endif
+
     std::array<float, 4> m_components;
 };
 
@@ -0,0 +1 @@
+#include "components_packet.h"
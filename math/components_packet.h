@@ -0,0 +1,87 @@
+#ifndef INCLUDED_COMPONENTS_PACKET_H_
+#define INCLUDED_COMPONENTS_PACKET_H_
+
+#include "point3.h"
+#include "simd_lanes.h"
+#include "vector3.h"
+
+#include <cstddef>
+
+namespace eyebeam
+{
+
+// Structure of arrays counterparts of Point3 and Vector3. Lane i of x, y and z together make up the i-th point or
+// vector of the packet.
+
+template <size_t Width>
+struct Point3Packet
+{
+    AlignedLaneStorage<Width> x;
+    AlignedLaneStorage<Width> y;
+    AlignedLaneStorage<Width> z;
+
+    void set(size_t lane, const Point3& p) noexcept
+    {
+        x.data[lane] = p.x();
+        y.data[lane] = p.y();
+        z.data[lane] = p.z();
+    }
+
+    [[nodiscard]] auto get(size_t lane) const noexcept
+    {
+        return Point3(x.data[lane], y.data[lane], z.data[lane]);
+    }
+};
+
+template <size_t Width>
+struct Vector3Packet
+{
+    AlignedLaneStorage<Width> x;
+    AlignedLaneStorage<Width> y;
+    AlignedLaneStorage<Width> z;
+
+    void set(size_t lane, const Vector3& v) noexcept
+    {
+        x.data[lane] = v.x();
+        y.data[lane] = v.y();
+        z.data[lane] = v.z();
+    }
+
+    [[nodiscard]] auto get(size_t lane) const noexcept
+    {
+        return Vector3(x.data[lane], y.data[lane], z.data[lane]);
+    }
+};
+
+template <size_t Width>
+[[nodiscard]] Vector3Packet<Width> norm(const Vector3Packet<Width>& v) noexcept
+{
+    using Lanes = PacketLanes<Width>;
+
+    Vector3Packet<Width> result;
+
+    for (size_t lane = 0; lane < Width; lane += Lanes::width)
+    {
+        const auto x = Lanes::load(&v.x.data[lane]);
+        const auto y = Lanes::load(&v.y.data[lane]);
+        const auto z = Lanes::load(&v.z.data[lane]);
+
+        const auto reciprocalLength = Lanes(1.0F) / sqrt(multiplyAdd(x, x, multiplyAdd(y, y, z * z)));
+
+        (x * reciprocalLength).store(&result.x.data[lane]);
+        (y * reciprocalLength).store(&result.y.data[lane]);
+        (z * reciprocalLength).store(&result.z.data[lane]);
+    }
+
+    return result;
+}
+
+template <size_t Width>
+void normalize(Vector3Packet<Width>& v) noexcept
+{
+    v = norm(v);
+}
+
+} // namespace eyebeam
+
+#endif // INCLUDED_COMPONENTS_PACKET_H_
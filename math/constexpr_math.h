@@ -2,6 +2,7 @@
 #define INCLUDED_CONSTEXPR_MATH_H_
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <stdexcept>
 
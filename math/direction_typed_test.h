@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+
 namespace eyebeam
 {
 
@@ -90,6 +92,20 @@ TYPED_TEST_P(DirectionTests, OperatorMultiplyEqualScalesVectorByConstant)
     EXPECT_EQ(expected, left);
 }
 
+// NOLINTNEXTLINE
+TYPED_TEST_P(DirectionTests, OperatorMultiplyEqualKeepsHomogeneousCoordinateAtZero)
+{
+    // GIVEN:
+    constexpr float scale = std::numeric_limits<float>::infinity();
+    TypeParam left(1.0F, 0.0F, -1.0F);
+
+    // WHEN:
+    left *= scale;
+
+    // THEN:
+    EXPECT_EQ(0.0F, left.w());
+}
+
 // NOLINTNEXTLINE
 TYPED_TEST_P(DirectionTests, OperatorMultiplyScalesConstantVectorByConstantOnRightSide)
 {
@@ -245,6 +261,7 @@ REGISTER_TYPED_TEST_SUITE_P(
     OperatorMinusEqualSubtractsConstantRightSideFromLeftSide,
     OperatorMinusSubtractsTwoConstantVectors,
     OperatorMultiplyEqualScalesVectorByConstant,
+    OperatorMultiplyEqualKeepsHomogeneousCoordinateAtZero,
     OperatorMultiplyScalesConstantVectorByConstantOnRightSide,
     OperatorMultiplyScalesConstantVectorByConstantOnLeftSide,
     OperatorDivideEqualScalesVectorByConstant,
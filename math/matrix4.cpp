@@ -1,112 +1,319 @@
 #include "matrix4.h"
 
+#include "simd.h"
+#include "vector3.h"
+
 #include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <limits>
 #include <ostream>
 #include <stdexcept>
-#include <utility>
 
 namespace eyebeam
 {
 
-namespace impl
+namespace
+{
+
+using namespace impl;
+
+using MatrixElements = std::array<float, 16>;
+
+[[nodiscard]] auto isAffine(const MatrixElements& m) noexcept
 {
+    return m[getIndexFromRowColumn(3, 0)] == 0.0F && m[getIndexFromRowColumn(3, 1)] == 0.0F &&
+           m[getIndexFromRowColumn(3, 2)] == 0.0F && m[getIndexFromRowColumn(3, 3)] == 1.0F;
+}
 
-void swapRowForNonZeroDiagonal(std::array<float, 16>& toInvert, std::array<float, 16>& inverse, size_t row)
+// The determinant of an order N matrix scales with the N-th power of its elements, so it is compared against the
+// largest element raised to that power rather than against an absolute tolerance
+template <size_t Order>
+void throwIfSingular(float largestElement, float determinant)
 {
-    float element; // NOLINT(cppcoreguidelines-init-variables) - this is initialized at the start of the for loop below
-    auto rowUnderneath = row;
-    for (; rowUnderneath < 4; ++rowUnderneath)
+    auto tolerance = std::numeric_limits<float>::epsilon();
+    for (size_t i = 0; i < Order; ++i)
     {
-        element = toInvert.at(getIndexFromRowColumn(rowUnderneath, row));
-        if (!areEqual(element, 0.0F))
-        {
-            break;
-        }
+        tolerance *= largestElement;
     }
 
-    if (rowUnderneath == 4)
+    // NaN determinants fail the comparison as well
+    if (!(std::abs(determinant) > tolerance))
     {
         throw std::runtime_error("Matrix4::inverse() called on matrix with no inverse");
     }
+}
 
-    if (rowUnderneath != row)
-    {
-        for (size_t swapColumn = 0; swapColumn < 4; ++swapColumn)
-        {
-            const auto originalRowIndex = getIndexFromRowColumn(row, swapColumn);
-            const auto swapRowIndex = getIndexFromRowColumn(rowUnderneath, swapColumn);
-            std::swap(toInvert.at(originalRowIndex), toInvert.at(swapRowIndex));
-            std::swap(inverse.at(originalRowIndex), inverse.at(swapRowIndex));
-        }
-    }
+#if defined(EYEBEAM_SIMD_SSE)
+
+template <int X, int Y, int Z, int W>
+[[nodiscard]] __m128 shuffle(__m128 left, __m128 right) noexcept
+{
+    return _mm_shuffle_ps(left, right, _MM_SHUFFLE(W, Z, Y, X));
 }
 
-void combineRows(
-    std::array<float, 16>& toInvert,
-    std::array<float, 16>& inverse,
-    size_t reducingRow,
-    size_t combinationRow,
-    float leadingElement) noexcept
+template <int X, int Y, int Z, int W>
+[[nodiscard]] __m128 swizzle(__m128 v) noexcept
 {
-    const auto toZero = toInvert.at(getIndexFromRowColumn(combinationRow, reducingRow));
-    const auto scalar = -toZero / leadingElement;
-    for (size_t combinationColumn = 0; combinationColumn < 4; ++combinationColumn)
-    {
-        const auto reducingRowIndex = getIndexFromRowColumn(reducingRow, combinationColumn);
-        const auto combinationIndex = getIndexFromRowColumn(combinationRow, combinationColumn);
-        const auto newIdentityElement = scalar * toInvert.at(reducingRowIndex) + toInvert.at(combinationIndex);
-        const auto newInverseElement = scalar * inverse.at(reducingRowIndex) + inverse.at(combinationIndex);
+    return shuffle<X, Y, Z, W>(v, v);
+}
 
-        toInvert.at(combinationIndex) = newIdentityElement;
-        inverse.at(combinationIndex) = newInverseElement;
-    }
+[[nodiscard]] float largestMagnitude(__m128 row0, __m128 row1, __m128 row2, __m128 row3) noexcept
+{
+    const auto signBit = _mm_set1_ps(-0.0F);
+    auto largest = _mm_max_ps(
+        _mm_max_ps(_mm_andnot_ps(signBit, row0), _mm_andnot_ps(signBit, row1)),
+        _mm_max_ps(_mm_andnot_ps(signBit, row2), _mm_andnot_ps(signBit, row3)));
+    largest = _mm_max_ps(largest, swizzle<2, 3, 0, 1>(largest));
+    largest = _mm_max_ps(largest, swizzle<1, 0, 3, 2>(largest));
+    return _mm_cvtss_f32(largest);
 }
 
-void scaleRow(std::array<float, 16>& toInvert, std::array<float, 16>& inverse, size_t row, float scalar) noexcept
+// Only the x, y and z lanes are meaningful. The w lane of the result is zero as long as both w lanes are finite.
+[[nodiscard]] __m128 cross3(__m128 left, __m128 right) noexcept
 {
-    for (size_t scaleColumn = 0; scaleColumn < 4; ++scaleColumn)
-    {
-        const auto index = getIndexFromRowColumn(row, scaleColumn);
-        toInvert.at(index) *= scalar;
-        inverse.at(index) *= scalar;
-    }
+    return _mm_sub_ps(
+        _mm_mul_ps(swizzle<1, 2, 0, 3>(left), swizzle<2, 0, 1, 3>(right)),
+        _mm_mul_ps(swizzle<2, 0, 1, 3>(left), swizzle<1, 2, 0, 3>(right)));
 }
 
-} // namespace impl
+// Inverts the upper 3x3 block with cross products of its rows, then maps the translation through that inverse
+AlignedMatrixStorage inverseAffine(const MatrixElements& m)
+{
+    const auto row0 = _mm_load_ps(&m[getIndexFromRowColumn(0, 0)]);
+    const auto row1 = _mm_load_ps(&m[getIndexFromRowColumn(1, 0)]);
+    const auto row2 = _mm_load_ps(&m[getIndexFromRowColumn(2, 0)]);
 
-Matrix4 Matrix4::inverse() const
+    // These are the columns of the adjugate of the 3x3 block
+    auto column0 = cross3(row1, row2);
+    auto column1 = cross3(row2, row0);
+    auto column2 = cross3(row0, row1);
+
+    const auto linearMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    auto determinant = _mm_mul_ps(_mm_and_ps(row0, linearMask), column0);
+    determinant = _mm_add_ps(determinant, swizzle<2, 3, 0, 1>(determinant));
+    determinant = _mm_add_ps(determinant, swizzle<1, 0, 3, 2>(determinant));
+
+    const auto linearRow0 = _mm_and_ps(row0, linearMask);
+    const auto linearRow1 = _mm_and_ps(row1, linearMask);
+    const auto linearRow2 = _mm_and_ps(row2, linearMask);
+    throwIfSingular<3>(
+        largestMagnitude(linearRow0, linearRow1, linearRow2, _mm_setzero_ps()),
+        _mm_cvtss_f32(determinant));
+
+    const auto reciprocal = _mm_div_ps(_mm_set1_ps(1.0F), determinant);
+    column0 = _mm_mul_ps(column0, reciprocal);
+    column1 = _mm_mul_ps(column1, reciprocal);
+    column2 = _mm_mul_ps(column2, reciprocal);
+
+    // The inverse translation is -(inverse 3x3 block * translation), built from the columns of the inverse block
+    auto translation = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(column0, swizzle<3, 3, 3, 3>(row0)), _mm_mul_ps(column1, swizzle<3, 3, 3, 3>(row1))),
+        _mm_mul_ps(column2, swizzle<3, 3, 3, 3>(row2)));
+    translation = _mm_sub_ps(_mm_setzero_ps(), translation);
+
+    _MM_TRANSPOSE4_PS(column0, column1, column2, translation);
+
+    AlignedMatrixStorage result;
+    _mm_store_ps(&result.data[getIndexFromRowColumn(0, 0)], column0);
+    _mm_store_ps(&result.data[getIndexFromRowColumn(1, 0)], column1);
+    _mm_store_ps(&result.data[getIndexFromRowColumn(2, 0)], column2);
+    _mm_store_ps(&result.data[getIndexFromRowColumn(3, 0)], _mm_setr_ps(0.0F, 0.0F, 0.0F, 1.0F));
+    return result;
+}
+
+// The helpers below treat a register as a row major 2x2 matrix (m00, m01, m10, m11). A# is the adjugate of A.
+
+// A * B
+[[nodiscard]] __m128 multiply2x2(__m128 a, __m128 b) noexcept
 {
-    using namespace impl;
+    return _mm_add_ps(
+        _mm_mul_ps(a, swizzle<0, 3, 0, 3>(b)),
+        _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
 
-    Matrix4 toInvert(*this);
-    Matrix4 inverse;
+// A# * B
+[[nodiscard]] __m128 adjugateMultiply2x2(__m128 a, __m128 b) noexcept
+{
+    return _mm_sub_ps(
+        _mm_mul_ps(swizzle<3, 3, 0, 0>(a), b),
+        _mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+}
 
-    for (size_t row = 0; row < 4; ++row)
-    {
-        swapRowForNonZeroDiagonal(toInvert.m_elements, inverse.m_elements, row);
-        auto leadingElement = toInvert.m_elements.at(getIndexFromRowColumn(row, row));
+// A * B#
+[[nodiscard]] __m128 multiplyAdjugate2x2(__m128 a, __m128 b) noexcept
+{
+    return _mm_sub_ps(
+        _mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)),
+        _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
 
-        for (size_t lowerRow = row + 1; lowerRow < 4; ++lowerRow)
-        {
-            combineRows(toInvert.m_elements, inverse.m_elements, row, lowerRow, leadingElement);
-            leadingElement = toInvert.m_elements.at(getIndexFromRowColumn(row, row));
-        }
+// Block matrix inverse. With M = | A B |, the inverse is 1 / |M| * | X# Y# | where
+//                                | C D |                          | Z# W# |
+// X = |D| A - B (D# C), Y = |B| C - D (A# B)#, Z = |C| B - A (D# C)#, W = |A| D - C (A# B)
+// and |M| = |A| |D| + |B| |C| - tr((A# B) (D# C)).
+AlignedMatrixStorage inverseGeneral(const MatrixElements& m)
+{
+    const auto row0 = _mm_load_ps(&m[getIndexFromRowColumn(0, 0)]);
+    const auto row1 = _mm_load_ps(&m[getIndexFromRowColumn(1, 0)]);
+    const auto row2 = _mm_load_ps(&m[getIndexFromRowColumn(2, 0)]);
+    const auto row3 = _mm_load_ps(&m[getIndexFromRowColumn(3, 0)]);
 
-        // scale current row so leading 1 is present
-        scaleRow(toInvert.m_elements, inverse.m_elements, row, 1.0F / leadingElement);
-    }
+    const auto a = _mm_movelh_ps(row0, row1);
+    const auto b = _mm_movehl_ps(row1, row0);
+    const auto c = _mm_movelh_ps(row2, row3);
+    const auto d = _mm_movehl_ps(row3, row2);
+
+    // (|A|, |B|, |C|, |D|)
+    const auto subDeterminants = _mm_sub_ps(
+        _mm_mul_ps(shuffle<0, 2, 0, 2>(row0, row2), shuffle<1, 3, 1, 3>(row1, row3)),
+        _mm_mul_ps(shuffle<1, 3, 1, 3>(row0, row2), shuffle<0, 2, 0, 2>(row1, row3)));
+    const auto determinantA = swizzle<0, 0, 0, 0>(subDeterminants);
+    const auto determinantB = swizzle<1, 1, 1, 1>(subDeterminants);
+    const auto determinantC = swizzle<2, 2, 2, 2>(subDeterminants);
+    const auto determinantD = swizzle<3, 3, 3, 3>(subDeterminants);
+
+    const auto adjugateDTimesC = adjugateMultiply2x2(d, c);
+    const auto adjugateATimesB = adjugateMultiply2x2(a, b);
+
+    auto x = _mm_sub_ps(_mm_mul_ps(determinantD, a), multiply2x2(b, adjugateDTimesC));
+    auto w = _mm_sub_ps(_mm_mul_ps(determinantA, d), multiply2x2(c, adjugateATimesB));
+    auto y = _mm_sub_ps(_mm_mul_ps(determinantB, c), multiplyAdjugate2x2(d, adjugateATimesB));
+    auto z = _mm_sub_ps(_mm_mul_ps(determinantC, b), multiplyAdjugate2x2(a, adjugateDTimesC));
+
+    auto trace = _mm_mul_ps(adjugateATimesB, swizzle<0, 2, 1, 3>(adjugateDTimesC));
+    trace = _mm_add_ps(trace, swizzle<2, 3, 0, 1>(trace));
+    trace = _mm_add_ps(trace, swizzle<1, 0, 3, 2>(trace));
+
+    const auto determinant = _mm_sub_ps(
+        _mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC)),
+        trace);
+    throwIfSingular<4>(largestMagnitude(row0, row1, row2, row3), _mm_cvtss_f32(determinant));
+
+    // The adjugate of each block flips the sign of its off diagonal elements
+    const auto reciprocal = _mm_div_ps(_mm_setr_ps(1.0F, -1.0F, -1.0F, 1.0F), determinant);
+    x = _mm_mul_ps(x, reciprocal);
+    y = _mm_mul_ps(y, reciprocal);
+    z = _mm_mul_ps(z, reciprocal);
+    w = _mm_mul_ps(w, reciprocal);
 
-    // convert to reduced row echelon form (now all of the diagonals are ones)
-    for (size_t row = 3; row > 0; --row)
+    // Taking the adjugate of each block and reassembling the rows are combined into one shuffle per row
+    AlignedMatrixStorage result;
+    _mm_store_ps(&result.data[getIndexFromRowColumn(0, 0)], shuffle<3, 1, 3, 1>(x, y));
+    _mm_store_ps(&result.data[getIndexFromRowColumn(1, 0)], shuffle<2, 0, 2, 0>(x, y));
+    _mm_store_ps(&result.data[getIndexFromRowColumn(2, 0)], shuffle<3, 1, 3, 1>(z, w));
+    _mm_store_ps(&result.data[getIndexFromRowColumn(3, 0)], shuffle<2, 0, 2, 0>(z, w));
+    return result;
+}
+
+#else
+
+[[nodiscard]] float largestMagnitude(const MatrixElements& m, size_t rows, size_t columns) noexcept
+{
+    auto largest = 0.0F;
+    for (size_t row = 0; row < rows; ++row)
     {
-        for (size_t upperRow = row - 1; upperRow < 4; --upperRow)
+        for (size_t column = 0; column < columns; ++column)
         {
-            combineRows(toInvert.m_elements, inverse.m_elements, row, upperRow, 1.0F);
+            largest = std::max(largest, std::abs(m[getIndexFromRowColumn(row, column)]));
         }
     }
 
-    return inverse;
+    return largest;
+}
+
+// Inverts the upper 3x3 block with cross products of its rows, then maps the translation through that inverse
+AlignedMatrixStorage inverseAffine(const MatrixElements& m)
+{
+    const Vector3 row0(m[getIndexFromRowColumn(0, 0)], m[getIndexFromRowColumn(0, 1)], m[getIndexFromRowColumn(0, 2)]);
+    const Vector3 row1(m[getIndexFromRowColumn(1, 0)], m[getIndexFromRowColumn(1, 1)], m[getIndexFromRowColumn(1, 2)]);
+    const Vector3 row2(m[getIndexFromRowColumn(2, 0)], m[getIndexFromRowColumn(2, 1)], m[getIndexFromRowColumn(2, 2)]);
+
+    // These are the columns of the adjugate of the 3x3 block
+    const auto column0(cross(row1, row2));
+    const auto column1(cross(row2, row0));
+    const auto column2(cross(row0, row1));
+
+    const auto determinant = dot(row0, column0);
+    throwIfSingular<3>(largestMagnitude(m, 3, 3), determinant);
+
+    const auto reciprocal = 1.0F / determinant;
+    const Vector3 translation(
+        m[getIndexFromRowColumn(0, 3)],
+        m[getIndexFromRowColumn(1, 3)],
+        m[getIndexFromRowColumn(2, 3)]);
+
+    const Vector3 inverseRow0(column0.x() * reciprocal, column1.x() * reciprocal, column2.x() * reciprocal);
+    const Vector3 inverseRow1(column0.y() * reciprocal, column1.y() * reciprocal, column2.y() * reciprocal);
+    const Vector3 inverseRow2(column0.z() * reciprocal, column1.z() * reciprocal, column2.z() * reciprocal);
+
+    // clang-format off
+    return AlignedMatrixStorage{
+        inverseRow0.x(), inverseRow0.y(), inverseRow0.z(), -dot(inverseRow0, translation),
+        inverseRow1.x(), inverseRow1.y(), inverseRow1.z(), -dot(inverseRow1, translation),
+        inverseRow2.x(), inverseRow2.y(), inverseRow2.z(), -dot(inverseRow2, translation),
+        0.0F, 0.0F, 0.0F, 1.0F};
+    // clang-format on
+}
+
+// Cofactor expansion using the 2x2 determinants of the top two and bottom two rows
+AlignedMatrixStorage inverseGeneral(const MatrixElements& m)
+{
+    const auto element = [&m](size_t row, size_t column) {
+        return m[getIndexFromRowColumn(row, column)];
+    };
+
+    const auto top01 = element(0, 0) * element(1, 1) - element(1, 0) * element(0, 1);
+    const auto top02 = element(0, 0) * element(1, 2) - element(1, 0) * element(0, 2);
+    const auto top03 = element(0, 0) * element(1, 3) - element(1, 0) * element(0, 3);
+    const auto top12 = element(0, 1) * element(1, 2) - element(1, 1) * element(0, 2);
+    const auto top13 = element(0, 1) * element(1, 3) - element(1, 1) * element(0, 3);
+    const auto top23 = element(0, 2) * element(1, 3) - element(1, 2) * element(0, 3);
+
+    const auto bottom01 = element(2, 0) * element(3, 1) - element(3, 0) * element(2, 1);
+    const auto bottom02 = element(2, 0) * element(3, 2) - element(3, 0) * element(2, 2);
+    const auto bottom03 = element(2, 0) * element(3, 3) - element(3, 0) * element(2, 3);
+    const auto bottom12 = element(2, 1) * element(3, 2) - element(3, 1) * element(2, 2);
+    const auto bottom13 = element(2, 1) * element(3, 3) - element(3, 1) * element(2, 3);
+    const auto bottom23 = element(2, 2) * element(3, 3) - element(3, 2) * element(2, 3);
+
+    const auto determinant = top01 * bottom23 - top02 * bottom13 + top03 * bottom12 + top12 * bottom03 -
+                             top13 * bottom02 + top23 * bottom01;
+    throwIfSingular<4>(largestMagnitude(m, 4, 4), determinant);
+
+    const auto r = 1.0F / determinant;
+
+    // clang-format off
+    return AlignedMatrixStorage{
+        (element(1, 1) * bottom23 - element(1, 2) * bottom13 + element(1, 3) * bottom12) * r,
+        (-element(0, 1) * bottom23 + element(0, 2) * bottom13 - element(0, 3) * bottom12) * r,
+        (element(3, 1) * top23 - element(3, 2) * top13 + element(3, 3) * top12) * r,
+        (-element(2, 1) * top23 + element(2, 2) * top13 - element(2, 3) * top12) * r,
+
+        (-element(1, 0) * bottom23 + element(1, 2) * bottom03 - element(1, 3) * bottom02) * r,
+        (element(0, 0) * bottom23 - element(0, 2) * bottom03 + element(0, 3) * bottom02) * r,
+        (-element(3, 0) * top23 + element(3, 2) * top03 - element(3, 3) * top02) * r,
+        (element(2, 0) * top23 - element(2, 2) * top03 + element(2, 3) * top02) * r,
+
+        (element(1, 0) * bottom13 - element(1, 1) * bottom03 + element(1, 3) * bottom01) * r,
+        (-element(0, 0) * bottom13 + element(0, 1) * bottom03 - element(0, 3) * bottom01) * r,
+        (element(3, 0) * top13 - element(3, 1) * top03 + element(3, 3) * top01) * r,
+        (-element(2, 0) * top13 + element(2, 1) * top03 - element(2, 3) * top01) * r,
+
+        (-element(1, 0) * bottom12 + element(1, 1) * bottom02 - element(1, 2) * bottom01) * r,
+        (element(0, 0) * bottom12 - element(0, 1) * bottom02 + element(0, 2) * bottom01) * r,
+        (-element(3, 0) * top12 + element(3, 1) * top02 - element(3, 2) * top01) * r,
+        (element(2, 0) * top12 - element(2, 1) * top02 + element(2, 2) * top01) * r};
+    // clang-format on
+}
+
+#endif // EYEBEAM_SIMD_SSE
+
+} // namespace
+
+Matrix4 Matrix4::inverse() const
+{
+    return Matrix4(isAffine(m_elements) ? inverseAffine(m_elements) : inverseGeneral(m_elements));
 }
 
 bool Matrix4::isEqual(const Matrix4& other) const
@@ -1,8 +1,10 @@
 #ifndef INCLUDED_MATRIX4_H_
 #define INCLUDED_MATRIX4_H_
 
+#include "components_packet.h"
 #include "constexpr_math.h"
 #include "point3.h"
+#include "simd_lanes.h"
 #include "vector3.h"
 
 #include <array>
@@ -14,17 +16,6 @@ namespace eyebeam
 namespace impl
 {
 
-void swapRowForNonZeroDiagonal(std::array<float, 16>& toInvert, std::array<float, 16>& inverse, size_t row);
-
-void combineRows(
-    std::array<float, 16>& toInvert,
-    std::array<float, 16>& inverse,
-    size_t reducingRow,
-    size_t combinationRow,
-    float leadingElement) noexcept;
-
-void scaleRow(std::array<float, 16>& toInvert, std::array<float, 16>& inverse, size_t row, float scalar) noexcept;
-
 [[nodiscard]] constexpr auto getIndexFromRowColumn(size_t row, size_t column) noexcept
 {
     return row * 4 + column;
@@ -163,6 +154,95 @@ public:
         return Vector3(result[0], result[1], result[2]);
     }
 
+    // Multiplies by the transpose of the upper 3x3 block without building the transposed matrix. Each component is
+    // computed directly rather than through a temporary array, which would be written as scalars and read back as a
+    // wider register.
+    [[nodiscard]] constexpr auto multiplyTransposed(const Vector3& rhs) const noexcept
+    {
+        using namespace impl;
+
+        const auto column = [this, &rhs](size_t c) {
+            return m_elements[getIndexFromRowColumn(0, c)] * rhs.x() +
+                   m_elements[getIndexFromRowColumn(1, c)] * rhs.y() +
+                   m_elements[getIndexFromRowColumn(2, c)] * rhs.z();
+        };
+
+        return Vector3(column(0), column(1), column(2));
+    }
+
+    // Unlike the single point version, the homogeneous divide is always performed so that no lane needs to branch
+    template <size_t Width>
+    [[nodiscard]] auto multiply(const Point3Packet<Width>& rhs) const noexcept
+    {
+        using Lanes = PacketLanes<Width>;
+        using namespace impl;
+
+        Point3Packet<Width> result;
+
+        for (size_t lane = 0; lane < Width; lane += Lanes::width)
+        {
+            const auto x = Lanes::load(&rhs.x.data[lane]);
+            const auto y = Lanes::load(&rhs.y.data[lane]);
+            const auto z = Lanes::load(&rhs.z.data[lane]);
+
+            std::array<Lanes, 4> rows;
+            for (size_t row = 0; row < 4; ++row)
+            {
+                rows[row] = multiplyAdd(
+                    Lanes(m_elements[getIndexFromRowColumn(row, 0)]),
+                    x,
+                    multiplyAdd(
+                        Lanes(m_elements[getIndexFromRowColumn(row, 1)]),
+                        y,
+                        multiplyAdd(
+                            Lanes(m_elements[getIndexFromRowColumn(row, 2)]),
+                            z,
+                            Lanes(m_elements[getIndexFromRowColumn(row, 3)]))));
+            }
+
+            const auto homogenousReciprocal = Lanes(1.0F) / rows[3];
+            (rows[0] * homogenousReciprocal).store(&result.x.data[lane]);
+            (rows[1] * homogenousReciprocal).store(&result.y.data[lane]);
+            (rows[2] * homogenousReciprocal).store(&result.z.data[lane]);
+        }
+
+        return result;
+    }
+
+    template <size_t Width>
+    [[nodiscard]] auto multiply(const Vector3Packet<Width>& rhs) const noexcept
+    {
+        using Lanes = PacketLanes<Width>;
+        using namespace impl;
+
+        Vector3Packet<Width> result;
+
+        for (size_t lane = 0; lane < Width; lane += Lanes::width)
+        {
+            const auto x = Lanes::load(&rhs.x.data[lane]);
+            const auto y = Lanes::load(&rhs.y.data[lane]);
+            const auto z = Lanes::load(&rhs.z.data[lane]);
+
+            std::array<Lanes, 3> rows;
+            for (size_t row = 0; row < 3; ++row)
+            {
+                rows[row] = multiplyAdd(
+                    Lanes(m_elements[getIndexFromRowColumn(row, 0)]),
+                    x,
+                    multiplyAdd(
+                        Lanes(m_elements[getIndexFromRowColumn(row, 1)]),
+                        y,
+                        Lanes(m_elements[getIndexFromRowColumn(row, 2)]) * z));
+            }
+
+            rows[0].store(&result.x.data[lane]);
+            rows[1].store(&result.y.data[lane]);
+            rows[2].store(&result.z.data[lane]);
+        }
+
+        return result;
+    }
+
     [[nodiscard]] constexpr auto multiply(const Matrix4& rhs) const noexcept
     {
         AlignedMatrixStorage result = {0.0F};
@@ -184,6 +264,8 @@ public:
         return Matrix4(result);
     }
 
+    // Throws std::runtime_error when the matrix is singular. Affine matrices, whose bottom row is exactly (0, 0, 0, 1),
+    // take a faster path that only inverts the upper 3x3 block.
     [[nodiscard]] Matrix4 inverse() const;
     [[nodiscard]] bool isEqual(const Matrix4& other) const;
 
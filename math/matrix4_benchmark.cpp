@@ -164,6 +164,38 @@ void benchmarkMatrix4InverseTranslation(benchmark::State& state)
     }
 }
 
+void benchmarkMatrix4InverseGeneral(benchmark::State& state)
+{
+    // clang-format off
+    const Matrix4 general(AlignedMatrixStorage{
+        1.0F, 2.0F, 3.0F, 4.0F,
+        5.0F, -6.0F, 7.0F, 8.0F,
+        9.0F, 10.0F, 11.0F, -12.0F,
+        13.0F, 14.0F, 15.0F, 16.0F});
+    // clang-format on
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(general.inverse());
+    }
+}
+
+void benchmarkMatrix4InverseAffine(benchmark::State& state)
+{
+    // clang-format off
+    const Matrix4 affine(AlignedMatrixStorage{
+        0.5F, -2.0F, 0.25F, 4.0F,
+        1.0F, 3.0F, -1.5F, -2.0F,
+        2.0F, 0.0F, 1.0F, 0.5F,
+        0.0F, 0.0F, 0.0F, 1.0F});
+    // clang-format on
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(affine.inverse());
+    }
+}
+
 // NOLINTNEXTLINE
 BENCHMARK(benchmarkMatrix4DefaultCtor);
 
@@ -182,4 +214,10 @@ BENCHMARK(benchmarkMatrix4InverseRotation);
 // NOLINTNEXTLINE
 BENCHMARK(benchmarkMatrix4InverseTranslation);
 
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkMatrix4InverseGeneral);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkMatrix4InverseAffine);
+
 } // namespace eyebeam
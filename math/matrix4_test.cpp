@@ -262,4 +262,104 @@ TEST_F(Matrix4TestFixture, Matrix4InverseGeneratesNegatedTranslationForTranslati
     EXPECT_EQ(result, expected);
 }
 
+// NOLINTNEXTLINE
+TEST(Matrix4Tests, Matrix4InverseOfGeneralMatrixMultipliesToIdentity)
+{
+    // GIVEN:
+    // clang-format off
+    constexpr Matrix4 m(AlignedMatrixStorage{
+        1.0F, 2.0F, 3.0F, 4.0F,
+        5.0F, -6.0F, 7.0F, 8.0F,
+        9.0F, 10.0F, 11.0F, -12.0F,
+        13.0F, 14.0F, 15.0F, 16.0F
+    });
+    // clang-format on
+
+    // WHEN:
+    const auto result(m.inverse());
+
+    // THEN:
+    EXPECT_TRUE(isIdentity(m.multiply(result)));
+    EXPECT_TRUE(isIdentity(result.multiply(m)));
+}
+
+// NOLINTNEXTLINE
+TEST(Matrix4Tests, Matrix4InverseOfAffineMatrixMultipliesToIdentity)
+{
+    // GIVEN:
+    // clang-format off
+    constexpr Matrix4 m(AlignedMatrixStorage{
+        0.5F, -2.0F, 0.25F, 4.0F,
+        1.0F, 3.0F, -1.5F, -2.0F,
+        2.0F, 0.0F, 1.0F, 0.5F,
+        0.0F, 0.0F, 0.0F, 1.0F
+    });
+    // clang-format on
+
+    // WHEN:
+    const auto result(m.inverse());
+
+    // THEN:
+    EXPECT_TRUE(isIdentity(m.multiply(result)));
+    EXPECT_TRUE(isIdentity(result.multiply(m)));
+}
+
+// NOLINTNEXTLINE
+TEST(Matrix4Tests, Matrix4InverseThrowsRuntimeErrorForSingularAffineMatrix)
+{
+    // GIVEN:
+    // clang-format off
+    constexpr Matrix4 flatten(AlignedMatrixStorage{
+        1.0F, 0.0F, 0.0F, 1.0F,
+        0.0F, 0.0F, 0.0F, 2.0F,
+        0.0F, 0.0F, 1.0F, 3.0F,
+        0.0F, 0.0F, 0.0F, 1.0F
+    });
+    // clang-format on
+
+    // WHEN/THEN:
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto)
+    EXPECT_THROW([[maybe_unused]] const auto inverse = flatten.inverse(), std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST(Matrix4Tests, Matrix4InverseThrowsRuntimeErrorForGeneralMatrixWithLinearlyDependentRows)
+{
+    // GIVEN:
+    // clang-format off
+    constexpr Matrix4 m(AlignedMatrixStorage{
+        1.0F, 2.0F, 3.0F, 4.0F,
+        2.0F, 4.0F, 6.0F, 8.0F,
+        9.0F, 10.0F, 11.0F, -12.0F,
+        13.0F, 14.0F, 15.0F, 16.0F
+    });
+    // clang-format on
+
+    // WHEN/THEN:
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-goto)
+    EXPECT_THROW([[maybe_unused]] const auto inverse = m.inverse(), std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST(Matrix4Tests, Matrix4InverseOfSmallUniformScaleWithLargeTranslationIsNotSingular)
+{
+    // GIVEN:
+    constexpr auto scale = 0.05F;
+    constexpr auto translation = 1000.0F;
+    // clang-format off
+    constexpr Matrix4 m(AlignedMatrixStorage{
+        scale, 0.0F, 0.0F, translation,
+        0.0F, scale, 0.0F, translation,
+        0.0F, 0.0F, scale, translation,
+        0.0F, 0.0F, 0.0F, 1.0F
+    });
+    // clang-format on
+
+    // WHEN:
+    const auto result(m.inverse());
+
+    // THEN:
+    EXPECT_TRUE(isIdentity(m.multiply(result)));
+}
+
 } // namespace eyebeam
@@ -31,26 +31,19 @@ public:
 
     auto& operator+=(const Normal3& rhs) noexcept
     {
-        x() += rhs.x();
-        y() += rhs.y();
-        z() += rhs.z();
+        addComponents(rhs);
         return *this;
     }
 
     auto& operator-=(const Normal3& rhs) noexcept
     {
-        x() -= rhs.x();
-        y() -= rhs.y();
-        z() -= rhs.z();
+        subtractComponents(rhs);
         return *this;
     }
 
     auto& operator*=(float rhs) noexcept
     {
-        x() *= rhs;
-        y() *= rhs;
-        z() *= rhs;
-
+        scaleComponents(rhs);
         return *this;
     }
 
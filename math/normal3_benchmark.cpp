@@ -0,0 +1,165 @@
+#include "normal3.h"
+
+#include "random_generator.h"
+#include "vector3.h"
+
+#include <benchmark/benchmark.h>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+void benchmarkNormal3OperatorPlus(benchmark::State& state)
+{
+    Normal3 randLeft(RandomGenerator::generateRandomNormal3());
+    Normal3 randRight(RandomGenerator::generateRandomNormal3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(randLeft + randRight);
+    }
+}
+
+void benchmarkNormal3OperatorMinus(benchmark::State& state)
+{
+    Normal3 randLeft(RandomGenerator::generateRandomNormal3());
+    Normal3 randRight(RandomGenerator::generateRandomNormal3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(randLeft - randRight);
+    }
+}
+
+void benchmarkNormal3OperatorMultiplyScaleOnRight(benchmark::State& state)
+{
+    Normal3 randLeft(RandomGenerator::generateRandomNormal3());
+    float scale = RandomGenerator::generateRandomFloat();
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(randLeft * scale);
+    }
+}
+
+void benchmarkNormal3OperatorMultiplyScaleOnLeft(benchmark::State& state)
+{
+    Normal3 randRight(RandomGenerator::generateRandomNormal3());
+    float scale = RandomGenerator::generateRandomFloat();
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(scale * randRight);
+    }
+}
+
+void benchmarkNormal3OperatorDivide(benchmark::State& state)
+{
+    Normal3 randLeft(RandomGenerator::generateRandomNormal3());
+    float scale = RandomGenerator::generateRandomFloat();
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(randLeft / scale);
+    }
+}
+
+void benchmarkNormal3Negation(benchmark::State& state)
+{
+    Normal3 rand(RandomGenerator::generateRandomNormal3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(-rand);
+    }
+}
+
+void benchmarkNormal3DotProduct(benchmark::State& state)
+{
+    Normal3 randLeft(RandomGenerator::generateRandomNormal3());
+    Normal3 randRight(RandomGenerator::generateRandomNormal3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(dot(randLeft, randRight));
+    }
+}
+
+void benchmarkNormal3CrossProductWithVector3(benchmark::State& state)
+{
+    Normal3 randLeft(RandomGenerator::generateRandomNormal3());
+    Vector3 randRight(RandomGenerator::generateRandomVector3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(cross(randLeft, randRight));
+    }
+}
+
+void benchmarkNormal3LengthSquared(benchmark::State& state)
+{
+    Normal3 rand(RandomGenerator::generateRandomNormal3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(lengthSquared(rand));
+    }
+}
+
+void benchmarkNormal3Length(benchmark::State& state)
+{
+    Normal3 rand(RandomGenerator::generateRandomNormal3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(length(rand));
+    }
+}
+
+void benchmarkNormal3Norm(benchmark::State& state)
+{
+    Normal3 rand(RandomGenerator::generateRandomNormal3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(norm(rand));
+    }
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3OperatorPlus);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3OperatorMinus);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3OperatorMultiplyScaleOnRight);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3OperatorMultiplyScaleOnLeft);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3OperatorDivide);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3Negation);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3DotProduct);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3CrossProductWithVector3);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3LengthSquared);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3Length);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkNormal3Norm);
+
+} // namespace
+} // namespace eyebeam
@@ -21,8 +21,9 @@ Point3 operator+(const Vector3& lhs, const Point3& rhs)
 
 Vector3 operator-(const Point3& lhs, const Point3& rhs)
 {
-    Vector3 result(lhs);
-    result -= Vector3(rhs);
+    // The homogeneous coordinates cancel out, so the difference is already a direction
+    Vector3 result;
+    result.assignDifference(lhs, rhs);
     return result;
 }
 
@@ -29,9 +29,7 @@ public:
 
     auto& operator+=(const Vector3& rhs) noexcept
     {
-        x() += rhs.x();
-        y() += rhs.y();
-        z() += rhs.z();
+        addComponents(rhs);
         return *this;
     }
 
@@ -24,6 +24,20 @@ TEST(Point3Tests, OperatorPlusEqualAddsConstantVector3ToLeftSide)
     EXPECT_EQ(expected, left);
 }
 
+// NOLINTNEXTLINE
+TEST(Point3Tests, OperatorPlusEqualKeepsHomogeneousCoordinateAtOne)
+{
+    // GIVEN:
+    Point3 left(1.0F, 2.0F, 3.0F);
+    constexpr Vector3 right(-4.0F, 0.5F, 1.0F);
+
+    // WHEN:
+    left += right;
+
+    // THEN:
+    EXPECT_EQ(1.0F, left.w());
+}
+
 // NOLINTNEXTLINE
 TEST(Point3Tests, OperatorPlusAddsPointAndVector)
 {
@@ -1,9 +1,12 @@
 #include "quadratic_solver.h"
 
 #include "constexpr_math.h"
+#include "simd_lanes.h"
 
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <stdexcept>
 #include <utility>
@@ -11,6 +14,29 @@
 namespace eyebeam
 {
 
+namespace
+{
+
+template <typename Lanes>
+void solveAndStore(const QuadraticBatch& equations, const QuadraticBatchRoots& roots, size_t first) noexcept
+{
+    const auto solution = solveQuadraticLanes(
+        Lanes::loadUnaligned(equations.a + first),
+        Lanes::loadUnaligned(equations.b + first),
+        Lanes::loadUnaligned(equations.c + first));
+
+    solution.nearRoots.storeUnaligned(roots.nearRoots + first);
+    solution.farRoots.storeUnaligned(roots.farRoots + first);
+
+    const auto hasRootsBits = solution.hasRoots.bits();
+    for (size_t lane = 0; lane < Lanes::width; ++lane)
+    {
+        roots.hasRoots[first + lane] = static_cast<std::uint8_t>((hasRootsBits >> lane) & 1);
+    }
+}
+
+} // namespace
+
 bool solveQuadratic(float a, float b, float c, QuadraticRoots& roots)
 {
     if (areEqual(a, 0.0F))
@@ -44,4 +70,20 @@ bool solveQuadratic(float a, float b, float c, QuadraticRoots& roots)
     return true;
 }
 
+void solveQuadratics(const QuadraticBatch& equations, const QuadraticBatchRoots& roots) noexcept
+{
+    using Lanes = FloatLanes<maxNativeLaneWidth>;
+
+    size_t first = 0;
+    for (; first + Lanes::width <= equations.count; first += Lanes::width)
+    {
+        solveAndStore<Lanes>(equations, roots, first);
+    }
+
+    for (; first < equations.count; ++first)
+    {
+        solveAndStore<FloatLanes<1>>(equations, roots, first);
+    }
+}
+
 } // namespace eyebeam
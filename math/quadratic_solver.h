@@ -1,7 +1,12 @@
 #ifndef INCLUDED_QUADRATIC_SOLVER_H_
 #define INCLUDED_QUADRATIC_SOLVER_H_
 
+#include "simd_lanes.h"
+
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 
 namespace eyebeam
 {
@@ -10,6 +15,60 @@ using QuadraticRoots = std::array<float, 2>;
 
 [[nodiscard]] bool solveQuadratic(float a, float b, float c, QuadraticRoots& roots);
 
+// Structure of arrays batch of count equations a[i] * t^2 + b[i] * t + c[i] = 0
+struct QuadraticBatch
+{
+    const float* a;
+    const float* b;
+    const float* c;
+    size_t count;
+};
+
+// Destination for the roots of a QuadraticBatch. Each array holds at least count elements. hasRoots[i] is 1 when
+// equation i has real roots, in which case nearRoots[i] <= farRoots[i], and 0 otherwise.
+struct QuadraticBatchRoots
+{
+    float* nearRoots;
+    float* farRoots;
+    std::uint8_t* hasRoots;
+};
+
+// Solves a batch of equations without branching on the discriminant. Equations with a == 0 are reported as having no
+// roots instead of throwing like solveQuadratic does, and the arithmetic stays in single precision.
+void solveQuadratics(const QuadraticBatch& equations, const QuadraticBatchRoots& roots) noexcept;
+
+// The roots of one equation per lane, in the layout of QuadraticBatchRoots
+template <size_t Width>
+struct QuadraticLaneRoots
+{
+    FloatLanes<Width> nearRoots;
+    FloatLanes<Width> farRoots;
+    MaskLanes<Width> hasRoots;
+};
+
+// The lane kernel of solveQuadratics, for callers that already hold their coefficients in lanes. The root nearer zero
+// is c / q rather than (-b +- sqrt(discriminant)) / 2a, which would subtract two nearly equal numbers.
+template <size_t Width>
+[[nodiscard]] QuadraticLaneRoots<Width> solveQuadraticLanes(
+    const FloatLanes<Width>& a,
+    const FloatLanes<Width>& b,
+    const FloatLanes<Width>& c) noexcept
+{
+    using Lanes = FloatLanes<Width>;
+
+    const Lanes zero(0.0F);
+    const auto discriminant = multiplyAdd(b, b, Lanes(-4.0F) * a * c);
+    const auto hasRoots = (discriminant >= zero) & !(a == zero);
+
+    const auto rootDiscriminant = sqrt(max(discriminant, zero));
+    const auto q = Lanes(-0.5F) * select(b < zero, b - rootDiscriminant, b + rootDiscriminant);
+
+    const auto root0 = q / a;
+    const auto root1 = select(abs(q) < Lanes(std::numeric_limits<float>::min()), root0, c / q);
+
+    return QuadraticLaneRoots<Width>{min(root0, root1), max(root0, root1), hasRoots};
+}
+
 } // namespace eyebeam
 
 #endif // INCLUDED_QUADRATIC_SOLVER_H_
@@ -2,7 +2,9 @@
 
 #include "random_generator.h"
 
+#include <cstdint>
 #include <tuple>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -26,6 +28,21 @@ auto generateRandomQuadraticCoefficients()
     return std::make_tuple(a, b, c);
 }
 
+struct RandomQuadraticBatch
+{
+    explicit RandomQuadraticBatch(size_t count) : a(count), b(count), c(count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::tie(a[i], b[i], c[i]) = generateRandomQuadraticCoefficients();
+        }
+    }
+
+    std::vector<float> a;
+    std::vector<float> b;
+    std::vector<float> c;
+};
+
 } // namespace
 
 void benchmarkQuadraticSolver(benchmark::State& state)
@@ -42,7 +59,63 @@ void benchmarkQuadraticSolver(benchmark::State& state)
     }
 }
 
+void benchmarkQuadraticSolverPerCall(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const RandomQuadraticBatch equations(count);
+    std::vector<float> nearRoots(count);
+    std::vector<float> farRoots(count);
+    std::vector<std::uint8_t> hasRoots(count);
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        QuadraticRoots roots;
+        for (size_t i = 0; i < count; ++i)
+        {
+            hasRoots[i] = solveQuadratic(equations.a[i], equations.b[i], equations.c[i], roots) ? 1 : 0;
+            nearRoots[i] = roots[0];
+            farRoots[i] = roots[1];
+        }
+
+        benchmark::DoNotOptimize(hasRoots.data());
+        benchmark::DoNotOptimize(nearRoots.data());
+        benchmark::DoNotOptimize(farRoots.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void benchmarkQuadraticSolverBatched(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const RandomQuadraticBatch equations(count);
+    std::vector<float> nearRoots(count);
+    std::vector<float> farRoots(count);
+    std::vector<std::uint8_t> hasRoots(count);
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        solveQuadratics(
+            QuadraticBatch{equations.a.data(), equations.b.data(), equations.c.data(), count},
+            QuadraticBatchRoots{nearRoots.data(), farRoots.data(), hasRoots.data()});
+
+        benchmark::DoNotOptimize(hasRoots.data());
+        benchmark::DoNotOptimize(nearRoots.data());
+        benchmark::DoNotOptimize(farRoots.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 // NOLINTNEXTLINE
 BENCHMARK(benchmarkQuadraticSolver);
 
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkQuadraticSolverPerCall)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkQuadraticSolverBatched)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
 } // namespace eyebeam
@@ -1,11 +1,14 @@
 #include "quadratic_solver.h"
 
 #include "constexpr_math.h"
+#include "random_generator.h"
 
 #include <gtest/gtest.h>
 
 #include <array>
+#include <cstdint>
 #include <limits>
+#include <vector>
 
 namespace eyebeam
 {
@@ -97,4 +100,115 @@ TEST_F(QuadraticSolverTestsFixture, TestCatastrophicCancellation)
     EXPECT_TRUE(areEqual(m_roots[1], expected[1]));
 }
 
+class QuadraticBatchSolverTestsFixture : public ::testing::Test
+{
+protected:
+    void resize(size_t count)
+    {
+        m_a.resize(count, 1.0F);
+        m_b.resize(count, 0.0F);
+        m_c.resize(count, 0.0F);
+        m_nearRoots.resize(count, std::numeric_limits<float>::infinity());
+        m_farRoots.resize(count, std::numeric_limits<float>::infinity());
+        m_hasRoots.resize(count, 2);
+    }
+
+    void solve()
+    {
+        solveQuadratics(
+            QuadraticBatch{m_a.data(), m_b.data(), m_c.data(), m_a.size()},
+            QuadraticBatchRoots{m_nearRoots.data(), m_farRoots.data(), m_hasRoots.data()});
+    }
+
+    std::vector<float> m_a;               // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+    std::vector<float> m_b;               // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+    std::vector<float> m_c;               // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+    std::vector<float> m_nearRoots;       // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+    std::vector<float> m_farRoots;        // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+    std::vector<std::uint8_t> m_hasRoots; // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+// NOLINTNEXTLINE
+TEST_F(QuadraticBatchSolverTestsFixture, MatchesSingleEquationSolverForEveryEquation)
+{
+    // GIVEN:
+    constexpr size_t count = 37; // not a multiple of any SIMD width, so the scalar tail is exercised
+    resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        while (areEqual(m_a[i], 0.0F))
+        {
+            m_a[i] = RandomGenerator::generateRandomFloat();
+        }
+
+        m_b[i] = RandomGenerator::generateRandomFloat();
+        m_c[i] = RandomGenerator::generateRandomFloat();
+    }
+
+    // WHEN:
+    solve();
+
+    // THEN:
+    for (size_t i = 0; i < count; ++i)
+    {
+        QuadraticRoots expected{};
+        const auto expectedHasRoots = solveQuadratic(m_a[i], m_b[i], m_c[i], expected);
+
+        ASSERT_EQ(expectedHasRoots ? 1 : 0, m_hasRoots[i]);
+        if (expectedHasRoots)
+        {
+            EXPECT_TRUE(areEqual(expected[0], m_nearRoots[i]));
+            EXPECT_TRUE(areEqual(expected[1], m_farRoots[i]));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(QuadraticBatchSolverTestsFixture, ReportsNoRootsWhenAIsZero)
+{
+    // GIVEN:
+    resize(1);
+    m_a[0] = 0.0F;
+    m_b[0] = 1.0F;
+
+    // WHEN:
+    solve();
+
+    // THEN:
+    EXPECT_EQ(0, m_hasRoots[0]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(QuadraticBatchSolverTestsFixture, ReturnsEquivalentRootsWhenFormulaHasOneRoot)
+{
+    // GIVEN:
+    resize(1);
+
+    // WHEN:
+    solve();
+
+    // THEN:
+    ASSERT_EQ(1, m_hasRoots[0]);
+    EXPECT_TRUE(areEqual(m_nearRoots[0], m_farRoots[0]));
+    EXPECT_TRUE(areEqual(m_nearRoots[0], 0.0F));
+}
+
+// NOLINTNEXTLINE
+TEST_F(QuadraticBatchSolverTestsFixture, TestCatastrophicCancellation)
+{
+    // GIVEN:
+    resize(1);
+    m_b[0] = 444.0F;
+    m_c[0] = 1.0F;
+
+    // WHEN:
+    solve();
+
+    // THEN:
+    const QuadraticRoots expected{-443.99774773632276650F, -0.00225226367723350F};
+    ASSERT_EQ(1, m_hasRoots[0]);
+    EXPECT_TRUE(areEqual(m_nearRoots[0], expected[0]));
+    EXPECT_TRUE(areEqual(m_farRoots[0], expected[1]));
+}
+
 } // namespace eyebeam
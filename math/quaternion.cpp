@@ -0,0 +1,123 @@
+#include "quaternion.h"
+
+#include "angle.h"
+#include "constexpr_math.h"
+#include "matrix4.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+namespace eyebeam
+{
+
+Quaternion Quaternion::rotateAxisAngle(Vector3 axis, Radians theta)
+{
+    normalize(axis);
+    return Quaternion(axis * std::sin(theta / 2.0F), std::cos(theta / 2.0F));
+}
+
+Quaternion Quaternion::rotateX(Radians theta)
+{
+    return rotateAxisAngle(Axes::X, theta);
+}
+
+Quaternion Quaternion::rotateY(Radians theta)
+{
+    return rotateAxisAngle(Axes::Y, theta);
+}
+
+Quaternion Quaternion::rotateZ(Radians theta)
+{
+    return rotateAxisAngle(Axes::Z, theta);
+}
+
+Quaternion Quaternion::multiply(const Quaternion& q) const noexcept
+{
+    return Quaternion(
+        m_vector * q.m_w + q.m_vector * m_w + cross(m_vector, q.m_vector),
+        m_w * q.m_w - dot(m_vector, q.m_vector));
+}
+
+Transform Quaternion::toTransform() const noexcept
+{
+    const auto x = m_vector.x();
+    const auto y = m_vector.y();
+    const auto z = m_vector.z();
+    const auto w = m_w;
+
+    const Matrix4 m(AlignedMatrixStorage{
+        1.0F - 2.0F * (y * y + z * z),
+        2.0F * (x * y - z * w),
+        2.0F * (x * z + y * w),
+        0.0F,
+        2.0F * (x * y + z * w),
+        1.0F - 2.0F * (x * x + z * z),
+        2.0F * (y * z - x * w),
+        0.0F,
+        2.0F * (x * z - y * w),
+        2.0F * (y * z + x * w),
+        1.0F - 2.0F * (x * x + y * y),
+        0.0F,
+        0.0F,
+        0.0F,
+        0.0F,
+        1.0F});
+
+    return Transform(m, m.transpose());
+}
+
+Quaternion norm(const Quaternion& q) noexcept
+{
+    const auto inverseLength = 1.0F / std::sqrt(dot(q, q));
+    return Quaternion(q.vector() * inverseLength, q.w() * inverseLength);
+}
+
+Radians angleBetween(const Quaternion& from, const Quaternion& to) noexcept
+{
+    return Radians(2.0F * std::acos(std::min(std::abs(dot(from, to)), 1.0F)));
+}
+
+// Nearly equal rotations are interpolated linearly, where the sine in the denominator would lose all its precision
+Quaternion slerp(const Quaternion& from, const Quaternion& to, float t) noexcept
+{
+    // q and -q are the same rotation, and the one closer to from gives the shorter arc
+    auto cosTheta = dot(from, to);
+    const auto sign = cosTheta < 0.0F ? -1.0F : 1.0F;
+    cosTheta *= sign;
+
+    constexpr auto linearThreshold = 0.9995F;
+    if (cosTheta > linearThreshold)
+    {
+        return norm(Quaternion(
+            from.vector() * (1.0F - t) + to.vector() * (sign * t),
+            from.w() * (1.0F - t) + to.w() * (sign * t)));
+    }
+
+    const auto theta = std::acos(cosTheta);
+    const auto inverseSinTheta = 1.0F / std::sin(theta);
+    const auto fromWeight = std::sin((1.0F - t) * theta) * inverseSinTheta;
+    const auto toWeight = sign * std::sin(t * theta) * inverseSinTheta;
+    return Quaternion(from.vector() * fromWeight + to.vector() * toWeight, from.w() * fromWeight + to.w() * toWeight);
+}
+
+// q and -q are the same rotation, so either compares equal
+bool operator==(const Quaternion& lhs, const Quaternion& rhs)
+{
+    return (lhs.vector() == rhs.vector() && areEqual(lhs.w(), rhs.w())) ||
+           (lhs.vector() == -rhs.vector() && areEqual(lhs.w(), -rhs.w()));
+}
+
+bool operator!=(const Quaternion& lhs, const Quaternion& rhs)
+{
+    return !(lhs == rhs);
+}
+
+std::ostream& operator<<(std::ostream& os, const Quaternion& out)
+{
+    return os << "Quaternion: " << out.vector() << ", " << out.w();
+}
+
+} // namespace eyebeam
@@ -0,0 +1,73 @@
+#ifndef INCLUDED_QUATERNION_H_
+#define INCLUDED_QUATERNION_H_
+
+#include "angle.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <iosfwd>
+
+namespace eyebeam
+{
+
+// A rotation as a unit quaternion, which unlike a rotation matrix can be interpolated without shearing or shrinking
+// the geometry it is applied to
+class Quaternion
+{
+public:
+    // The identity rotation
+    constexpr Quaternion() noexcept = default;
+
+    constexpr Quaternion(const Vector3& vector, float w) noexcept : m_vector(vector), m_w(w)
+    {
+    }
+
+    [[nodiscard]] constexpr const auto& vector() const noexcept
+    {
+        return m_vector;
+    }
+
+    [[nodiscard]] constexpr auto w() const noexcept
+    {
+        return m_w;
+    }
+
+    // Rotations by theta about axis, turning counterclockwise when looking down it, as Transform does
+    [[nodiscard]] static Quaternion rotateAxisAngle(Vector3 axis, Radians theta);
+    [[nodiscard]] static Quaternion rotateX(Radians theta);
+    [[nodiscard]] static Quaternion rotateY(Radians theta);
+    [[nodiscard]] static Quaternion rotateZ(Radians theta);
+
+    // The rotation by q followed by this one, like Transform::multiply
+    [[nodiscard]] Quaternion multiply(const Quaternion& q) const noexcept;
+
+    // The rotation matrix, whose inverse is its transpose
+    [[nodiscard]] Transform toTransform() const noexcept;
+
+private:
+    Vector3 m_vector;
+    float m_w = 1.0F;
+};
+
+[[nodiscard]] constexpr auto dot(const Quaternion& left, const Quaternion& right) noexcept
+{
+    return dot(left.vector(), right.vector()) + left.w() * right.w();
+}
+
+[[nodiscard]] Quaternion norm(const Quaternion& q) noexcept;
+
+// The angle the shortest rotation from one to the other turns through, in [0, pi]
+[[nodiscard]] Radians angleBetween(const Quaternion& from, const Quaternion& to) noexcept;
+
+// Spherical linear interpolation, which turns at a constant rate along the shortest arc from one rotation to the other
+// as t goes from 0 to 1
+[[nodiscard]] Quaternion slerp(const Quaternion& from, const Quaternion& to, float t) noexcept;
+
+bool operator==(const Quaternion& lhs, const Quaternion& rhs);
+bool operator!=(const Quaternion& lhs, const Quaternion& rhs);
+
+std::ostream& operator<<(std::ostream& os, const Quaternion& out);
+
+} // namespace eyebeam
+
+#endif // INCLUDED_QUATERNION_H_
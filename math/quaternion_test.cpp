@@ -0,0 +1,126 @@
+#include "quaternion.h"
+
+#include "random_generator.h"
+
+#include <gtest/gtest.h>
+
+namespace eyebeam
+{
+
+// NOLINTNEXTLINE
+TEST(QuaternionTests, DefaultCtorResultsInIdentityRotation)
+{
+    // GIVEN:
+    constexpr Quaternion q;
+
+    // WHEN:
+    const auto result(q.toTransform());
+
+    // THEN:
+    EXPECT_TRUE(result.isIdentity());
+}
+
+// NOLINTNEXTLINE
+TEST(QuaternionTests, AxisAngleRotationMatchesTransform)
+{
+    // GIVEN:
+    const auto axis(RandomGenerator::generateRandomVector3());
+    const Radians theta(RandomGenerator::generateRandomFloat());
+
+    // WHEN:
+    const auto result(Quaternion::rotateAxisAngle(axis, theta).toTransform());
+
+    // THEN:
+    EXPECT_EQ(Transform::rotateAxisAngle(axis, theta), result);
+}
+
+// NOLINTNEXTLINE
+TEST(QuaternionTests, MultiplyComposesLikeTransform)
+{
+    // GIVEN:
+    const Radians x(0.3F);
+    const Radians y(-1.2F);
+
+    // WHEN:
+    const auto result(Quaternion::rotateY(y).multiply(Quaternion::rotateX(x)).toTransform());
+
+    // THEN:
+    EXPECT_EQ(Transform::rotateY(y).multiply(Transform::rotateX(x)), result);
+}
+
+// NOLINTNEXTLINE
+TEST(QuaternionTests, NegatedQuaternionIsTheSameRotation)
+{
+    // GIVEN:
+    const auto q(Quaternion::rotateZ(Radians(0.7F)));
+
+    // WHEN:
+    const Quaternion negated(-q.vector(), -q.w());
+
+    // THEN:
+    EXPECT_EQ(q, negated);
+    EXPECT_EQ(q.toTransform(), negated.toTransform());
+}
+
+// NOLINTNEXTLINE
+TEST(QuaternionTests, SlerpTurnsAtAConstantRate)
+{
+    // GIVEN:
+    const auto from(Quaternion::rotateZ(Radians(0.2F)));
+    const auto to(Quaternion::rotateZ(Radians(1.8F)));
+
+    // WHEN:
+    const auto quarter(slerp(from, to, 0.25F));
+    const auto half(slerp(from, to, 0.5F));
+
+    // THEN:
+    EXPECT_EQ(from, slerp(from, to, 0.0F));
+    EXPECT_EQ(to, slerp(from, to, 1.0F));
+    EXPECT_EQ(Quaternion::rotateZ(Radians(0.6F)), quarter);
+    EXPECT_EQ(Quaternion::rotateZ(Radians(1.0F)), half);
+}
+
+// NOLINTNEXTLINE
+TEST(QuaternionTests, SlerpTakesTheShortestArc)
+{
+    // GIVEN:
+    const auto from(Quaternion::rotateY(Radians(0.1F)));
+    const auto to(Quaternion::rotateY(Radians(-0.3F)));
+    const Quaternion negatedTo(-to.vector(), -to.w());
+
+    // WHEN:
+    const auto result(slerp(from, negatedTo, 0.5F));
+
+    // THEN:
+    EXPECT_EQ(Quaternion::rotateY(Radians(-0.1F)), result);
+}
+
+// NOLINTNEXTLINE
+TEST(QuaternionTests, SlerpBetweenNearlyEqualRotationsStaysNormalized)
+{
+    // GIVEN:
+    const auto from(Quaternion::rotateX(Radians(1.0F)));
+    const auto to(Quaternion::rotateX(Radians(1.0001F)));
+
+    // WHEN:
+    const auto result(slerp(from, to, 0.5F));
+
+    // THEN:
+    EXPECT_FLOAT_EQ(1.0F, dot(result, result));
+}
+
+// NOLINTNEXTLINE
+TEST(QuaternionTests, AngleBetweenIsTheAngleTurned)
+{
+    // GIVEN:
+    const auto from(Quaternion::rotateAxisAngle(Vector3(1.0F, 2.0F, 3.0F), Radians(0.5F)));
+    const auto by(Quaternion::rotateAxisAngle(Vector3(-2.0F, 0.0F, 1.0F), Radians(1.5F)));
+
+    // WHEN:
+    const auto result = angleBetween(from, by.multiply(from));
+
+    // THEN:
+    EXPECT_NEAR(1.5F, result, 1e-4F);
+}
+
+} // namespace eyebeam
@@ -4,8 +4,10 @@
 #include "point3.h"
 #include "ray3.h"
 #include "vector3.h"
+#include "xoshiro128.h"
 
 #include <cmath>
+#include <cstdint>
 #include <random>
 
 namespace eyebeam
@@ -14,19 +16,34 @@ namespace eyebeam
 namespace
 {
 
-auto& getRng()
+constexpr std::uint64_t seed = 0x5EED;
+
+// The distribution keeps the second of each pair of numbers it draws, so it is restarted along with the stream
+struct ThreadGenerator
+{
+    Xoshiro128Plus rng;
+    std::normal_distribution<float> normalDistribution;
+};
+
+auto& getThreadGenerator()
 {
-    static std::random_device s_seedGenerator;
-    static std::mt19937 s_rng(s_seedGenerator());
-    return s_rng;
+    thread_local ThreadGenerator s_generator{Xoshiro128Plus::forStream(seed, 0), {}};
+    return s_generator;
 }
 
 } // namespace
 
+void RandomGenerator::startStream(std::uint64_t stream)
+{
+    auto& generator = getThreadGenerator();
+    generator.rng = Xoshiro128Plus::forStream(seed, stream);
+    generator.normalDistribution.reset();
+}
+
 float RandomGenerator::generateRandomFloat()
 {
-    static std::normal_distribution<float> s_normalDistribution;
-    return s_normalDistribution(getRng());
+    auto& generator = getThreadGenerator();
+    return generator.normalDistribution(generator.rng);
 }
 
 float RandomGenerator::generateRandomPositiveFloat()
@@ -6,12 +6,20 @@
 #include "ray3.h"
 #include "vector3.h"
 
+#include <cstdint>
+
 namespace eyebeam
 {
 
+// Normally distributed numbers from a generator owned by the calling thread. A thread draws from stream 0 until it
+// starts another one, so work spread over threads seeds each item by startStream with the index of the item, never
+// by the thread that happens to run it, and sees the same numbers whatever the number of threads.
 class RandomGenerator
 {
 public:
+    // Restarts the generator of the calling thread at the beginning of stream
+    static void startStream(std::uint64_t stream);
+
     static float generateRandomFloat();
     static float generateRandomPositiveFloat();
     static Vector3 generateRandomVector3();
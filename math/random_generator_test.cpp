@@ -0,0 +1,102 @@
+#include "random_generator.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr size_t itemCount = 16;
+constexpr size_t drawsPerItem = 9;
+
+using ItemDraws = std::array<float, drawsPerItem>;
+
+// Items are taken from a shared counter, so which thread draws for which item depends on scheduling
+std::vector<ItemDraws> drawItems(size_t threadCount)
+{
+    std::vector<ItemDraws> draws(itemCount);
+    std::atomic<size_t> nextItem{0};
+
+    const auto drawRemainingItems = [&] {
+        for (auto item = nextItem++; item < itemCount; item = nextItem++)
+        {
+            RandomGenerator::startStream(item);
+            for (auto& draw : draws[item])
+            {
+                draw = RandomGenerator::generateRandomFloat();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(drawRemainingItems);
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return draws;
+}
+
+// NOLINTNEXTLINE
+TEST(RandomGeneratorTests, itemsDrawTheSameNumbersWhateverTheThreadCount)
+{
+    // GIVEN:
+    const auto expected(drawItems(1));
+
+    for (const size_t threadCount : {2, 3, 8})
+    {
+        // WHEN:
+        const auto draws(drawItems(threadCount));
+
+        // THEN:
+        EXPECT_EQ(expected, draws);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(RandomGeneratorTests, threadsStartAtStreamZero)
+{
+    // GIVEN:
+    RandomGenerator::startStream(0);
+    const auto expected = RandomGenerator::generateRandomFloat();
+
+    // WHEN:
+    auto first = 0.0F;
+    std::thread([&first] { first = RandomGenerator::generateRandomFloat(); }).join();
+
+    // THEN:
+    EXPECT_EQ(expected, first);
+}
+
+// NOLINTNEXTLINE
+TEST(RandomGeneratorTests, restartingAStreamRepeatsItsNumbers)
+{
+    // GIVEN:
+    RandomGenerator::startStream(5);
+    const auto first = RandomGenerator::generateRandomFloat();
+    const auto second = RandomGenerator::generateRandomFloat();
+
+    // WHEN:
+    RandomGenerator::startStream(5);
+
+    // THEN:
+    EXPECT_EQ(first, RandomGenerator::generateRandomFloat());
+    EXPECT_EQ(second, RandomGenerator::generateRandomFloat());
+}
+
+} // namespace
+
+} // namespace eyebeam
@@ -10,7 +10,7 @@ Point3 evaluate(const Ray3& ray, float t) noexcept
 
 bool operator==(const Ray3& lhs, const Ray3& rhs)
 {
-    return lhs.origin() == rhs.origin() && lhs.direction() == rhs.direction();
+    return lhs.origin() == rhs.origin() && lhs.direction() == rhs.direction() && lhs.shutterTime() == rhs.shutterTime();
 }
 
 bool operator!=(const Ray3& lhs, const Ray3& rhs)
@@ -9,12 +9,15 @@
 namespace eyebeam
 {
 
+// A ray cast at shutterTime, which runs from 0 when the shutter opens to 1 when it closes and selects where moving
+// geometry is. Times along the ray itself are parameters of evaluate().
 class Ray3
 {
 public:
-    explicit Ray3(const Point3& origin, const Vector3& direction) noexcept
+    explicit Ray3(const Point3& origin, const Vector3& direction, float shutterTime = 0.0F) noexcept
         : m_origin(origin)
         , m_direction(norm(direction))
+        , m_shutterTime(shutterTime)
     {
     }
 
@@ -28,9 +31,15 @@ public:
         return m_direction;
     }
 
+    [[nodiscard]] auto shutterTime() const noexcept
+    {
+        return m_shutterTime;
+    }
+
 private:
     Point3 m_origin;
     Vector3 m_direction;
+    float m_shutterTime;
 };
 
 Point3 evaluate(const Ray3& ray, float t) noexcept;
@@ -2,10 +2,17 @@
 
 #include "point3.h"
 #include "random_generator.h"
+#include "ray3_packet.h"
+#include "transform.h"
+#include "traversal_ray3.h"
 #include "vector3.h"
 
 #include <benchmark/benchmark.h>
 
+#include <array>
+#include <cstddef>
+#include <vector>
+
 namespace eyebeam
 {
 
@@ -21,6 +28,8 @@ void benchmarkRay3Construction(benchmark::State& state)
     {
         benchmark::DoNotOptimize(Ray3(randomOrigin, randomDirection));
     }
+
+    state.SetItemsProcessed(state.iterations());
 }
 
 void benchmarkRay3Evaluate(benchmark::State& state)
@@ -32,6 +41,155 @@ void benchmarkRay3Evaluate(benchmark::State& state)
     {
         benchmark::DoNotOptimize(evaluate(randomRay, randomT));
     }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void benchmarkRay3Transform(benchmark::State& state)
+{
+    const auto randomRay(RandomGenerator::generateRandomRay3());
+    const auto t(Transform::rotateAxisAngle(
+        RandomGenerator::generateRandomVector3(),
+        Radians(RandomGenerator::generateRandomFloat())));
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(t.multiply(randomRay));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void benchmarkTraversalRay3Construction(benchmark::State& state)
+{
+    const auto randomRay(RandomGenerator::generateRandomRay3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(TraversalRay3(randomRay));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Boxes around the origin, so that random rays hit a fair share of them and neither outcome is always predicted
+auto generateRandomBoxes()
+{
+    constexpr size_t boxCount = 256;
+
+    std::vector<std::array<float, 3>> corners;
+    corners.reserve(2 * boxCount);
+    for (size_t i = 0; i < boxCount; ++i)
+    {
+        const auto corner(RandomGenerator::generateRandomPoint3());
+        const auto size = RandomGenerator::generateRandomPositiveFloat();
+        corners.push_back({corner.x(), corner.y(), corner.z()});
+        corners.push_back({corner.x() + size, corner.y() + size, corner.z() + size});
+    }
+
+    return corners;
+}
+
+// Items are box tests. The traversal ray is rebuilt for every box, as a slab test written against Ray3 would have to
+// divide and branch on the direction each time.
+void benchmarkRay3SlabTestRebuildingTraversalRay(benchmark::State& state)
+{
+    const auto randomRay(RandomGenerator::generateRandomRay3());
+    const auto boxes(generateRandomBoxes());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (size_t i = 0; i < boxes.size(); i += 2)
+        {
+            benchmark::DoNotOptimize(TraversalRay3(randomRay).intersects(boxes[i], boxes[i + 1]));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(boxes.size() / 2));
+}
+
+// The traversal ray is built once and reused for every box, as the BVH traversal does
+void benchmarkTraversalRay3SlabTest(benchmark::State& state)
+{
+    const TraversalRay3 traversalRay(RandomGenerator::generateRandomRay3());
+    const auto boxes(generateRandomBoxes());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (size_t i = 0; i < boxes.size(); i += 2)
+        {
+            benchmark::DoNotOptimize(traversalRay.intersects(boxes[i], boxes[i + 1]));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(boxes.size() / 2));
+}
+
+// The packet benchmarks report items per second as rays per second so they can be compared with the scalar ones
+
+template <size_t Width>
+auto generateRandomRay3Packet()
+{
+    Ray3Packet<Width> packet;
+    for (size_t lane = 0; lane < Width; ++lane)
+    {
+        packet.set(lane, RandomGenerator::generateRandomRay3());
+    }
+
+    return packet;
+}
+
+template <size_t Width>
+void benchmarkRay3PacketConstruction(benchmark::State& state)
+{
+    Point3Packet<Width> randomOrigins;
+    Vector3Packet<Width> randomDirections;
+    for (size_t lane = 0; lane < Width; ++lane)
+    {
+        randomOrigins.set(lane, RandomGenerator::generateRandomPoint3());
+        randomDirections.set(lane, RandomGenerator::generateRandomVector3());
+    }
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(Ray3Packet<Width>(randomOrigins, randomDirections));
+    }
+
+    state.SetItemsProcessed(state.iterations() * Width);
+}
+
+template <size_t Width>
+void benchmarkRay3PacketEvaluate(benchmark::State& state)
+{
+    const auto randomPacket(generateRandomRay3Packet<Width>());
+    AlignedLaneStorage<Width> randomT;
+    for (auto& t : randomT.data)
+    {
+        t = RandomGenerator::generateRandomFloat();
+    }
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(evaluate(randomPacket, randomT));
+    }
+
+    state.SetItemsProcessed(state.iterations() * Width);
+}
+
+template <size_t Width>
+void benchmarkRay3PacketTransform(benchmark::State& state)
+{
+    const auto randomPacket(generateRandomRay3Packet<Width>());
+    const auto t(Transform::rotateAxisAngle(
+        RandomGenerator::generateRandomVector3(),
+        Radians(RandomGenerator::generateRandomFloat())));
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        benchmark::DoNotOptimize(t.multiply(randomPacket));
+    }
+
+    state.SetItemsProcessed(state.iterations() * Width);
 }
 
 // NOLINTNEXTLINE
@@ -40,6 +198,45 @@ BENCHMARK(benchmarkRay3Construction);
 // NOLINTNEXTLINE
 BENCHMARK(benchmarkRay3Evaluate);
 
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkRay3Transform);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTraversalRay3Construction);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkRay3SlabTestRebuildingTraversalRay);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTraversalRay3SlabTest);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkRay3PacketConstruction, 4);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkRay3PacketConstruction, 8);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkRay3PacketConstruction, 16);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkRay3PacketEvaluate, 4);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkRay3PacketEvaluate, 8);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkRay3PacketEvaluate, 16);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkRay3PacketTransform, 4);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkRay3PacketTransform, 8);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkRay3PacketTransform, 16);
+
 } // namespace
 
 } // namespace eyebeam
@@ -0,0 +1 @@
+#include "ray3_packet.h"
@@ -0,0 +1,108 @@
+#ifndef INCLUDED_RAY3_PACKET_H_
+#define INCLUDED_RAY3_PACKET_H_
+
+#include "components_packet.h"
+#include "ray3.h"
+#include "simd_lanes.h"
+
+#include <cstddef>
+
+namespace eyebeam
+{
+
+// Width rays stored as structure of arrays so that a single SIMD operation advances several rays at once. Coherent
+// rays, such as primary rays from the camera, are the intended use. Each ray keeps its own shutter time, since the
+// pixels of a packet sample the shutter interval independently.
+template <size_t Width>
+class Ray3Packet
+{
+public:
+    static_assert(Width == 4 || Width == 8 || Width == 16, "Ray3Packet supports packets of 4, 8 or 16 rays");
+
+    static constexpr size_t width = Width;
+
+    Ray3Packet() = default;
+
+    // Directions are normalized, as they are for Ray3
+    explicit Ray3Packet(
+        const Point3Packet<Width>& origins,
+        const Vector3Packet<Width>& directions,
+        float shutterTime = 0.0F) noexcept
+        : m_origins(origins)
+        , m_directions(norm(directions))
+    {
+        m_shutterTimes.data.fill(shutterTime);
+    }
+
+    Ray3Packet(
+        const Point3Packet<Width>& origins,
+        const Vector3Packet<Width>& directions,
+        const AlignedLaneStorage<Width>& shutterTimes) noexcept
+        : m_origins(origins)
+        , m_directions(norm(directions))
+        , m_shutterTimes(shutterTimes)
+    {
+    }
+
+    [[nodiscard]] const auto& origins() const noexcept
+    {
+        return m_origins;
+    }
+
+    [[nodiscard]] const auto& directions() const noexcept
+    {
+        return m_directions;
+    }
+
+    [[nodiscard]] const auto& shutterTimes() const noexcept
+    {
+        return m_shutterTimes;
+    }
+
+    // Ray3 is already normalized, so no normalization happens here
+    void set(size_t lane, const Ray3& ray) noexcept
+    {
+        m_origins.set(lane, ray.origin());
+        m_directions.set(lane, ray.direction());
+        m_shutterTimes.data[lane] = ray.shutterTime();
+    }
+
+    [[nodiscard]] auto get(size_t lane) const noexcept
+    {
+        return Ray3(m_origins.get(lane), m_directions.get(lane), m_shutterTimes.data[lane]);
+    }
+
+private:
+    Point3Packet<Width> m_origins{};
+    Vector3Packet<Width> m_directions{};
+    AlignedLaneStorage<Width> m_shutterTimes{};
+};
+
+template <size_t Width>
+[[nodiscard]] Point3Packet<Width> evaluate(const Ray3Packet<Width>& rays, const AlignedLaneStorage<Width>& t) noexcept
+{
+    using Lanes = PacketLanes<Width>;
+
+    const auto& origins = rays.origins();
+    const auto& directions = rays.directions();
+
+    Point3Packet<Width> result;
+
+    for (size_t lane = 0; lane < Width; lane += Lanes::width)
+    {
+        const auto laneT = Lanes::load(&t.data[lane]);
+
+        multiplyAdd(laneT, Lanes::load(&directions.x.data[lane]), Lanes::load(&origins.x.data[lane]))
+            .store(&result.x.data[lane]);
+        multiplyAdd(laneT, Lanes::load(&directions.y.data[lane]), Lanes::load(&origins.y.data[lane]))
+            .store(&result.y.data[lane]);
+        multiplyAdd(laneT, Lanes::load(&directions.z.data[lane]), Lanes::load(&origins.z.data[lane]))
+            .store(&result.z.data[lane]);
+    }
+
+    return result;
+}
+
+} // namespace eyebeam
+
+#endif // INCLUDED_RAY3_PACKET_H_
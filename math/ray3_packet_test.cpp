@@ -0,0 +1,146 @@
+#include "ray3_packet.h"
+
+#include "random_generator.h"
+#include "transform.h"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+template <typename T>
+class Ray3PacketTests : public testing::Test
+{
+public:
+    static constexpr size_t width = T::value;
+
+    static auto generateRandomPacket()
+    {
+        Ray3Packet<width> packet;
+        for (size_t lane = 0; lane < width; ++lane)
+        {
+            packet.set(lane, RandomGenerator::generateRandomRay3());
+        }
+
+        return packet;
+    }
+};
+
+using PacketWidths = testing::
+    Types<std::integral_constant<size_t, 4>, std::integral_constant<size_t, 8>, std::integral_constant<size_t, 16>>;
+
+// NOLINTNEXTLINE
+TYPED_TEST_SUITE(Ray3PacketTests, PacketWidths);
+
+// NOLINTNEXTLINE
+TYPED_TEST(Ray3PacketTests, ConstructorNormalizesEveryDirection)
+{
+    // GIVEN:
+    constexpr auto width = TestFixture::width;
+    Point3Packet<width> origins{};
+    Vector3Packet<width> directions{};
+    for (size_t lane = 0; lane < width; ++lane)
+    {
+        directions.set(lane, RandomGenerator::generateRandomVector3());
+    }
+
+    // WHEN:
+    const Ray3Packet<width> packet(origins, directions);
+
+    // THEN:
+    for (size_t lane = 0; lane < width; ++lane)
+    {
+        EXPECT_TRUE(areEqual(1.0F, length(packet.directions().get(lane))));
+        EXPECT_EQ(norm(directions.get(lane)), packet.directions().get(lane));
+    }
+}
+
+// NOLINTNEXTLINE
+TYPED_TEST(Ray3PacketTests, GetReturnsRaySetInLane)
+{
+    // GIVEN:
+    constexpr auto width = TestFixture::width;
+    Ray3Packet<width> packet;
+    const auto ray(RandomGenerator::generateRandomRay3());
+
+    // WHEN:
+    packet.set(width - 1, ray);
+
+    // THEN:
+    EXPECT_EQ(ray, packet.get(width - 1));
+}
+
+// NOLINTNEXTLINE
+TYPED_TEST(Ray3PacketTests, EveryLaneKeepsItsOwnShutterTime)
+{
+    // GIVEN:
+    constexpr auto width = TestFixture::width;
+    Ray3Packet<width> packet;
+    for (size_t lane = 0; lane < width; ++lane)
+    {
+        const auto ray(RandomGenerator::generateRandomRay3());
+        packet.set(lane, Ray3(ray.origin(), ray.direction(), static_cast<float>(lane) / static_cast<float>(width)));
+    }
+
+    // WHEN:
+    const auto result(Transform::translate(RandomGenerator::generateRandomVector3()).multiply(packet));
+
+    // THEN:
+    for (size_t lane = 0; lane < width; ++lane)
+    {
+        EXPECT_EQ(static_cast<float>(lane) / static_cast<float>(width), result.get(lane).shutterTime());
+        EXPECT_EQ(result.shutterTimes().data[lane], result.get(lane).shutterTime());
+    }
+}
+
+// NOLINTNEXTLINE
+TYPED_TEST(Ray3PacketTests, EvaluateMatchesScalarEvaluateInEveryLane)
+{
+    // GIVEN:
+    constexpr auto width = TestFixture::width;
+    const auto packet(TestFixture::generateRandomPacket());
+    AlignedLaneStorage<width> t{};
+    for (auto& laneT : t.data)
+    {
+        laneT = RandomGenerator::generateRandomFloat();
+    }
+
+    // WHEN:
+    const auto result(evaluate(packet, t));
+
+    // THEN:
+    for (size_t lane = 0; lane < width; ++lane)
+    {
+        EXPECT_EQ(evaluate(packet.get(lane), t.data[lane]), result.get(lane));
+    }
+}
+
+// NOLINTNEXTLINE
+TYPED_TEST(Ray3PacketTests, TransformMultiplyMatchesScalarMultiplyInEveryLane)
+{
+    // GIVEN:
+    constexpr auto width = TestFixture::width;
+    const auto packet(TestFixture::generateRandomPacket());
+    const auto t(Transform::translate(RandomGenerator::generateRandomVector3())
+                     .multiply(Transform::rotateAxisAngle(
+                         RandomGenerator::generateRandomVector3(),
+                         Radians(RandomGenerator::generateRandomFloat()))));
+
+    // WHEN:
+    const auto result(t.multiply(packet));
+
+    // THEN:
+    for (size_t lane = 0; lane < width; ++lane)
+    {
+        EXPECT_EQ(t.multiply(packet.get(lane)), result.get(lane));
+    }
+}
+
+} // namespace
+
+} // namespace eyebeam
@@ -0,0 +1,269 @@
+#include "sampler.h"
+
+#include "blue_noise.h"
+#include "sampling.h"
+#include "xoshiro128.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+[[nodiscard]] std::uint64_t hashPair(std::uint64_t first, std::uint64_t second) noexcept
+{
+    std::uint64_t state = first ^ (second * 0xD6E8FEB86659FD93ULL);
+    return splitMix64(state);
+}
+
+[[nodiscard]] std::uint64_t hashPixel(std::uint64_t seed, int x, int y) noexcept
+{
+    const auto pixel = (std::uint64_t{static_cast<std::uint32_t>(y)} << 32U) | static_cast<std::uint32_t>(x);
+    return hashPair(seed, pixel);
+}
+
+[[nodiscard]] float toUnitFloat(std::uint32_t bits) noexcept
+{
+    return static_cast<float>(bits >> 8U) * 0x1.0p-24F;
+}
+
+constexpr std::array<std::uint32_t, HaltonSampler::maxDimension> primes = {
+    2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109,
+    113, 127, 131};
+
+// The number of base digits needed to write any index
+constexpr auto indexDigitCounts = [] {
+    std::array<std::uint32_t, primes.size()> counts{};
+    for (size_t i = 0; i < primes.size(); ++i)
+    {
+        for (auto left = std::numeric_limits<std::uint32_t>::max(); left != 0; left /= primes[i])
+        {
+            ++counts[i];
+        }
+    }
+
+    return counts;
+}();
+
+// The digits of index in base, mirrored around the radix point, with each digit position shifted by its own amount
+// modulo base. The shifts are the same for every index, so the strata of the sequence are only permuted. They are the
+// base digits of the random fraction digitShifts / 2^64, each found by a multiplication rather than a division.
+[[nodiscard]] float shiftedRadicalInverse(size_t primeIndex, std::uint32_t index, std::uint64_t digitShifts) noexcept
+{
+    const auto base = primes[primeIndex];
+    const auto inverseBase = 1.0 / static_cast<double>(base);
+    const auto nextShift = [&] {
+        const auto shift = static_cast<std::uint32_t>(((digitShifts >> 32U) * base) >> 32U);
+        digitShifts *= base;
+        return shift;
+    };
+
+    auto result = 0.0;
+    auto cellSize = 1.0;
+    std::uint32_t position = 0;
+    for (; index != 0; ++position)
+    {
+        const auto digit = index % base;
+        index /= base;
+        cellSize *= inverseBase;
+        result += static_cast<double>((digit + nextShift()) % base) * cellSize;
+    }
+
+    for (; position < indexDigitCounts[primeIndex]; ++position)
+    {
+        cellSize *= inverseBase;
+        result += static_cast<double>(nextShift()) * cellSize;
+    }
+
+    // Below the digits any index can have, the shifted zeros add up to a uniform offset within the cell
+    const auto offset = static_cast<double>(digitShifts >> 11U) * 0x1.0p-53;
+    return std::min(static_cast<float>(result + offset * cellSize), oneBelowOne);
+}
+
+[[nodiscard]] constexpr std::uint32_t reverseBits(std::uint32_t bits) noexcept
+{
+    bits = (bits << 16U) | (bits >> 16U);
+    bits = ((bits & 0x00FF00FFU) << 8U) | ((bits & 0xFF00FF00U) >> 8U);
+    bits = ((bits & 0x0F0F0F0FU) << 4U) | ((bits & 0xF0F0F0F0U) >> 4U);
+    bits = ((bits & 0x33333333U) << 2U) | ((bits & 0xCCCCCCCCU) >> 2U);
+    return ((bits & 0x55555555U) << 1U) | ((bits & 0xAAAAAAAAU) >> 1U);
+}
+
+// Burley's hash based approximation of Owen scrambling: each bit is flipped by a random function of the bits above
+// it, which permutes every elementary interval and so keeps the stratification of the points
+[[nodiscard]] constexpr std::uint32_t owenScramble(std::uint32_t bits, std::uint32_t seed) noexcept
+{
+    bits = reverseBits(bits);
+    bits ^= bits * 0x3D20ADEAU;
+    bits += seed;
+    bits *= (seed >> 16U) | 1U;
+    bits ^= bits * 0x05526C56U;
+    bits ^= bits * 0x53A22864U;
+    return reverseBits(bits);
+}
+
+constexpr auto sobolMatrix1 = [] {
+    std::array<std::uint32_t, 32> matrix{};
+    matrix[0] = 0x80000000U;
+    for (size_t i = 1; i < matrix.size(); ++i)
+    {
+        matrix[i] = matrix[i - 1] ^ (matrix[i - 1] >> 1U);
+    }
+
+    return matrix;
+}();
+
+[[nodiscard]] constexpr std::uint32_t sobolDimension0(std::uint32_t index) noexcept
+{
+    return reverseBits(index);
+}
+
+[[nodiscard]] constexpr std::uint32_t sobolDimension1(std::uint32_t index) noexcept
+{
+    std::uint32_t result = 0;
+    for (size_t i = 0; index != 0; index >>= 1U, ++i)
+    {
+        // Scrambled indices have random high bits, so a branch here would be mispredicted half the time
+        result ^= sobolMatrix1[i] & (0U - (index & 1U));
+    }
+
+    return result;
+}
+
+// Irrational steps make successive samples of a blue noise texel fill [0, 1) evenly. The golden ratio is the best
+// step in one dimension, and the inverse powers of the plastic number, as in Roberts' R2 sequence, in two.
+constexpr auto goldenRatioConjugate = 0.61803398874989484820;
+constexpr auto inversePlasticNumber = 0.75487766624669276005;
+constexpr auto inversePlasticNumberSquared = 0.56984029099805326591;
+
+[[nodiscard]] float rotate(float value, double step, std::uint32_t sampleIndex) noexcept
+{
+    const auto rotated = value + step * sampleIndex;
+    return std::min(static_cast<float>(rotated - std::floor(rotated)), oneBelowOne);
+}
+
+} // namespace
+
+std::optional<SamplerType> samplerTypeFromName(std::string_view name) noexcept
+{
+    if (name == "independent")
+    {
+        return SamplerType::Independent;
+    }
+
+    if (name == "halton")
+    {
+        return SamplerType::Halton;
+    }
+
+    if (name == "sobol")
+    {
+        return SamplerType::Sobol;
+    }
+
+    if (name == "bluenoise")
+    {
+        return SamplerType::BlueNoise;
+    }
+
+    return std::nullopt;
+}
+
+TypedSampler<SamplerType::Independent>::TypedSampler(std::uint64_t seed) noexcept : m_seed(seed), m_generator(seed)
+{
+}
+
+void TypedSampler<SamplerType::Independent>::startPixelSample(int x, int y, std::uint32_t sampleIndex) noexcept
+{
+    m_generator = Xoshiro128Plus::forStream(hashPixel(m_seed, x, y), sampleIndex);
+}
+
+TypedSampler<SamplerType::Halton>::TypedSampler(std::uint64_t seed) noexcept : m_seed(seed)
+{
+}
+
+void TypedSampler<SamplerType::Halton>::startPixelSample(int x, int y, std::uint32_t sampleIndex) noexcept
+{
+    m_pixelSeed = hashPixel(m_seed, x, y);
+    m_sampleIndex = sampleIndex;
+    m_dimension = 0;
+}
+
+float TypedSampler<SamplerType::Halton>::get1D() noexcept
+{
+    const auto dimension = m_dimension++;
+    return shiftedRadicalInverse(dimension % primes.size(), m_sampleIndex, hashPair(m_pixelSeed, dimension));
+}
+
+TypedSampler<SamplerType::Sobol>::TypedSampler(std::uint64_t seed) noexcept : m_seed(seed)
+{
+}
+
+void TypedSampler<SamplerType::Sobol>::startPixelSample(int x, int y, std::uint32_t sampleIndex) noexcept
+{
+    m_pixelSeed = hashPixel(m_seed, x, y);
+    m_sampleIndex = sampleIndex;
+    m_dimension = 0;
+}
+
+float TypedSampler<SamplerType::Sobol>::get1D() noexcept
+{
+    const auto hash = hashPair(m_pixelSeed, m_dimension++);
+    const auto index = owenScramble(m_sampleIndex, static_cast<std::uint32_t>(hash));
+    return toUnitFloat(owenScramble(sobolDimension0(index), static_cast<std::uint32_t>(hash >> 32U)));
+}
+
+Sample2 TypedSampler<SamplerType::Sobol>::get2D() noexcept
+{
+    const auto hash = hashPair(m_pixelSeed, m_dimension++);
+    const auto index = owenScramble(m_sampleIndex, static_cast<std::uint32_t>(hash));
+    const auto scrambleSeeds = hashPair(hash, 0);
+    return Sample2{
+        toUnitFloat(owenScramble(sobolDimension0(index), static_cast<std::uint32_t>(scrambleSeeds))),
+        toUnitFloat(owenScramble(sobolDimension1(index), static_cast<std::uint32_t>(scrambleSeeds >> 32U)))};
+}
+
+TypedSampler<SamplerType::BlueNoise>::TypedSampler(std::uint64_t seed) noexcept : m_seed(seed)
+{
+}
+
+void TypedSampler<SamplerType::BlueNoise>::startPixelSample(int x, int y, std::uint32_t sampleIndex) noexcept
+{
+    m_x = x;
+    m_y = y;
+    m_sampleIndex = sampleIndex;
+    m_dimension = 0;
+}
+
+float TypedSampler<SamplerType::BlueNoise>::get1D() noexcept
+{
+    return rotate(nextTexel(), goldenRatioConjugate, m_sampleIndex);
+}
+
+Sample2 TypedSampler<SamplerType::BlueNoise>::get2D() noexcept
+{
+    const auto x = nextTexel();
+    const auto y = nextTexel();
+    return Sample2{
+        rotate(x, inversePlasticNumber, m_sampleIndex),
+        rotate(y, inversePlasticNumberSquared, m_sampleIndex)};
+}
+
+float TypedSampler<SamplerType::BlueNoise>::nextTexel() noexcept
+{
+    const auto offset = hashPair(m_seed, m_dimension++);
+    const auto texelX = static_cast<size_t>(static_cast<std::uint32_t>(m_x)) + static_cast<size_t>(offset & 0xFFFFU);
+    const auto texelY = static_cast<size_t>(static_cast<std::uint32_t>(m_y)) + static_cast<size_t>(offset >> 48U);
+    return blueNoiseValue(texelX, texelY);
+}
+
+} // namespace eyebeam
@@ -0,0 +1,138 @@
+#ifndef INCLUDED_SAMPLER_H_
+#define INCLUDED_SAMPLER_H_
+
+#include "sampling.h"
+#include "xoshiro128.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace eyebeam
+{
+
+enum class SamplerType
+{
+    Independent,
+    Halton,
+    Sobol,
+    BlueNoise
+};
+
+// The sampler named independent, halton, sobol or bluenoise
+[[nodiscard]] std::optional<SamplerType> samplerTypeFromName(std::string_view name) noexcept;
+
+// Every TypedSampler has the same interface, so code written against one can be instantiated with any other.
+// startPixelSample selects sample sampleIndex of pixel (x, y), after which get1D and get2D return its dimensions in
+// turn. The sequence of a pixel depends only on the seed, the pixel and the sample index, so renders are reproducible
+// however their pixels are spread over threads.
+template <SamplerType Type>
+class TypedSampler;
+
+// Uniform random numbers, the baseline the other samplers are measured against
+template <>
+class TypedSampler<SamplerType::Independent>
+{
+public:
+    explicit TypedSampler(std::uint64_t seed = 0) noexcept;
+
+    void startPixelSample(int x, int y, std::uint32_t sampleIndex) noexcept;
+
+    [[nodiscard]] float get1D() noexcept
+    {
+        return m_generator.nextFloat();
+    }
+
+    [[nodiscard]] Sample2 get2D() noexcept
+    {
+        const auto x = m_generator.nextFloat();
+        return Sample2{x, m_generator.nextFloat()};
+    }
+
+private:
+    std::uint64_t m_seed;
+    Xoshiro128Plus m_generator;
+};
+
+// The Halton sequence, whose dimension d is the radical inverse of the sample index in the d-th prime. Each pixel
+// shifts the digits of every dimension by its own random amounts, which keeps the stratification of the sequence.
+template <>
+class TypedSampler<SamplerType::Halton>
+{
+public:
+    // Dimensions beyond this many reuse the primes with fresh digit shifts
+    static constexpr size_t maxDimension = 32;
+
+    explicit TypedSampler(std::uint64_t seed = 0) noexcept;
+
+    void startPixelSample(int x, int y, std::uint32_t sampleIndex) noexcept;
+
+    [[nodiscard]] float get1D() noexcept;
+
+    [[nodiscard]] Sample2 get2D() noexcept
+    {
+        const auto x = get1D();
+        return Sample2{x, get1D()};
+    }
+
+private:
+    std::uint64_t m_seed;
+    std::uint64_t m_pixelSeed = 0;
+    std::uint32_t m_sampleIndex = 0;
+    std::uint32_t m_dimension = 0;
+};
+
+// The first two dimensions of the Sobol sequence, a (0, 2) sequence, with Owen scrambling and a shuffled sample order
+// that both differ per pixel and per pair of dimensions. Any power of two count of samples of a pixel is stratified
+// in every pair of dimensions returned by get2D.
+template <>
+class TypedSampler<SamplerType::Sobol>
+{
+public:
+    explicit TypedSampler(std::uint64_t seed = 0) noexcept;
+
+    void startPixelSample(int x, int y, std::uint32_t sampleIndex) noexcept;
+
+    [[nodiscard]] float get1D() noexcept;
+    [[nodiscard]] Sample2 get2D() noexcept;
+
+private:
+    std::uint64_t m_seed;
+    std::uint64_t m_pixelSeed = 0;
+    std::uint32_t m_sampleIndex = 0;
+    std::uint32_t m_dimension = 0;
+};
+
+// Looks each dimension up in a tiled blue noise texture, offset per dimension, so that the error of neighbouring
+// pixels is uncorrelated and reads as fine grain instead of blotches. Successive samples rotate the texels by
+// irrational steps, which spreads the samples of a pixel evenly for any count.
+template <>
+class TypedSampler<SamplerType::BlueNoise>
+{
+public:
+    explicit TypedSampler(std::uint64_t seed = 0) noexcept;
+
+    void startPixelSample(int x, int y, std::uint32_t sampleIndex) noexcept;
+
+    [[nodiscard]] float get1D() noexcept;
+    [[nodiscard]] Sample2 get2D() noexcept;
+
+private:
+    [[nodiscard]] float nextTexel() noexcept;
+
+    std::uint64_t m_seed;
+    int m_x = 0;
+    int m_y = 0;
+    std::uint32_t m_sampleIndex = 0;
+    std::uint32_t m_dimension = 0;
+};
+
+using IndependentSampler = TypedSampler<SamplerType::Independent>;
+using HaltonSampler = TypedSampler<SamplerType::Halton>;
+using SobolSampler = TypedSampler<SamplerType::Sobol>;
+using BlueNoiseSampler = TypedSampler<SamplerType::BlueNoise>;
+
+} // namespace eyebeam
+
+#endif // INCLUDED_SAMPLER_H_
@@ -0,0 +1,72 @@
+#include "sampler.h"
+
+#include "angle.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr int pixelsPerSide = 32;
+
+// An edge crossing the pixel, like the silhouette of an object: the part of the pixel inside a circle around one corner
+constexpr auto radiusSquared = 0.8F;
+constexpr auto coveredArea = constants::pi * radiusSquared / 4.0F;
+
+// Integrates the covered area of every pixel with state.range(0) samples and reports the root mean square error over
+// the pixels next to the time taken
+template <SamplerType Type>
+void benchmarkSamplerConvergence(benchmark::State& state)
+{
+    const auto sampleCount = static_cast<std::uint32_t>(state.range(0));
+    TypedSampler<Type> sampler(1);
+
+    auto squaredError = 0.0;
+    for ([[maybe_unused]] auto s : state)
+    {
+        squaredError = 0.0;
+        for (int y = 0; y < pixelsPerSide; ++y)
+        {
+            for (int x = 0; x < pixelsPerSide; ++x)
+            {
+                std::uint32_t covered = 0;
+                for (std::uint32_t index = 0; index < sampleCount; ++index)
+                {
+                    sampler.startPixelSample(x, y, index);
+                    const auto sample = sampler.get2D();
+                    covered += sample.x * sample.x + sample.y * sample.y < radiusSquared ? 1 : 0;
+                }
+
+                const auto error = static_cast<double>(covered) / sampleCount - coveredArea;
+                squaredError += error * error;
+            }
+        }
+
+        benchmark::DoNotOptimize(squaredError);
+    }
+
+    state.counters["rmse"] = std::sqrt(squaredError / (pixelsPerSide * pixelsPerSide));
+    state.SetItemsProcessed(state.iterations() * pixelsPerSide * pixelsPerSide * sampleCount);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkSamplerConvergence, SamplerType::Independent)->RangeMultiplier(4)->Range(1, 1024);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkSamplerConvergence, SamplerType::Halton)->RangeMultiplier(4)->Range(1, 1024);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkSamplerConvergence, SamplerType::Sobol)->RangeMultiplier(4)->Range(1, 1024);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkSamplerConvergence, SamplerType::BlueNoise)->RangeMultiplier(4)->Range(1, 1024);
+
+} // namespace
+
+} // namespace eyebeam
@@ -0,0 +1,236 @@
+#include "sampler.h"
+
+#include "blue_noise.h"
+#include "sampling.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+template <typename T>
+class SamplerTests : public testing::Test
+{
+};
+
+using SamplerTypes = testing::Types<IndependentSampler, HaltonSampler, SobolSampler, BlueNoiseSampler>;
+
+// NOLINTNEXTLINE
+TYPED_TEST_SUITE(SamplerTests, SamplerTypes);
+
+// NOLINTNEXTLINE
+TYPED_TEST(SamplerTests, everyDimensionIsInUnitInterval)
+{
+    // GIVEN:
+    TypeParam sampler(3);
+
+    for (std::uint32_t index = 0; index < 256; ++index)
+    {
+        // WHEN:
+        sampler.startPixelSample(5, 7, index);
+        const auto first = sampler.get1D();
+        const auto second = sampler.get2D();
+
+        // THEN:
+        for (const auto value : {first, second.x, second.y})
+        {
+            EXPECT_GE(value, 0.0F);
+            EXPECT_LT(value, 1.0F);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TYPED_TEST(SamplerTests, samplesDependOnlyOnSeedPixelAndIndex)
+{
+    // GIVEN:
+    TypeParam sampler(3);
+    TypeParam other(3);
+    other.startPixelSample(100, 200, 9);
+    [[maybe_unused]] const auto unrelated = other.get2D();
+
+    // WHEN:
+    sampler.startPixelSample(1, 2, 4);
+    const auto expected = sampler.get2D();
+    other.startPixelSample(1, 2, 4);
+    const auto repeated = other.get2D();
+
+    // THEN:
+    EXPECT_EQ(repeated.x, expected.x);
+    EXPECT_EQ(repeated.y, expected.y);
+}
+
+// NOLINTNEXTLINE
+TYPED_TEST(SamplerTests, neighbouringPixelsGetDifferentSamples)
+{
+    // GIVEN:
+    TypeParam sampler(3);
+
+    // WHEN:
+    sampler.startPixelSample(10, 10, 0);
+    const auto left = sampler.get2D();
+    sampler.startPixelSample(11, 10, 0);
+    const auto right = sampler.get2D();
+
+    // THEN:
+    EXPECT_TRUE(left.x != right.x || left.y != right.y);
+}
+
+// NOLINTNEXTLINE
+TYPED_TEST(SamplerTests, meanOfManySamplesIsOneHalf)
+{
+    // GIVEN:
+    TypeParam sampler(3);
+    constexpr std::uint32_t sampleCount = 4096;
+
+    // WHEN:
+    auto sum = 0.0;
+    for (std::uint32_t index = 0; index < sampleCount; ++index)
+    {
+        sampler.startPixelSample(0, 0, index);
+        sum += sampler.get1D();
+    }
+
+    // THEN:
+    EXPECT_NEAR(sum / sampleCount, 0.5, 0.02);
+}
+
+// Counts the samples in each cell of a columns by rows grid
+std::vector<int> countPerCell(const std::vector<Sample2>& samples, size_t columns, size_t rows)
+{
+    std::vector<int> counts(columns * rows, 0);
+    for (const auto& sample : samples)
+    {
+        const auto column = static_cast<size_t>(sample.x * static_cast<float>(columns));
+        const auto row = static_cast<size_t>(sample.y * static_cast<float>(rows));
+        ++counts[row * columns + column];
+    }
+
+    return counts;
+}
+
+// NOLINTNEXTLINE
+TEST(SamplerTypeTests, samplersAreFoundByName)
+{
+    // GIVEN:
+    // WHEN:
+    // THEN:
+    EXPECT_EQ(SamplerType::Independent, samplerTypeFromName("independent"));
+    EXPECT_EQ(SamplerType::Halton, samplerTypeFromName("halton"));
+    EXPECT_EQ(SamplerType::Sobol, samplerTypeFromName("sobol"));
+    EXPECT_EQ(SamplerType::BlueNoise, samplerTypeFromName("bluenoise"));
+    EXPECT_FALSE(samplerTypeFromName("stratified").has_value());
+}
+
+// NOLINTNEXTLINE
+TEST(SobolSamplerTests, powerOfTwoSampleCountsFillEveryElementaryInterval)
+{
+    // GIVEN:
+    SobolSampler sampler(7);
+    constexpr size_t log2SampleCount = 6;
+    constexpr size_t sampleCount = size_t{1} << log2SampleCount;
+
+    for (size_t dimension = 0; dimension < 3; ++dimension)
+    {
+        // WHEN:
+        std::vector<Sample2> samples;
+        for (std::uint32_t index = 0; index < sampleCount; ++index)
+        {
+            sampler.startPixelSample(12, 34, index);
+            for (size_t skipped = 0; skipped < dimension; ++skipped)
+            {
+                [[maybe_unused]] const auto earlier = sampler.get2D();
+            }
+
+            samples.push_back(sampler.get2D());
+        }
+
+        // THEN:
+        for (size_t log2Columns = 0; log2Columns <= log2SampleCount; ++log2Columns)
+        {
+            const auto counts(countPerCell(samples, size_t{1} << log2Columns, sampleCount >> log2Columns));
+            EXPECT_TRUE(std::all_of(counts.begin(), counts.end(), [](int count) { return count == 1; }));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(HaltonSamplerTests, firstSamplesFillEveryCellOfTheirMixedRadixGrid)
+{
+    // GIVEN:
+    HaltonSampler sampler(7);
+    constexpr size_t columns = 4;
+    constexpr size_t rows = 9;
+
+    // WHEN:
+    std::vector<Sample2> samples;
+    for (std::uint32_t index = 0; index < columns * rows; ++index)
+    {
+        sampler.startPixelSample(12, 34, index);
+        samples.push_back(sampler.get2D());
+    }
+
+    // THEN:
+    const auto counts(countPerCell(samples, columns, rows));
+    EXPECT_TRUE(std::all_of(counts.begin(), counts.end(), [](int count) { return count == 1; }));
+}
+
+// NOLINTNEXTLINE
+TEST(BlueNoiseTests, tileRanksEveryTexelOnce)
+{
+    // WHEN:
+    auto ranks(blueNoiseTile());
+
+    // THEN:
+    std::sort(ranks.begin(), ranks.end());
+    for (size_t i = 0; i < ranks.size(); ++i)
+    {
+        EXPECT_EQ(ranks[i], i);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(BlueNoiseTests, texelsBelowAnyThresholdAreSpreadEvenly)
+{
+    // GIVEN:
+    const auto& tile = blueNoiseTile();
+    constexpr size_t blockSize = 16;
+    constexpr size_t blocksPerSide = blueNoiseTileSize / blockSize;
+
+    for (const auto fraction : {0.1F, 0.5F, 0.9F})
+    {
+        // WHEN:
+        const auto threshold = static_cast<size_t>(fraction * static_cast<float>(tile.size()));
+        std::vector<size_t> counts(blocksPerSide * blocksPerSide, 0);
+        for (size_t y = 0; y < blueNoiseTileSize; ++y)
+        {
+            for (size_t x = 0; x < blueNoiseTileSize; ++x)
+            {
+                if (tile[y * blueNoiseTileSize + x] < threshold)
+                {
+                    ++counts[(y / blockSize) * blocksPerSide + x / blockSize];
+                }
+            }
+        }
+
+        // THEN:
+        // White noise would stray by about ten texels at the middle threshold
+        const auto expected = fraction * static_cast<float>(blockSize * blockSize);
+        for (const auto count : counts)
+        {
+            EXPECT_NEAR(static_cast<float>(count), expected, 4.0F);
+        }
+    }
+}
+
+} // namespace
+
+} // namespace eyebeam
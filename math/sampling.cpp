@@ -0,0 +1,44 @@
+#include "sampling.h"
+
+#include "angle.h"
+#include "vector3.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace eyebeam
+{
+
+Sample2 sampleUnitDisk(float u, float v) noexcept
+{
+    const auto a = 2.0F * u - 1.0F;
+    const auto b = 2.0F * v - 1.0F;
+    if (a == 0.0F && b == 0.0F)
+    {
+        return Sample2{0.0F, 0.0F};
+    }
+
+    constexpr auto quarterPi = constants::pi / 4.0F;
+    if (std::abs(a) > std::abs(b))
+    {
+        const auto theta = quarterPi * (b / a);
+        return Sample2{a * std::cos(theta), a * std::sin(theta)};
+    }
+
+    const auto theta = 2.0F * quarterPi - quarterPi * (a / b);
+    return Sample2{b * std::cos(theta), b * std::sin(theta)};
+}
+
+Vector3 sampleCosineHemisphere(float u, float v) noexcept
+{
+    const auto disk = sampleUnitDisk(u, v);
+    const auto z = std::sqrt(std::max(0.0F, 1.0F - disk.x * disk.x - disk.y * disk.y));
+    return Vector3(disk.x, disk.y, z);
+}
+
+float cosineHemispherePdf(float cosTheta) noexcept
+{
+    return cosTheta / constants::pi;
+}
+
+} // namespace eyebeam
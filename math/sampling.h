@@ -0,0 +1,57 @@
+#ifndef INCLUDED_SAMPLING_H_
+#define INCLUDED_SAMPLING_H_
+
+#include "vector3.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace eyebeam
+{
+
+// Maps pairs of uniform numbers in [0, 1) onto the shapes the renderer samples. Each mapping is continuous and keeps
+// areas in proportion, so stratified or low discrepancy inputs stay well spread after mapping.
+
+struct Sample2
+{
+    float x;
+    float y;
+};
+
+// Shirley and Chiu's concentric mapping of the unit square onto the unit disk
+[[nodiscard]] Sample2 sampleUnitDisk(float u, float v) noexcept;
+
+// A direction around +z with density cos(theta) / pi, found by lifting a point on the unit disk onto the hemisphere
+[[nodiscard]] Vector3 sampleCosineHemisphere(float u, float v) noexcept;
+
+[[nodiscard]] float cosineHemispherePdf(float cosTheta) noexcept;
+
+// The largest float below one
+constexpr auto oneBelowOne = 0x1.fffffep-1F;
+
+// samplesPerAxis squared offsets in [0, 1) x [0, 1), one jittered sample in each cell of a regular grid
+template <typename Generator>
+[[nodiscard]] std::vector<Sample2> stratifiedPixelOffsets(size_t samplesPerAxis, Generator& generator)
+{
+    const auto cellSize = 1.0F / static_cast<float>(samplesPerAxis);
+
+    std::vector<Sample2> offsets;
+    offsets.reserve(samplesPerAxis * samplesPerAxis);
+    for (size_t y = 0; y < samplesPerAxis; ++y)
+    {
+        for (size_t x = 0; x < samplesPerAxis; ++x)
+        {
+            // Rounding may carry a sample onto the far edge of the pixel, which belongs to its neighbour
+            const auto offsetX = std::min((static_cast<float>(x) + generator.nextFloat()) * cellSize, oneBelowOne);
+            const auto offsetY = std::min((static_cast<float>(y) + generator.nextFloat()) * cellSize, oneBelowOne);
+            offsets.push_back(Sample2{offsetX, offsetY});
+        }
+    }
+
+    return offsets;
+}
+
+} // namespace eyebeam
+
+#endif // INCLUDED_SAMPLING_H_
@@ -0,0 +1,114 @@
+#include "sampling.h"
+
+#include "angle.h"
+#include "vector3.h"
+#include "xoshiro128.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// NOLINTNEXTLINE
+TEST(SamplingTests, unitDiskSamplesStayInsideDisk)
+{
+    // GIVEN:
+    auto generator = Xoshiro128Plus::forStream(11, 0);
+
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        // WHEN:
+        const auto sample = sampleUnitDisk(generator.nextFloat(), generator.nextFloat());
+
+        // THEN:
+        EXPECT_LE(sample.x * sample.x + sample.y * sample.y, 1.0F + 1.0e-6F);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(SamplingTests, unitDiskMapsSquareCenterAndEdgesOntoDiskCenterAndRim)
+{
+    // WHEN:
+    const auto center = sampleUnitDisk(0.5F, 0.5F);
+    const auto right = sampleUnitDisk(1.0F, 0.5F);
+    const auto top = sampleUnitDisk(0.5F, 1.0F);
+
+    // THEN:
+    EXPECT_EQ(center.x, 0.0F);
+    EXPECT_EQ(center.y, 0.0F);
+    EXPECT_NEAR(right.x, 1.0F, 1.0e-6F);
+    EXPECT_NEAR(right.y, 0.0F, 1.0e-6F);
+    EXPECT_NEAR(top.x, 0.0F, 1.0e-6F);
+    EXPECT_NEAR(top.y, 1.0F, 1.0e-6F);
+}
+
+// NOLINTNEXTLINE
+TEST(SamplingTests, cosineHemisphereSamplesAreUnitDirectionsAboveHorizon)
+{
+    // GIVEN:
+    auto generator = Xoshiro128Plus::forStream(12, 0);
+    constexpr size_t count = 100000;
+
+    // WHEN:
+    auto sumCosTheta = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto direction = sampleCosineHemisphere(generator.nextFloat(), generator.nextFloat());
+
+        // THEN:
+        ASSERT_GE(direction.z(), 0.0F);
+        EXPECT_NEAR(length(direction), 1.0F, 1.0e-5F);
+        sumCosTheta += direction.z();
+    }
+
+    // The mean of cos(theta) under a cos(theta) / pi density is 2 / 3
+    EXPECT_NEAR(sumCosTheta / count, 2.0 / 3.0, 0.01);
+}
+
+// NOLINTNEXTLINE
+TEST(SamplingTests, cosineHemispherePdfFallsFromOneOverPiToZeroAtHorizon)
+{
+    // WHEN/THEN:
+    EXPECT_NEAR(cosineHemispherePdf(1.0F), 1.0F / constants::pi, 1.0e-6F);
+    EXPECT_EQ(cosineHemispherePdf(0.0F), 0.0F);
+}
+
+// NOLINTNEXTLINE
+TEST(SamplingTests, stratifiedOffsetsPlaceOneSampleInEachCell)
+{
+    // GIVEN:
+    auto generator = Xoshiro128Plus::forStream(13, 0);
+    constexpr size_t samplesPerAxis = 4;
+
+    // WHEN:
+    const auto offsets(stratifiedPixelOffsets(samplesPerAxis, generator));
+
+    // THEN:
+    ASSERT_EQ(offsets.size(), samplesPerAxis * samplesPerAxis);
+    std::vector<int> cells(offsets.size(), 0);
+    for (const auto& offset : offsets)
+    {
+        ASSERT_GE(offset.x, 0.0F);
+        ASSERT_LT(offset.x, 1.0F);
+        ASSERT_GE(offset.y, 0.0F);
+        ASSERT_LT(offset.y, 1.0F);
+        const auto cellX = static_cast<size_t>(offset.x * samplesPerAxis);
+        const auto cellY = static_cast<size_t>(offset.y * samplesPerAxis);
+        ++cells[cellY * samplesPerAxis + cellX];
+    }
+
+    for (const auto count : cells)
+    {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+} // namespace
+
+} // namespace eyebeam
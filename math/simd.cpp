@@ -0,0 +1 @@
+#include "simd.h"
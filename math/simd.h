@@ -0,0 +1,25 @@
+#ifndef INCLUDED_SIMD_H_
+#define INCLUDED_SIMD_H_
+
+// Selects the SIMD code path at compile time. Defining EYEBEAM_SIMD_DISABLED forces the scalar fallback, otherwise
+// SSE is used whenever the target supports it and AVX whenever the compiler has been told the target supports it.
+
+#if !defined(EYEBEAM_SIMD_DISABLED)
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EYEBEAM_SIMD_SSE 1
+#endif
+
+#if defined(EYEBEAM_SIMD_SSE) && defined(__AVX__)
+#define EYEBEAM_SIMD_AVX 1
+#endif
+
+#endif
+
+#if defined(EYEBEAM_SIMD_AVX)
+#include <immintrin.h>
+#elif defined(EYEBEAM_SIMD_SSE)
+#include <emmintrin.h>
+#endif
+
+#endif // INCLUDED_SIMD_H_
@@ -0,0 +1 @@
+#include "simd_lanes.h"
@@ -0,0 +1,589 @@
+#ifndef INCLUDED_SIMD_LANES_H_
+#define INCLUDED_SIMD_LANES_H_
+
+#include "simd.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace eyebeam
+{
+
+// Storage for one float per lane of a packet, aligned so that every native register sized chunk can be loaded with
+// an aligned load
+template <size_t Width>
+struct alignas(Width * sizeof(float)) AlignedLaneStorage
+{
+    std::array<float, Width> data;
+};
+
+// FloatLanes<Width> wraps a native register holding Width floats, and MaskLanes<Width> holds the per lane result of
+// comparing two of them. Only the widths supported by the target are defined; PacketLanes<Width> picks the widest one
+// that evenly divides a packet. FloatLanes::generate(laneValue) builds lanes from laneValue(i) in registers, avoiding
+// the stall of loading a register from scalars just stored to memory.
+
+template <size_t Width>
+class FloatLanes;
+
+template <size_t Width>
+class MaskLanes;
+
+template <>
+class MaskLanes<1>
+{
+public:
+    explicit constexpr MaskLanes(bool value) noexcept : m_value(value)
+    {
+    }
+
+    [[nodiscard]] constexpr auto native() const noexcept
+    {
+        return m_value;
+    }
+
+    [[nodiscard]] constexpr int bits() const noexcept
+    {
+        return m_value ? 1 : 0;
+    }
+
+    friend constexpr auto operator&(MaskLanes left, MaskLanes right) noexcept
+    {
+        return MaskLanes(left.m_value && right.m_value);
+    }
+
+    friend constexpr auto operator|(MaskLanes left, MaskLanes right) noexcept
+    {
+        return MaskLanes(left.m_value || right.m_value);
+    }
+
+    friend constexpr auto operator!(MaskLanes operand) noexcept
+    {
+        return MaskLanes(!operand.m_value);
+    }
+
+private:
+    bool m_value;
+};
+
+template <>
+class FloatLanes<1>
+{
+public:
+    static constexpr size_t width = 1;
+
+    constexpr FloatLanes() noexcept : FloatLanes(0.0F)
+    {
+    }
+
+    explicit constexpr FloatLanes(float value) noexcept : m_value(value)
+    {
+    }
+
+    [[nodiscard]] static auto load(const float* source) noexcept
+    {
+        return FloatLanes(*source);
+    }
+
+    [[nodiscard]] static auto loadUnaligned(const float* source) noexcept
+    {
+        return FloatLanes(*source);
+    }
+
+    template <typename LaneValue>
+    [[nodiscard]] static auto generate(LaneValue&& laneValue) noexcept
+    {
+        return FloatLanes(laneValue(size_t{0}));
+    }
+
+    void store(float* destination) const noexcept
+    {
+        *destination = m_value;
+    }
+
+    void storeUnaligned(float* destination) const noexcept
+    {
+        *destination = m_value;
+    }
+
+    [[nodiscard]] constexpr auto native() const noexcept
+    {
+        return m_value;
+    }
+
+    friend constexpr auto operator+(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(left.m_value + right.m_value);
+    }
+
+    friend constexpr auto operator-(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(left.m_value - right.m_value);
+    }
+
+    friend constexpr auto operator*(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(left.m_value * right.m_value);
+    }
+
+    friend constexpr auto operator/(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(left.m_value / right.m_value);
+    }
+
+    friend constexpr auto operator-(FloatLanes operand) noexcept
+    {
+        return FloatLanes(-operand.m_value);
+    }
+
+    friend constexpr auto operator==(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<1>(left.m_value == right.m_value);
+    }
+
+    friend constexpr auto operator<(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<1>(left.m_value < right.m_value);
+    }
+
+    friend constexpr auto operator<=(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<1>(left.m_value <= right.m_value);
+    }
+
+    friend constexpr auto operator>(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<1>(left.m_value > right.m_value);
+    }
+
+    friend constexpr auto operator>=(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<1>(left.m_value >= right.m_value);
+    }
+
+    friend auto multiplyAdd(FloatLanes left, FloatLanes right, FloatLanes addend) noexcept
+    {
+        return FloatLanes(left.m_value * right.m_value + addend.m_value);
+    }
+
+    friend auto sqrt(FloatLanes operand) noexcept
+    {
+        return FloatLanes(std::sqrt(operand.m_value));
+    }
+
+    friend auto abs(FloatLanes operand) noexcept
+    {
+        return FloatLanes(std::abs(operand.m_value));
+    }
+
+    friend constexpr auto min(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(left.m_value < right.m_value ? left.m_value : right.m_value);
+    }
+
+    friend constexpr auto max(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(left.m_value > right.m_value ? left.m_value : right.m_value);
+    }
+
+    friend constexpr auto select(MaskLanes<1> mask, FloatLanes ifTrue, FloatLanes ifFalse) noexcept
+    {
+        return mask.native() ? ifTrue : ifFalse;
+    }
+
+private:
+    float m_value;
+};
+
+#if defined(EYEBEAM_SIMD_SSE)
+
+template <>
+class MaskLanes<4>
+{
+public:
+    explicit MaskLanes(__m128 value) noexcept : m_value(value)
+    {
+    }
+
+    [[nodiscard]] auto native() const noexcept
+    {
+        return m_value;
+    }
+
+    [[nodiscard]] int bits() const noexcept
+    {
+        return _mm_movemask_ps(m_value);
+    }
+
+    friend auto operator&(MaskLanes left, MaskLanes right) noexcept
+    {
+        return MaskLanes(_mm_and_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator|(MaskLanes left, MaskLanes right) noexcept
+    {
+        return MaskLanes(_mm_or_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator!(MaskLanes operand) noexcept
+    {
+        return MaskLanes(_mm_xor_ps(operand.m_value, _mm_castsi128_ps(_mm_set1_epi32(-1))));
+    }
+
+private:
+    __m128 m_value;
+};
+
+template <>
+class FloatLanes<4>
+{
+public:
+    static constexpr size_t width = 4;
+
+    FloatLanes() noexcept : m_value(_mm_setzero_ps())
+    {
+    }
+
+    explicit FloatLanes(float value) noexcept : m_value(_mm_set1_ps(value))
+    {
+    }
+
+    explicit FloatLanes(__m128 value) noexcept : m_value(value)
+    {
+    }
+
+    [[nodiscard]] static auto load(const float* source) noexcept
+    {
+        return FloatLanes(_mm_load_ps(source));
+    }
+
+    [[nodiscard]] static auto loadUnaligned(const float* source) noexcept
+    {
+        return FloatLanes(_mm_loadu_ps(source));
+    }
+
+    template <typename LaneValue>
+    [[nodiscard]] static auto generate(LaneValue&& laneValue) noexcept
+    {
+        return FloatLanes(
+            _mm_setr_ps(laneValue(size_t{0}), laneValue(size_t{1}), laneValue(size_t{2}), laneValue(size_t{3})));
+    }
+
+    void store(float* destination) const noexcept
+    {
+        _mm_store_ps(destination, m_value);
+    }
+
+    void storeUnaligned(float* destination) const noexcept
+    {
+        _mm_storeu_ps(destination, m_value);
+    }
+
+    [[nodiscard]] auto native() const noexcept
+    {
+        return m_value;
+    }
+
+    friend auto operator+(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm_add_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator-(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm_sub_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator*(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm_mul_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator/(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm_div_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator-(FloatLanes operand) noexcept
+    {
+        return FloatLanes(_mm_xor_ps(operand.m_value, _mm_set1_ps(-0.0F)));
+    }
+
+    friend auto operator==(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<4>(_mm_cmpeq_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator<(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<4>(_mm_cmplt_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator<=(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<4>(_mm_cmple_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator>(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<4>(_mm_cmpgt_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator>=(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<4>(_mm_cmpge_ps(left.m_value, right.m_value));
+    }
+
+    friend auto multiplyAdd(FloatLanes left, FloatLanes right, FloatLanes addend) noexcept
+    {
+#if defined(__FMA__)
+        return FloatLanes(_mm_fmadd_ps(left.m_value, right.m_value, addend.m_value));
+#else
+        return FloatLanes(_mm_add_ps(_mm_mul_ps(left.m_value, right.m_value), addend.m_value));
+#endif
+    }
+
+    friend auto sqrt(FloatLanes operand) noexcept
+    {
+        return FloatLanes(_mm_sqrt_ps(operand.m_value));
+    }
+
+    friend auto abs(FloatLanes operand) noexcept
+    {
+        return FloatLanes(_mm_andnot_ps(_mm_set1_ps(-0.0F), operand.m_value));
+    }
+
+    friend auto min(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm_min_ps(left.m_value, right.m_value));
+    }
+
+    friend auto max(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm_max_ps(left.m_value, right.m_value));
+    }
+
+    friend auto select(MaskLanes<4> mask, FloatLanes ifTrue, FloatLanes ifFalse) noexcept
+    {
+        return FloatLanes(
+            _mm_or_ps(_mm_and_ps(mask.native(), ifTrue.m_value), _mm_andnot_ps(mask.native(), ifFalse.m_value)));
+    }
+
+private:
+    __m128 m_value;
+};
+
+#endif // EYEBEAM_SIMD_SSE
+
+#if defined(EYEBEAM_SIMD_AVX)
+
+template <>
+class MaskLanes<8>
+{
+public:
+    explicit MaskLanes(__m256 value) noexcept : m_value(value)
+    {
+    }
+
+    [[nodiscard]] auto native() const noexcept
+    {
+        return m_value;
+    }
+
+    [[nodiscard]] int bits() const noexcept
+    {
+        return _mm256_movemask_ps(m_value);
+    }
+
+    friend auto operator&(MaskLanes left, MaskLanes right) noexcept
+    {
+        return MaskLanes(_mm256_and_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator|(MaskLanes left, MaskLanes right) noexcept
+    {
+        return MaskLanes(_mm256_or_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator!(MaskLanes operand) noexcept
+    {
+        return MaskLanes(_mm256_xor_ps(operand.m_value, _mm256_castsi256_ps(_mm256_set1_epi32(-1))));
+    }
+
+private:
+    __m256 m_value;
+};
+
+template <>
+class FloatLanes<8>
+{
+public:
+    static constexpr size_t width = 8;
+
+    FloatLanes() noexcept : m_value(_mm256_setzero_ps())
+    {
+    }
+
+    explicit FloatLanes(float value) noexcept : m_value(_mm256_set1_ps(value))
+    {
+    }
+
+    explicit FloatLanes(__m256 value) noexcept : m_value(value)
+    {
+    }
+
+    [[nodiscard]] static auto load(const float* source) noexcept
+    {
+        return FloatLanes(_mm256_load_ps(source));
+    }
+
+    [[nodiscard]] static auto loadUnaligned(const float* source) noexcept
+    {
+        return FloatLanes(_mm256_loadu_ps(source));
+    }
+
+    template <typename LaneValue>
+    [[nodiscard]] static auto generate(LaneValue&& laneValue) noexcept
+    {
+        return FloatLanes(_mm256_setr_ps(
+            laneValue(size_t{0}),
+            laneValue(size_t{1}),
+            laneValue(size_t{2}),
+            laneValue(size_t{3}),
+            laneValue(size_t{4}),
+            laneValue(size_t{5}),
+            laneValue(size_t{6}),
+            laneValue(size_t{7})));
+    }
+
+    void store(float* destination) const noexcept
+    {
+        _mm256_store_ps(destination, m_value);
+    }
+
+    void storeUnaligned(float* destination) const noexcept
+    {
+        _mm256_storeu_ps(destination, m_value);
+    }
+
+    [[nodiscard]] auto native() const noexcept
+    {
+        return m_value;
+    }
+
+    friend auto operator+(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm256_add_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator-(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm256_sub_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator*(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm256_mul_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator/(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm256_div_ps(left.m_value, right.m_value));
+    }
+
+    friend auto operator-(FloatLanes operand) noexcept
+    {
+        return FloatLanes(_mm256_xor_ps(operand.m_value, _mm256_set1_ps(-0.0F)));
+    }
+
+    friend auto operator==(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<8>(_mm256_cmp_ps(left.m_value, right.m_value, _CMP_EQ_OQ));
+    }
+
+    friend auto operator<(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<8>(_mm256_cmp_ps(left.m_value, right.m_value, _CMP_LT_OQ));
+    }
+
+    friend auto operator<=(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<8>(_mm256_cmp_ps(left.m_value, right.m_value, _CMP_LE_OQ));
+    }
+
+    friend auto operator>(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<8>(_mm256_cmp_ps(left.m_value, right.m_value, _CMP_GT_OQ));
+    }
+
+    friend auto operator>=(FloatLanes left, FloatLanes right) noexcept
+    {
+        return MaskLanes<8>(_mm256_cmp_ps(left.m_value, right.m_value, _CMP_GE_OQ));
+    }
+
+    friend auto multiplyAdd(FloatLanes left, FloatLanes right, FloatLanes addend) noexcept
+    {
+#if defined(__FMA__)
+        return FloatLanes(_mm256_fmadd_ps(left.m_value, right.m_value, addend.m_value));
+#else
+        return FloatLanes(_mm256_add_ps(_mm256_mul_ps(left.m_value, right.m_value), addend.m_value));
+#endif
+    }
+
+    friend auto sqrt(FloatLanes operand) noexcept
+    {
+        return FloatLanes(_mm256_sqrt_ps(operand.m_value));
+    }
+
+    friend auto abs(FloatLanes operand) noexcept
+    {
+        return FloatLanes(_mm256_andnot_ps(_mm256_set1_ps(-0.0F), operand.m_value));
+    }
+
+    friend auto min(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm256_min_ps(left.m_value, right.m_value));
+    }
+
+    friend auto max(FloatLanes left, FloatLanes right) noexcept
+    {
+        return FloatLanes(_mm256_max_ps(left.m_value, right.m_value));
+    }
+
+    friend auto select(MaskLanes<8> mask, FloatLanes ifTrue, FloatLanes ifFalse) noexcept
+    {
+        return FloatLanes(_mm256_blendv_ps(ifFalse.m_value, ifTrue.m_value, mask.native()));
+    }
+
+private:
+    __m256 m_value;
+};
+
+#endif // EYEBEAM_SIMD_AVX
+
+#if defined(EYEBEAM_SIMD_AVX)
+constexpr size_t maxNativeLaneWidth = 8;
+#elif defined(EYEBEAM_SIMD_SSE)
+constexpr size_t maxNativeLaneWidth = 4;
+#else
+constexpr size_t maxNativeLaneWidth = 1;
+#endif
+
+template <size_t Width>
+[[nodiscard]] constexpr size_t chooseLaneWidth() noexcept
+{
+    auto laneWidth = maxNativeLaneWidth;
+    while (Width % laneWidth != 0)
+    {
+        laneWidth /= 2;
+    }
+
+    return laneWidth;
+}
+
+template <size_t Width>
+using PacketLanes = FloatLanes<chooseLaneWidth<Width>()>;
+
+} // namespace eyebeam
+
+#endif // INCLUDED_SIMD_LANES_H_
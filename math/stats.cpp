@@ -0,0 +1,138 @@
+#include "stats.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr std::array<std::string_view, statCount> statNames = {
+    "raysCast",
+    "bvhNodesVisited",
+    "primitiveTests",
+    "hits",
+    "samples"};
+
+// Every live thread's counters, plus the totals of the threads that have exited
+class StatsRegistry
+{
+public:
+    void add(detail::ThreadStatCounters& counters)
+    {
+        const std::lock_guard lock(m_mutex);
+        m_threads.push_back(&counters);
+    }
+
+    void retire(detail::ThreadStatCounters& counters)
+    {
+        const std::lock_guard lock(m_mutex);
+        for (size_t i = 0; i < statCount; ++i)
+        {
+            m_retired[static_cast<Stat>(i)] += counters[i].load(std::memory_order_relaxed);
+        }
+
+        m_threads.erase(std::find(m_threads.begin(), m_threads.end(), &counters));
+    }
+
+    [[nodiscard]] StatsSnapshot collect()
+    {
+        const std::lock_guard lock(m_mutex);
+        auto result(m_retired);
+        for (const auto* counters : m_threads)
+        {
+            for (size_t i = 0; i < statCount; ++i)
+            {
+                result[static_cast<Stat>(i)] += (*counters)[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        return result;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<detail::ThreadStatCounters*> m_threads;
+    StatsSnapshot m_retired;
+};
+
+StatsRegistry& statsRegistry()
+{
+    // Never destroyed, so threads that exit after main returns can still retire their counters
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    static auto* s_registry = new StatsRegistry();
+    return *s_registry;
+}
+
+class RegisteredThreadStatCounters
+{
+public:
+    RegisteredThreadStatCounters()
+    {
+        statsRegistry().add(m_counters);
+    }
+
+    ~RegisteredThreadStatCounters()
+    {
+        statsRegistry().retire(m_counters);
+    }
+
+    RegisteredThreadStatCounters(const RegisteredThreadStatCounters&) = delete;
+    RegisteredThreadStatCounters(RegisteredThreadStatCounters&&) = delete;
+
+    RegisteredThreadStatCounters& operator=(const RegisteredThreadStatCounters&) = delete;
+    RegisteredThreadStatCounters& operator=(RegisteredThreadStatCounters&&) = delete;
+
+    [[nodiscard]] auto& counters() noexcept
+    {
+        return m_counters;
+    }
+
+private:
+    detail::ThreadStatCounters m_counters{};
+};
+
+} // namespace
+
+std::string_view statName(Stat stat) noexcept
+{
+    return statNames[static_cast<size_t>(stat)];
+}
+
+StatsSnapshot StatsSnapshot::collect()
+{
+    return statsRegistry().collect();
+}
+
+std::ostream& operator<<(std::ostream& os, const StatsSnapshot& stats)
+{
+    for (size_t i = 0; i < statCount; ++i)
+    {
+        const auto stat = static_cast<Stat>(i);
+        os << (i == 0 ? "" : ", ") << statName(stat) << " " << stats[stat];
+    }
+
+    return os << "\n";
+}
+
+namespace detail
+{
+
+ThreadStatCounters& threadStatCounters() noexcept
+{
+    thread_local RegisteredThreadStatCounters t_counters;
+    return t_counters.counters();
+}
+
+} // namespace detail
+
+} // namespace eyebeam
@@ -0,0 +1,138 @@
+#ifndef INCLUDED_STATS_H_
+#define INCLUDED_STATS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+namespace eyebeam
+{
+
+// Counters of the work done while rendering. Builds configured with EYEBEAM_ENABLE_STATS=OFF define
+// EYEBEAM_STATS_DISABLED, which compiles every counter away.
+#ifdef EYEBEAM_STATS_DISABLED
+constexpr bool statsEnabled = false;
+#else
+constexpr bool statsEnabled = true;
+#endif
+
+enum class Stat : size_t
+{
+    // Rays traced against the geometry of a scene
+    RaysCast,
+    BvhNodesVisited,
+    PrimitiveTests,
+    // Rays that found an intersection or an occluder
+    Hits,
+    // Pixel samples shaded
+    Samples,
+    Count
+};
+
+constexpr auto statCount = static_cast<size_t>(Stat::Count);
+
+// The name a counter is printed and written to JSON under
+[[nodiscard]] std::string_view statName(Stat stat) noexcept;
+
+// The totals of every counter at some moment. The difference of two snapshots is the work done in between.
+class StatsSnapshot
+{
+public:
+    // Sums the counters of every thread that ever counted anything, including threads that have exited
+    [[nodiscard]] static StatsSnapshot collect();
+
+    [[nodiscard]] constexpr std::uint64_t operator[](Stat stat) const noexcept
+    {
+        return m_counters[static_cast<size_t>(stat)];
+    }
+
+    [[nodiscard]] constexpr std::uint64_t& operator[](Stat stat) noexcept
+    {
+        return m_counters[static_cast<size_t>(stat)];
+    }
+
+    constexpr StatsSnapshot& operator-=(const StatsSnapshot& rhs) noexcept
+    {
+        for (size_t i = 0; i < statCount; ++i)
+        {
+            m_counters[i] -= rhs.m_counters[i];
+        }
+
+        return *this;
+    }
+
+private:
+    std::array<std::uint64_t, statCount> m_counters{};
+};
+
+[[nodiscard]] constexpr StatsSnapshot operator-(StatsSnapshot lhs, const StatsSnapshot& rhs) noexcept
+{
+    return lhs -= rhs;
+}
+
+// One line with every counter
+std::ostream& operator<<(std::ostream& os, const StatsSnapshot& stats);
+
+namespace detail
+{
+
+// Only the owning thread adds to its counters, so a relaxed load and store are enough and compile to a plain add.
+// They are atomic only so that StatsSnapshot::collect can read them from another thread.
+using ThreadStatCounters = std::array<std::atomic<std::uint64_t>, statCount>;
+
+[[nodiscard]] ThreadStatCounters& threadStatCounters() noexcept;
+
+} // namespace detail
+
+inline void countStat([[maybe_unused]] Stat stat, [[maybe_unused]] std::uint64_t amount = 1) noexcept
+{
+    if constexpr (statsEnabled)
+    {
+        auto& counter = detail::threadStatCounters()[static_cast<size_t>(stat)];
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+}
+
+// Counts into a local variable and adds the total to the thread's counter when it goes out of scope, for loops too
+// hot to touch the thread's counters on every iteration
+template <Stat S>
+class ScopedStat
+{
+public:
+    ScopedStat() = default;
+
+    ~ScopedStat()
+    {
+        countStat(S, m_count);
+    }
+
+    ScopedStat(const ScopedStat&) = delete;
+    ScopedStat(ScopedStat&&) = delete;
+
+    ScopedStat& operator=(const ScopedStat&) = delete;
+    ScopedStat& operator=(ScopedStat&&) = delete;
+
+    constexpr void add([[maybe_unused]] std::uint64_t amount) noexcept
+    {
+        if constexpr (statsEnabled)
+        {
+            m_count += amount;
+        }
+    }
+
+    constexpr ScopedStat& operator++() noexcept
+    {
+        add(1);
+        return *this;
+    }
+
+private:
+    std::uint64_t m_count = 0;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_STATS_H_
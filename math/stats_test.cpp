@@ -0,0 +1,105 @@
+#include "stats.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// NOLINTNEXTLINE
+TEST(StatsTests, countsOfEveryThreadAreMerged)
+{
+    if constexpr (!statsEnabled)
+    {
+        GTEST_SKIP() << "Stats are compiled out";
+    }
+
+    // GIVEN:
+    constexpr std::uint64_t threadCount = 4;
+    constexpr std::uint64_t countPerThread = 1000;
+    const auto before(StatsSnapshot::collect());
+
+    // WHEN:
+    std::vector<std::thread> threads;
+    for (std::uint64_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([] {
+            for (std::uint64_t j = 0; j < countPerThread; ++j)
+            {
+                countStat(Stat::PrimitiveTests);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    countStat(Stat::PrimitiveTests, 5);
+    const auto counted(StatsSnapshot::collect() - before);
+
+    // THEN:
+    EXPECT_EQ(counted[Stat::PrimitiveTests], threadCount * countPerThread + 5);
+}
+
+// NOLINTNEXTLINE
+TEST(StatsTests, scopedStatCountsWhenItGoesOutOfScope)
+{
+    if constexpr (!statsEnabled)
+    {
+        GTEST_SKIP() << "Stats are compiled out";
+    }
+
+    // GIVEN:
+    const auto before(StatsSnapshot::collect());
+
+    // WHEN:
+    std::uint64_t countedInScope = 0;
+    {
+        ScopedStat<Stat::BvhNodesVisited> nodesVisited;
+        ++nodesVisited;
+        nodesVisited.add(6);
+        countedInScope = (StatsSnapshot::collect() - before)[Stat::BvhNodesVisited];
+    }
+    const auto counted(StatsSnapshot::collect() - before);
+
+    // THEN:
+    EXPECT_EQ(countedInScope, 0U);
+    EXPECT_EQ(counted[Stat::BvhNodesVisited], 7U);
+    EXPECT_EQ(counted[Stat::Hits], 0U);
+}
+
+// NOLINTNEXTLINE
+TEST(StatsTests, compiledOutStatsCountNothing)
+{
+    if constexpr (statsEnabled)
+    {
+        GTEST_SKIP() << "Stats are compiled in";
+    }
+
+    // GIVEN:
+    const auto before(StatsSnapshot::collect());
+
+    // WHEN:
+    countStat(Stat::RaysCast, 3);
+    {
+        ScopedStat<Stat::Samples> samples;
+        ++samples;
+    }
+    const auto counted(StatsSnapshot::collect() - before);
+
+    // THEN:
+    EXPECT_EQ(counted[Stat::RaysCast], 0U);
+    EXPECT_EQ(counted[Stat::Samples], 0U);
+}
+
+} // namespace
+
+} // namespace eyebeam
@@ -4,6 +4,7 @@
 #include "normal3.h"
 #include "point3.h"
 #include "ray3.h"
+#include "simd.h"
 #include "vector3.h"
 
 #include <cmath>
@@ -18,13 +19,52 @@ Transform::Transform(const AlignedMatrixStorage& elements) : m_matrix(elements),
 
 Normal3 Transform::multiply(const Normal3& n) const noexcept
 {
-    const auto transposedInverse(m_inverse.transpose());
-    return Normal3(transposedInverse.multiply(Vector3(n)));
+    return Normal3(m_inverse.multiplyTransposed(Vector3(n)));
 }
 
+#if defined(EYEBEAM_SIMD_SSE)
+void Transform::transformNormals(Normal3* normals, size_t count) const noexcept
+{
+    const auto inverse(m_inverse.getUnaligned());
+
+    // The rows of the inverse are the columns of the normal matrix. Their w lanes hold the translation, which must not
+    // leak into the normals.
+    const auto linearMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const auto row0 = _mm_and_ps(_mm_loadu_ps(&inverse[0]), linearMask);
+    const auto row1 = _mm_and_ps(_mm_loadu_ps(&inverse[4]), linearMask);
+    const auto row2 = _mm_and_ps(_mm_loadu_ps(&inverse[8]), linearMask);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto* components = &normals[i].x();
+        const auto n = _mm_load_ps(components);
+
+        const auto transformed = _mm_add_ps(
+            _mm_add_ps(
+                _mm_mul_ps(row0, _mm_shuffle_ps(n, n, _MM_SHUFFLE(0, 0, 0, 0))),
+                _mm_mul_ps(row1, _mm_shuffle_ps(n, n, _MM_SHUFFLE(1, 1, 1, 1)))),
+            _mm_mul_ps(row2, _mm_shuffle_ps(n, n, _MM_SHUFFLE(2, 2, 2, 2))));
+
+        auto squares = _mm_mul_ps(transformed, transformed);
+        squares = _mm_add_ps(squares, _mm_shuffle_ps(squares, squares, _MM_SHUFFLE(2, 3, 0, 1)));
+        const auto lengthSquared = _mm_add_ps(squares, _mm_shuffle_ps(squares, squares, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        _mm_store_ps(components, _mm_div_ps(transformed, _mm_sqrt_ps(lengthSquared)));
+    }
+}
+#else
+void Transform::transformNormals(Normal3* normals, size_t count) const noexcept
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        normals[i] = multiply(normals[i]);
+    }
+}
+#endif
+
 Ray3 Transform::multiply(const Ray3& r) const
 {
-    return Ray3(m_matrix.multiply(r.origin()), m_matrix.multiply(r.direction()));
+    return Ray3(m_matrix.multiply(r.origin()), m_matrix.multiply(r.direction()), r.shutterTime());
 }
 
 Transform Transform::rotateX(Radians theta)
@@ -5,8 +5,10 @@
 #include "matrix4.h"
 #include "normal3.h"
 #include "ray3.h"
+#include "ray3_packet.h"
 #include "vector3.h"
 
+#include <cstddef>
 #include <iosfwd>
 #include <utility>
 
@@ -70,9 +72,19 @@ public:
         return Transform(m_matrix.multiply(t.m_matrix), t.m_inverse.multiply(m_inverse));
     }
 
+    // Normals are transformed by the transposed inverse, which is read straight out of the inverse rather than built
     [[nodiscard]] Normal3 multiply(const Normal3& n) const noexcept;
     [[nodiscard]] Ray3 multiply(const Ray3& r) const;
 
+    // Transforms count normals in place, equivalent to multiply(const Normal3&) on each of them
+    void transformNormals(Normal3* normals, size_t count) const noexcept;
+
+    template <size_t Width>
+    [[nodiscard]] auto multiply(const Ray3Packet<Width>& r) const noexcept
+    {
+        return Ray3Packet<Width>(m_matrix.multiply(r.origins()), m_matrix.multiply(r.directions()), r.shutterTimes());
+    }
+
     [[nodiscard]] static constexpr auto translate(const Vector3& deltaX) noexcept
     {
         // clang-format off
@@ -0,0 +1,281 @@
+#include "transform_array.h"
+
+#include "components_packet.h"
+#include "matrix4.h"
+#include "point3.h"
+#include "ray3.h"
+#include "ray3_packet.h"
+#include "simd_lanes.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+using Lanes = PacketLanes<MatrixArray::packetWidth>;
+
+constexpr auto elementIndex = impl::getIndexFromRowColumn;
+
+[[nodiscard]] auto loadElement(const MatrixArray::Block& block, size_t row, size_t column, size_t lane) noexcept
+{
+    return Lanes::load(&block[elementIndex(row, column)].data[lane]);
+}
+
+// Applies every matrix of block to its lane of the input. input(lane) returns the x, y and z lanes starting at lane.
+template <bool IsPoint, typename Input, typename Output>
+void transformBlock(const MatrixArray::Block& block, Input&& input, Output& output) noexcept
+{
+    for (size_t lane = 0; lane < MatrixArray::packetWidth; lane += Lanes::width)
+    {
+        const auto [x, y, z] = input(lane);
+
+        std::array<Lanes, 4> rows;
+        for (size_t row = 0; row < (IsPoint ? 4 : 3); ++row)
+        {
+            const auto translation = IsPoint ? loadElement(block, row, 3, lane) : Lanes(0.0F);
+            auto sum = multiplyAdd(loadElement(block, row, 2, lane), z, translation);
+            sum = multiplyAdd(loadElement(block, row, 1, lane), y, sum);
+            rows[row] = multiplyAdd(loadElement(block, row, 0, lane), x, sum);
+        }
+
+        if constexpr (IsPoint)
+        {
+            const auto homogenousReciprocal = Lanes(1.0F) / rows[3];
+            rows[0] = rows[0] * homogenousReciprocal;
+            rows[1] = rows[1] * homogenousReciprocal;
+            rows[2] = rows[2] * homogenousReciprocal;
+        }
+
+        rows[0].store(&output.x.data[lane]);
+        rows[1].store(&output.y.data[lane]);
+        rows[2].store(&output.z.data[lane]);
+    }
+}
+
+template <typename Packet>
+auto packetLanes(const Packet& packet)
+{
+    return [&packet](size_t lane) {
+        return std::array<Lanes, 3>{
+            Lanes::load(&packet.x.data[lane]), Lanes::load(&packet.y.data[lane]), Lanes::load(&packet.z.data[lane])};
+    };
+}
+
+auto broadcastLanes(float x, float y, float z)
+{
+    return [broadcast = std::array<Lanes, 3>{Lanes(x), Lanes(y), Lanes(z)}](size_t) { return broadcast; };
+}
+
+// product(left, right) computes one element of a matrix product from the lanes of one row and one column
+template <typename Product>
+void multiplyBlock(MatrixArray::Block& block, Product&& product) noexcept
+{
+    for (size_t lane = 0; lane < MatrixArray::packetWidth; lane += Lanes::width)
+    {
+        std::array<Lanes, 16> elements;
+        for (size_t i = 0; i < elements.size(); ++i)
+        {
+            elements[i] = Lanes::load(&block[i].data[lane]);
+        }
+
+        for (size_t row = 0; row < 4; ++row)
+        {
+            for (size_t column = 0; column < 4; ++column)
+            {
+                product(elements, row, column).store(&block[elementIndex(row, column)].data[lane]);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void MatrixArray::add(const Matrix4& matrix)
+{
+    if (m_size == m_blocks.size() * packetWidth)
+    {
+        Block identity;
+        const auto elements(Matrix4().getUnaligned());
+        for (size_t i = 0; i < elements.size(); ++i)
+        {
+            identity[i].data.fill(elements[i]);
+        }
+
+        m_blocks.push_back(identity);
+    }
+
+    set(m_size++, matrix);
+}
+
+void MatrixArray::set(size_t index, const Matrix4& matrix) noexcept
+{
+    auto& block = m_blocks[index / packetWidth];
+    const auto elements(matrix.getUnaligned());
+    for (size_t i = 0; i < elements.size(); ++i)
+    {
+        block[i].data[index % packetWidth] = elements[i];
+    }
+}
+
+Matrix4 MatrixArray::get(size_t index) const noexcept
+{
+    const auto& block = m_blocks[index / packetWidth];
+    UnalignedMatrixStorage elements{};
+    for (size_t i = 0; i < elements.size(); ++i)
+    {
+        elements[i] = block[i].data[index % packetWidth];
+    }
+
+    return Matrix4(elements);
+}
+
+void MatrixArray::reserve(size_t count)
+{
+    m_blocks.reserve((count + packetWidth - 1) / packetWidth);
+}
+
+Point3Packet<MatrixArray::packetWidth> MatrixArray::multiply(size_t block, const Point3& p) const noexcept
+{
+    Point3Packet<packetWidth> result;
+    transformBlock<true>(m_blocks[block], broadcastLanes(p.x(), p.y(), p.z()), result);
+    return result;
+}
+
+Vector3Packet<MatrixArray::packetWidth> MatrixArray::multiply(size_t block, const Vector3& v) const noexcept
+{
+    Vector3Packet<packetWidth> result;
+    transformBlock<false>(m_blocks[block], broadcastLanes(v.x(), v.y(), v.z()), result);
+    return result;
+}
+
+Point3Packet<MatrixArray::packetWidth> MatrixArray::multiply(
+    size_t block,
+    const Point3Packet<packetWidth>& p) const noexcept
+{
+    Point3Packet<packetWidth> result;
+    transformBlock<true>(m_blocks[block], packetLanes(p), result);
+    return result;
+}
+
+Vector3Packet<MatrixArray::packetWidth> MatrixArray::multiply(
+    size_t block,
+    const Vector3Packet<packetWidth>& v) const noexcept
+{
+    Vector3Packet<packetWidth> result;
+    transformBlock<false>(m_blocks[block], packetLanes(v), result);
+    return result;
+}
+
+void MatrixArray::premultiply(const Matrix4& lhs) noexcept
+{
+    const auto left(lhs.getUnaligned());
+    for (auto& block : m_blocks)
+    {
+        multiplyBlock(block, [&left](const std::array<Lanes, 16>& elements, size_t row, size_t column) {
+            auto sum = Lanes(left[elementIndex(row, 3)]) * elements[elementIndex(3, column)];
+            for (size_t i = 0; i < 3; ++i)
+            {
+                sum = multiplyAdd(Lanes(left[elementIndex(row, i)]), elements[elementIndex(i, column)], sum);
+            }
+
+            return sum;
+        });
+    }
+}
+
+void MatrixArray::postmultiply(const Matrix4& rhs) noexcept
+{
+    const auto right(rhs.getUnaligned());
+    for (auto& block : m_blocks)
+    {
+        multiplyBlock(block, [&right](const std::array<Lanes, 16>& elements, size_t row, size_t column) {
+            auto sum = elements[elementIndex(row, 3)] * Lanes(right[elementIndex(3, column)]);
+            for (size_t i = 0; i < 3; ++i)
+            {
+                sum = multiplyAdd(elements[elementIndex(row, i)], Lanes(right[elementIndex(i, column)]), sum);
+            }
+
+            return sum;
+        });
+    }
+}
+
+void TransformArray::add(const Transform& transform)
+{
+    const auto [matrix, inverse] = transform.getTransformUnaligned();
+    m_matrices.add(Matrix4(matrix));
+    m_inverses.add(Matrix4(inverse));
+}
+
+void TransformArray::set(size_t index, const Transform& transform) noexcept
+{
+    const auto [matrix, inverse] = transform.getTransformUnaligned();
+    m_matrices.set(index, Matrix4(matrix));
+    m_inverses.set(index, Matrix4(inverse));
+}
+
+Transform TransformArray::get(size_t index) const noexcept
+{
+    return Transform(m_matrices.get(index), m_inverses.get(index));
+}
+
+void TransformArray::reserve(size_t count)
+{
+    m_matrices.reserve(count);
+    m_inverses.reserve(count);
+}
+
+Point3Packet<TransformArray::packetWidth> TransformArray::multiply(size_t block, const Point3& p) const noexcept
+{
+    return m_matrices.multiply(block, p);
+}
+
+Vector3Packet<TransformArray::packetWidth> TransformArray::multiply(size_t block, const Vector3& v) const noexcept
+{
+    return m_matrices.multiply(block, v);
+}
+
+Ray3Packet<TransformArray::packetWidth> TransformArray::multiply(size_t block, const Ray3& r) const noexcept
+{
+    return Ray3Packet<packetWidth>(
+        m_matrices.multiply(block, r.origin()), m_matrices.multiply(block, r.direction()), r.shutterTime());
+}
+
+Point3Packet<TransformArray::packetWidth> TransformArray::multiply(
+    size_t block,
+    const Point3Packet<packetWidth>& p) const noexcept
+{
+    return m_matrices.multiply(block, p);
+}
+
+Vector3Packet<TransformArray::packetWidth> TransformArray::multiply(
+    size_t block,
+    const Vector3Packet<packetWidth>& v) const noexcept
+{
+    return m_matrices.multiply(block, v);
+}
+
+Ray3Packet<TransformArray::packetWidth> TransformArray::multiply(
+    size_t block,
+    const Ray3Packet<packetWidth>& r) const noexcept
+{
+    return Ray3Packet<packetWidth>(
+        m_matrices.multiply(block, r.origins()), m_matrices.multiply(block, r.directions()), r.shutterTimes());
+}
+
+// The inverse of transform * t is t^-1 * transform^-1
+void TransformArray::premultiply(const Transform& transform) noexcept
+{
+    const auto [matrix, inverse] = transform.getTransformUnaligned();
+    m_matrices.premultiply(Matrix4(matrix));
+    m_inverses.postmultiply(Matrix4(inverse));
+}
+
+} // namespace eyebeam
@@ -0,0 +1,122 @@
+#ifndef INCLUDED_TRANSFORM_ARRAY_H_
+#define INCLUDED_TRANSFORM_ARRAY_H_
+
+#include "components_packet.h"
+#include "matrix4.h"
+#include "point3.h"
+#include "ray3.h"
+#include "ray3_packet.h"
+#include "simd_lanes.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace eyebeam
+{
+
+// Matrices stored as an array of structures of arrays. Each block holds packetWidth consecutive matrices as sixteen
+// 64 byte columns, one per matrix element, so that an element of every matrix in a block is one aligned cache line
+// and the block can be applied to a packet with one multiply-add per element and native register. The lanes of the
+// last block past size() hold identity matrices.
+class MatrixArray
+{
+public:
+    static constexpr size_t packetWidth = 16;
+
+    using Block = std::array<AlignedLaneStorage<packetWidth>, 16>;
+
+    static_assert(sizeof(AlignedLaneStorage<packetWidth>) == 64, "Each element of a block should fill a cache line");
+
+    void add(const Matrix4& matrix);
+    void set(size_t index, const Matrix4& matrix) noexcept;
+    [[nodiscard]] Matrix4 get(size_t index) const noexcept;
+
+    void reserve(size_t count);
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] auto blockCount() const noexcept
+    {
+        return m_blocks.size();
+    }
+
+    [[nodiscard]] const auto& blocks() const noexcept
+    {
+        return m_blocks;
+    }
+
+    // Lane i holds p, v or lane i of the packet multiplied by matrix block * packetWidth + i. Points are divided by
+    // their homogeneous coordinate in every lane, as Matrix4 does for packets.
+    [[nodiscard]] Point3Packet<packetWidth> multiply(size_t block, const Point3& p) const noexcept;
+    [[nodiscard]] Vector3Packet<packetWidth> multiply(size_t block, const Vector3& v) const noexcept;
+    [[nodiscard]] Point3Packet<packetWidth> multiply(size_t block, const Point3Packet<packetWidth>& p) const noexcept;
+    [[nodiscard]] Vector3Packet<packetWidth> multiply(size_t block, const Vector3Packet<packetWidth>& v) const noexcept;
+
+    // Replaces every matrix m by lhs * m, or by m * rhs, a block at a time
+    void premultiply(const Matrix4& lhs) noexcept;
+    void postmultiply(const Matrix4& rhs) noexcept;
+
+private:
+    std::vector<Block> m_blocks;
+    size_t m_size = 0;
+};
+
+// Transforms stored densely for bulk work on many instances, with the matrices and their inverses in separate
+// MatrixArrays. Carrying a world ray into the space of every instance applies inverses(); placing the instances
+// applies matrices().
+class TransformArray
+{
+public:
+    static constexpr size_t packetWidth = MatrixArray::packetWidth;
+
+    void add(const Transform& transform);
+    void set(size_t index, const Transform& transform) noexcept;
+    [[nodiscard]] Transform get(size_t index) const noexcept;
+
+    void reserve(size_t count);
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_matrices.size();
+    }
+
+    [[nodiscard]] auto blockCount() const noexcept
+    {
+        return m_matrices.blockCount();
+    }
+
+    [[nodiscard]] const auto& matrices() const noexcept
+    {
+        return m_matrices;
+    }
+
+    [[nodiscard]] const auto& inverses() const noexcept
+    {
+        return m_inverses;
+    }
+
+    // Lane i holds the argument, or lane i of it, transformed by transform block * packetWidth + i
+    [[nodiscard]] Point3Packet<packetWidth> multiply(size_t block, const Point3& p) const noexcept;
+    [[nodiscard]] Vector3Packet<packetWidth> multiply(size_t block, const Vector3& v) const noexcept;
+    [[nodiscard]] Ray3Packet<packetWidth> multiply(size_t block, const Ray3& r) const noexcept;
+    [[nodiscard]] Point3Packet<packetWidth> multiply(size_t block, const Point3Packet<packetWidth>& p) const noexcept;
+    [[nodiscard]] Vector3Packet<packetWidth> multiply(size_t block, const Vector3Packet<packetWidth>& v) const noexcept;
+    [[nodiscard]] Ray3Packet<packetWidth> multiply(size_t block, const Ray3Packet<packetWidth>& r) const noexcept;
+
+    // Replaces every transform t by transform.multiply(t), which moves every instance by the same transform
+    void premultiply(const Transform& transform) noexcept;
+
+private:
+    MatrixArray m_matrices;
+    MatrixArray m_inverses;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_TRANSFORM_ARRAY_H_
@@ -0,0 +1,191 @@
+#include "transform_array.h"
+
+#include "random_generator.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+auto generateRandomTransform()
+{
+    return Transform::translate(RandomGenerator::generateRandomVector3())
+        .multiply(Transform::rotateAxisAngle(
+            RandomGenerator::generateRandomVector3(),
+            Radians(RandomGenerator::generateRandomFloat())))
+        .multiply(Transform::scale(2.0F, 0.5F, 3.0F));
+}
+
+// More than one block, with the last one only partly used
+constexpr size_t transformCount = TransformArray::packetWidth + 5;
+
+auto generateRandomTransformArray()
+{
+    TransformArray transforms;
+    for (size_t i = 0; i < transformCount; ++i)
+    {
+        transforms.add(generateRandomTransform());
+    }
+
+    return transforms;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(TransformArrayTests, AddStoresTransformsInBlocksOfPacketWidth)
+{
+    // GIVEN:
+    const auto t(generateRandomTransform());
+    TransformArray transforms;
+
+    // WHEN:
+    for (size_t i = 0; i < transformCount; ++i)
+    {
+        transforms.add(t);
+    }
+
+    // THEN:
+    EXPECT_EQ(transformCount, transforms.size());
+    EXPECT_EQ(2U, transforms.blockCount());
+    EXPECT_EQ(t, transforms.get(transformCount - 1));
+}
+
+// NOLINTNEXTLINE
+TEST(TransformArrayTests, SetReplacesOnlyTheGivenTransform)
+{
+    // GIVEN:
+    auto transforms(generateRandomTransformArray());
+    const auto before(transforms.get(2));
+    const auto t(generateRandomTransform());
+
+    // WHEN:
+    transforms.set(3, t);
+
+    // THEN:
+    EXPECT_EQ(t, transforms.get(3));
+    EXPECT_EQ(before, transforms.get(2));
+}
+
+// NOLINTNEXTLINE
+TEST(TransformArrayTests, UnusedLanesOfTheLastBlockHoldIdentity)
+{
+    // GIVEN:
+    const auto transforms(generateRandomTransformArray());
+    const auto p(RandomGenerator::generateRandomPoint3());
+
+    // WHEN:
+    const auto result(transforms.multiply(transforms.blockCount() - 1, p));
+
+    // THEN:
+    for (size_t lane = transformCount % TransformArray::packetWidth; lane < TransformArray::packetWidth; ++lane)
+    {
+        EXPECT_EQ(p, result.get(lane));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TransformArrayTests, MultiplyPointMatchesTransformInEveryLane)
+{
+    // GIVEN:
+    const auto transforms(generateRandomTransformArray());
+    const auto p(RandomGenerator::generateRandomPoint3());
+
+    for (size_t block = 0; block < transforms.blockCount(); ++block)
+    {
+        // WHEN:
+        const auto result(transforms.multiply(block, p));
+
+        // THEN:
+        const auto first = block * TransformArray::packetWidth;
+        for (size_t i = first; i < std::min(transformCount, first + TransformArray::packetWidth); ++i)
+        {
+            EXPECT_EQ(transforms.get(i).multiply(p), result.get(i % TransformArray::packetWidth));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TransformArrayTests, MultiplyVectorMatchesTransformInEveryLane)
+{
+    // GIVEN:
+    const auto transforms(generateRandomTransformArray());
+    const auto v(RandomGenerator::generateRandomVector3());
+
+    for (size_t block = 0; block < transforms.blockCount(); ++block)
+    {
+        // WHEN:
+        const auto result(transforms.multiply(block, v));
+
+        // THEN:
+        const auto first = block * TransformArray::packetWidth;
+        for (size_t i = first; i < std::min(transformCount, first + TransformArray::packetWidth); ++i)
+        {
+            EXPECT_EQ(transforms.get(i).multiply(v), result.get(i % TransformArray::packetWidth));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TransformArrayTests, MultiplyRayMatchesTransformInEveryLane)
+{
+    // GIVEN:
+    const auto transforms(generateRandomTransformArray());
+    const auto r(RandomGenerator::generateRandomRay3());
+
+    // WHEN:
+    const auto result(transforms.multiply(0, r));
+
+    // THEN:
+    for (size_t lane = 0; lane < TransformArray::packetWidth; ++lane)
+    {
+        EXPECT_EQ(transforms.get(lane).multiply(r), result.get(lane));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TransformArrayTests, MultiplyRayPacketMatchesTransformInEveryLane)
+{
+    // GIVEN:
+    const auto transforms(generateRandomTransformArray());
+    Ray3Packet<TransformArray::packetWidth> packet;
+    for (size_t lane = 0; lane < packet.width; ++lane)
+    {
+        packet.set(lane, RandomGenerator::generateRandomRay3());
+    }
+
+    // WHEN:
+    const auto result(transforms.multiply(0, packet));
+
+    // THEN:
+    for (size_t lane = 0; lane < packet.width; ++lane)
+    {
+        EXPECT_EQ(transforms.get(lane).multiply(packet.get(lane)), result.get(lane));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TransformArrayTests, PremultiplyComposesLikeTransform)
+{
+    // GIVEN:
+    auto transforms(generateRandomTransformArray());
+    const auto original(transforms);
+    const auto t(generateRandomTransform());
+
+    // WHEN:
+    transforms.premultiply(t);
+
+    // THEN:
+    for (size_t i = 0; i < transformCount; ++i)
+    {
+        EXPECT_EQ(t.multiply(original.get(i)), transforms.get(i));
+    }
+}
+
+} // namespace eyebeam
@@ -1,9 +1,13 @@
 #include "transform.h"
 
 #include "random_generator.h"
+#include "transform_array.h"
 
 #include <benchmark/benchmark.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace eyebeam
 {
 
@@ -167,6 +171,55 @@ void benchmarkTransformApplyToNormal(benchmark::State& state)
     }
 }
 
+void benchmarkTransformApplyToNormalsPerCall(benchmark::State& state)
+{
+    std::vector<Normal3> normals(static_cast<size_t>(state.range(0)));
+    for (auto& n : normals)
+    {
+        n = RandomGenerator::generateRandomNormal3();
+    }
+
+    const auto t(Transform::rotateAxisAngle(
+        RandomGenerator::generateRandomVector3(),
+        Radians(RandomGenerator::generateRandomFloat())));
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (auto& n : normals)
+        {
+            n = t.multiply(n);
+        }
+
+        benchmark::DoNotOptimize(normals.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void benchmarkTransformApplyToNormalsBatched(benchmark::State& state)
+{
+    std::vector<Normal3> normals(static_cast<size_t>(state.range(0)));
+    for (auto& n : normals)
+    {
+        n = RandomGenerator::generateRandomNormal3();
+    }
+
+    const auto t(Transform::rotateAxisAngle(
+        RandomGenerator::generateRandomVector3(),
+        Radians(RandomGenerator::generateRandomFloat())));
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        t.transformNormals(normals.data(), normals.size());
+
+        benchmark::DoNotOptimize(normals.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
 void benchmarkTransformApplyToRay(benchmark::State& state)
 {
     const auto r(RandomGenerator::generateRandomRay3());
@@ -195,6 +248,139 @@ void benchmarkTransformCompose(benchmark::State& state)
     }
 }
 
+auto generateRandomTransforms(size_t count)
+{
+    std::vector<Transform> transforms;
+    transforms.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        transforms.push_back(Transform::translate(RandomGenerator::generateRandomVector3())
+                                 .multiply(Transform::rotateAxisAngle(
+                                     RandomGenerator::generateRandomVector3(),
+                                     Radians(RandomGenerator::generateRandomFloat()))));
+    }
+
+    return transforms;
+}
+
+auto makeTransformArray(const std::vector<Transform>& transforms)
+{
+    TransformArray transformArray;
+    transformArray.reserve(transforms.size());
+    for (const auto& t : transforms)
+    {
+        transformArray.add(t);
+    }
+
+    return transformArray;
+}
+
+// One ray transformed by every transform of a set of instances, one Transform at a time
+void benchmarkTransformApplyToRayPerTransform(benchmark::State& state)
+{
+    const auto transforms(generateRandomTransforms(static_cast<size_t>(state.range(0))));
+    const auto r(RandomGenerator::generateRandomRay3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (const auto& t : transforms)
+        {
+            const auto transformed(t.multiply(r));
+            benchmark::DoNotOptimize(transformed);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// The same, TransformArray::packetWidth transforms at a time
+void benchmarkTransformApplyToRayTransformArray(benchmark::State& state)
+{
+    const auto transforms(makeTransformArray(generateRandomTransforms(static_cast<size_t>(state.range(0)))));
+    const auto r(RandomGenerator::generateRandomRay3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (size_t block = 0; block < transforms.blockCount(); ++block)
+        {
+            const auto transformed(transforms.multiply(block, r));
+            benchmark::DoNotOptimize(transformed);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void benchmarkTransformApplyToPointPerTransform(benchmark::State& state)
+{
+    const auto transforms(generateRandomTransforms(static_cast<size_t>(state.range(0))));
+    const auto p(RandomGenerator::generateRandomPoint3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (const auto& t : transforms)
+        {
+            const auto transformed(t.multiply(p));
+            benchmark::DoNotOptimize(transformed);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void benchmarkTransformApplyToPointTransformArray(benchmark::State& state)
+{
+    const auto transforms(makeTransformArray(generateRandomTransforms(static_cast<size_t>(state.range(0)))));
+    const auto p(RandomGenerator::generateRandomPoint3());
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (size_t block = 0; block < transforms.blockCount(); ++block)
+        {
+            const auto transformed(transforms.multiply(block, p));
+            benchmark::DoNotOptimize(transformed);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Moving every instance by the same transform
+void benchmarkTransformComposeManyPerTransform(benchmark::State& state)
+{
+    auto transforms(generateRandomTransforms(static_cast<size_t>(state.range(0))));
+    const auto t(Transform::translate(RandomGenerator::generateRandomVector3()));
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (auto& instance : transforms)
+        {
+            instance = t.multiply(instance);
+        }
+
+        benchmark::DoNotOptimize(transforms.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void benchmarkTransformComposeManyTransformArray(benchmark::State& state)
+{
+    auto transforms(makeTransformArray(generateRandomTransforms(static_cast<size_t>(state.range(0)))));
+    const auto t(Transform::translate(RandomGenerator::generateRandomVector3()));
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        transforms.premultiply(t);
+
+        benchmark::DoNotOptimize(transforms.matrices().blocks().data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
 // NOLINTNEXTLINE
 BENCHMARK(benchmarkTransformDefaultConstruction);
 
@@ -234,12 +420,36 @@ BENCHMARK(benchmarkTransformApplyToVector);
 // NOLINTNEXTLINE
 BENCHMARK(benchmarkTransformApplyToNormal);
 
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTransformApplyToNormalsPerCall)->Arg(16 * 16)->Arg(64 * 64);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTransformApplyToNormalsBatched)->Arg(16 * 16)->Arg(64 * 64);
+
 // NOLINTNEXTLINE
 BENCHMARK(benchmarkTransformApplyToRay);
 
 // NOLINTNEXTLINE
 BENCHMARK(benchmarkTransformCompose);
 
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTransformApplyToRayPerTransform)->Arg(1024)->Arg(128 * 1024);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTransformApplyToRayTransformArray)->Arg(1024)->Arg(128 * 1024);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTransformApplyToPointPerTransform)->Arg(1024)->Arg(128 * 1024);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTransformApplyToPointTransformArray)->Arg(1024)->Arg(128 * 1024);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTransformComposeManyPerTransform)->Arg(1024)->Arg(128 * 1024);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTransformComposeManyTransformArray)->Arg(1024)->Arg(128 * 1024);
+
 } // namespace
 
 } // namespace eyebeam
@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 namespace eyebeam
 {
 
@@ -224,6 +226,32 @@ TEST(TransformTests, TransformMultiplyScalesNormals)
     EXPECT_EQ(expected, result);
 }
 
+// NOLINTNEXTLINE
+TEST(TransformTests, TransformNormalsMatchesMultiplyForEveryNormal)
+{
+    // GIVEN:
+    const auto t(Transform::translate(RandomGenerator::generateRandomVector3())
+                     .multiply(Transform::rotateAxisAngle(
+                         RandomGenerator::generateRandomVector3(),
+                         Radians(RandomGenerator::generateRandomFloat())))
+                     .multiply(Transform::scale(2.0F, 0.5F, 3.0F)));
+    std::vector<Normal3> normals(17);
+    for (auto& n : normals)
+    {
+        n = RandomGenerator::generateRandomNormal3();
+    }
+    const auto original(normals);
+
+    // WHEN:
+    t.transformNormals(normals.data(), normals.size());
+
+    // THEN:
+    for (size_t i = 0; i < normals.size(); ++i)
+    {
+        EXPECT_EQ(t.multiply(original[i]), normals[i]);
+    }
+}
+
 // NOLINTNEXTLINE
 TEST(TransformTests, TransformMultiplyScalesRays)
 {
@@ -242,6 +270,20 @@ TEST(TransformTests, TransformMultiplyScalesRays)
     EXPECT_EQ(expected, result);
 }
 
+// NOLINTNEXTLINE
+TEST(TransformTests, TransformMultiplyKeepsTheShutterTimeOfRays)
+{
+    // GIVEN:
+    const auto t(Transform::translate(Vector3(1.0F, 2.0F, 3.0F)));
+    const Ray3 r(Point3(1.0F, 1.0F, 1.0F), Vector3(0.0F, 0.0F, 1.0F), 0.75F);
+
+    // WHEN:
+    const auto result(t.multiply(r));
+
+    // THEN:
+    EXPECT_EQ(0.75F, result.shutterTime());
+}
+
 // NOLINTNEXTLINE
 TEST(TransformTests, TransformMultiplyComposesTransforms)
 {
@@ -0,0 +1,20 @@
+#include "traversal_ray3.h"
+
+namespace eyebeam
+{
+
+TraversalRay3::TraversalRay3(const Ray3& ray, float tMin, float tMax) noexcept
+    : m_ray(ray)
+    , m_origin{ray.origin().x(), ray.origin().y(), ray.origin().z()}
+    , m_inverseDirection{1.0F / ray.direction().x(), 1.0F / ray.direction().y(), 1.0F / ray.direction().z()}
+    // Taken from the reciprocal so that -0 counts as negative, which keeps the near plane on the side of -infinity
+    , m_directionSigns{
+          static_cast<std::uint8_t>(m_inverseDirection[0] < 0.0F),
+          static_cast<std::uint8_t>(m_inverseDirection[1] < 0.0F),
+          static_cast<std::uint8_t>(m_inverseDirection[2] < 0.0F)}
+    , m_tMin(tMin)
+    , m_tMax(tMax)
+{
+}
+
+} // namespace eyebeam
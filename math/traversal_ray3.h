@@ -0,0 +1,114 @@
+#ifndef INCLUDED_TRAVERSAL_RAY3_H_
+#define INCLUDED_TRAVERSAL_RAY3_H_
+
+#include "ray3.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace eyebeam
+{
+
+// A ray prepared for testing against many axis aligned boxes, such as the nodes of a bounding volume hierarchy. The
+// reciprocal direction and the sign of each direction component are computed once when it is built, so each box test
+// is a few multiplies with no division and no branch on the direction. Only hits in [tMin, tMax] count.
+class TraversalRay3
+{
+public:
+    explicit TraversalRay3(
+        const Ray3& ray,
+        float tMin = 0.0F,
+        float tMax = std::numeric_limits<float>::infinity()) noexcept;
+
+    [[nodiscard]] const auto& ray() const noexcept
+    {
+        return m_ray;
+    }
+
+    [[nodiscard]] const auto& origin() const noexcept
+    {
+        return m_origin;
+    }
+
+    // Infinite along axes the direction does not move along
+    [[nodiscard]] const auto& inverseDirection() const noexcept
+    {
+        return m_inverseDirection;
+    }
+
+    // 1 along axes with a negative direction and 0 otherwise, which is the index of the near plane of a box in
+    // {min, max} along that axis
+    [[nodiscard]] const auto& directionSigns() const noexcept
+    {
+        return m_directionSigns;
+    }
+
+    [[nodiscard]] constexpr auto tMin() const noexcept
+    {
+        return m_tMin;
+    }
+
+    [[nodiscard]] constexpr auto tMax() const noexcept
+    {
+        return m_tMax;
+    }
+
+    // Shrinks the interval once a hit is found, so boxes beyond it are culled
+    constexpr void setTMax(float tMax) noexcept
+    {
+        m_tMax = tMax;
+    }
+
+    // Slab test of the box [boundsMin, boundsMax] over [tMin, maxTime]. A zero direction component gives infinite slab
+    // distances, and a ray starting on a slab plane then gives NaN; the comparisons are ordered so that NaN never
+    // narrows the interval.
+    [[nodiscard]] bool intersects(
+        const std::array<float, 3>& boundsMin,
+        const std::array<float, 3>& boundsMax,
+        float maxTime) const noexcept
+    {
+        // Widens the far distance by a few ulps so rounding in the multiplies cannot cull a box the ray grazes
+        constexpr auto roundingAllowance = 1.0F + 2.0F * 3.0F * std::numeric_limits<float>::epsilon();
+
+        auto nearTime = m_tMin;
+        auto farTime = maxTime;
+
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            // A select rather than an index into {min, max}, which would cost the loads an extra indirection
+            const auto isNegative = m_directionSigns[axis] != 0;
+            const auto nearPlane = isNegative ? boundsMax[axis] : boundsMin[axis];
+            const auto farPlane = isNegative ? boundsMin[axis] : boundsMax[axis];
+
+            const auto axisNear = (nearPlane - m_origin[axis]) * m_inverseDirection[axis];
+            const auto axisFar = (farPlane - m_origin[axis]) * m_inverseDirection[axis] * roundingAllowance;
+
+            nearTime = axisNear > nearTime ? axisNear : nearTime;
+            farTime = axisFar < farTime ? axisFar : farTime;
+        }
+
+        return nearTime <= farTime;
+    }
+
+    // Slab test over [tMin, tMax]
+    [[nodiscard]] bool intersects(
+        const std::array<float, 3>& boundsMin,
+        const std::array<float, 3>& boundsMax) const noexcept
+    {
+        return intersects(boundsMin, boundsMax, m_tMax);
+    }
+
+private:
+    Ray3 m_ray;
+    std::array<float, 3> m_origin;
+    std::array<float, 3> m_inverseDirection;
+    std::array<std::uint8_t, 3> m_directionSigns;
+    float m_tMin;
+    float m_tMax;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_TRAVERSAL_RAY3_H_
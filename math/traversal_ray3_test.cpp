@@ -0,0 +1,115 @@
+#include "traversal_ray3.h"
+
+#include "point3.h"
+#include "ray3.h"
+#include "vector3.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <limits>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr std::array<float, 3> unitBoxMin = {-1.0F, -1.0F, -1.0F};
+constexpr std::array<float, 3> unitBoxMax = {1.0F, 1.0F, 1.0F};
+
+// NOLINTNEXTLINE
+TEST(TraversalRay3Tests, cachesReciprocalDirectionAndSigns)
+{
+    // GIVEN:
+    const Ray3 ray(Point3(1.0F, 2.0F, 3.0F), Vector3(2.0F, -1.0F, 0.0F));
+
+    // WHEN:
+    const TraversalRay3 traversalRay(ray);
+
+    // THEN:
+    EXPECT_FLOAT_EQ(traversalRay.inverseDirection()[0], 1.0F / ray.direction().x());
+    EXPECT_FLOAT_EQ(traversalRay.inverseDirection()[1], 1.0F / ray.direction().y());
+    EXPECT_EQ(traversalRay.inverseDirection()[2], std::numeric_limits<float>::infinity());
+    EXPECT_EQ(traversalRay.directionSigns()[0], 0U);
+    EXPECT_EQ(traversalRay.directionSigns()[1], 1U);
+    EXPECT_EQ(traversalRay.directionSigns()[2], 0U);
+    EXPECT_EQ(traversalRay.tMin(), 0.0F);
+    EXPECT_EQ(traversalRay.tMax(), std::numeric_limits<float>::infinity());
+}
+
+// NOLINTNEXTLINE
+TEST(TraversalRay3Tests, intersectsBoxAheadInEveryDirection)
+{
+    for (const auto& direction :
+         {Vector3(1.0F, 0.0F, 0.0F),
+          Vector3(-1.0F, 0.0F, 0.0F),
+          Vector3(0.0F, 1.0F, 0.0F),
+          Vector3(0.0F, -1.0F, 0.0F),
+          Vector3(0.0F, 0.0F, 1.0F),
+          Vector3(0.0F, 0.0F, -1.0F),
+          Vector3(-1.0F, -1.0F, -1.0F)})
+    {
+        // GIVEN:
+        const Ray3 ray(Point3(0.0F, 0.0F, 0.0F) + -5.0F * norm(direction), direction);
+
+        // WHEN:
+        const TraversalRay3 traversalRay(ray);
+
+        // THEN:
+        EXPECT_TRUE(traversalRay.intersects(unitBoxMin, unitBoxMax));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TraversalRay3Tests, missesBoxBehindOrBesideTheRay)
+{
+    // GIVEN:
+    const TraversalRay3 behind(Ray3(Point3(0.0F, 0.0F, 5.0F), Vector3(0.0F, 0.0F, 1.0F)));
+    const TraversalRay3 beside(Ray3(Point3(0.0F, 2.0F, -5.0F), Vector3(0.0F, 0.0F, 1.0F)));
+
+    // WHEN:
+    const auto hitsBehind = behind.intersects(unitBoxMin, unitBoxMax);
+    const auto hitsBeside = beside.intersects(unitBoxMin, unitBoxMax);
+
+    // THEN:
+    EXPECT_FALSE(hitsBehind);
+    EXPECT_FALSE(hitsBeside);
+}
+
+// NOLINTNEXTLINE
+TEST(TraversalRay3Tests, onlyBoxesWithinTheIntervalAreIntersected)
+{
+    // GIVEN:
+    const Ray3 ray(Point3(0.0F, 0.0F, -5.0F), Vector3(0.0F, 0.0F, 1.0F));
+    TraversalRay3 traversalRay(ray, 0.0F, 3.0F);
+    const TraversalRay3 startingBeyond(ray, 6.5F);
+
+    // WHEN:
+    const auto hitsBeforeTMax = traversalRay.intersects(unitBoxMin, unitBoxMax);
+    traversalRay.setTMax(4.5F);
+    const auto hitsAfterSetTMax = traversalRay.intersects(unitBoxMin, unitBoxMax);
+    const auto hitsAfterTMin = startingBeyond.intersects(unitBoxMin, unitBoxMax);
+
+    // THEN:
+    EXPECT_FALSE(hitsBeforeTMax);
+    EXPECT_TRUE(hitsAfterSetTMax);
+    EXPECT_FALSE(hitsAfterTMin);
+}
+
+// NOLINTNEXTLINE
+TEST(TraversalRay3Tests, rayStartingOnSlabPlaneStillHitsBox)
+{
+    // GIVEN:
+    const TraversalRay3 traversalRay(Ray3(Point3(1.0F, 0.0F, -5.0F), Vector3(0.0F, 0.0F, 1.0F)));
+
+    // WHEN:
+    const auto hits = traversalRay.intersects(unitBoxMin, unitBoxMax);
+
+    // THEN:
+    EXPECT_TRUE(hits);
+}
+
+} // namespace
+
+} // namespace eyebeam
@@ -10,6 +10,8 @@
 namespace eyebeam
 {
 
+class Point3;
+
 class Vector3 : public Components
 {
 public:
@@ -25,25 +27,19 @@ public:
 
     auto& operator+=(const Vector3& rhs) noexcept
     {
-        x() += rhs.x();
-        y() += rhs.y();
-        z() += rhs.z();
+        addComponents(rhs);
         return *this;
     }
 
     auto& operator-=(const Vector3& rhs) noexcept
     {
-        x() -= rhs.x();
-        y() -= rhs.y();
-        z() -= rhs.z();
+        subtractComponents(rhs);
         return *this;
     }
 
     auto& operator*=(float rhs) noexcept
     {
-        x() *= rhs;
-        y() *= rhs;
-        z() *= rhs;
+        scaleComponents(rhs);
         return *this;
     }
 
@@ -51,6 +47,9 @@ public:
     {
         return *this *= (1.0F / rhs);
     }
+
+private:
+    friend Vector3 operator-(const Point3& lhs, const Point3& rhs);
 };
 
 Vector3 operator+(const Vector3& left, const Vector3& right) noexcept;
@@ -0,0 +1 @@
+#include "xoshiro128.h"
@@ -0,0 +1,246 @@
+#ifndef INCLUDED_XOSHIRO128_H_
+#define INCLUDED_XOSHIRO128_H_
+
+#include "simd.h"
+#include "simd_lanes.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace eyebeam
+{
+
+// Expands a 64 bit seed into well mixed bits; consecutive seeds give unrelated results
+[[nodiscard]] constexpr std::uint64_t splitMix64(std::uint64_t& state) noexcept
+{
+    state += 0x9E3779B97F4A7C15ULL;
+    auto z = state;
+    z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+}
+
+// xoshiro128+ by Blackman and Vigna: 128 bits of state, a period of 2^128 - 1 and only a few adds, shifts and xors per
+// number. Its lowest bits are weak, so floats are made from the highest 24 bits. It is a UniformRandomBitGenerator, so
+// it also works with the standard distributions.
+class Xoshiro128Plus
+{
+public:
+    using result_type = std::uint32_t;
+    using State = std::array<std::uint32_t, 4>;
+
+    explicit Xoshiro128Plus(std::uint64_t seed = 0) noexcept : m_state()
+    {
+        const auto low = splitMix64(seed);
+        const auto high = splitMix64(seed);
+        m_state = {
+            static_cast<std::uint32_t>(low),
+            static_cast<std::uint32_t>(low >> 32U),
+            static_cast<std::uint32_t>(high),
+            static_cast<std::uint32_t>(high >> 32U)};
+    }
+
+    // The state must not be all zeros
+    explicit constexpr Xoshiro128Plus(const State& state) noexcept : m_state(state)
+    {
+    }
+
+    // The generator for one item of work, such as a tile in a pass of a render. Seeding by what is being sampled
+    // instead of by the thread that samples it keeps results identical whatever the number of threads.
+    [[nodiscard]] static Xoshiro128Plus forStream(std::uint64_t seed, std::uint64_t stream) noexcept
+    {
+        auto mixed = seed;
+        mixed = splitMix64(mixed) ^ stream;
+        return Xoshiro128Plus(splitMix64(mixed));
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    [[nodiscard]] static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        const auto result = m_state[0] + m_state[3];
+        const auto t = m_state[1] << 9U;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = (m_state[3] << 11U) | (m_state[3] >> 21U);
+
+        return result;
+    }
+
+    // Uniform in [0, 1)
+    constexpr float nextFloat() noexcept
+    {
+        return static_cast<float>(operator()() >> 8U) * 0x1.0p-24F;
+    }
+
+    [[nodiscard]] constexpr const State& state() const noexcept
+    {
+        return m_state;
+    }
+
+private:
+    State m_state;
+};
+
+// Width independent xoshiro128+ streams stepped together, with the state of each word held across lanes so that SSE2
+// or AVX2 steps four or eight streams per instruction. Lane i produces the same numbers as
+// Xoshiro128Plus::forStream(seed, stream * Width + i).
+template <size_t Width>
+class Xoshiro128PlusLanes
+{
+public:
+    Xoshiro128PlusLanes(std::uint64_t seed, std::uint64_t stream) noexcept : m_words()
+    {
+        for (size_t lane = 0; lane < Width; ++lane)
+        {
+            const auto generator = Xoshiro128Plus::forStream(seed, stream * Width + lane);
+            for (size_t word = 0; word < m_words.size(); ++word)
+            {
+                m_words[word].data[lane] = generator.state()[word];
+            }
+        }
+    }
+
+    // One float uniform in [0, 1) from each lane
+    void nextFloats(AlignedLaneStorage<Width>& result) noexcept
+    {
+        size_t lane = 0;
+#if defined(EYEBEAM_SIMD_AVX) && defined(__AVX2__)
+        for (; lane + 8 <= Width; lane += 8)
+        {
+            stepAvx2(lane, result);
+        }
+#endif
+#if defined(EYEBEAM_SIMD_SSE)
+        for (; lane + 4 <= Width; lane += 4)
+        {
+            stepSse2(lane, result);
+        }
+#endif
+        for (; lane < Width; ++lane)
+        {
+            stepScalar(lane, result);
+        }
+    }
+
+    // Fills count floats uniform in [0, 1), taking Width at a time across the lanes
+    void fill(float* output, size_t count) noexcept
+    {
+        AlignedLaneStorage<Width> batch;
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            nextFloats(batch);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::copy(batch.data.begin(), batch.data.end(), output + i);
+        }
+
+        if (i < count)
+        {
+            nextFloats(batch);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::copy_n(batch.data.begin(), count - i, output + i);
+        }
+    }
+
+private:
+    struct alignas(Width * sizeof(std::uint32_t)) LaneWords
+    {
+        std::array<std::uint32_t, Width> data;
+    };
+
+    using Words = std::array<LaneWords, 4>;
+
+    void stepScalar(size_t lane, AlignedLaneStorage<Width>& result) noexcept
+    {
+        Xoshiro128Plus generator(Xoshiro128Plus::State{
+            m_words[0].data[lane],
+            m_words[1].data[lane],
+            m_words[2].data[lane],
+            m_words[3].data[lane]});
+        result.data[lane] = generator.nextFloat();
+
+        for (size_t word = 0; word < m_words.size(); ++word)
+        {
+            m_words[word].data[lane] = generator.state()[word];
+        }
+    }
+
+#if defined(EYEBEAM_SIMD_SSE)
+    void stepSse2(size_t lane, AlignedLaneStorage<Width>& result) noexcept
+    {
+        auto s0 = _mm_load_si128(wordPointer<__m128i>(0, lane));
+        auto s1 = _mm_load_si128(wordPointer<__m128i>(1, lane));
+        auto s2 = _mm_load_si128(wordPointer<__m128i>(2, lane));
+        auto s3 = _mm_load_si128(wordPointer<__m128i>(3, lane));
+
+        const auto bits = _mm_srli_epi32(_mm_add_epi32(s0, s3), 8);
+        const auto t = _mm_slli_epi32(s1, 9);
+        s2 = _mm_xor_si128(s2, s0);
+        s3 = _mm_xor_si128(s3, s1);
+        s1 = _mm_xor_si128(s1, s2);
+        s0 = _mm_xor_si128(s0, s3);
+        s2 = _mm_xor_si128(s2, t);
+        s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+
+        _mm_store_si128(wordPointer<__m128i>(0, lane), s0);
+        _mm_store_si128(wordPointer<__m128i>(1, lane), s1);
+        _mm_store_si128(wordPointer<__m128i>(2, lane), s2);
+        _mm_store_si128(wordPointer<__m128i>(3, lane), s3);
+        _mm_store_ps(&result.data[lane], _mm_mul_ps(_mm_cvtepi32_ps(bits), _mm_set1_ps(0x1.0p-24F)));
+    }
+#endif
+
+#if defined(EYEBEAM_SIMD_AVX) && defined(__AVX2__)
+    void stepAvx2(size_t lane, AlignedLaneStorage<Width>& result) noexcept
+    {
+        auto s0 = _mm256_load_si256(wordPointer<__m256i>(0, lane));
+        auto s1 = _mm256_load_si256(wordPointer<__m256i>(1, lane));
+        auto s2 = _mm256_load_si256(wordPointer<__m256i>(2, lane));
+        auto s3 = _mm256_load_si256(wordPointer<__m256i>(3, lane));
+
+        const auto bits = _mm256_srli_epi32(_mm256_add_epi32(s0, s3), 8);
+        const auto t = _mm256_slli_epi32(s1, 9);
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, t);
+        s3 = _mm256_or_si256(_mm256_slli_epi32(s3, 11), _mm256_srli_epi32(s3, 21));
+
+        _mm256_store_si256(wordPointer<__m256i>(0, lane), s0);
+        _mm256_store_si256(wordPointer<__m256i>(1, lane), s1);
+        _mm256_store_si256(wordPointer<__m256i>(2, lane), s2);
+        _mm256_store_si256(wordPointer<__m256i>(3, lane), s3);
+        _mm256_store_ps(&result.data[lane], _mm256_mul_ps(_mm256_cvtepi32_ps(bits), _mm256_set1_ps(0x1.0p-24F)));
+    }
+#endif
+
+    template <typename Register>
+    [[nodiscard]] Register* wordPointer(size_t word, size_t lane) noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<Register*>(&m_words[word].data[lane]);
+    }
+
+    Words m_words;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_XOSHIRO128_H_
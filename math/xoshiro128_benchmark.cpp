@@ -0,0 +1,90 @@
+#include "xoshiro128.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr size_t batchSize = 4096;
+
+void benchmarkMersenneTwisterUniformFloats(benchmark::State& state)
+{
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<float> distribution;
+    std::vector<float> values(batchSize);
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (auto& value : values)
+        {
+            value = distribution(engine);
+        }
+
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batchSize));
+}
+
+void benchmarkXoshiro128PlusUniformFloats(benchmark::State& state)
+{
+    auto generator = Xoshiro128Plus::forStream(1, 0);
+    std::vector<float> values(batchSize);
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        for (auto& value : values)
+        {
+            value = generator.nextFloat();
+        }
+
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batchSize));
+}
+
+template <size_t Width>
+void benchmarkXoshiro128PlusLanesUniformFloats(benchmark::State& state)
+{
+    Xoshiro128PlusLanes<Width> lanes(1, 0);
+    std::vector<float> values(batchSize);
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        lanes.fill(values.data(), values.size());
+
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batchSize));
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkMersenneTwisterUniformFloats);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkXoshiro128PlusUniformFloats);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkXoshiro128PlusLanesUniformFloats, 4);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkXoshiro128PlusLanesUniformFloats, 8);
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkXoshiro128PlusLanesUniformFloats, 16);
+
+} // namespace
+
+} // namespace eyebeam
@@ -0,0 +1,148 @@
+#include "xoshiro128.h"
+
+#include "simd_lanes.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// NOLINTNEXTLINE
+TEST(Xoshiro128PlusTests, matchesReferenceSequence)
+{
+    // GIVEN:
+    Xoshiro128Plus generator(Xoshiro128Plus::State{1, 2, 3, 4});
+
+    // WHEN:
+    const auto first = generator();
+    const auto second = generator();
+
+    // THEN:
+    EXPECT_EQ(first, 5U);
+    EXPECT_EQ(second, 12295U);
+}
+
+// NOLINTNEXTLINE
+TEST(Xoshiro128PlusTests, sameStreamRepeatsAndOtherStreamsDiffer)
+{
+    // GIVEN:
+    auto generator = Xoshiro128Plus::forStream(42, 7);
+    auto repeated = Xoshiro128Plus::forStream(42, 7);
+    auto nextStream = Xoshiro128Plus::forStream(42, 8);
+    auto otherSeed = Xoshiro128Plus::forStream(43, 7);
+
+    // WHEN:
+    size_t nextStreamMatches = 0;
+    size_t otherSeedMatches = 0;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        const auto value = generator();
+
+        // THEN:
+        EXPECT_EQ(value, repeated());
+        nextStreamMatches += value == nextStream() ? 1 : 0;
+        otherSeedMatches += value == otherSeed() ? 1 : 0;
+    }
+
+    EXPECT_EQ(nextStreamMatches, 0U);
+    EXPECT_EQ(otherSeedMatches, 0U);
+}
+
+// NOLINTNEXTLINE
+TEST(Xoshiro128PlusTests, floatsAreUniformInUnitInterval)
+{
+    // GIVEN:
+    auto generator = Xoshiro128Plus::forStream(1, 0);
+    constexpr size_t count = 100000;
+    constexpr size_t bucketCount = 10;
+    std::vector<size_t> buckets(bucketCount, 0);
+
+    // WHEN:
+    auto sum = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto value = generator.nextFloat();
+
+        // THEN:
+        ASSERT_GE(value, 0.0F);
+        ASSERT_LT(value, 1.0F);
+        sum += value;
+        ++buckets[static_cast<size_t>(value * bucketCount)];
+    }
+
+    EXPECT_NEAR(sum / count, 0.5, 0.01);
+    for (const auto bucket : buckets)
+    {
+        EXPECT_NEAR(static_cast<double>(bucket), count / bucketCount, count / bucketCount * 0.05);
+    }
+}
+
+template <size_t Width>
+void expectLanesMatchScalarStreams()
+{
+    // GIVEN:
+    constexpr std::uint64_t seed = 99;
+    constexpr std::uint64_t stream = 3;
+    Xoshiro128PlusLanes<Width> lanes(seed, stream);
+    std::vector<Xoshiro128Plus> scalars;
+    for (size_t lane = 0; lane < Width; ++lane)
+    {
+        scalars.push_back(Xoshiro128Plus::forStream(seed, stream * Width + lane));
+    }
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        // WHEN:
+        AlignedLaneStorage<Width> values;
+        lanes.nextFloats(values);
+
+        // THEN:
+        for (size_t lane = 0; lane < Width; ++lane)
+        {
+            EXPECT_EQ(values.data[lane], scalars[lane].nextFloat());
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(Xoshiro128PlusLanesTests, everyLaneMatchesItsScalarStream)
+{
+    expectLanesMatchScalarStreams<1>();
+    expectLanesMatchScalarStreams<4>();
+    expectLanesMatchScalarStreams<8>();
+    expectLanesMatchScalarStreams<16>();
+}
+
+// NOLINTNEXTLINE
+TEST(Xoshiro128PlusLanesTests, fillTakesWholeBatchesAcrossLanes)
+{
+    // GIVEN:
+    Xoshiro128PlusLanes<8> lanes(5, 0);
+    Xoshiro128PlusLanes<8> reference(5, 0);
+    std::vector<float> values(21);
+
+    // WHEN:
+    lanes.fill(values.data(), values.size());
+
+    // THEN:
+    for (size_t i = 0; i < values.size(); i += 8)
+    {
+        AlignedLaneStorage<8> batch;
+        reference.nextFloats(batch);
+        for (size_t lane = 0; lane < 8 && i + lane < values.size(); ++lane)
+        {
+            EXPECT_EQ(values[i + lane], batch.data[lane]);
+        }
+    }
+}
+
+} // namespace
+
+} // namespace eyebeam
@@ -0,0 +1,117 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace eyebeam
+{
+
+Arena::Arena(size_t blockSize, std::pmr::memory_resource* upstream) noexcept
+    : m_blockSize(std::max(blockSize, blockAlignment))
+    , m_upstream(upstream)
+{
+}
+
+Arena::~Arena()
+{
+    releaseBlocks();
+}
+
+void Arena::reset()
+{
+    if (m_blocks.size() > 1)
+    {
+        const auto total = capacity();
+        releaseBlocks();
+        addBlock(total);
+    }
+
+    m_offset = 0;
+}
+
+size_t Arena::bytesUsed() const noexcept
+{
+    if (m_blocks.empty())
+    {
+        return 0;
+    }
+
+    return capacity() - m_blocks.back().size + m_offset;
+}
+
+size_t Arena::capacity() const noexcept
+{
+    size_t total = 0;
+    for (const auto& block : m_blocks)
+    {
+        total += block.size;
+    }
+
+    return total;
+}
+
+// Earlier blocks are not revisited, so the space left at the end of a block when the next allocation does not fit is
+// only recovered by reset()
+void* Arena::do_allocate(size_t bytes, size_t alignment)
+{
+    // Offset of the first suitably aligned free byte of the last block. Alignments above blockAlignment are applied to
+    // the address, every smaller one divides the alignment of the block.
+    const auto alignedOffset = [this, alignment] {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto address = reinterpret_cast<std::uintptr_t>(m_blocks.back().data);
+        return (address + m_offset + alignment - 1) / alignment * alignment - address;
+    };
+
+    if (m_blocks.empty() || alignedOffset() + bytes > m_blocks.back().size)
+    {
+        // Larger alignments need room to move the start of the allocation within the new block
+        addBlock(std::max(m_blockSize, bytes + (alignment > blockAlignment ? alignment : 0)));
+    }
+
+    const auto start = alignedOffset();
+    m_offset = start + bytes;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return m_blocks.back().data + start;
+}
+
+void Arena::do_deallocate(
+    [[maybe_unused]] void* p,
+    [[maybe_unused]] size_t bytes,
+    [[maybe_unused]] size_t alignment) noexcept
+{
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void Arena::addBlock(size_t size)
+{
+    // The vector grows before the block is taken, so a failure cannot leak it
+    m_blocks.reserve(m_blocks.size() + 1);
+    m_blocks.push_back(Block{static_cast<std::byte*>(m_upstream->allocate(size, blockAlignment)), size});
+    m_offset = 0;
+}
+
+void Arena::releaseBlocks() noexcept
+{
+    for (const auto& block : m_blocks)
+    {
+        m_upstream->deallocate(block.data, block.size, blockAlignment);
+    }
+
+    m_blocks.clear();
+}
+
+Arena& threadArena()
+{
+    thread_local Arena t_arena;
+    return t_arena;
+}
+
+} // namespace eyebeam
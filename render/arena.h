@@ -0,0 +1,71 @@
+#ifndef INCLUDED_ARENA_H_
+#define INCLUDED_ARENA_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace eyebeam
+{
+
+// Bump allocator for data that lives no longer than a tile or a frame. Allocating only moves a pointer through blocks
+// taken from the upstream resource, deallocating does nothing, and reset() makes all of the memory available again at
+// once. Containers opt in through std::pmr, for example std::pmr::vector<T> values(&arena). An arena is not thread
+// safe; each thread allocates from its own, see threadArena().
+class Arena final : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t defaultBlockSize = size_t{64} * 1024;
+
+    // Blocks start on a cache line, so that arenas of different threads never share one
+    static constexpr size_t blockAlignment = 64;
+
+    explicit Arena(
+        size_t blockSize = defaultBlockSize,
+        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept;
+    ~Arena() final;
+
+    Arena(const Arena&) = delete;
+    Arena(Arena&&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    // Ends the lifetime of everything allocated so far. When that took more than one block, the blocks are replaced by
+    // a single one as large as all of them, so a steady workload soon stops calling the upstream resource at all.
+    void reset();
+
+    // Bytes taken up since the last reset, including alignment padding and the unused ends of full blocks
+    [[nodiscard]] size_t bytesUsed() const noexcept;
+
+    // Bytes held from the upstream resource
+    [[nodiscard]] size_t capacity() const noexcept;
+
+private:
+    struct Block
+    {
+        std::byte* data;
+        size_t size;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) final;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) noexcept final;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final;
+
+    void addBlock(size_t size);
+    void releaseBlocks() noexcept;
+
+    size_t m_blockSize;
+    std::pmr::memory_resource* m_upstream;
+    std::vector<Block> m_blocks;
+    // Offset of the first free byte in the last block
+    size_t m_offset = 0;
+};
+
+// The arena of the calling thread, which lives as long as the thread does. shadeTile() resets it at the start of
+// every tile, so anything allocated from it while shading a tile must not outlive the tile.
+[[nodiscard]] Arena& threadArena();
+
+} // namespace eyebeam
+
+#endif // INCLUDED_ARENA_H_
@@ -0,0 +1,91 @@
+#include "arena.h"
+
+#include "normal3.h"
+#include "point3.h"
+#include "ray3.h"
+#include "vector3.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr size_t pixelsPerTile = size_t{32} * 32;
+
+// What a renderer would keep per hit while shading a pixel
+struct HitRecord
+{
+    Point3 point;
+    Normal3 normal;
+    float time;
+    std::uint32_t primitive;
+};
+
+// The transient data of one tile: a list of hits per pixel, of varying length, and the secondary rays they spawn
+void buildTileData(std::pmr::memory_resource* resource)
+{
+    std::pmr::vector<std::pmr::vector<HitRecord>> hits(resource);
+    std::pmr::vector<Ray3> secondaryRays(resource);
+    hits.reserve(pixelsPerTile);
+
+    for (size_t pixel = 0; pixel < pixelsPerTile; ++pixel)
+    {
+        auto& pixelHits = hits.emplace_back();
+        const auto hitCount = 1 + pixel % 7;
+        for (size_t i = 0; i < hitCount; ++i)
+        {
+            const auto time = static_cast<float>(i);
+            pixelHits.push_back(HitRecord{Point3(time, 0.0F, 0.0F), Normal3(0.0F, 1.0F, 0.0F), time, 0});
+            secondaryRays.emplace_back(Point3(time, 0.0F, 0.0F), Vector3(0.0F, 1.0F, 0.0F));
+        }
+    }
+
+    benchmark::DoNotOptimize(hits.data());
+    benchmark::DoNotOptimize(secondaryRays.data());
+}
+
+// Every thread allocates from the global heap, as standard containers do
+void benchmarkTileDataGlobalHeap(benchmark::State& state)
+{
+    for ([[maybe_unused]] auto s : state)
+    {
+        buildTileData(std::pmr::new_delete_resource());
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * pixelsPerTile));
+}
+
+// Every thread allocates from its own arena, reset per tile as shadeTile does
+void benchmarkTileDataThreadArena(benchmark::State& state)
+{
+    auto& arena = threadArena();
+    for ([[maybe_unused]] auto s : state)
+    {
+        arena.reset();
+        buildTileData(&arena);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * pixelsPerTile));
+}
+
+const auto maxThreads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTileDataGlobalHeap)->ThreadRange(1, maxThreads)->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTileDataThreadArena)->ThreadRange(1, maxThreads)->UseRealTime();
+
+} // namespace
+
+} // namespace eyebeam
@@ -0,0 +1,179 @@
+#include "arena.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// Forwards to the global heap while counting the calls and the bytes outstanding
+class CountingResource final : public std::pmr::memory_resource
+{
+public:
+    size_t allocations = 0;
+    size_t bytesOutstanding = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) final
+    {
+        ++allocations;
+        bytesOutstanding += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) noexcept final
+    {
+        bytesOutstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final
+    {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(ArenaTests, AllocationsAreAlignedAsRequested)
+{
+    // GIVEN:
+    Arena arena(1024);
+
+    for (const size_t alignment : {1, 2, 4, 8, 16, 32, 64, 128, 256})
+    {
+        // WHEN:
+        [[maybe_unused]] const auto* unaligned = arena.allocate(3, 1);
+        const auto* p = arena.allocate(24, alignment);
+
+        // THEN:
+        EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(p) % alignment); // NOLINT
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTests, ResetMakesTheSameMemoryAvailableAgain)
+{
+    // GIVEN:
+    Arena arena;
+    const auto* first = arena.allocate(100, 8);
+    [[maybe_unused]] const auto* second = arena.allocate(200, 8);
+
+    // WHEN:
+    arena.reset();
+
+    // THEN:
+    EXPECT_EQ(first, arena.allocate(100, 8));
+    EXPECT_EQ(100U, arena.bytesUsed());
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTests, AllocationsLargerThanABlockGetABlockOfTheirOwn)
+{
+    // GIVEN:
+    CountingResource upstream;
+    Arena arena(1024, &upstream);
+
+    // WHEN:
+    auto* p = static_cast<std::byte*>(arena.allocate(10000, 16));
+    p[9999] = std::byte{1}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    // THEN:
+    EXPECT_EQ(1U, upstream.allocations);
+    EXPECT_LE(10000U, arena.capacity());
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTests, ResetMergesBlocksSoThatTheSameWorkloadNeedsNoMore)
+{
+    // GIVEN:
+    CountingResource upstream;
+    Arena arena(1024, &upstream);
+    const auto workload = [&arena] {
+        for (int i = 0; i < 100; ++i)
+        {
+            [[maybe_unused]] const auto* p = arena.allocate(100, 8);
+        }
+    };
+
+    workload();
+    arena.reset();
+    const auto allocationsAfterFirstPass = upstream.allocations;
+
+    // WHEN:
+    for (int pass = 0; pass < 10; ++pass)
+    {
+        workload();
+        arena.reset();
+    }
+
+    // THEN:
+    EXPECT_LT(1U, allocationsAfterFirstPass);
+    EXPECT_EQ(allocationsAfterFirstPass, upstream.allocations);
+    EXPECT_EQ(arena.capacity(), upstream.bytesOutstanding);
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTests, DestructionReturnsEveryBlock)
+{
+    // GIVEN:
+    CountingResource upstream;
+
+    // WHEN:
+    {
+        Arena arena(1024, &upstream);
+        for (int i = 0; i < 100; ++i)
+        {
+            [[maybe_unused]] const auto* p = arena.allocate(100, 8);
+        }
+    }
+
+    // THEN:
+    EXPECT_EQ(0U, upstream.bytesOutstanding);
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTests, PmrContainersAllocateFromTheArena)
+{
+    // GIVEN:
+    CountingResource upstream;
+    Arena arena(size_t{1} << 16, &upstream);
+
+    // WHEN:
+    std::pmr::vector<int> values(&arena);
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back(i);
+    }
+
+    // THEN:
+    EXPECT_EQ(999, values.back());
+    EXPECT_EQ(1U, upstream.allocations);
+    EXPECT_LE(1000 * sizeof(int), arena.bytesUsed());
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTests, EveryThreadHasItsOwnArena)
+{
+    // GIVEN:
+    const auto* mainArena = &threadArena();
+    const Arena* otherArena = nullptr;
+
+    // WHEN:
+    std::thread([&otherArena] { otherArena = &threadArena(); }).join();
+
+    // THEN:
+    EXPECT_EQ(mainArena, &threadArena());
+    EXPECT_NE(mainArena, otherArena);
+}
+
+} // namespace eyebeam
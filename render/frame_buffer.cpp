@@ -0,0 +1,13 @@
+#include "frame_buffer.h"
+
+namespace eyebeam
+{
+
+FrameBuffer::FrameBuffer(const SceneResolution& resolution)
+    : m_width(resolution.width())
+    , m_height(resolution.height())
+    , m_pixels(static_cast<size_t>(m_width) * static_cast<size_t>(m_height), Color{0.0F, 0.0F, 0.0F})
+{
+}
+
+} // namespace eyebeam
@@ -0,0 +1,57 @@
+#ifndef INCLUDED_FRAME_BUFFER_H_
+#define INCLUDED_FRAME_BUFFER_H_
+
+#include "color.h"
+#include "scene_resolution.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace eyebeam
+{
+
+// Row major image that the renderers write into
+class FrameBuffer
+{
+public:
+    explicit FrameBuffer(const SceneResolution& resolution);
+
+    [[nodiscard]] auto width() const noexcept
+    {
+        return m_width;
+    }
+
+    [[nodiscard]] auto height() const noexcept
+    {
+        return m_height;
+    }
+
+    [[nodiscard]] const auto& at(int x, int y) const noexcept
+    {
+        return m_pixels[index(x, y)];
+    }
+
+    [[nodiscard]] auto& at(int x, int y) noexcept
+    {
+        return m_pixels[index(x, y)];
+    }
+
+    [[nodiscard]] const auto* data() const noexcept
+    {
+        return m_pixels.data();
+    }
+
+private:
+    [[nodiscard]] size_t index(int x, int y) const noexcept
+    {
+        return static_cast<size_t>(y) * static_cast<size_t>(m_width) + static_cast<size_t>(x);
+    }
+
+    int m_width;
+    int m_height;
+    std::vector<Color> m_pixels;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_FRAME_BUFFER_H_
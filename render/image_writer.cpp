@@ -0,0 +1,288 @@
+#include "image_writer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+using Bytes = std::vector<std::uint8_t>;
+
+// Sampling the transfer curve finely enough that every 8 bit output is reachable avoids a pow per channel
+class SrgbEncoder
+{
+public:
+    SrgbEncoder() noexcept
+    {
+        constexpr auto maxChannel = 255.0F;
+
+        for (size_t i = 0; i < m_table.size(); ++i)
+        {
+            const auto linear = static_cast<float>(i) / static_cast<float>(tableSteps);
+            const auto encoded =
+                linear <= 0.0031308F ? 12.92F * linear : 1.055F * std::pow(linear, 1.0F / 2.4F) - 0.055F;
+            m_table[i] = static_cast<std::uint8_t>(encoded * maxChannel + 0.5F);
+        }
+    }
+
+    [[nodiscard]] std::uint8_t encode(float linear) const noexcept
+    {
+        const auto clamped = std::clamp(linear, 0.0F, 1.0F);
+        return m_table[static_cast<size_t>(clamped * static_cast<float>(tableSteps) + 0.5F)];
+    }
+
+private:
+    static constexpr size_t tableSteps = 1U << 14U;
+
+    std::array<std::uint8_t, tableSteps + 1> m_table{};
+};
+
+std::uint8_t toSrgbByte(float linear) noexcept
+{
+    static const SrgbEncoder s_encoder;
+    return s_encoder.encode(linear);
+}
+
+void writeBytes(std::ostream& os, const std::uint8_t* data, size_t size)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    os.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+void writePpm(const FrameBuffer& frame, std::ostream& os)
+{
+    os << "P6\n" << frame.width() << ' ' << frame.height() << "\n255\n";
+
+    Bytes row(static_cast<size_t>(frame.width()) * 3);
+    for (int y = 0; y < frame.height(); ++y)
+    {
+        for (int x = 0; x < frame.width(); ++x)
+        {
+            const auto& color = frame.at(x, y);
+            const auto offset = static_cast<size_t>(x) * 3;
+            row[offset] = toSrgbByte(color.red);
+            row[offset + 1] = toSrgbByte(color.green);
+            row[offset + 2] = toSrgbByte(color.blue);
+        }
+
+        writeBytes(os, row.data(), row.size());
+    }
+}
+
+// PFM stores rows bottom to top. A negative scale marks the floats as little endian, which assumes a little endian
+// host since the frame is written as is.
+void writePfm(const FrameBuffer& frame, std::ostream& os)
+{
+    static_assert(sizeof(Color) == 3 * sizeof(float), "Color must be three tightly packed floats");
+
+    os << "PF\n" << frame.width() << ' ' << frame.height() << "\n-1.0\n";
+
+    const auto rowSize = static_cast<size_t>(frame.width()) * sizeof(Color);
+    for (int y = frame.height() - 1; y >= 0; --y)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        writeBytes(os, reinterpret_cast<const std::uint8_t*>(&frame.at(0, y)), rowSize);
+    }
+}
+
+class Crc32
+{
+public:
+    Crc32() noexcept
+    {
+        constexpr std::uint32_t polynomial = 0xEDB88320U;
+
+        for (std::uint32_t i = 0; i < m_table.size(); ++i)
+        {
+            auto value = i;
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                value = (value & 1U) != 0 ? polynomial ^ (value >> 1U) : value >> 1U;
+            }
+            m_table[i] = value;
+        }
+    }
+
+    [[nodiscard]] std::uint32_t compute(const Bytes& data) const noexcept
+    {
+        auto crc = 0xFFFFFFFFU;
+        for (const auto byte : data)
+        {
+            crc = m_table[(crc ^ byte) & 0xFFU] ^ (crc >> 8U);
+        }
+
+        return crc ^ 0xFFFFFFFFU;
+    }
+
+private:
+    std::array<std::uint32_t, 256> m_table{};
+};
+
+void appendBigEndian(Bytes& bytes, std::uint32_t value)
+{
+    bytes.push_back(static_cast<std::uint8_t>(value >> 24U));
+    bytes.push_back(static_cast<std::uint8_t>(value >> 16U));
+    bytes.push_back(static_cast<std::uint8_t>(value >> 8U));
+    bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+// The CRC covers the chunk type and data but not the length
+void writePngChunk(std::ostream& os, const char* type, const Bytes& data)
+{
+    static const Crc32 s_crc;
+
+    Bytes typeAndData(type, type + 4);
+    typeAndData.insert(end(typeAndData), begin(data), end(data));
+
+    Bytes length;
+    appendBigEndian(length, static_cast<std::uint32_t>(data.size()));
+    writeBytes(os, length.data(), length.size());
+    writeBytes(os, typeAndData.data(), typeAndData.size());
+
+    Bytes crc;
+    appendBigEndian(crc, s_crc.compute(typeAndData));
+    writeBytes(os, crc.data(), crc.size());
+}
+
+// Wraps data in a zlib stream made of uncompressed deflate blocks
+Bytes storeInZlib(const Bytes& data)
+{
+    constexpr size_t maxBlockSize = 0xFFFF;
+    constexpr std::uint32_t adlerModulus = 65521;
+
+    Bytes stream{0x78, 0x01};
+    stream.reserve(data.size() + data.size() / maxBlockSize * 5 + 16);
+
+    size_t offset = 0;
+    do
+    {
+        const auto blockSize = std::min(maxBlockSize, data.size() - offset);
+        const auto isFinal = offset + blockSize == data.size();
+
+        stream.push_back(isFinal ? 1 : 0);
+        stream.push_back(static_cast<std::uint8_t>(blockSize));
+        stream.push_back(static_cast<std::uint8_t>(blockSize >> 8U));
+        stream.push_back(static_cast<std::uint8_t>(~blockSize));
+        stream.push_back(static_cast<std::uint8_t>(~blockSize >> 8U));
+        stream.insert(end(stream), begin(data) + offset, begin(data) + offset + blockSize);
+
+        offset += blockSize;
+    } while (offset < data.size());
+
+    // The sums cannot overflow 32 bits within adlerBlockSize bytes, so the modulo is only taken once per block
+    constexpr size_t adlerBlockSize = 5552;
+
+    std::uint32_t a = 1;
+    std::uint32_t b = 0;
+    for (size_t blockStart = 0; blockStart < data.size(); blockStart += adlerBlockSize)
+    {
+        const auto blockEnd = std::min(blockStart + adlerBlockSize, data.size());
+        for (auto i = blockStart; i < blockEnd; ++i)
+        {
+            a += data[i];
+            b += a;
+        }
+
+        a %= adlerModulus;
+        b %= adlerModulus;
+    }
+
+    appendBigEndian(stream, (b << 16U) | a);
+    return stream;
+}
+
+void writePng(const FrameBuffer& frame, std::ostream& os)
+{
+    constexpr std::array<std::uint8_t, 8> signature = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    constexpr std::uint8_t bitDepth = 8;
+    constexpr std::uint8_t truecolor = 2;
+
+    writeBytes(os, signature.data(), signature.size());
+
+    Bytes header;
+    appendBigEndian(header, static_cast<std::uint32_t>(frame.width()));
+    appendBigEndian(header, static_cast<std::uint32_t>(frame.height()));
+    header.insert(end(header), {bitDepth, truecolor, 0, 0, 0});
+    writePngChunk(os, "IHDR", header);
+
+    // Every scanline starts with filter type 0, meaning no filtering
+    Bytes scanlines;
+    scanlines.reserve(static_cast<size_t>(frame.height()) * (static_cast<size_t>(frame.width()) * 3 + 1));
+    for (int y = 0; y < frame.height(); ++y)
+    {
+        scanlines.push_back(0);
+        for (int x = 0; x < frame.width(); ++x)
+        {
+            const auto& color = frame.at(x, y);
+            scanlines.push_back(toSrgbByte(color.red));
+            scanlines.push_back(toSrgbByte(color.green));
+            scanlines.push_back(toSrgbByte(color.blue));
+        }
+    }
+
+    writePngChunk(os, "IDAT", storeInZlib(scanlines));
+    writePngChunk(os, "IEND", Bytes());
+}
+
+} // namespace
+
+std::optional<ImageFormat> imageFormatFromName(std::string_view name) noexcept
+{
+    if (name == "ppm")
+    {
+        return ImageFormat::Ppm;
+    }
+
+    if (name == "pfm")
+    {
+        return ImageFormat::Pfm;
+    }
+
+    if (name == "png")
+    {
+        return ImageFormat::Png;
+    }
+
+    return std::nullopt;
+}
+
+std::string_view imageFormatExtension(ImageFormat format) noexcept
+{
+    switch (format)
+    {
+    case ImageFormat::Ppm:
+        return ".ppm";
+    case ImageFormat::Pfm:
+        return ".pfm";
+    case ImageFormat::Png:
+        return ".png";
+    }
+
+    return "";
+}
+
+void writeImage(const FrameBuffer& frame, ImageFormat format, std::ostream& os)
+{
+    switch (format)
+    {
+    case ImageFormat::Ppm:
+        writePpm(frame, os);
+        break;
+    case ImageFormat::Pfm:
+        writePfm(frame, os);
+        break;
+    case ImageFormat::Png:
+        writePng(frame, os);
+        break;
+    }
+}
+
+} // namespace eyebeam
@@ -0,0 +1,34 @@
+#ifndef INCLUDED_IMAGE_WRITER_H_
+#define INCLUDED_IMAGE_WRITER_H_
+
+#include "frame_buffer.h"
+
+#include <iosfwd>
+#include <optional>
+#include <string_view>
+
+namespace eyebeam
+{
+
+enum class ImageFormat
+{
+    // Binary 8 bit portable pixmap, sRGB encoded
+    Ppm,
+    // Portable float map holding the linear frame without any loss
+    Pfm,
+    // 8 bit RGB PNG, sRGB encoded. The image data is stored uncompressed, trading file size for encode time.
+    Png
+};
+
+// Accepts "ppm", "pfm" and "png"
+[[nodiscard]] std::optional<ImageFormat> imageFormatFromName(std::string_view name) noexcept;
+
+// The file extension for format, including the leading dot
+[[nodiscard]] std::string_view imageFormatExtension(ImageFormat format) noexcept;
+
+// os must have been opened in binary mode
+void writeImage(const FrameBuffer& frame, ImageFormat format, std::ostream& os);
+
+} // namespace eyebeam
+
+#endif // INCLUDED_IMAGE_WRITER_H_
@@ -0,0 +1,102 @@
+#include "image_writer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+auto buildGradientFrame()
+{
+    FrameBuffer frame(SceneResolution(3, 2));
+    for (int y = 0; y < frame.height(); ++y)
+    {
+        for (int x = 0; x < frame.width(); ++x)
+        {
+            frame.at(x, y) = Color{static_cast<float>(x) / 2.0F, static_cast<float>(y), 0.0F};
+        }
+    }
+
+    return frame;
+}
+
+auto encode(const FrameBuffer& frame, ImageFormat format)
+{
+    std::ostringstream os(std::ios::binary);
+    writeImage(frame, format, os);
+    return os.str();
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(ImageWriterTests, ImageFormatFromNameAcceptsEveryFormat)
+{
+    // GIVEN:
+    // WHEN:
+    // THEN:
+    EXPECT_EQ(ImageFormat::Ppm, imageFormatFromName("ppm"));
+    EXPECT_EQ(ImageFormat::Pfm, imageFormatFromName("pfm"));
+    EXPECT_EQ(ImageFormat::Png, imageFormatFromName("png"));
+    EXPECT_FALSE(imageFormatFromName("jpg").has_value());
+}
+
+// NOLINTNEXTLINE
+TEST(ImageWriterTests, PpmHasHeaderFollowedBySrgbBytes)
+{
+    // GIVEN:
+    const auto frame(buildGradientFrame());
+
+    // WHEN:
+    const auto result(encode(frame, ImageFormat::Ppm));
+
+    // THEN:
+    const std::string header("P6\n3 2\n255\n");
+    ASSERT_EQ(header.size() + 3 * 2 * 3, result.size());
+    EXPECT_EQ(header, result.substr(0, header.size()));
+    EXPECT_EQ('\x00', result[header.size()]);
+    EXPECT_EQ('\xFF', result[header.size() + 2 * 3]);
+    EXPECT_EQ('\xFF', result[header.size() + 3 * 3 + 1]);
+}
+
+// NOLINTNEXTLINE
+TEST(ImageWriterTests, PfmStoresLinearFloatsBottomRowFirst)
+{
+    // GIVEN:
+    const auto frame(buildGradientFrame());
+
+    // WHEN:
+    const auto result(encode(frame, ImageFormat::Pfm));
+
+    // THEN:
+    const std::string header("PF\n3 2\n-1.0\n");
+    ASSERT_EQ(header.size() + 3 * 2 * sizeof(Color), result.size());
+    EXPECT_EQ(header, result.substr(0, header.size()));
+
+    Color firstStored{};
+    std::memcpy(&firstStored, result.data() + header.size(), sizeof(Color));
+    EXPECT_EQ(frame.at(0, 1).green, firstStored.green);
+}
+
+// NOLINTNEXTLINE
+TEST(ImageWriterTests, PngHasSignatureHeaderAndEndChunk)
+{
+    // GIVEN:
+    const auto frame(buildGradientFrame());
+
+    // WHEN:
+    const auto result(encode(frame, ImageFormat::Png));
+
+    // THEN:
+    EXPECT_EQ(std::string("\x89PNG\r\n\x1A\n", 8), result.substr(0, 8));
+    EXPECT_EQ(std::string("\0\0\0\x0DIHDR\0\0\0\x03\0\0\0\x02\x08\x02", 18), result.substr(8, 18));
+    EXPECT_EQ(std::string("\0\0\0\0IEND\xAE\x42\x60\x82", 12), result.substr(result.size() - 12));
+}
+
+} // namespace eyebeam
@@ -0,0 +1,262 @@
+#include "progressive_renderer.h"
+
+#include "frame_buffer.h"
+#include "scene.h"
+#include "tile.h"
+#include "tile_renderer.h"
+#include "tile_shading.h"
+
+#include "sampler.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// Tiles are published in batches of this many per worker, which keeps the frames flowing to the display thread
+// while leaving the pool enough tiles to balance
+constexpr size_t tilesPerWorkerInBatch = 4;
+
+[[nodiscard]] size_t pixelIndex(int width, int x, int y) noexcept
+{
+    return static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x);
+}
+
+auto toMilliseconds(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+ProgressiveRenderer::ProgressiveRenderer(
+    const Scene& scene,
+    WorkStealingPool& pool,
+    size_t maxSamples,
+    int tileSize,
+    SamplerType samplerType)
+    : m_scene(scene)
+    , m_pool(pool)
+    , m_maxSamples(maxSamples)
+    , m_samplerType(samplerType)
+    // The center of the frame is usually what the user is looking at, so it refines first
+    , m_tiles(buildTiles(scene.resolution(), tileSize, TileOrder::Spiral))
+    , m_sums(static_cast<size_t>(scene.width()) * static_cast<size_t>(scene.height()), Color{0.0F, 0.0F, 0.0F})
+    , m_tileSamples(m_tiles.size(), 0)
+    , m_tileVersions(m_tiles.size(), 0)
+    , m_frames(PublishedFrame{FrameBuffer(scene.resolution()), m_tileVersions, Clock::now()})
+    , m_presentedVersions(m_tiles.size(), 0)
+    , m_thread([this] { renderPasses(); })
+{
+}
+
+ProgressiveRenderer::~ProgressiveRenderer()
+{
+    m_stopping = true;
+    m_thread.join();
+}
+
+std::vector<Tile> ProgressiveRenderer::takeChangedTiles()
+{
+    if (!m_frames.take())
+    {
+        return {};
+    }
+
+    const auto& published = m_frames.front();
+    m_lastLatency = Clock::now() - published.publishTime;
+    m_totalLatency += m_lastLatency;
+    m_maxLatency = std::max(m_maxLatency, m_lastLatency);
+    ++m_presentedFrames;
+
+    std::vector<Tile> changed;
+    for (size_t i = 0; i < m_tiles.size(); ++i)
+    {
+        if (published.tileVersions[i] != m_presentedVersions[i])
+        {
+            m_presentedVersions[i] = published.tileVersions[i];
+            changed.push_back(m_tiles[i]);
+        }
+    }
+
+    return changed;
+}
+
+std::optional<RenderStatistics> ProgressiveRenderer::takeFirstPassStatistics()
+{
+    if (m_hasTakenFirstPassStatistics || !m_hasFirstPassStatistics.load(std::memory_order_acquire))
+    {
+        return std::nullopt;
+    }
+
+    m_hasTakenFirstPassStatistics = true;
+    return m_firstPassStatistics;
+}
+
+FrameHandoffStatistics ProgressiveRenderer::handoffStatistics() const
+{
+    const auto meanLatency = m_presentedFrames == 0
+                                 ? std::chrono::nanoseconds(0)
+                                 : m_totalLatency / static_cast<std::chrono::nanoseconds::rep>(m_presentedFrames);
+    return FrameHandoffStatistics{m_presentedFrames, m_droppedFrames, m_lastLatency, meanLatency, m_maxLatency};
+}
+
+void ProgressiveRenderer::waitUntilConverged()
+{
+    std::unique_lock lock(m_progressMutex);
+    m_progress.wait(lock, [this] { return m_completedPasses >= m_maxSamples; });
+}
+
+void ProgressiveRenderer::renderPasses()
+{
+    const auto batchSize = tilesPerWorkerInBatch * m_pool.threadCount();
+
+    while (!m_stopping && m_completedPasses < m_maxSamples)
+    {
+        const auto passStartTime(Clock::now());
+        const auto countersAtStart(StatsSnapshot::collect());
+        RenderStatistics statistics{std::chrono::nanoseconds(0), m_pool.threadCount(), {}, {}};
+        statistics.tiles.resize(m_tiles.size());
+
+        for (size_t first = 0; first < m_tiles.size(); first += batchSize)
+        {
+            const auto last = std::min(first + batchSize, m_tiles.size());
+
+            m_pool.run(last - first, [&](size_t task, size_t worker) {
+                const auto index = first + task;
+                const auto tileStartTime(Clock::now());
+                renderTile(index);
+                statistics.tiles[index] = TileTiming{m_tiles[index], worker, Clock::now() - tileStartTime};
+            });
+
+            if (m_stopping)
+            {
+                return;
+            }
+
+            for (auto i = first; i < last; ++i)
+            {
+                ++m_tileVersions[i];
+            }
+
+            publishFrame();
+        }
+
+        if (m_completedPasses == 0)
+        {
+            statistics.frameDuration = Clock::now() - passStartTime;
+            statistics.counters = StatsSnapshot::collect() - countersAtStart;
+            m_firstPassStatistics = std::move(statistics);
+            m_hasFirstPassStatistics.store(true, std::memory_order_release);
+        }
+
+        {
+            const std::lock_guard lock(m_progressMutex);
+            ++m_completedPasses;
+        }
+
+        m_progress.notify_all();
+    }
+}
+
+void ProgressiveRenderer::renderTile(size_t index)
+{
+    if (m_stopping)
+    {
+        return;
+    }
+
+    switch (m_samplerType)
+    {
+    case SamplerType::Independent:
+        accumulateTile(index, IndependentSampler());
+        break;
+    case SamplerType::Halton:
+        accumulateTile(index, HaltonSampler());
+        break;
+    case SamplerType::Sobol:
+        accumulateTile(index, SobolSampler());
+        break;
+    case SamplerType::BlueNoise:
+        accumulateTile(index, BlueNoiseSampler());
+        break;
+    }
+
+    ++m_tileSamples[index];
+}
+
+// Every pixel draws its own sample of the sampler for this pass, so neighbouring pixels do not share a sample and a
+// render is the same whatever order the tiles ran in
+template <typename Sampler>
+void ProgressiveRenderer::accumulateTile(size_t index, Sampler sampler)
+{
+    const auto pass = static_cast<std::uint32_t>(m_tileSamples[index]);
+    const auto sampleAt = [&](int x, int y) {
+        sampler.startPixelSample(x, y, pass);
+        const auto offset = sampler.get2D();
+        return CameraSample{offset.x, offset.y, sampler.get1D()};
+    };
+
+    shadeTile(m_scene, m_tiles[index], sampleAt, [&](int x, int y, const Color& color) {
+        auto& sum = m_sums[pixelIndex(m_scene.width(), x, y)];
+        sum.red += color.red;
+        sum.green += color.green;
+        sum.blue += color.blue;
+    });
+}
+
+// The back frame was last written two publications ago, so every tile that gained samples since then is resolved
+// into it again
+void ProgressiveRenderer::publishFrame()
+{
+    auto& published = m_frames.back();
+
+    for (size_t i = 0; i < m_tiles.size(); ++i)
+    {
+        if (published.tileVersions[i] == m_tileVersions[i])
+        {
+            continue;
+        }
+
+        const auto& tile = m_tiles[i];
+        const auto scale = 1.0F / static_cast<float>(m_tileSamples[i]);
+
+        for (int y = tile.y; y < tile.y + tile.height; ++y)
+        {
+            for (int x = tile.x; x < tile.x + tile.width; ++x)
+            {
+                const auto& sum = m_sums[pixelIndex(m_scene.width(), x, y)];
+                published.frame.at(x, y) = Color{sum.red * scale, sum.green * scale, sum.blue * scale};
+            }
+        }
+
+        published.tileVersions[i] = m_tileVersions[i];
+    }
+
+    published.publishTime = Clock::now();
+    if (m_frames.publish())
+    {
+        ++m_droppedFrames;
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, const FrameHandoffStatistics& statistics)
+{
+    return os << statistics.presentedFrames << " frames presented, " << statistics.droppedFrames
+              << " dropped, latency " << toMilliseconds(statistics.meanLatency) << " ms mean, "
+              << toMilliseconds(statistics.maxLatency) << " ms max\n";
+}
+
+} // namespace eyebeam
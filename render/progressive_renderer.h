@@ -0,0 +1,146 @@
+#ifndef INCLUDED_PROGRESSIVE_RENDERER_H_
+#define INCLUDED_PROGRESSIVE_RENDERER_H_
+
+#include "color.h"
+#include "frame_buffer.h"
+#include "tile.h"
+#include "tile_renderer.h"
+#include "triple_buffer.h"
+#include "work_stealing_pool.h"
+
+#include "sampler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace eyebeam
+{
+
+class Scene;
+
+// How frames travelled from the render thread to the display thread
+struct FrameHandoffStatistics
+{
+    size_t presentedFrames;
+    // Frames replaced by a newer one before the display thread took them
+    size_t droppedFrames;
+    // Time from a frame being published to it being taken by the display thread
+    std::chrono::nanoseconds lastLatency;
+    std::chrono::nanoseconds meanLatency;
+    std::chrono::nanoseconds maxLatency;
+};
+
+std::ostream& operator<<(std::ostream& os, const FrameHandoffStatistics& statistics);
+
+// Keeps refining a frame on a render thread of its own, which renders passes of one sample per pixel on a
+// WorkStealingPool and adds them to a float accumulation buffer. Every batch of tiles is resolved into a frame that
+// is handed to the display thread through a TripleBuffer, so neither thread ever waits for the other and the display
+// thread only redraws the tiles that changed. Pass n of a pixel takes sample n of that pixel from a sampler of the
+// chosen type.
+class ProgressiveRenderer
+{
+public:
+    static constexpr size_t defaultMaxSamples = 1024;
+    static constexpr SamplerType defaultSamplerType = SamplerType::Sobol;
+
+    // Starts rendering straight away. scene and pool must outlive the renderer.
+    ProgressiveRenderer(
+        const Scene& scene,
+        WorkStealingPool& pool,
+        size_t maxSamples = defaultMaxSamples,
+        int tileSize = TileRenderer::defaultTileSize,
+        SamplerType samplerType = defaultSamplerType);
+
+    // Stops after the tiles that are being rendered
+    ~ProgressiveRenderer();
+
+    ProgressiveRenderer(const ProgressiveRenderer&) = delete;
+    ProgressiveRenderer(ProgressiveRenderer&&) = delete;
+
+    ProgressiveRenderer& operator=(const ProgressiveRenderer&) = delete;
+    ProgressiveRenderer& operator=(ProgressiveRenderer&&) = delete;
+
+    // Display thread only, like every method below up to completedPasses(). Takes the newest frame the render thread
+    // published, without waiting, and returns the tiles in which it differs from the frame taken before.
+    [[nodiscard]] std::vector<Tile> takeChangedTiles();
+
+    // The frame taken by the last call to takeChangedTiles, holding the mean of the samples of each pixel
+    [[nodiscard]] const FrameBuffer& frame() const noexcept
+    {
+        return m_frames.front().frame;
+    }
+
+    // The timings of the first pass, returned once after it has finished
+    [[nodiscard]] std::optional<RenderStatistics> takeFirstPassStatistics();
+
+    [[nodiscard]] FrameHandoffStatistics handoffStatistics() const;
+
+    [[nodiscard]] auto completedPasses() const noexcept
+    {
+        return m_completedPasses.load();
+    }
+
+    // Blocks until maxSamples passes have been rendered and published
+    void waitUntilConverged();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct PublishedFrame
+    {
+        FrameBuffer frame;
+        // The number of batches that had added to each tile when it was last resolved into frame
+        std::vector<std::uint32_t> tileVersions;
+        Clock::time_point publishTime;
+    };
+
+    void renderPasses();
+    void renderTile(size_t index);
+
+    template <typename Sampler>
+    void accumulateTile(size_t index, Sampler sampler);
+    void publishFrame();
+
+    const Scene& m_scene;
+    WorkStealingPool& m_pool;
+    size_t m_maxSamples;
+    SamplerType m_samplerType;
+    std::vector<Tile> m_tiles;
+
+    // Owned by the render thread and the workers it runs, which only touch the tiles of the current batch
+    std::vector<Color> m_sums;
+    std::vector<size_t> m_tileSamples;
+    std::vector<std::uint32_t> m_tileVersions;
+    std::optional<RenderStatistics> m_firstPassStatistics;
+
+    TripleBuffer<PublishedFrame> m_frames;
+    std::atomic<size_t> m_droppedFrames = 0;
+    std::atomic<bool> m_hasFirstPassStatistics = false;
+
+    // Owned by the display thread
+    std::vector<std::uint32_t> m_presentedVersions;
+    bool m_hasTakenFirstPassStatistics = false;
+    size_t m_presentedFrames = 0;
+    std::chrono::nanoseconds m_lastLatency{0};
+    std::chrono::nanoseconds m_totalLatency{0};
+    std::chrono::nanoseconds m_maxLatency{0};
+
+    std::mutex m_progressMutex;
+    std::condition_variable m_progress;
+    std::atomic<size_t> m_completedPasses = 0;
+    std::atomic<bool> m_stopping = false;
+
+    std::thread m_thread;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_PROGRESSIVE_RENDERER_H_
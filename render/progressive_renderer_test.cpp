@@ -0,0 +1,172 @@
+#include "progressive_renderer.h"
+
+#include "color.h"
+#include "scene.h"
+#include "scene_resolution.h"
+#include "tile.h"
+#include "work_stealing_pool.h"
+
+#include "camera.h"
+#include "geometry.h"
+#include "sphere_pool.h"
+
+#include "point3.h"
+#include "sampler.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+// NOLINTNEXTLINE
+TEST(ProgressiveRendererTests, ConvergedFrameIsTheMeanOfTheSamples)
+{
+    // GIVEN:
+    WorkStealingPool pool(4);
+    const Scene scene(SceneResolution(100, 70));
+
+    // WHEN:
+    ProgressiveRenderer renderer(scene, pool, 8, 16);
+    renderer.waitUntilConverged();
+    const auto changed(renderer.takeChangedTiles());
+    const auto& frame = renderer.frame();
+
+    // THEN:
+    EXPECT_EQ(8U, renderer.completedPasses());
+    EXPECT_EQ(buildTiles(scene.resolution(), 16, TileOrder::Spiral).size(), changed.size());
+    for (int y = 0; y < frame.height(); ++y)
+    {
+        for (int x = 0; x < frame.width(); ++x)
+        {
+            const auto expected(
+                scene.shade(scene.camera().generateRay(static_cast<float>(x) + 0.5F, static_cast<float>(y) + 0.5F)));
+            EXPECT_FLOAT_EQ(expected.red, frame.at(x, y).red);
+            EXPECT_FLOAT_EQ(expected.green, frame.at(x, y).green);
+            EXPECT_FLOAT_EQ(expected.blue, frame.at(x, y).blue);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ProgressiveRendererTests, PassesTakeTheSamplesOfTheChosenSampler)
+{
+    // GIVEN: a sphere whose outline crosses many pixels, so that the samples within them see different colors
+    constexpr std::uint32_t passes = 4;
+    WorkStealingPool pool(2);
+    SpherePool spheres;
+    spheres.add(Point3(0.0F, 0.0F, 5.0F), 1.0F);
+    const Scene scene(
+        SceneResolution(40, 30),
+        Camera(40, 30),
+        Geometry(std::move(spheres), PlanePool(), BoxPool(), TrianglePool(), MeshPool(), InstancePool()));
+
+    // WHEN:
+    ProgressiveRenderer renderer(scene, pool, passes, 16, SamplerType::Halton);
+    renderer.waitUntilConverged();
+    static_cast<void>(renderer.takeChangedTiles());
+    const auto& frame = renderer.frame();
+
+    // THEN:
+    HaltonSampler sampler;
+    for (int y = 0; y < frame.height(); ++y)
+    {
+        for (int x = 0; x < frame.width(); ++x)
+        {
+            auto expected = 0.0F;
+            for (std::uint32_t pass = 0; pass < passes; ++pass)
+            {
+                sampler.startPixelSample(x, y, pass);
+                const auto offset = sampler.get2D();
+                const auto shutterTime = sampler.get1D();
+                expected += scene
+                                .shade(scene.camera().generateRay(
+                                    static_cast<float>(x) + offset.x, static_cast<float>(y) + offset.y, shutterTime))
+                                .red;
+            }
+
+            EXPECT_NEAR(expected / static_cast<float>(passes), frame.at(x, y).red, 1e-3F);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ProgressiveRendererTests, UnchangedTilesAreNotResolvedAgain)
+{
+    // GIVEN:
+    WorkStealingPool pool(4);
+    const Scene scene(SceneResolution(64, 64));
+    ProgressiveRenderer renderer(scene, pool, 2, 16);
+    renderer.waitUntilConverged();
+    static_cast<void>(renderer.takeChangedTiles());
+
+    // WHEN:
+    const auto changed(renderer.takeChangedTiles());
+
+    // THEN:
+    EXPECT_TRUE(changed.empty());
+}
+
+// NOLINTNEXTLINE
+TEST(ProgressiveRendererTests, FirstPassStatisticsAreTakenOnce)
+{
+    // GIVEN:
+    WorkStealingPool pool(2);
+    const Scene scene(SceneResolution(64, 32));
+    ProgressiveRenderer renderer(scene, pool, 3, 16);
+    renderer.waitUntilConverged();
+
+    // WHEN:
+    const auto first(renderer.takeFirstPassStatistics());
+    const auto second(renderer.takeFirstPassStatistics());
+
+    // THEN:
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(8U, first->tiles.size());
+    EXPECT_EQ(2U, first->threadCount);
+    EXPECT_FALSE(second.has_value());
+}
+
+// NOLINTNEXTLINE
+TEST(ProgressiveRendererTests, FramesPublishedBeforeTheyAreTakenAreCountedAsDropped)
+{
+    // GIVEN:
+    WorkStealingPool pool(2);
+    const Scene scene(SceneResolution(100, 70));
+    ProgressiveRenderer renderer(scene, pool, 4, 16);
+    renderer.waitUntilConverged();
+
+    // WHEN:
+    static_cast<void>(renderer.takeChangedTiles());
+    const auto statistics(renderer.handoffStatistics());
+
+    // THEN:
+    // 35 tiles in batches of 8 are published 5 times a pass
+    EXPECT_EQ(1U, statistics.presentedFrames);
+    EXPECT_EQ(19U, statistics.droppedFrames);
+    EXPECT_LE(statistics.meanLatency, statistics.maxLatency);
+}
+
+// NOLINTNEXTLINE
+TEST(ProgressiveRendererTests, DestroyingBeforeConvergenceStopsRendering)
+{
+    // GIVEN:
+    WorkStealingPool pool(2);
+    const Scene scene(SceneResolution(256, 256));
+
+    // WHEN:
+    {
+        const ProgressiveRenderer renderer(scene, pool, 1000000, 16);
+    }
+
+    // THEN:
+    std::atomic<int> executed = 0;
+    pool.run(10, [&executed](size_t, size_t) { ++executed; });
+    EXPECT_EQ(10, executed);
+}
+
+} // namespace eyebeam
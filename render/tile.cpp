@@ -0,0 +1,94 @@
+#include "tile.h"
+
+#include "angle.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// Spreads the lower 16 bits of value so that a zero bit sits between each of them
+constexpr std::uint32_t spreadBits(std::uint32_t value) noexcept
+{
+    value &= 0x0000FFFFU;
+    value = (value | (value << 8U)) & 0x00FF00FFU;
+    value = (value | (value << 4U)) & 0x0F0F0F0FU;
+    value = (value | (value << 2U)) & 0x33333333U;
+    value = (value | (value << 1U)) & 0x55555555U;
+    return value;
+}
+
+constexpr std::uint32_t mortonCode(int column, int row) noexcept
+{
+    return spreadBits(static_cast<std::uint32_t>(column)) | (spreadBits(static_cast<std::uint32_t>(row)) << 1U);
+}
+
+// Rings are squares around the central tile. The low bits order tiles by angle inside their ring.
+std::uint64_t spiralKey(int column, int row, float centerColumn, float centerRow) noexcept
+{
+    constexpr auto fullTurn = 2.0F * constants::pi;
+    constexpr auto angleSteps = static_cast<float>(1U << 24U);
+
+    const auto dx = static_cast<float>(column) - centerColumn;
+    const auto dy = static_cast<float>(row) - centerRow;
+    const auto ring = static_cast<std::uint64_t>(std::round(std::max(std::abs(dx), std::abs(dy))));
+    const auto turn = (std::atan2(dy, dx) + constants::pi) / fullTurn;
+    return (ring << 32U) | static_cast<std::uint64_t>(std::min(turn * angleSteps, angleSteps - 1.0F));
+}
+
+} // namespace
+
+std::vector<Tile> buildTiles(const SceneResolution& resolution, int tileSize, TileOrder order)
+{
+    if (tileSize < 1)
+    {
+        throw std::invalid_argument("buildTiles() called with a tile size of less than one pixel");
+    }
+
+    const auto columns = (resolution.width() + tileSize - 1) / tileSize;
+    const auto rows = (resolution.height() + tileSize - 1) / tileSize;
+
+    const auto centerColumn = static_cast<float>(columns - 1) / 2.0F;
+    const auto centerRow = static_cast<float>(rows - 1) / 2.0F;
+
+    // Sort keys are computed once per tile rather than in every comparison
+    std::vector<std::pair<std::uint64_t, Tile>> keyedTiles;
+    keyedTiles.reserve(static_cast<size_t>(columns) * static_cast<size_t>(rows));
+
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            const auto key = order == TileOrder::Morton ? std::uint64_t{mortonCode(column, row)}
+                                                        : spiralKey(column, row, centerColumn, centerRow);
+            const auto x = column * tileSize;
+            const auto y = row * tileSize;
+            keyedTiles.emplace_back(
+                key,
+                Tile{x, y, std::min(tileSize, resolution.width() - x), std::min(tileSize, resolution.height() - y)});
+        }
+    }
+
+    std::stable_sort(begin(keyedTiles), end(keyedTiles), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    std::vector<Tile> tiles;
+    tiles.reserve(keyedTiles.size());
+    std::transform(begin(keyedTiles), end(keyedTiles), std::back_inserter(tiles), [](const auto& keyedTile) {
+        return keyedTile.second;
+    });
+
+    return tiles;
+}
+
+} // namespace eyebeam
@@ -0,0 +1,33 @@
+#ifndef INCLUDED_TILE_H_
+#define INCLUDED_TILE_H_
+
+#include "scene_resolution.h"
+
+#include <vector>
+
+namespace eyebeam
+{
+
+// Rectangle of pixels [x, x + width) x [y, y + height) rendered as one unit of work
+struct Tile
+{
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+enum class TileOrder
+{
+    // Z-order curve over the tile grid. Consecutive tiles stay close together at every scale.
+    Morton,
+    // Rings growing outwards from the center, so the middle of the frame finishes first
+    Spiral
+};
+
+// Covers the frame with tiles of tileSize x tileSize pixels, clipped at the right and bottom edges, in the given order
+[[nodiscard]] std::vector<Tile> buildTiles(const SceneResolution& resolution, int tileSize, TileOrder order);
+
+} // namespace eyebeam
+
+#endif // INCLUDED_TILE_H_
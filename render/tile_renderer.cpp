@@ -0,0 +1,120 @@
+#include "tile_renderer.h"
+
+#include "scene.h"
+#include "tile_shading.h"
+
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// Every pixel is shaded through its centre
+void renderTile(const Scene& scene, const Tile& tile, FrameBuffer& frame)
+{
+    shadeTile(
+        scene,
+        tile,
+        [](int, int) { return CameraSample{0.5F, 0.5F, 0.5F}; },
+        [&](int x, int y, const Color& color) { frame.at(x, y) = color; });
+}
+
+auto toMilliseconds(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+TileRenderer::TileRenderer(WorkStealingPool& pool, int tileSize, TileOrder order)
+    : m_pool(pool)
+    , m_tileSize(tileSize)
+    , m_order(order)
+{
+}
+
+RenderStatistics TileRenderer::render(const Scene& scene, FrameBuffer& frame) const
+{
+    if (frame.width() != scene.width() || frame.height() != scene.height())
+    {
+        throw std::invalid_argument("TileRenderer::render() called with a frame that does not match the scene");
+    }
+
+    const auto frameStartTime(Clock::now());
+    const auto countersAtStart(StatsSnapshot::collect());
+
+    const auto tiles(buildTiles(scene.resolution(), m_tileSize, m_order));
+
+    RenderStatistics statistics{std::chrono::nanoseconds(0), m_pool.threadCount(), {}, {}};
+    statistics.tiles.resize(tiles.size());
+
+    m_pool.run(tiles.size(), [&](size_t task, size_t worker) {
+        const auto tileStartTime(Clock::now());
+        renderTile(scene, tiles[task], frame);
+        statistics.tiles[task] = TileTiming{tiles[task], worker, Clock::now() - tileStartTime};
+    });
+
+    statistics.frameDuration = Clock::now() - frameStartTime;
+    statistics.counters = StatsSnapshot::collect() - countersAtStart;
+    return statistics;
+}
+
+double millionsPerSecond(const RenderStatistics& statistics, Stat stat) noexcept
+{
+    const auto microseconds = std::chrono::duration<double, std::micro>(statistics.frameDuration).count();
+    return microseconds > 0.0 ? static_cast<double>(statistics.counters[stat]) / microseconds : 0.0;
+}
+
+std::ostream& operator<<(std::ostream& os, const RenderStatistics& statistics)
+{
+    os << "Frame rendered in " << toMilliseconds(statistics.frameDuration) << " ms using "
+       << statistics.threadCount << " threads\n";
+
+    if (statistics.tiles.empty())
+    {
+        return os;
+    }
+
+    std::vector<std::chrono::nanoseconds> workerBusyTime(statistics.threadCount, std::chrono::nanoseconds(0));
+    std::chrono::nanoseconds totalTileTime(0);
+    for (const auto& timing : statistics.tiles)
+    {
+        workerBusyTime[timing.worker] += timing.duration;
+        totalTileTime += timing.duration;
+    }
+
+    const auto [fastestTile, slowestTile] = std::minmax_element(
+        begin(statistics.tiles),
+        end(statistics.tiles),
+        [](const TileTiming& lhs, const TileTiming& rhs) { return lhs.duration < rhs.duration; });
+
+    const auto [leastBusy, mostBusy] = std::minmax_element(begin(workerBusyTime), end(workerBusyTime));
+    const auto meanBusy = totalTileTime / static_cast<std::chrono::nanoseconds::rep>(statistics.threadCount);
+
+    os << statistics.tiles.size() << " tiles, "
+       << toMilliseconds(totalTileTime / static_cast<std::chrono::nanoseconds::rep>(statistics.tiles.size()))
+       << " ms mean, " << toMilliseconds(fastestTile->duration) << " ms fastest, "
+       << toMilliseconds(slowestTile->duration) << " ms slowest at (" << slowestTile->tile.x << ", "
+       << slowestTile->tile.y << ")\n";
+
+    // A ratio of 1 means every worker was busy for the same amount of time
+    os << "Worker busy time " << toMilliseconds(*leastBusy) << " ms to " << toMilliseconds(*mostBusy)
+       << " ms, imbalance " << (meanBusy.count() > 0 ? static_cast<double>(mostBusy->count()) / meanBusy.count() : 1.0)
+       << "\n";
+
+    if constexpr (statsEnabled)
+    {
+        os << millionsPerSecond(statistics, Stat::Samples) << " Msamples/s, "
+           << millionsPerSecond(statistics, Stat::RaysCast) << " Mrays/s: " << statistics.counters;
+    }
+
+    return os;
+}
+
+} // namespace eyebeam
@@ -0,0 +1,61 @@
+#ifndef INCLUDED_TILE_RENDERER_H_
+#define INCLUDED_TILE_RENDERER_H_
+
+#include "frame_buffer.h"
+#include "stats.h"
+#include "tile.h"
+#include "work_stealing_pool.h"
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+namespace eyebeam
+{
+
+class Scene;
+
+struct TileTiming
+{
+    Tile tile;
+    size_t worker;
+    std::chrono::nanoseconds duration;
+};
+
+// Timings of one frame. tiles is in render order, so index i is the i-th tile handed to the pool.
+struct RenderStatistics
+{
+    std::chrono::nanoseconds frameDuration;
+    size_t threadCount;
+    std::vector<TileTiming> tiles;
+    // The work counted while the frame rendered, all zero when stats are compiled out
+    StatsSnapshot counters;
+};
+
+// Millions of counted items per second of frame time
+[[nodiscard]] double millionsPerSecond(const RenderStatistics& statistics, Stat stat) noexcept;
+
+// Summarizes tile durations, how evenly the work spread over the worker threads and the work counted
+std::ostream& operator<<(std::ostream& os, const RenderStatistics& statistics);
+
+// Renders a frame by splitting it into tiles that are shaded in parallel on a WorkStealingPool
+class TileRenderer
+{
+public:
+    static constexpr int defaultTileSize = 32;
+
+    explicit TileRenderer(WorkStealingPool& pool, int tileSize = defaultTileSize, TileOrder order = TileOrder::Morton);
+
+    // frame must have the same resolution as scene
+    RenderStatistics render(const Scene& scene, FrameBuffer& frame) const;
+
+private:
+    WorkStealingPool& m_pool;
+    int m_tileSize;
+    TileOrder m_order;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_TILE_RENDERER_H_
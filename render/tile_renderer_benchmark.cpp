@@ -0,0 +1,62 @@
+#include "tile_renderer.h"
+
+#include "scene.h"
+
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+void benchmarkTileRendererThreads(benchmark::State& state)
+{
+    const Scene scene(SceneResolution(1024, 1024));
+    FrameBuffer frame(scene.resolution());
+    WorkStealingPool pool(static_cast<size_t>(state.range(0)));
+    const TileRenderer renderer(pool);
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto statistics(renderer.render(scene, frame));
+        benchmark::DoNotOptimize(statistics);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * scene.width() * scene.height());
+}
+
+template <TileOrder Order>
+void benchmarkTileRendererOrder(benchmark::State& state)
+{
+    const Scene scene(SceneResolution(1024, 1024));
+    FrameBuffer frame(scene.resolution());
+    WorkStealingPool pool;
+    const TileRenderer renderer(pool, static_cast<int>(state.range(0)), Order);
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto statistics(renderer.render(scene, frame));
+        benchmark::DoNotOptimize(statistics);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * scene.width() * scene.height());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTileRendererThreads)
+    ->RangeMultiplier(2)
+    ->Range(1, static_cast<int64_t>(std::max(std::thread::hardware_concurrency(), 1U)))
+    ->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkTileRendererOrder, TileOrder::Morton)->Arg(16)->Arg(32)->Arg(64)->UseRealTime();
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(benchmarkTileRendererOrder, TileOrder::Spiral)->Arg(16)->Arg(32)->Arg(64)->UseRealTime();
+
+} // namespace
+
+} // namespace eyebeam
@@ -0,0 +1,75 @@
+#include "tile_renderer.h"
+
+#include "frame_buffer.h"
+#include "scene.h"
+#include "scene_resolution.h"
+#include "stats.h"
+#include "tile.h"
+#include "work_stealing_pool.h"
+
+#include "camera.h"
+#include "geometry.h"
+#include "sphere_pool.h"
+
+#include "point3.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+
+namespace eyebeam
+{
+
+// NOLINTNEXTLINE
+TEST(TileRendererTests, FrameStatisticsCountEverySampleOnce)
+{
+    // GIVEN:
+    WorkStealingPool pool(4);
+    const Scene scene(SceneResolution(100, 70));
+    FrameBuffer frame(scene.resolution());
+    const TileRenderer renderer(pool, 16);
+
+    // WHEN:
+    const auto statistics(renderer.render(scene, frame));
+
+    // THEN:
+    EXPECT_EQ(buildTiles(scene.resolution(), 16, TileOrder::Morton).size(), statistics.tiles.size());
+    EXPECT_EQ(statsEnabled ? std::uint64_t{100 * 70} : 0U, statistics.counters[Stat::Samples]);
+}
+
+// NOLINTNEXTLINE
+TEST(TileRendererTests, FrameStatisticsCountTheRaysTracedBySampling)
+{
+    // GIVEN:
+    WorkStealingPool pool(4);
+    SpherePool spheres;
+    spheres.add(Point3(-1.0F, 0.0F, 5.0F), 1.0F);
+    spheres.add(Point3(1.0F, 0.0F, 5.0F), 1.0F);
+    const Scene scene(
+        SceneResolution(100, 70),
+        Camera(100, 70),
+        Geometry(std::move(spheres), PlanePool(), BoxPool(), TrianglePool(), MeshPool(), InstancePool()));
+    FrameBuffer frame(scene.resolution());
+    const TileRenderer renderer(pool, 16);
+
+    // WHEN:
+    const auto statistics(renderer.render(scene, frame));
+
+    // THEN:
+    const auto& counters = statistics.counters;
+    if (statsEnabled)
+    {
+        EXPECT_EQ(counters[Stat::Samples], counters[Stat::RaysCast]);
+        EXPECT_LT(0U, counters[Stat::Hits]);
+        EXPECT_GT(counters[Stat::RaysCast], counters[Stat::Hits]);
+        EXPECT_LT(0U, counters[Stat::BvhNodesVisited]);
+        EXPECT_LT(0U, counters[Stat::PrimitiveTests]);
+    }
+    else
+    {
+        EXPECT_EQ(0U, counters[Stat::RaysCast]);
+    }
+}
+
+} // namespace eyebeam
@@ -0,0 +1 @@
+#include "tile_shading.h"
@@ -0,0 +1,58 @@
+#ifndef INCLUDED_TILE_SHADING_H_
+#define INCLUDED_TILE_SHADING_H_
+
+#include "arena.h"
+#include "camera.h"
+#include "ray3_packet.h"
+#include "scene.h"
+#include "stats.h"
+#include "tile.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace eyebeam
+{
+
+// Rays are generated a packet of this many pixels of a row at a time
+constexpr size_t tileShadingPacketWidth = 8;
+
+// Shades every pixel of tile through the point within it and at the shutter time that sampleAt(x, y) returns as a
+// CameraSample, and passes the color to write(x, y, color). The camera rays of the whole tile are generated up front.
+// The transient data of a tile is allocated from the arena of the calling thread, which is reset first, so once the
+// arena has grown to fit a tile shading allocates nothing from the global heap.
+template <typename SampleAt, typename Write>
+void shadeTile(const Scene& scene, const Tile& tile, SampleAt&& sampleAt, Write&& write)
+{
+    constexpr auto width = tileShadingPacketWidth;
+
+    auto& arena = threadArena();
+    arena.reset();
+    std::pmr::vector<Ray3Packet<width>> packets(&arena);
+
+    scene.camera().generateRays(tile.x, tile.y, tile.width, tile.height, sampleAt, packets);
+
+    const auto perRow = Camera::packetsPerRow<width>(tile.width);
+    for (int row = 0; row < tile.height; ++row)
+    {
+        for (size_t i = 0; i < perRow; ++i)
+        {
+            const auto& packet = packets[static_cast<size_t>(row) * perRow + i];
+            const auto first = static_cast<int>(i * width);
+            const auto lanes = std::min(width, static_cast<size_t>(tile.width - first));
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                write(tile.x + first + static_cast<int>(lane), tile.y + row, scene.shade(packet.get(lane)));
+            }
+        }
+    }
+
+    countStat(Stat::Samples, static_cast<std::uint64_t>(tile.width) * static_cast<std::uint64_t>(tile.height));
+}
+
+} // namespace eyebeam
+
+#endif // INCLUDED_TILE_SHADING_H_
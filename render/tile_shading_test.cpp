@@ -0,0 +1,82 @@
+#include "tile_shading.h"
+
+#include "color.h"
+#include "scene.h"
+#include "scene_resolution.h"
+#include "tile.h"
+
+#include "camera.h"
+#include "geometry.h"
+#include "sphere_pool.h"
+
+#include "point3.h"
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+CameraSample centerOfPixel(int /*x*/, int /*y*/)
+{
+    return CameraSample{0.5F, 0.5F, 0.5F};
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(TileShadingTests, EveryPixelOfTheTileIsWrittenOnce)
+{
+    // GIVEN:
+    const Scene scene(SceneResolution(40, 30));
+    // Wider than a packet and not a multiple of its width
+    const Tile tile{3, 5, 19, 7};
+    std::vector<int> writes(40 * 30, 0);
+
+    // WHEN:
+    shadeTile(scene, tile, centerOfPixel, [&](int x, int y, const Color&) { ++writes[y * 40 + x]; });
+
+    // THEN:
+    for (int y = 0; y < 30; ++y)
+    {
+        for (int x = 0; x < 40; ++x)
+        {
+            const auto inside = x >= tile.x && x < tile.x + tile.width && y >= tile.y && y < tile.y + tile.height;
+            EXPECT_EQ(inside ? 1 : 0, writes[y * 40 + x]);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TileShadingTests, PixelsShowTheGeometryInFrontOfTheCamera)
+{
+    // GIVEN:
+    SpherePool spheres;
+    spheres.add(Point3(0.0F, 0.0F, 5.0F), 1.0F);
+    const Scene scene(
+        SceneResolution(40, 30),
+        Camera(40, 30),
+        Geometry(std::move(spheres), PlanePool(), BoxPool(), TrianglePool(), MeshPool(), InstancePool()));
+    std::vector<Color> colors(40 * 30, Color{-1.0F, -1.0F, -1.0F});
+
+    // WHEN:
+    shadeTile(scene, Tile{0, 0, 40, 30}, centerOfPixel, [&](int x, int y, const Color& color) {
+        colors[y * 40 + x] = color;
+    });
+
+    // THEN:
+    const auto& center = colors[15 * 40 + 20];
+    EXPECT_NEAR(1.0F, center.red, 1e-2F);
+    EXPECT_FLOAT_EQ(center.red, center.green);
+    EXPECT_FLOAT_EQ(center.red, center.blue);
+    EXPECT_FLOAT_EQ(Scene::background.red, colors[0].red);
+    EXPECT_FLOAT_EQ(Scene::background.green, colors[0].green);
+    EXPECT_FLOAT_EQ(Scene::background.blue, colors[0].blue);
+}
+
+} // namespace eyebeam
@@ -0,0 +1,128 @@
+#include "tile.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+auto countCoverage(const SceneResolution& resolution, const std::vector<Tile>& tiles)
+{
+    std::vector<int> coverage(static_cast<size_t>(resolution.width()) * static_cast<size_t>(resolution.height()), 0);
+
+    for (const auto& tile : tiles)
+    {
+        for (int y = tile.y; y < tile.y + tile.height; ++y)
+        {
+            for (int x = tile.x; x < tile.x + tile.width; ++x)
+            {
+                ++coverage[static_cast<size_t>(y) * static_cast<size_t>(resolution.width()) + static_cast<size_t>(x)];
+            }
+        }
+    }
+
+    return coverage;
+}
+
+class TileOrderTests : public testing::TestWithParam<TileOrder>
+{
+};
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_P(TileOrderTests, TilesCoverEveryPixelExactlyOnce)
+{
+    // GIVEN:
+    const SceneResolution resolution(100, 70);
+
+    // WHEN:
+    const auto tiles(buildTiles(resolution, 16, GetParam()));
+
+    // THEN:
+    const auto coverage(countCoverage(resolution, tiles));
+    EXPECT_TRUE(std::all_of(begin(coverage), end(coverage), [](int count) { return count == 1; }));
+}
+
+// NOLINTNEXTLINE
+TEST_P(TileOrderTests, EdgeTilesAreClippedToTheFrame)
+{
+    // GIVEN:
+    const SceneResolution resolution(100, 70);
+
+    // WHEN:
+    const auto tiles(buildTiles(resolution, 16, GetParam()));
+
+    // THEN:
+    for (const auto& tile : tiles)
+    {
+        EXPECT_LE(tile.x + tile.width, resolution.width());
+        EXPECT_LE(tile.y + tile.height, resolution.height());
+    }
+}
+
+// NOLINTNEXTLINE
+INSTANTIATE_TEST_SUITE_P(AllTileOrders, TileOrderTests, testing::Values(TileOrder::Morton, TileOrder::Spiral));
+
+// NOLINTNEXTLINE
+TEST(TileTests, MortonOrderVisitsEachQuadrantBeforeTheNext)
+{
+    // GIVEN:
+    const SceneResolution resolution(4, 4);
+
+    // WHEN:
+    const auto tiles(buildTiles(resolution, 1, TileOrder::Morton));
+
+    // THEN:
+    for (size_t quadrant = 0; quadrant < 4; ++quadrant)
+    {
+        const auto first = tiles[quadrant * 4];
+        for (size_t i = 1; i < 4; ++i)
+        {
+            EXPECT_EQ(first.x / 2, tiles[quadrant * 4 + i].x / 2);
+            EXPECT_EQ(first.y / 2, tiles[quadrant * 4 + i].y / 2);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TileTests, SpiralOrderStartsAtTheCenterAndMovesOutwards)
+{
+    // GIVEN:
+    const SceneResolution resolution(5, 5);
+
+    // WHEN:
+    const auto tiles(buildTiles(resolution, 1, TileOrder::Spiral));
+
+    // THEN:
+    EXPECT_EQ(2, tiles.front().x);
+    EXPECT_EQ(2, tiles.front().y);
+
+    auto previousRing = 0;
+    for (const auto& tile : tiles)
+    {
+        const auto ring = std::max(std::abs(tile.x - 2), std::abs(tile.y - 2));
+        EXPECT_GE(ring, previousRing);
+        previousRing = ring;
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TileTests, BuildTilesThrowsInvalidArgumentForEmptyTiles)
+{
+    // GIVEN:
+    const SceneResolution resolution(100, 70);
+
+    // WHEN:
+    // THEN:
+    EXPECT_THROW(static_cast<void>(buildTiles(resolution, 0, TileOrder::Morton)), std::invalid_argument);
+}
+
+} // namespace eyebeam
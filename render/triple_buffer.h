@@ -0,0 +1,71 @@
+#ifndef INCLUDED_TRIPLE_BUFFER_H_
+#define INCLUDED_TRIPLE_BUFFER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace eyebeam
+{
+
+// Hands values from one producer thread to one consumer thread without either ever waiting for the other. The
+// producer writes into back() and publishes it; the consumer takes the newest published value into front(). Values
+// published faster than they are taken replace each other, so the consumer always sees the latest one.
+template <typename T>
+class TripleBuffer
+{
+public:
+    explicit TripleBuffer(const T& initial) : m_slots{initial, initial, initial}
+    {
+    }
+
+    // Producer only
+    [[nodiscard]] T& back() noexcept
+    {
+        return m_slots[m_back];
+    }
+
+    // Producer only. Makes back() the newest value and hands the producer another slot to write into. Returns true
+    // when the value published before was replaced without the consumer ever taking it.
+    bool publish() noexcept
+    {
+        const auto previous = m_shared.exchange(m_back | isFreshBit, std::memory_order_acq_rel);
+        m_back = previous & slotMask;
+        return (previous & isFreshBit) != 0;
+    }
+
+    // Consumer only. Moves the newest published value into front(). Returns false, leaving front() as it was, when
+    // nothing was published since the last take.
+    bool take() noexcept
+    {
+        if ((m_shared.load(std::memory_order_relaxed) & isFreshBit) == 0)
+        {
+            return false;
+        }
+
+        m_front = m_shared.exchange(m_front, std::memory_order_acq_rel) & slotMask;
+        return true;
+    }
+
+    // Consumer only
+    [[nodiscard]] const T& front() const noexcept
+    {
+        return m_slots[m_front];
+    }
+
+private:
+    static constexpr std::uint8_t slotMask = 0x3;
+    static constexpr std::uint8_t isFreshBit = 0x4;
+
+    std::array<T, 3> m_slots;
+
+    // Index of the slot that is neither being written nor read, and whether it holds a value not yet taken. The
+    // indices owned by each side sit on their own cache lines so that the two threads never share one.
+    alignas(64) std::atomic<std::uint8_t> m_shared = 1;
+    alignas(64) std::uint8_t m_back = 0;
+    alignas(64) std::uint8_t m_front = 2;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_TRIPLE_BUFFER_H_
@@ -0,0 +1,106 @@
+#include "triple_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace eyebeam
+{
+
+// NOLINTNEXTLINE
+TEST(TripleBufferTests, TakeWithoutPublishKeepsFront)
+{
+    // GIVEN:
+    TripleBuffer<int> buffer(7);
+
+    // WHEN:
+    const auto hasTaken = buffer.take();
+
+    // THEN:
+    EXPECT_FALSE(hasTaken);
+    EXPECT_EQ(7, buffer.front());
+}
+
+// NOLINTNEXTLINE
+TEST(TripleBufferTests, TakeReturnsPublishedValueOnce)
+{
+    // GIVEN:
+    TripleBuffer<int> buffer(0);
+    buffer.back() = 42;
+    const auto isDropped = buffer.publish();
+
+    // WHEN:
+    const auto firstTake = buffer.take();
+    const auto secondTake = buffer.take();
+
+    // THEN:
+    EXPECT_FALSE(isDropped);
+    EXPECT_TRUE(firstTake);
+    EXPECT_FALSE(secondTake);
+    EXPECT_EQ(42, buffer.front());
+}
+
+// NOLINTNEXTLINE
+TEST(TripleBufferTests, PublishingOverAnUntakenValueDropsIt)
+{
+    // GIVEN:
+    TripleBuffer<int> buffer(0);
+    buffer.back() = 1;
+    static_cast<void>(buffer.publish());
+
+    // WHEN:
+    buffer.back() = 2;
+    const auto isDropped = buffer.publish();
+    buffer.take();
+
+    // THEN:
+    EXPECT_TRUE(isDropped);
+    EXPECT_EQ(2, buffer.front());
+}
+
+// NOLINTNEXTLINE
+TEST(TripleBufferTests, ConsumerSeesIncreasingValuesFromConcurrentProducer)
+{
+    // GIVEN:
+    struct Pair
+    {
+        int first;
+        int second;
+    };
+
+    constexpr auto valueCount = 100000;
+    TripleBuffer<Pair> buffer(Pair{0, 0});
+    std::atomic<int> dropped = 0;
+
+    // WHEN:
+    std::thread producer([&] {
+        for (int i = 1; i <= valueCount; ++i)
+        {
+            buffer.back() = Pair{i, -i};
+            dropped += buffer.publish() ? 1 : 0;
+        }
+    });
+
+    auto previous = 0;
+    auto taken = 0;
+    auto isConsistent = true;
+    while (previous != valueCount)
+    {
+        if (buffer.take())
+        {
+            const auto value = buffer.front();
+            isConsistent = isConsistent && value.first > previous && value.second == -value.first;
+            previous = value.first;
+            ++taken;
+        }
+    }
+
+    producer.join();
+
+    // THEN:
+    EXPECT_TRUE(isConsistent);
+    EXPECT_EQ(valueCount, taken + dropped);
+}
+
+} // namespace eyebeam
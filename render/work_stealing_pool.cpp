@@ -0,0 +1,143 @@
+#include "work_stealing_pool.h"
+
+#include <algorithm>
+
+namespace eyebeam
+{
+
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    m_queues.reserve(threadCount);
+    for (size_t worker = 0; worker < threadCount; ++worker)
+    {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    m_threads.reserve(threadCount);
+    for (size_t worker = 0; worker < threadCount; ++worker)
+    {
+        m_threads.emplace_back([this, worker]() { workerLoop(worker); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        const std::lock_guard lock(m_batchMutex);
+        m_stopping = true;
+    }
+
+    m_batchStarted.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::run(size_t taskCount, const Task& task)
+{
+    if (taskCount == 0)
+    {
+        return;
+    }
+
+    const auto workerCount = m_queues.size();
+
+    std::unique_lock lock(m_batchMutex);
+    m_task = &task;
+    m_remainingTasks = taskCount;
+
+    for (size_t worker = 0; worker < workerCount; ++worker)
+    {
+        const auto first = worker * taskCount / workerCount;
+        const auto last = (worker + 1) * taskCount / workerCount;
+
+        auto& queue = *m_queues[worker];
+        const std::lock_guard queueLock(queue.mutex);
+        for (auto i = first; i < last; ++i)
+        {
+            queue.tasks.push_back(i);
+        }
+    }
+
+    ++m_generation;
+    m_batchStarted.notify_all();
+
+    m_batchFinished.wait(lock, [this]() { return m_remainingTasks == 0; });
+    m_task = nullptr;
+}
+
+void WorkStealingPool::workerLoop(size_t worker)
+{
+    size_t seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_batchMutex);
+            m_batchStarted.wait(lock, [this, seenGeneration]() {
+                return m_stopping || m_generation != seenGeneration;
+            });
+
+            if (m_stopping)
+            {
+                return;
+            }
+
+            seenGeneration = m_generation;
+        }
+
+        // A worker can still be stealing when the next batch is queued and pick up one of its tasks. m_task is read
+        // after every pop so such a task runs with the batch it belongs to; the queue mutex orders the read after
+        // run() published it.
+        while (const auto index = popOrSteal(worker))
+        {
+            (*m_task)(*index, worker);
+
+            if (m_remainingTasks.fetch_sub(1) == 1)
+            {
+                // Taking the lock orders the notification after run() has started waiting
+                const std::lock_guard lock(m_batchMutex);
+                m_batchFinished.notify_one();
+            }
+        }
+    }
+}
+
+std::optional<size_t> WorkStealingPool::popOrSteal(size_t worker)
+{
+    {
+        auto& own = *m_queues[worker];
+        const std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            const auto index = own.tasks.front();
+            own.tasks.pop_front();
+            return index;
+        }
+    }
+
+    // Victims are visited starting with the next worker so that thieves spread out instead of all hitting worker 0
+    const auto workerCount = m_queues.size();
+    for (size_t offset = 1; offset < workerCount; ++offset)
+    {
+        auto& victim = *m_queues[(worker + offset) % workerCount];
+        const std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            const auto index = victim.tasks.back();
+            victim.tasks.pop_back();
+            return index;
+        }
+    }
+
+    return std::nullopt;
+}
+
+} // namespace eyebeam
@@ -0,0 +1,70 @@
+#ifndef INCLUDED_WORK_STEALING_POOL_H_
+#define INCLUDED_WORK_STEALING_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace eyebeam
+{
+
+// Fixed set of worker threads that execute batches of indexed tasks. Each batch is dealt out to the workers in
+// contiguous blocks, so tasks that are next to each other in the batch usually run on the same thread. A worker that
+// runs out of tasks steals from the far end of another worker's block.
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void(size_t task, size_t worker)>;
+
+    // Zero threads means one per hardware thread
+    explicit WorkStealingPool(size_t threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool(WorkStealingPool&&) = delete;
+
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+
+    [[nodiscard]] auto threadCount() const noexcept
+    {
+        return m_threads.size();
+    }
+
+    // Calls task(i, worker) for every i in [0, taskCount) and returns once all of them have finished. worker is the
+    // index of the calling worker thread, in [0, threadCount()). Tasks must not throw.
+    void run(size_t taskCount, const Task& task);
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    void workerLoop(size_t worker);
+    [[nodiscard]] std::optional<size_t> popOrSteal(size_t worker);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_batchMutex;
+    std::condition_variable m_batchStarted;
+    std::condition_variable m_batchFinished;
+    const Task* m_task = nullptr;
+    size_t m_generation = 0;
+    bool m_stopping = false;
+
+    std::atomic<size_t> m_remainingTasks = 0;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_WORK_STEALING_POOL_H_
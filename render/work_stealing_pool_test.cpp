@@ -0,0 +1,83 @@
+#include "work_stealing_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace eyebeam
+{
+
+// NOLINTNEXTLINE
+TEST(WorkStealingPoolTests, ZeroThreadsUsesEveryHardwareThread)
+{
+    // GIVEN:
+    const auto expected = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    // WHEN:
+    const WorkStealingPool pool(0);
+
+    // THEN:
+    EXPECT_EQ(expected, pool.threadCount());
+}
+
+// NOLINTNEXTLINE
+TEST(WorkStealingPoolTests, RunExecutesEveryTaskExactlyOnce)
+{
+    // GIVEN:
+    WorkStealingPool pool(4);
+    std::vector<std::atomic<int>> executions(1000);
+
+    // WHEN:
+    pool.run(executions.size(), [&executions](size_t task, size_t) { ++executions[task]; });
+
+    // THEN:
+    EXPECT_TRUE(std::all_of(begin(executions), end(executions), [](const auto& count) { return count == 1; }));
+}
+
+// NOLINTNEXTLINE
+TEST(WorkStealingPoolTests, ConsecutiveBatchesDoNotMix)
+{
+    // GIVEN:
+    WorkStealingPool pool(4);
+    std::atomic<int> firstBatch = 0;
+    std::atomic<int> secondBatch = 0;
+
+    // WHEN:
+    for (int repeat = 0; repeat < 100; ++repeat)
+    {
+        pool.run(37, [&firstBatch](size_t, size_t) { ++firstBatch; });
+        pool.run(11, [&secondBatch](size_t, size_t) { ++secondBatch; });
+    }
+
+    // THEN:
+    EXPECT_EQ(3700, firstBatch);
+    EXPECT_EQ(1100, secondBatch);
+}
+
+// NOLINTNEXTLINE
+TEST(WorkStealingPoolTests, IdleWorkersStealFromBusyWorkers)
+{
+    // GIVEN:
+    constexpr size_t workerCount = 2;
+    WorkStealingPool pool(workerCount);
+    std::vector<std::atomic<int>> tasksPerWorker(workerCount);
+
+    // WHEN:
+    // Worker 0 is dealt the slow first task and the rest of its block is left for worker 1 to steal
+    pool.run(8, [&tasksPerWorker](size_t task, size_t worker) {
+        if (task == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        ++tasksPerWorker[worker];
+    });
+
+    // THEN:
+    EXPECT_GT(tasksPerWorker[1], 4);
+}
+
+} // namespace eyebeam
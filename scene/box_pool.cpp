@@ -0,0 +1,88 @@
+#include "box_pool.h"
+
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "normal3.h"
+#include "point3.h"
+#include "ray3.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace eyebeam
+{
+
+BoxPool::BoxPool(std::array<LaneColumn, columnCount> columns) noexcept
+    : m_minX(std::move(columns[0]))
+    , m_minY(std::move(columns[1]))
+    , m_minZ(std::move(columns[2]))
+    , m_maxX(std::move(columns[3]))
+    , m_maxY(std::move(columns[4]))
+    , m_maxZ(std::move(columns[5]))
+{
+}
+
+std::array<const LaneColumn*, BoxPool::columnCount> BoxPool::columns() const noexcept
+{
+    return {&m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ};
+}
+
+void BoxPool::add(const Bounds3& box)
+{
+    m_minX.push_back(box.min().x());
+    m_minY.push_back(box.min().y());
+    m_minZ.push_back(box.min().z());
+    m_maxX.push_back(box.max().x());
+    m_maxY.push_back(box.max().y());
+    m_maxZ.push_back(box.max().z());
+}
+
+Bounds3 BoxPool::bounds(size_t index) const noexcept
+{
+    return Bounds3(
+        Point3(m_minX[index], m_minY[index], m_minZ[index]),
+        Point3(m_maxX[index], m_maxY[index], m_maxZ[index]));
+}
+
+IntersectionInfo BoxPool::intersectionAt(size_t index, const Ray3& ray, float time) const
+{
+    const auto point(evaluate(ray, time));
+    const std::array<float, 3> coordinates = {point.x(), point.y(), point.z()};
+    const std::array<float, 3> minimum = {m_minX[index], m_minY[index], m_minZ[index]};
+    const std::array<float, 3> maximum = {m_maxX[index], m_maxY[index], m_maxZ[index]};
+
+    std::array<float, 3> normal = {0.0F, 0.0F, 0.0F};
+    auto nearestDistance = std::abs(coordinates[0] - minimum[0]);
+    normal[0] = -1.0F;
+
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+        for (const auto side : {-1.0F, 1.0F})
+        {
+            const auto distance = std::abs(coordinates[axis] - (side < 0.0F ? minimum[axis] : maximum[axis]));
+            if (distance < nearestDistance)
+            {
+                nearestDistance = distance;
+                normal = {0.0F, 0.0F, 0.0F};
+                normal[axis] = side;
+            }
+        }
+    }
+
+    return IntersectionInfo(point, Normal3(normal[0], normal[1], normal[2]), time);
+}
+
+void BoxPool::reorder(const BorrowableArray<std::uint32_t>& order)
+{
+    m_minX.reorder(order);
+    m_minY.reorder(order);
+    m_minZ.reorder(order);
+    m_maxX.reorder(order);
+    m_maxY.reorder(order);
+    m_maxZ.reorder(order);
+}
+
+} // namespace eyebeam
@@ -0,0 +1,73 @@
+#ifndef INCLUDED_BOX_POOL_H_
+#define INCLUDED_BOX_POOL_H_
+
+#include "primitive_lanes.h"
+
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "ray3.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace eyebeam
+{
+
+// Axis aligned boxes stored as structure of arrays
+class BoxPool
+{
+public:
+    static constexpr size_t columnCount = 6;
+
+    BoxPool() = default;
+
+    // Adopts columns in the order columns() returns them
+    explicit BoxPool(std::array<LaneColumn, columnCount> columns) noexcept;
+
+    [[nodiscard]] std::array<const LaneColumn*, columnCount> columns() const noexcept;
+
+    void add(const Bounds3& box);
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_minX.size();
+    }
+
+    [[nodiscard]] Bounds3 bounds(size_t index) const noexcept;
+
+    // Distances to the boxes starting at first, using the exit distance when the ray starts inside a box
+    [[nodiscard]] auto hitTimes(const RayLanes& ray, size_t first) const noexcept
+    {
+        const auto slabX0((m_minX.load(first) - ray.originX) * ray.inverseDirectionX);
+        const auto slabX1((m_maxX.load(first) - ray.originX) * ray.inverseDirectionX);
+        const auto slabY0((m_minY.load(first) - ray.originY) * ray.inverseDirectionY);
+        const auto slabY1((m_maxY.load(first) - ray.originY) * ray.inverseDirectionY);
+        const auto slabZ0((m_minZ.load(first) - ray.originZ) * ray.inverseDirectionZ);
+        const auto slabZ1((m_maxZ.load(first) - ray.originZ) * ray.inverseDirectionZ);
+
+        const auto entry(max(max(min(slabX0, slabX1), min(slabY0, slabY1)), min(slabZ0, slabZ1)));
+        const auto exit(min(min(max(slabX0, slabX1), max(slabY0, slabY1)), max(slabZ0, slabZ1)));
+        const auto time(select(entry > PrimitiveLanes(0.0F), entry, exit));
+
+        return missedToInfinity((entry <= exit) & (time > PrimitiveLanes(0.0F)), time);
+    }
+
+    // The normal is that of the face nearest the hit point
+    [[nodiscard]] IntersectionInfo intersectionAt(size_t index, const Ray3& ray, float time) const;
+
+    void reorder(const BorrowableArray<std::uint32_t>& order);
+
+private:
+    LaneColumn m_minX;
+    LaneColumn m_minY;
+    LaneColumn m_minZ;
+    LaneColumn m_maxX;
+    LaneColumn m_maxY;
+    LaneColumn m_maxZ;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_BOX_POOL_H_
@@ -0,0 +1,17 @@
+#ifndef INCLUDED_COLOR_H_
+#define INCLUDED_COLOR_H_
+
+namespace eyebeam
+{
+
+// Linear radiance carried by a pixel, one float per channel
+struct Color
+{
+    float red;
+    float green;
+    float blue;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_COLOR_H_
@@ -0,0 +1,264 @@
+#include "geometry.h"
+
+#include "box_pool.h"
+#include "instance_pool.h"
+#include "mesh_pool.h"
+#include "plane_pool.h"
+#include "primitive_lanes.h"
+#include "sphere_pool.h"
+#include "triangle_pool.h"
+
+#include "bounds3.h"
+#include "bvh.h"
+#include "intersection_info.h"
+#include "normal3.h"
+#include "point3.h"
+#include "ray3.h"
+#include "stats.h"
+#include "traversal_ray3.h"
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+template <typename Pool>
+auto buildHierarchy(Pool& pool)
+{
+    std::vector<BvhPrimitiveRun> runs;
+    runs.push_back(gatherBounds(pool));
+
+    Bvh hierarchy(std::move(runs));
+    pool.reorder(hierarchy.primitiveIndices());
+    return hierarchy;
+}
+
+// Only the winning primitive has its intersection point and normal computed, after the traversal. The traversal ray
+// is limited to closest, which earlier pools may have shortened.
+template <typename Pool, typename Lanes>
+bool intersectPool(
+    const Pool& pool,
+    const Bvh& hierarchy,
+    TraversalRay3& ray,
+    const Lanes& rayLanes,
+    IntersectionInfo& closest)
+{
+    std::optional<PrimitiveHit> closestHit;
+    ScopedStat<Stat::PrimitiveTests> primitiveTests;
+
+    ray.setTMax(closest.getTime());
+    hierarchy.traverseLeaves(ray, [&](std::uint32_t first, std::uint32_t count, float& maxTime) {
+        primitiveTests.add(count);
+        const auto hit(findClosestHit(pool, rayLanes, first, first + count, maxTime));
+        if (hit.has_value())
+        {
+            closestHit = hit;
+            maxTime = hit->time;
+        }
+
+        return false;
+    });
+
+    if (!closestHit.has_value())
+    {
+        return false;
+    }
+
+    closest.updateWithNewIntersection(pool.intersectionAt(closestHit->index, ray.ray(), closestHit->time));
+    return true;
+}
+
+template <typename Pool, typename Lanes>
+bool isPoolOccluded(const Pool& pool, const Bvh& hierarchy, const TraversalRay3& ray, const Lanes& rayLanes)
+{
+    auto isBlocked = false;
+    ScopedStat<Stat::PrimitiveTests> primitiveTests;
+
+    hierarchy.traverseLeaves(ray, [&](std::uint32_t first, std::uint32_t count, float& leafMaxTime) {
+        primitiveTests.add(count);
+        isBlocked = isAnyHit(pool, rayLanes, first, first + count, leafMaxTime);
+        return isBlocked;
+    });
+
+    return isBlocked;
+}
+
+} // namespace
+
+Geometry::Geometry(
+    SpherePool spheres,
+    PlanePool planes,
+    BoxPool boxes,
+    TrianglePool triangles,
+    MeshPool meshes,
+    InstancePool instances)
+    : m_spheres(std::move(spheres))
+    , m_planes(std::move(planes))
+    , m_boxes(std::move(boxes))
+    , m_triangles(std::move(triangles))
+    , m_meshes(std::move(meshes))
+    , m_instances(std::move(instances))
+{
+    // Each pool has its bounds gathered, hierarchy built and primitives reordered independently of the others
+    auto sphereHierarchy = std::async(std::launch::async, [this] { return buildHierarchy(m_spheres); });
+    auto boxHierarchy = std::async(std::launch::async, [this] { return buildHierarchy(m_boxes); });
+    auto meshHierarchy = std::async(std::launch::async, [this] { return buildHierarchy(m_meshes); });
+    auto instanceHierarchy = std::async(std::launch::async, [this] { return buildHierarchy(m_instances); });
+    m_triangleHierarchy = buildHierarchy(m_triangles);
+    m_sphereHierarchy = sphereHierarchy.get();
+    m_boxHierarchy = boxHierarchy.get();
+    m_meshHierarchy = meshHierarchy.get();
+    m_instanceHierarchy = instanceHierarchy.get();
+}
+
+Geometry::Geometry(
+    SpherePool spheres,
+    PlanePool planes,
+    BoxPool boxes,
+    TrianglePool triangles,
+    MeshPool meshes,
+    InstancePool instances,
+    Bvh sphereHierarchy,
+    Bvh boxHierarchy,
+    Bvh triangleHierarchy,
+    Bvh meshHierarchy,
+    std::shared_ptr<const void> backing)
+    : m_spheres(std::move(spheres))
+    , m_planes(std::move(planes))
+    , m_boxes(std::move(boxes))
+    , m_triangles(std::move(triangles))
+    , m_meshes(std::move(meshes))
+    , m_instances(std::move(instances))
+    , m_sphereHierarchy(std::move(sphereHierarchy))
+    , m_boxHierarchy(std::move(boxHierarchy))
+    , m_triangleHierarchy(std::move(triangleHierarchy))
+    , m_meshHierarchy(std::move(meshHierarchy))
+    , m_instanceHierarchy(buildHierarchy(m_instances))
+    , m_backing(std::move(backing))
+{
+}
+
+Bounds3 Geometry::bounds() const noexcept
+{
+    return unite(
+        unite(m_sphereHierarchy.bounds(), m_boxHierarchy.bounds()),
+        unite(unite(m_triangleHierarchy.bounds(), m_meshHierarchy.bounds()), m_instanceHierarchy.bounds()));
+}
+
+bool Geometry::intersect(const Ray3& ray, IntersectionInfo& closest) const
+{
+    const auto hasHit = findIntersection(ray, closest);
+
+    countStat(Stat::RaysCast);
+    countStat(Stat::Hits, hasHit ? 1 : 0);
+    return hasHit;
+}
+
+bool Geometry::isOccluded(const Ray3& ray, float maxTime) const
+{
+    const auto isBlocked = hasOccluder(ray, maxTime);
+
+    countStat(Stat::RaysCast);
+    countStat(Stat::Hits, isBlocked ? 1 : 0);
+    return isBlocked;
+}
+
+// The reciprocal direction of the ray is computed once and shared by every pool and hierarchy
+bool Geometry::findIntersection(const Ray3& ray, IntersectionInfo& closest) const
+{
+    TraversalRay3 traversalRay(ray);
+    const RayLanes rayLanes(traversalRay);
+    auto hasHit = false;
+
+    const auto planeHit(findClosestHit(m_planes, rayLanes, 0, m_planes.size(), closest.getTime()));
+    if (planeHit.has_value())
+    {
+        closest.updateWithNewIntersection(m_planes.intersectionAt(planeHit->index, ray, planeHit->time));
+        hasHit = true;
+    }
+
+    hasHit = intersectPool(m_spheres, m_sphereHierarchy, traversalRay, rayLanes, closest) || hasHit;
+    hasHit = intersectPool(m_boxes, m_boxHierarchy, traversalRay, rayLanes, closest) || hasHit;
+    hasHit = intersectPool(m_triangles, m_triangleHierarchy, traversalRay, rayLanes, closest) || hasHit;
+    if (m_meshes.size() != 0)
+    {
+        hasHit = intersectPool(m_meshes, m_meshHierarchy, traversalRay, ShearedRayLanes(ray), closest) || hasHit;
+    }
+
+    if (m_instances.size() != 0)
+    {
+        hasHit = intersectInstances(ray, traversalRay, closest) || hasHit;
+    }
+
+    countStat(Stat::PrimitiveTests, m_planes.size());
+    return hasHit;
+}
+
+bool Geometry::hasOccluder(const Ray3& ray, float maxTime) const
+{
+    const TraversalRay3 traversalRay(ray, 0.0F, maxTime);
+    const RayLanes rayLanes(traversalRay);
+    const auto isBlocked = isAnyHit(m_planes, rayLanes, 0, m_planes.size(), maxTime) ||
+                           isPoolOccluded(m_spheres, m_sphereHierarchy, traversalRay, rayLanes) ||
+                           isPoolOccluded(m_boxes, m_boxHierarchy, traversalRay, rayLanes) ||
+                           isPoolOccluded(m_triangles, m_triangleHierarchy, traversalRay, rayLanes) ||
+                           (m_meshes.size() != 0 &&
+                            isPoolOccluded(m_meshes, m_meshHierarchy, traversalRay, ShearedRayLanes(ray))) ||
+                           (m_instances.size() != 0 && isOccludedByInstances(ray, traversalRay));
+
+    countStat(Stat::PrimitiveTests, m_planes.size());
+    return isBlocked;
+}
+
+// Each instance the ray reaches has the ray carried into the space of its prototype, whose own hierarchies are then
+// traversed. The closest hit so far limits the object ray too, once scaled to its times.
+bool Geometry::intersectInstances(const Ray3& ray, TraversalRay3& traversalRay, IntersectionInfo& closest) const
+{
+    auto hasHit = false;
+
+    traversalRay.setTMax(closest.getTime());
+    m_instanceHierarchy.traverseLeaves(traversalRay, [&](std::uint32_t first, std::uint32_t count, float& maxTime) {
+        for (auto i = first; i < first + count; ++i)
+        {
+            const auto objectRay(m_instances.toObjectSpace(i, ray));
+            IntersectionInfo objectClosest(Point3(), Normal3(), closest.getTime() * objectRay.timeScale);
+            if (m_instances.prototype(i).findIntersection(objectRay.ray, objectClosest))
+            {
+                closest.updateWithNewIntersection(InstancePool::toWorldSpace(objectRay, ray, objectClosest));
+                maxTime = closest.getTime();
+                hasHit = true;
+            }
+        }
+
+        return false;
+    });
+
+    return hasHit;
+}
+
+bool Geometry::isOccludedByInstances(const Ray3& ray, const TraversalRay3& traversalRay) const
+{
+    auto isBlocked = false;
+
+    m_instanceHierarchy.traverseLeaves(traversalRay, [&](std::uint32_t first, std::uint32_t count, float& maxTime) {
+        for (auto i = first; i < first + count && !isBlocked; ++i)
+        {
+            const auto objectRay(m_instances.toObjectSpace(i, ray));
+            isBlocked = m_instances.prototype(i).hasOccluder(objectRay.ray, maxTime * objectRay.timeScale);
+        }
+
+        return isBlocked;
+    });
+
+    return isBlocked;
+}
+
+} // namespace eyebeam
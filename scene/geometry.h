@@ -0,0 +1,144 @@
+#ifndef INCLUDED_GEOMETRY_H_
+#define INCLUDED_GEOMETRY_H_
+
+#include "box_pool.h"
+#include "instance_pool.h"
+#include "mesh_pool.h"
+#include "plane_pool.h"
+#include "sphere_pool.h"
+#include "triangle_pool.h"
+
+#include "bounds3.h"
+#include "bvh.h"
+#include "intersection_info.h"
+#include "ray3.h"
+#include "traversal_ray3.h"
+
+#include <memory>
+
+namespace eyebeam
+{
+
+// Every primitive in a scene, kept in one pool per primitive type so that intersection never dispatches through a
+// virtual call. Each bounded pool gets its own bounding volume hierarchy and is reordered to match it, which makes
+// every leaf a contiguous run of primitives that is tested as one batch. Instances of other geometries form one more
+// pool, whose hierarchy is the top level above the hierarchies of their prototypes.
+class Geometry
+{
+public:
+    Geometry() = default;
+    Geometry(
+        SpherePool spheres,
+        PlanePool planes,
+        BoxPool boxes,
+        TrianglePool triangles,
+        MeshPool meshes,
+        InstancePool instances);
+
+    // Adopts pools that are already in the leaf order of their hierarchies, as stored in a compiled scene file or
+    // gathered from the chunks of a JSON scene, and builds the hierarchy over the instances. backing keeps any memory
+    // the pools and hierarchies borrow alive for as long as the geometry exists.
+    Geometry(
+        SpherePool spheres,
+        PlanePool planes,
+        BoxPool boxes,
+        TrianglePool triangles,
+        MeshPool meshes,
+        InstancePool instances,
+        Bvh sphereHierarchy,
+        Bvh boxHierarchy,
+        Bvh triangleHierarchy,
+        Bvh meshHierarchy,
+        std::shared_ptr<const void> backing);
+
+    [[nodiscard]] const auto& spheres() const noexcept
+    {
+        return m_spheres;
+    }
+
+    [[nodiscard]] const auto& planes() const noexcept
+    {
+        return m_planes;
+    }
+
+    [[nodiscard]] const auto& boxes() const noexcept
+    {
+        return m_boxes;
+    }
+
+    [[nodiscard]] const auto& triangles() const noexcept
+    {
+        return m_triangles;
+    }
+
+    [[nodiscard]] const auto& meshes() const noexcept
+    {
+        return m_meshes;
+    }
+
+    [[nodiscard]] const auto& instances() const noexcept
+    {
+        return m_instances;
+    }
+
+    [[nodiscard]] const auto& sphereHierarchy() const noexcept
+    {
+        return m_sphereHierarchy;
+    }
+
+    [[nodiscard]] const auto& boxHierarchy() const noexcept
+    {
+        return m_boxHierarchy;
+    }
+
+    [[nodiscard]] const auto& triangleHierarchy() const noexcept
+    {
+        return m_triangleHierarchy;
+    }
+
+    [[nodiscard]] const auto& meshHierarchy() const noexcept
+    {
+        return m_meshHierarchy;
+    }
+
+    [[nodiscard]] const auto& instanceHierarchy() const noexcept
+    {
+        return m_instanceHierarchy;
+    }
+
+    // The bounds of every primitive except the planes, which are unbounded
+    [[nodiscard]] Bounds3 bounds() const noexcept;
+
+    // Merges the closest hit with closest, as Bvh::intersect does. Returns true when closest was updated.
+    bool intersect(const Ray3& ray, IntersectionInfo& closest) const;
+
+    [[nodiscard]] bool isOccluded(const Ray3& ray, float maxTime) const;
+
+private:
+    // The tests behind intersect and isOccluded. They count the primitives tested but not the ray, so that the
+    // prototypes of instances can run them as part of the world ray.
+    bool findIntersection(const Ray3& ray, IntersectionInfo& closest) const;
+    [[nodiscard]] bool hasOccluder(const Ray3& ray, float maxTime) const;
+
+    bool intersectInstances(const Ray3& ray, TraversalRay3& traversalRay, IntersectionInfo& closest) const;
+    [[nodiscard]] bool isOccludedByInstances(const Ray3& ray, const TraversalRay3& traversalRay) const;
+
+    SpherePool m_spheres;
+    PlanePool m_planes;
+    BoxPool m_boxes;
+    TrianglePool m_triangles;
+    MeshPool m_meshes;
+    InstancePool m_instances;
+
+    Bvh m_sphereHierarchy;
+    Bvh m_boxHierarchy;
+    Bvh m_triangleHierarchy;
+    Bvh m_meshHierarchy;
+    Bvh m_instanceHierarchy;
+
+    std::shared_ptr<const void> m_backing;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_GEOMETRY_H_
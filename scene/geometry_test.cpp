@@ -0,0 +1,534 @@
+#include "geometry.h"
+
+#include "box_pool.h"
+#include "instance_pool.h"
+#include "mesh_pool.h"
+#include "plane_pool.h"
+#include "sphere_pool.h"
+#include "triangle_mesh.h"
+#include "triangle_pool.h"
+
+#include "affine_transform.h"
+#include "angle.h"
+#include "animated_transform.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "normal3.h"
+#include "point3.h"
+#include "quaternion.h"
+#include "ray3.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr auto miss = std::numeric_limits<double>::infinity();
+
+using Vector = std::array<double, 3>;
+
+auto toVector(const Point3& p)
+{
+    return Vector{p.x(), p.y(), p.z()};
+}
+
+auto toVector(const Vector3& v)
+{
+    return Vector{v.x(), v.y(), v.z()};
+}
+
+auto toPoint(const Vector& p)
+{
+    return Point3(static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2]));
+}
+
+auto subtract(const Vector& a, const Vector& b)
+{
+    return Vector{a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+auto dot(const Vector& a, const Vector& b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+auto cross(const Vector& a, const Vector& b)
+{
+    return Vector{a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+struct ReferenceSphere
+{
+    Point3 center;
+    float radius;
+};
+
+struct ReferencePlane
+{
+    Point3 point;
+    Normal3 normal;
+};
+
+struct ReferenceTriangle
+{
+    std::array<Point3, 3> vertices;
+};
+
+// The primitives of a scene kept as plain lists, which the reference tests below intersect one by one in double
+// precision without any hierarchy
+struct ReferenceScene
+{
+    std::vector<ReferenceSphere> spheres;
+    std::vector<ReferencePlane> planes;
+    std::vector<Bounds3> boxes;
+    std::vector<ReferenceTriangle> triangles;
+    std::vector<ReferenceTriangle> meshTriangles;
+};
+
+double intersect(const ReferenceSphere& sphere, const Ray3& ray)
+{
+    const auto toOrigin = subtract(toVector(ray.origin()), toVector(sphere.center));
+    const auto direction = toVector(ray.direction());
+    const auto b = dot(toOrigin, direction);
+    const auto c = dot(toOrigin, toOrigin) - static_cast<double>(sphere.radius) * static_cast<double>(sphere.radius);
+    const auto discriminant = b * b - c;
+    if (discriminant < 0.0)
+    {
+        return miss;
+    }
+
+    const auto nearTime = -b - std::sqrt(discriminant);
+    const auto farTime = -b + std::sqrt(discriminant);
+    return nearTime > 0.0 ? nearTime : (farTime > 0.0 ? farTime : miss);
+}
+
+double intersect(const ReferencePlane& plane, const Ray3& ray)
+{
+    const Vector normal{plane.normal.x(), plane.normal.y(), plane.normal.z()};
+    const auto time = dot(subtract(toVector(plane.point), toVector(ray.origin())), normal) /
+                      dot(toVector(ray.direction()), normal);
+    return time > 0.0 ? time : miss;
+}
+
+double intersect(const Bounds3& box, const Ray3& ray)
+{
+    const auto origin = toVector(ray.origin());
+    const auto direction = toVector(ray.direction());
+    const auto minimum = toVector(box.min());
+    const auto maximum = toVector(box.max());
+
+    auto enter = -miss;
+    auto exit = miss;
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+        const auto near = (minimum[axis] - origin[axis]) / direction[axis];
+        const auto far = (maximum[axis] - origin[axis]) / direction[axis];
+        enter = std::max(enter, std::min(near, far));
+        exit = std::min(exit, std::max(near, far));
+    }
+
+    return enter <= exit && exit > 0.0 ? (enter > 0.0 ? enter : exit) : miss;
+}
+
+double intersect(const ReferenceTriangle& triangle, const Ray3& ray)
+{
+    const auto origin = toVector(ray.origin());
+    const auto direction = toVector(ray.direction());
+    const auto vertex0 = toVector(triangle.vertices[0]);
+    const auto edge1 = subtract(toVector(triangle.vertices[1]), vertex0);
+    const auto edge2 = subtract(toVector(triangle.vertices[2]), vertex0);
+
+    const auto p = cross(direction, edge2);
+    const auto determinant = dot(edge1, p);
+    if (determinant == 0.0)
+    {
+        return miss;
+    }
+
+    const auto toOrigin = subtract(origin, vertex0);
+    const auto u = dot(toOrigin, p) / determinant;
+    const auto q = cross(toOrigin, edge1);
+    const auto v = dot(direction, q) / determinant;
+    const auto time = dot(edge2, q) / determinant;
+    return u >= 0.0 && v >= 0.0 && u + v <= 1.0 && time > 0.0 ? time : miss;
+}
+
+template <typename Primitives>
+double closestTime(const Primitives& primitives, const Ray3& ray)
+{
+    auto closest = miss;
+    for (const auto& primitive : primitives)
+    {
+        closest = std::min(closest, intersect(primitive, ray));
+    }
+
+    return closest;
+}
+
+double closestTime(const ReferenceScene& scene, const Ray3& ray)
+{
+    return std::min(
+        {closestTime(scene.spheres, ray),
+         closestTime(scene.planes, ray),
+         closestTime(scene.boxes, ray),
+         closestTime(scene.triangles, ray),
+         closestTime(scene.meshTriangles, ray)});
+}
+
+// Primitives of every type scattered through [-10, 10]^3, with a floor below them
+ReferenceScene makeReferenceScene()
+{
+    std::mt19937 engine(1234);
+    std::uniform_real_distribution<float> position(-10.0F, 10.0F);
+    std::uniform_real_distribution<float> size(0.1F, 1.0F);
+    std::uniform_real_distribution<float> offset(-1.0F, 1.0F);
+
+    const auto randomPoint = [&] { return Point3(position(engine), position(engine), position(engine)); };
+    const auto randomTriangle = [&] {
+        const auto corner(randomPoint());
+        return ReferenceTriangle{
+            {corner,
+             corner + Vector3(offset(engine), offset(engine), offset(engine)),
+             corner + Vector3(offset(engine), offset(engine), offset(engine))}};
+    };
+
+    ReferenceScene scene;
+    scene.planes.push_back(ReferencePlane{Point3(0.0F, -12.0F, 0.0F), Normal3(0.0F, 1.0F, 0.0F)});
+    for (size_t i = 0; i < 300; ++i)
+    {
+        scene.spheres.push_back(ReferenceSphere{randomPoint(), size(engine)});
+
+        const auto minimum(randomPoint());
+        scene.boxes.emplace_back(minimum, minimum + Vector3(size(engine), size(engine), size(engine)));
+
+        scene.triangles.push_back(randomTriangle());
+        scene.meshTriangles.push_back(randomTriangle());
+    }
+
+    return scene;
+}
+
+// Only the mesh triangles of the scene, which instances place and quantization applies to
+ReferenceScene onlyMeshes(ReferenceScene scene)
+{
+    scene.spheres.clear();
+    scene.planes.clear();
+    scene.boxes.clear();
+    scene.triangles.clear();
+    return scene;
+}
+
+Geometry makeGeometry(const ReferenceScene& scene, MeshVertexFormat meshVertexFormat = MeshVertexFormat::Float)
+{
+    SpherePool spheres;
+    for (const auto& sphere : scene.spheres)
+    {
+        spheres.add(sphere.center, sphere.radius);
+    }
+
+    PlanePool planes;
+    for (const auto& plane : scene.planes)
+    {
+        planes.add(plane.point, plane.normal);
+    }
+
+    BoxPool boxes;
+    for (const auto& box : scene.boxes)
+    {
+        boxes.add(box);
+    }
+
+    TrianglePool triangles;
+    for (const auto& triangle : scene.triangles)
+    {
+        triangles.add(triangle.vertices[0], triangle.vertices[1], triangle.vertices[2]);
+    }
+
+    TriangleMesh mesh;
+    for (const auto& triangle : scene.meshTriangles)
+    {
+        const auto first = static_cast<std::uint32_t>(mesh.vertexCount());
+        for (const auto& vertex : triangle.vertices)
+        {
+            mesh.addVertex(vertex);
+        }
+
+        mesh.addTriangle(first, first + 1, first + 2);
+    }
+
+    MeshPool meshes;
+    meshes.add(mesh);
+    if (meshVertexFormat == MeshVertexFormat::Quantized16)
+    {
+        meshes.quantize();
+    }
+
+    return Geometry(
+        std::move(spheres),
+        std::move(planes),
+        std::move(boxes),
+        std::move(triangles),
+        std::move(meshes),
+        InstancePool());
+}
+
+// Rays from outside the scene towards random points within it, so that they cross many primitives and none starts
+// inside one
+std::vector<Ray3> makeRays(size_t count)
+{
+    std::mt19937 engine(5678);
+    std::uniform_real_distribution<float> position(-10.0F, 10.0F);
+    std::uniform_real_distribution<float> angle(0.0F, 2.0F * constants::pi);
+
+    std::vector<Ray3> rays;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto theta = angle(engine);
+        const Point3 origin(30.0F * std::cos(theta), position(engine), 30.0F * std::sin(theta));
+        const Point3 target(position(engine), position(engine), position(engine));
+        rays.emplace_back(origin, target - origin);
+    }
+
+    return rays;
+}
+
+// Rays from well outside the bounds towards points spread over each of their faces, each point set just inside or
+// just outside its face
+std::vector<Ray3> makeRaysNearFaces(const Bounds3& bounds, float shutterTime)
+{
+    const auto minimum = toVector(bounds.min());
+    const auto maximum = toVector(bounds.max());
+    const auto extent = subtract(maximum, minimum);
+
+    std::vector<Ray3> rays;
+    for (size_t face = 0; face < 6; ++face)
+    {
+        const auto axis = face % 3;
+        const auto a = (axis + 1) % 3;
+        const auto b = (axis + 2) % 3;
+        const auto side = face < 3 ? -1.0 : 1.0;
+        for (const auto inset : {-1e-3, 1e-3})
+        {
+            for (const auto u : {0.1, 0.5, 0.9})
+            {
+                for (const auto v : {0.1, 0.5, 0.9})
+                {
+                    Vector target{};
+                    target[axis] = (side < 0.0 ? minimum[axis] : maximum[axis]) - side * inset * extent[axis];
+                    target[a] = minimum[a] + u * extent[a];
+                    target[b] = minimum[b] + v * extent[b];
+
+                    auto origin = target;
+                    origin[axis] += 30.0 * side;
+                    origin[a] += 2.0;
+                    origin[b] -= 1.0;
+                    rays.emplace_back(toPoint(origin), toPoint(target) - toPoint(origin), shutterTime);
+                }
+            }
+        }
+    }
+
+    return rays;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(GeometryTests, ClosestHitsMatchTestingEveryPrimitive)
+{
+    // GIVEN:
+    const auto reference(makeReferenceScene());
+    const auto geometry(makeGeometry(reference));
+
+    for (const auto& ray : makeRays(2000))
+    {
+        // WHEN:
+        IntersectionInfo closest;
+        const auto hasHit = geometry.intersect(ray, closest);
+
+        // THEN:
+        const auto expected = closestTime(reference, ray);
+        ASSERT_EQ(expected != miss, hasHit);
+        if (hasHit)
+        {
+            EXPECT_NEAR(expected, closest.getTime(), expected * 1e-4);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(GeometryTests, OcclusionMatchesTestingEveryPrimitive)
+{
+    // GIVEN:
+    const auto reference(makeReferenceScene());
+    const auto geometry(makeGeometry(reference));
+
+    for (const auto& ray : makeRays(2000))
+    {
+        // WHEN: the ray stops well before or well after the closest primitive
+        const auto expected = closestTime(reference, ray);
+        const auto maxTime = expected == miss ? 100.0F : static_cast<float>(expected);
+
+        // THEN:
+        EXPECT_FALSE(geometry.isOccluded(ray, 0.99F * maxTime));
+        EXPECT_EQ(expected != miss, geometry.isOccluded(ray, 1.01F * maxTime));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(GeometryTests, QuantizedMeshesAreHitLikeTheirFloatCopy)
+{
+    // GIVEN: only meshes, so every hit lands on a quantized triangle
+    const auto reference(onlyMeshes(makeReferenceScene()));
+    const auto floatGeometry(makeGeometry(reference));
+    const auto quantizedGeometry(makeGeometry(reference, MeshVertexFormat::Quantized16));
+    ASSERT_EQ(MeshVertexFormat::Quantized16, quantizedGeometry.meshes().vertexFormat());
+
+    // Vertices move by up to half a step of the grid over the meshes, which moves hits further along rays that meet a
+    // triangle at a grazing angle, and rays that graze an edge may change sides
+    const auto halfStep = 0.5F * 20.0F / 65535.0F;
+    size_t hitCount = 0;
+    size_t disagreementCount = 0;
+    for (const auto& ray : makeRays(2000))
+    {
+        // WHEN:
+        IntersectionInfo floatClosest;
+        IntersectionInfo quantizedClosest;
+        const auto hasFloatHit = floatGeometry.intersect(ray, floatClosest);
+        const auto hasQuantizedHit = quantizedGeometry.intersect(ray, quantizedClosest);
+
+        // THEN:
+        hitCount += hasFloatHit ? 1 : 0;
+        if (hasFloatHit != hasQuantizedHit)
+        {
+            ++disagreementCount;
+        }
+        else if (hasFloatHit)
+        {
+            EXPECT_NEAR(0.0F, length(floatClosest.getPoint() - quantizedClosest.getPoint()), 20.0F * halfStep);
+        }
+    }
+
+    EXPECT_GT(hitCount, 100U);
+    EXPECT_LE(disagreementCount, 2U);
+}
+
+// NOLINTNEXTLINE
+TEST(GeometryTests, InstancesAreHitLikeTheirTransformedGeometry)
+{
+    // GIVEN: the same primitives once as a prototype placed by a transform and once transformed into the world
+    const AffineTransform placement(Transform::translate(Vector3(2.0F, -1.0F, 3.0F))
+                                        .multiply(Transform::rotateY(Radians(0.7F)))
+                                        .multiply(Transform::scale(1.5F, 0.5F, 1.0F)));
+    const auto prototypeScene(onlyMeshes(makeReferenceScene()));
+    auto placedScene(prototypeScene);
+    for (auto& triangle : placedScene.meshTriangles)
+    {
+        for (auto& vertex : triangle.vertices)
+        {
+            vertex = placement.multiply(vertex);
+        }
+    }
+
+    InstancePool instances;
+    instances.add(
+        instances.addPrototype(std::make_shared<const Geometry>(makeGeometry(prototypeScene))), placement);
+    const Geometry instanced(SpherePool(), PlanePool(), BoxPool(), TrianglePool(), MeshPool(), std::move(instances));
+    const auto flattened(makeGeometry(placedScene));
+
+    for (const auto& ray : makeRays(2000))
+    {
+        // WHEN:
+        IntersectionInfo instancedClosest;
+        IntersectionInfo flattenedClosest;
+        const auto hasInstancedHit = instanced.intersect(ray, instancedClosest);
+        const auto hasFlattenedHit = flattened.intersect(ray, flattenedClosest);
+
+        // THEN:
+        ASSERT_EQ(hasFlattenedHit, hasInstancedHit);
+        if (hasInstancedHit)
+        {
+            const auto time = flattenedClosest.getTime();
+            EXPECT_NEAR(time, instancedClosest.getTime(), time * 1e-4F);
+            EXPECT_NEAR(1.0F, std::abs(dot(flattenedClosest.getNormal(), instancedClosest.getNormal())), 1e-3F);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(GeometryTests, MovingInstancesAreHitLikeTheirGeometryPlacedAtTheRayTime)
+{
+    // GIVEN: a prototype that moves, turns and stretches through three keyframes
+    const AnimatedTransform motion({
+        TransformKeyframe{
+            0.0F, Vector3(-3.0F, 0.0F, 1.0F), Quaternion::rotateY(Radians(0.0F)), Vector3(1.0F, 1.0F, 1.0F)},
+        TransformKeyframe{
+            0.4F, Vector3(1.0F, 2.0F, 0.0F), Quaternion::rotateY(Radians(0.8F)), Vector3(1.2F, 1.2F, 1.2F)},
+        TransformKeyframe{
+            1.0F, Vector3(4.0F, -1.0F, -2.0F), Quaternion::rotateX(Radians(0.5F)), Vector3(0.8F, 1.0F, 1.3F)},
+    });
+    const auto prototypeScene(onlyMeshes(makeReferenceScene()));
+
+    InstancePool instances;
+    instances.add(instances.addPrototype(std::make_shared<const Geometry>(makeGeometry(prototypeScene))), motion);
+    const Geometry instanced(SpherePool(), PlanePool(), BoxPool(), TrianglePool(), MeshPool(), std::move(instances));
+
+    for (const auto shutterTime : {0.0F, 0.15F, 0.4F, 0.73F, 1.0F})
+    {
+        auto placedScene(prototypeScene);
+        for (auto& triangle : placedScene.meshTriangles)
+        {
+            for (auto& vertex : triangle.vertices)
+            {
+                vertex = motion.at(shutterTime).multiply(vertex);
+            }
+        }
+
+        const auto flattened(makeGeometry(placedScene));
+        EXPECT_EQ(instanced.bounds(), unite(instanced.bounds(), flattened.bounds()));
+
+        auto rays(makeRaysNearFaces(instanced.bounds(), shutterTime));
+        const auto nearFlattenedFaces(makeRaysNearFaces(flattened.bounds(), shutterTime));
+        rays.insert(rays.end(), nearFlattenedFaces.begin(), nearFlattenedFaces.end());
+        for (const auto& ray : makeRays(500))
+        {
+            rays.emplace_back(ray.origin(), ray.direction(), shutterTime);
+        }
+
+        for (const auto& ray : rays)
+        {
+            // WHEN:
+            IntersectionInfo instancedClosest;
+            IntersectionInfo flattenedClosest;
+            const auto hasInstancedHit = instanced.intersect(ray, instancedClosest);
+            const auto hasFlattenedHit = flattened.intersect(ray, flattenedClosest);
+
+            // THEN:
+            ASSERT_EQ(hasFlattenedHit, hasInstancedHit) << "at shutter time " << shutterTime;
+            if (hasInstancedHit)
+            {
+                const auto time = flattenedClosest.getTime();
+                EXPECT_NEAR(time, instancedClosest.getTime(), time * 1e-4F);
+                EXPECT_NEAR(1.0F, std::abs(dot(flattenedClosest.getNormal(), instancedClosest.getNormal())), 1e-3F);
+            }
+        }
+    }
+}
+
+} // namespace eyebeam
@@ -0,0 +1,128 @@
+#include "instance_pool.h"
+
+#include "geometry.h"
+
+#include "affine_transform.h"
+#include "animated_transform.h"
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "normal3.h"
+#include "point3.h"
+#include "ray3.h"
+#include "vector3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+std::uint32_t InstancePool::addPrototype(std::shared_ptr<const Geometry> prototype)
+{
+    const auto bounds(prototype->bounds());
+    if (bounds.isEmpty())
+    {
+        throw std::invalid_argument("Prototypes need at least one bounded primitive");
+    }
+
+    m_prototypes.push_back(std::move(prototype));
+    m_prototypeBounds.push_back(bounds);
+    return static_cast<std::uint32_t>(m_prototypes.size() - 1);
+}
+
+void InstancePool::add(std::uint32_t prototype, const AffineTransform& objectToWorld)
+{
+    if (prototype >= m_prototypes.size())
+    {
+        throw std::out_of_range("Instance of an unknown prototype");
+    }
+
+    m_objectToWorld.push_back(objectToWorld);
+    m_prototypeIndices.push_back(prototype);
+    m_motionIndices.push_back(noMotion);
+}
+
+void InstancePool::add(std::uint32_t prototype, AnimatedTransform objectToWorld)
+{
+    add(prototype, objectToWorld.at(0.0F));
+    m_motionIndices.back() = static_cast<std::uint32_t>(m_motions.size());
+    m_motions.push_back(std::move(objectToWorld));
+}
+
+AffineTransform InstancePool::objectToWorld(size_t index, float shutterTime) const noexcept
+{
+    const auto motion = m_motionIndices[index];
+    return motion == noMotion ? m_objectToWorld[index] : m_motions[motion].at(shutterTime);
+}
+
+Bounds3 InstancePool::bounds(size_t index) const
+{
+    const auto& objectBounds = m_prototypeBounds[m_prototypeIndices[index]];
+    const auto motion = m_motionIndices[index];
+    if (motion != noMotion)
+    {
+        return m_motions[motion].motionBounds(objectBounds);
+    }
+
+    const auto& objectToWorld = m_objectToWorld[index];
+    Bounds3 worldBounds;
+    for (size_t corner = 0; corner < 8; ++corner)
+    {
+        worldBounds.unite(objectToWorld.multiply(Point3(
+            (corner & 1U) == 0 ? objectBounds.min().x() : objectBounds.max().x(),
+            (corner & 2U) == 0 ? objectBounds.min().y() : objectBounds.max().y(),
+            (corner & 4U) == 0 ? objectBounds.min().z() : objectBounds.max().z())));
+    }
+
+    return worldBounds;
+}
+
+ObjectRay InstancePool::toObjectSpace(size_t index, const Ray3& ray) const
+{
+    auto objectToWorld(this->objectToWorld(index, ray.shutterTime()));
+    const auto worldToObject(objectToWorld.inverse());
+    const auto direction(worldToObject.multiply(ray.direction()));
+    return ObjectRay{
+        Ray3(worldToObject.multiply(ray.origin()), direction, ray.shutterTime()),
+        length(direction),
+        std::move(objectToWorld)};
+}
+
+// The point is found along the world ray, as every other pool does, and the normal by the transposed inverse
+IntersectionInfo InstancePool::toWorldSpace(
+    const ObjectRay& objectRay,
+    const Ray3& ray,
+    const IntersectionInfo& objectIntersection)
+{
+    const auto time = objectIntersection.getTime() / objectRay.timeScale;
+    return IntersectionInfo(
+        evaluate(ray, time), objectRay.objectToWorld.multiply(objectIntersection.getNormal()), time);
+}
+
+void InstancePool::reorder(const BorrowableArray<std::uint32_t>& order)
+{
+    std::vector<AffineTransform> objectToWorld;
+    std::vector<std::uint32_t> prototypeIndices;
+    std::vector<std::uint32_t> motionIndices;
+    objectToWorld.reserve(order.size());
+    prototypeIndices.reserve(order.size());
+    motionIndices.reserve(order.size());
+
+    for (const auto index : order)
+    {
+        objectToWorld.push_back(m_objectToWorld[index]);
+        prototypeIndices.push_back(m_prototypeIndices[index]);
+        motionIndices.push_back(m_motionIndices[index]);
+    }
+
+    m_objectToWorld = std::move(objectToWorld);
+    m_prototypeIndices = std::move(prototypeIndices);
+    m_motionIndices = std::move(motionIndices);
+}
+
+} // namespace eyebeam
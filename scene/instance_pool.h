@@ -0,0 +1,100 @@
+#ifndef INCLUDED_INSTANCE_POOL_H_
+#define INCLUDED_INSTANCE_POOL_H_
+
+#include "affine_transform.h"
+#include "animated_transform.h"
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "ray3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace eyebeam
+{
+
+class Geometry;
+
+// A ray carried into the space of an instance. The direction is normalized again there, so times along the object
+// ray are times along the world ray multiplied by timeScale. objectToWorld places the instance at the shutter time of
+// the ray.
+struct ObjectRay
+{
+    Ray3 ray;
+    float timeScale;
+    AffineTransform objectToWorld;
+};
+
+// Copies of shared geometry placed in the world. Each prototype is a Geometry with its own hierarchies, and each
+// instance is only a transform and the index of its prototype, so memory grows with the unique geometry rather than
+// with the number of copies. Rays are carried into the space of an instance rather than its geometry into the world.
+// Placements are affine, so only the top three rows of their matrices are stored and applied. Moving instances are
+// bounded over the whole shutter interval, so the hierarchy over them is built once and rays cast at any time only pay
+// for interpolating the transforms of the instances they reach.
+class InstancePool
+{
+public:
+    // Returns the index that instances refer to the prototype by. Throws std::invalid_argument when the prototype has
+    // no bounded primitives.
+    std::uint32_t addPrototype(std::shared_ptr<const Geometry> prototype);
+
+    // objectToWorld maps the space of the prototype to the world. Throws std::out_of_range for unknown prototypes.
+    void add(std::uint32_t prototype, const AffineTransform& objectToWorld);
+    void add(std::uint32_t prototype, AnimatedTransform objectToWorld);
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_prototypeIndices.size();
+    }
+
+    [[nodiscard]] auto prototypeCount() const noexcept
+    {
+        return m_prototypes.size();
+    }
+
+    [[nodiscard]] auto movingCount() const noexcept
+    {
+        return m_motions.size();
+    }
+
+    // The geometry of an instance, in the space of its prototype
+    [[nodiscard]] const Geometry& prototype(size_t index) const noexcept
+    {
+        return *m_prototypes[m_prototypeIndices[index]];
+    }
+
+    [[nodiscard]] AffineTransform objectToWorld(size_t index, float shutterTime) const noexcept;
+
+    // The bounds of the prototype carried into the world, which are looser than the transformed primitives. Those of
+    // moving instances hold every place they pass through while the shutter is open.
+    [[nodiscard]] Bounds3 bounds(size_t index) const;
+
+    [[nodiscard]] ObjectRay toObjectSpace(size_t index, const Ray3& ray) const;
+
+    // An intersection found along objectRay, carried back to ray in the world
+    [[nodiscard]] static IntersectionInfo toWorldSpace(
+        const ObjectRay& objectRay,
+        const Ray3& ray,
+        const IntersectionInfo& objectIntersection);
+
+    void reorder(const BorrowableArray<std::uint32_t>& order);
+
+private:
+    static constexpr auto noMotion = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<std::shared_ptr<const Geometry>> m_prototypes;
+    std::vector<Bounds3> m_prototypeBounds;
+    std::vector<AffineTransform> m_objectToWorld;
+    std::vector<std::uint32_t> m_prototypeIndices;
+    // Index into m_motions of each instance, or noMotion for those that hold still
+    std::vector<std::uint32_t> m_motionIndices;
+    std::vector<AnimatedTransform> m_motions;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_INSTANCE_POOL_H_
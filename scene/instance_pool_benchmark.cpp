@@ -0,0 +1,243 @@
+#include "geometry.h"
+#include "instance_pool.h"
+#include "mesh_pool.h"
+#include "triangle_mesh.h"
+
+#include "affine_transform.h"
+#include "angle.h"
+#include "animated_transform.h"
+#include "intersection_info.h"
+#include "point3.h"
+#include "quaternion.h"
+#include "ray3.h"
+#include "vector3.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr std::uint32_t forestSize = 16;
+constexpr size_t leafCount = 1024;
+constexpr size_t rayCount = 1024;
+
+// A clump of small random triangles in the unit cube, standing in for a plant
+TriangleMesh makeAsset()
+{
+    std::mt19937 engine(1234);
+    std::uniform_real_distribution<float> position(-1.0F, 1.0F);
+    std::uniform_real_distribution<float> offset(-0.1F, 0.1F);
+
+    TriangleMesh mesh;
+    for (std::uint32_t leaf = 0; leaf < leafCount; ++leaf)
+    {
+        const Point3 center(position(engine), position(engine), position(engine));
+        for (size_t corner = 0; corner < 3; ++corner)
+        {
+            mesh.addVertex(center + Vector3(offset(engine), offset(engine), offset(engine)));
+        }
+
+        mesh.addTriangle(3 * leaf, 3 * leaf + 1, 3 * leaf + 2);
+    }
+
+    return mesh;
+}
+
+// forestSize x forestSize copies of the asset on a grid, each turned and scaled differently
+std::vector<TransformKeyframe> makePoses()
+{
+    std::mt19937 engine(5678);
+    std::uniform_real_distribution<float> angle(0.0F, 360.0F);
+    std::uniform_real_distribution<float> scale(0.75F, 1.25F);
+
+    std::vector<TransformKeyframe> poses;
+    for (std::uint32_t z = 0; z < forestSize; ++z)
+    {
+        for (std::uint32_t x = 0; x < forestSize; ++x)
+        {
+            const auto size = scale(engine);
+            poses.push_back(TransformKeyframe{
+                0.0F,
+                Vector3(3.0F * static_cast<float>(x), 0.0F, 3.0F * static_cast<float>(z)),
+                Quaternion::rotateY(toRadians(Degrees(angle(engine)))),
+                Vector3(size, size, size)});
+        }
+    }
+
+    return poses;
+}
+
+std::vector<AffineTransform> makePlacements()
+{
+    std::vector<AffineTransform> placements;
+    for (const auto& pose : makePoses())
+    {
+        placements.push_back(AnimatedTransform({pose}).at(0.0F));
+    }
+
+    return placements;
+}
+
+// Each copy sways and turns while the shutter is open
+std::vector<AnimatedTransform> makeMotions()
+{
+    std::vector<AnimatedTransform> motions;
+    for (const auto& pose : makePoses())
+    {
+        auto moved(pose);
+        moved.shutterTime = 1.0F;
+        moved.translation += Vector3(0.5F, 0.0F, 0.25F);
+        moved.rotation = Quaternion::rotateY(toRadians(Degrees(30.0F))).multiply(pose.rotation);
+        motions.emplace_back(std::vector{pose, moved});
+    }
+
+    return motions;
+}
+
+std::shared_ptr<const Geometry> makePrototype()
+{
+    MeshPool meshes;
+    meshes.add(makeAsset());
+    return std::make_shared<const Geometry>(
+        SpherePool(), PlanePool(), BoxPool(), TrianglePool(), std::move(meshes), InstancePool());
+}
+
+template <typename Placement>
+Geometry makeInstancedForest(std::shared_ptr<const Geometry> asset, const std::vector<Placement>& placements)
+{
+    InstancePool instances;
+    const auto prototype = instances.addPrototype(std::move(asset));
+    for (const auto& placement : placements)
+    {
+        instances.add(prototype, placement);
+    }
+
+    return Geometry(SpherePool(), PlanePool(), BoxPool(), TrianglePool(), MeshPool(), std::move(instances));
+}
+
+// The same forest with every copy of the asset transformed into one large mesh
+Geometry makeFlattenedForest()
+{
+    const auto asset(makeAsset());
+    const auto& vertices = asset.vertices();
+
+    TriangleMesh forest;
+    for (const auto& placement : makePlacements())
+    {
+        const auto firstVertex = static_cast<std::uint32_t>(forest.vertexCount());
+        for (size_t i = 0; i < vertices.size(); i += 3)
+        {
+            forest.addVertex(placement.multiply(Point3(vertices[i], vertices[i + 1], vertices[i + 2])));
+        }
+
+        const auto& indices = asset.indices();
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            forest.addTriangle(
+                firstVertex + indices[i], firstVertex + indices[i + 1], firstVertex + indices[i + 2]);
+        }
+    }
+
+    MeshPool meshes;
+    meshes.add(forest);
+    return Geometry(SpherePool(), PlanePool(), BoxPool(), TrianglePool(), std::move(meshes), InstancePool());
+}
+
+// Rays from above the forest looking down at it at an angle, so that they pass through several copies, cast at times
+// spread over the shutter interval
+std::vector<Ray3> makeRays()
+{
+    std::mt19937 engine(9012);
+    const auto extent = 3.0F * static_cast<float>(forestSize);
+    std::uniform_real_distribution<float> position(0.0F, extent);
+    std::uniform_real_distribution<float> slope(-0.5F, 0.5F);
+    std::uniform_real_distribution<float> shutterTime(0.0F, 1.0F);
+
+    std::vector<Ray3> rays;
+    for (size_t i = 0; i < rayCount; ++i)
+    {
+        const Point3 origin(position(engine), 5.0F, position(engine));
+        const Vector3 direction(slope(engine), -1.0F, 1.0F);
+        rays.emplace_back(origin, direction, shutterTime(engine));
+    }
+
+    return rays;
+}
+
+void benchmarkClosestHits(benchmark::State& state, const Geometry& geometry)
+{
+    const auto rays(makeRays());
+
+    size_t ray = 0;
+    for ([[maybe_unused]] auto s : state)
+    {
+        IntersectionInfo closest;
+        benchmark::DoNotOptimize(geometry.intersect(rays[ray], closest));
+        ray = (ray + 1) % rays.size();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void benchmarkInstancedForest(benchmark::State& state)
+{
+    benchmarkClosestHits(state, makeInstancedForest(makePrototype(), makePlacements()));
+}
+
+// The same forest moving while the shutter is open, which costs the rays the looser bounds of the moving copies and an
+// interpolated transform for each copy they reach
+void benchmarkMovingInstancedForest(benchmark::State& state)
+{
+    benchmarkClosestHits(state, makeInstancedForest(makePrototype(), makeMotions()));
+}
+
+// What bounding the motion saves: placing every copy at one shutter time and building the hierarchy over the copies
+// again, which a renderer without motion bounds would pay for every shutter time it samples
+void benchmarkRebuildForestPerShutterTime(benchmark::State& state)
+{
+    const auto asset(makePrototype());
+    const auto motions(makeMotions());
+
+    auto shutterTime = 0.0F;
+    for ([[maybe_unused]] auto s : state)
+    {
+        std::vector<AffineTransform> placements;
+        placements.reserve(motions.size());
+        for (const auto& motion : motions)
+        {
+            placements.push_back(motion.at(shutterTime));
+        }
+
+        benchmark::DoNotOptimize(makeInstancedForest(asset, placements));
+        shutterTime = shutterTime < 1.0F ? shutterTime + 0.125F : 0.0F;
+    }
+}
+
+void benchmarkFlattenedForest(benchmark::State& state)
+{
+    benchmarkClosestHits(state, makeFlattenedForest());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkInstancedForest);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkFlattenedForest);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkMovingInstancedForest);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkRebuildForestPerShutterTime);
+
+} // namespace
+} // namespace eyebeam
@@ -0,0 +1,130 @@
+#include "mapped_file.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace eyebeam
+{
+
+namespace
+{
+
+[[noreturn]] void throwMappingError(const std::filesystem::path& path, const char* reason)
+{
+    throw std::runtime_error("Could not map " + path.string() + ": " + reason);
+}
+
+} // namespace
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    const auto file = CreateFileW(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throwMappingError(path, "could not open the file");
+    }
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) == 0)
+    {
+        CloseHandle(file);
+        throwMappingError(path, "could not read the file size");
+    }
+
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    if (m_size == 0)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (m_mapping == nullptr)
+    {
+        throwMappingError(path, "could not create the mapping");
+    }
+
+    m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        CloseHandle(m_mapping);
+        throwMappingError(path, "could not map a view of the file");
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+
+    if (m_mapping != nullptr)
+    {
+        CloseHandle(m_mapping);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    const auto file = open(path.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (file < 0)
+    {
+        throwMappingError(path, "could not open the file");
+    }
+
+    struct stat status = {};
+    if (fstat(file, &status) != 0)
+    {
+        close(file);
+        throwMappingError(path, "could not read the file size");
+    }
+
+    m_size = static_cast<size_t>(status.st_size);
+    if (m_size == 0)
+    {
+        close(file);
+        return;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    auto* const mapped = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, file, 0);
+    close(file);
+    if (mapped == MAP_FAILED) // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    {
+        throwMappingError(path, "mmap failed");
+    }
+
+    m_data = static_cast<const std::byte*>(mapped);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<std::byte*>(m_data), m_size); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+}
+
+#endif
+
+} // namespace eyebeam
@@ -0,0 +1,45 @@
+#ifndef INCLUDED_MAPPED_FILE_H_
+#define INCLUDED_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <filesystem>
+
+namespace eyebeam
+{
+
+// A whole file mapped read only into memory. Pages are loaded on first access and shared with every other process
+// mapping the same file.
+class MappedFile
+{
+public:
+    // Throws std::runtime_error when the file cannot be opened or mapped
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    [[nodiscard]] const std::byte* data() const noexcept
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+private:
+    const std::byte* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_mapping = nullptr;
+#endif
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_MAPPED_FILE_H_
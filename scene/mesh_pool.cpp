@@ -0,0 +1,317 @@
+#include "mesh_pool.h"
+
+#include "primitive_lanes.h"
+#include "triangle_mesh.h"
+
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "normal3.h"
+#include "point3.h"
+#include "ray3.h"
+#include "simd_lanes.h"
+#include "vector3.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr float quantizedSteps = std::numeric_limits<std::uint16_t>::max();
+
+} // namespace
+
+ShearedRayLanes::ShearedRayLanes(const Ray3& ray) noexcept
+{
+    const std::array<float, 3> origin = {ray.origin().x(), ray.origin().y(), ray.origin().z()};
+    const std::array<float, 3> direction = {ray.direction().x(), ray.direction().y(), ray.direction().z()};
+
+    size_t z = 0;
+    for (size_t axis = 1; axis < 3; ++axis)
+    {
+        z = std::abs(direction[axis]) > std::abs(direction[z]) ? axis : z;
+    }
+
+    // Swapping x and y for rays along -z keeps the winding of the triangles, and so the signs of the edge functions
+    auto x = (z + 1) % 3;
+    auto y = (x + 1) % 3;
+    if (direction[z] < 0.0F)
+    {
+        std::swap(x, y);
+    }
+
+    axes = {static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), static_cast<std::uint8_t>(z)};
+    originX = PrimitiveLanes(origin[x]);
+    originY = PrimitiveLanes(origin[y]);
+    originZ = PrimitiveLanes(origin[z]);
+    shearX = PrimitiveLanes(direction[x] / direction[z]);
+    shearY = PrimitiveLanes(direction[y] / direction[z]);
+    shearZ = PrimitiveLanes(1.0F / direction[z]);
+}
+
+MeshPool::MeshPool() : m_indices(std::vector<std::uint32_t>(3 * padding, 0))
+{
+}
+
+MeshPool::MeshPool(BorrowableArray<float> vertices, BorrowableArray<std::uint32_t> indices) noexcept
+    : m_vertices(std::move(vertices))
+    , m_indices(std::move(indices))
+{
+}
+
+MeshPool::MeshPool(
+    BorrowableArray<std::uint16_t> quantizedVertices,
+    const MeshQuantization& quantization,
+    BorrowableArray<std::uint32_t> indices) noexcept
+    : m_vertexFormat(MeshVertexFormat::Quantized16)
+    , m_quantizedVertices(std::move(quantizedVertices))
+    , m_quantization(quantization)
+    , m_indices(std::move(indices))
+{
+}
+
+void MeshPool::add(const TriangleMesh& mesh)
+{
+    append(mesh.vertices().data(), mesh.vertexCount(), mesh.indices().data(), mesh.triangleCount());
+}
+
+void MeshPool::append(const MeshPool& other)
+{
+    if (other.m_vertexFormat != MeshVertexFormat::Float)
+    {
+        throw std::logic_error("Quantized mesh pools cannot be appended");
+    }
+
+    append(other.m_vertices.data(), other.vertexCount(), other.m_indices.data(), other.size());
+}
+
+void MeshPool::append(const float* vertices, size_t vertexCount, const std::uint32_t* indices, size_t triangleCount)
+{
+    if (m_vertexFormat != MeshVertexFormat::Float)
+    {
+        throw std::logic_error("Meshes cannot be added to a quantized mesh pool");
+    }
+
+    const auto firstVertex = this->vertexCount();
+    if (vertexCount > std::numeric_limits<std::uint32_t>::max() - firstVertex)
+    {
+        throw std::length_error("Mesh pools hold at most 2^32 - 1 vertices");
+    }
+
+    auto& ownedVertices = m_vertices.owned();
+    auto& ownedIndices = m_indices.owned();
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ownedVertices.insert(ownedVertices.end(), vertices, vertices + 3 * vertexCount);
+
+    const auto start = ownedIndices.size() - 3 * padding;
+    ownedIndices.resize(ownedIndices.size() + 3 * triangleCount);
+    for (size_t i = 0; i < 3 * triangleCount; ++i)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        ownedIndices[start + i] = indices[i] + static_cast<std::uint32_t>(firstVertex);
+    }
+
+    std::fill(ownedIndices.end() - static_cast<std::ptrdiff_t>(3 * padding), ownedIndices.end(), 0U);
+}
+
+void MeshPool::quantize()
+{
+    if (m_vertexFormat == MeshVertexFormat::Quantized16)
+    {
+        return;
+    }
+
+    std::array<float, 3> minimum = {};
+    std::array<float, 3> maximum = {};
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+        minimum[axis] = std::numeric_limits<float>::infinity();
+        maximum[axis] = -std::numeric_limits<float>::infinity();
+    }
+
+    for (size_t i = 0; i < m_vertices.size(); ++i)
+    {
+        minimum[i % 3] = std::min(minimum[i % 3], m_vertices[i]);
+        maximum[i % 3] = std::max(maximum[i % 3], m_vertices[i]);
+    }
+
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+        m_quantization.origin[axis] = m_vertices.empty() ? 0.0F : minimum[axis];
+        m_quantization.scale[axis] = m_vertices.empty() ? 0.0F : (maximum[axis] - minimum[axis]) / quantizedSteps;
+    }
+
+    std::vector<std::uint16_t> quantized;
+    quantized.reserve(m_vertices.size());
+    for (size_t i = 0; i < m_vertices.size(); ++i)
+    {
+        const auto scale = m_quantization.scale[i % 3];
+        const auto steps = scale > 0.0F ? std::round((m_vertices[i] - m_quantization.origin[i % 3]) / scale) : 0.0F;
+        quantized.push_back(static_cast<std::uint16_t>(std::clamp(steps, 0.0F, quantizedSteps)));
+    }
+
+    m_quantizedVertices = BorrowableArray<std::uint16_t>(std::move(quantized));
+    m_vertices = BorrowableArray<float>();
+    m_vertexFormat = MeshVertexFormat::Quantized16;
+}
+
+size_t MeshPool::vertexCount() const noexcept
+{
+    return (m_vertexFormat == MeshVertexFormat::Float ? m_vertices.size() : m_quantizedVertices.size()) / 3;
+}
+
+Point3 MeshPool::vertex(std::uint32_t index) const noexcept
+{
+    const auto first = size_t{3} * index;
+    if (m_vertexFormat == MeshVertexFormat::Float)
+    {
+        return Point3(m_vertices[first], m_vertices[first + 1], m_vertices[first + 2]);
+    }
+
+    const auto dequantize = [&](size_t axis) {
+        return static_cast<float>(m_quantizedVertices[first + axis]) * m_quantization.scale[axis] +
+               m_quantization.origin[axis];
+    };
+
+    return Point3(dequantize(0), dequantize(1), dequantize(2));
+}
+
+Bounds3 MeshPool::bounds(size_t index) const noexcept
+{
+    return Bounds3(vertex(m_indices[3 * index]))
+        .unite(vertex(m_indices[3 * index + 1]))
+        .unite(vertex(m_indices[3 * index + 2]));
+}
+
+IntersectionInfo MeshPool::intersectionAt(size_t index, const Ray3& ray, float time) const
+{
+    const auto vertex0(vertex(m_indices[3 * index]));
+    const auto edge1(vertex(m_indices[3 * index + 1]) - vertex0);
+    const auto edge2(vertex(m_indices[3 * index + 2]) - vertex0);
+    return IntersectionInfo(evaluate(ray, time), Normal3(cross(edge1, edge2)), time);
+}
+
+void MeshPool::reorder(const BorrowableArray<std::uint32_t>& order)
+{
+    std::vector<std::uint32_t> reordered;
+    reordered.reserve(3 * (order.size() + padding));
+
+    for (const auto index : order)
+    {
+        reordered.insert(
+            reordered.end(), {m_indices[3 * index], m_indices[3 * index + 1], m_indices[3 * index + 2]});
+    }
+
+    reordered.resize(3 * (order.size() + padding), 0);
+    m_indices = BorrowableArray<std::uint32_t>(std::move(reordered));
+}
+
+MeshPool gatherPools(const std::vector<const MeshPool*>& parts, const BorrowableArray<std::uint32_t>& order)
+{
+    const auto firstTriangles(detail::firstIndicesOf(parts));
+
+    std::vector<std::uint32_t> firstVertices;
+    size_t vertexCount = 0;
+    for (const auto* part : parts)
+    {
+        if (part->vertexFormat() != MeshVertexFormat::Float)
+        {
+            throw std::logic_error("Quantized mesh pools cannot be gathered");
+        }
+
+        if (part->vertexCount() > std::numeric_limits<std::uint32_t>::max() - vertexCount)
+        {
+            throw std::length_error("Mesh pools hold at most 2^32 - 1 vertices");
+        }
+
+        firstVertices.push_back(static_cast<std::uint32_t>(vertexCount));
+        vertexCount += part->vertexCount();
+    }
+
+    std::vector<float> vertices;
+    vertices.reserve(3 * vertexCount);
+    for (const auto* part : parts)
+    {
+        vertices.insert(vertices.end(), part->vertices().begin(), part->vertices().end());
+    }
+
+    std::vector<std::uint32_t> indices;
+    indices.reserve(3 * (order.size() + MeshPool::padding));
+    for (const auto index : order)
+    {
+        const auto part = detail::partOf(firstTriangles, index);
+        const auto first = 3 * (index - firstTriangles[part]);
+        const auto& partIndices = parts[part]->indices();
+        for (size_t corner = 0; corner < 3; ++corner)
+        {
+            indices.push_back(partIndices[first + corner] + firstVertices[part]);
+        }
+    }
+
+    indices.resize(3 * (order.size() + MeshPool::padding), 0);
+    return MeshPool(BorrowableArray<float>(std::move(vertices)), BorrowableArray<std::uint32_t>(std::move(indices)));
+}
+
+namespace detail
+{
+
+void recomputeZeroEdgesInDouble(
+    const std::array<PrimitiveLanes, 6>& corners,
+    PrimitiveLanes& u,
+    PrimitiveLanes& v,
+    PrimitiveLanes& w) noexcept
+{
+    constexpr auto width = PrimitiveLanes::width;
+
+    std::array<AlignedLaneStorage<width>, 6> stored;
+    for (size_t i = 0; i < corners.size(); ++i)
+    {
+        corners[i].store(stored[i].data.data());
+    }
+
+    AlignedLaneStorage<width> storedU;
+    AlignedLaneStorage<width> storedV;
+    AlignedLaneStorage<width> storedW;
+    u.store(storedU.data.data());
+    v.store(storedV.data.data());
+    w.store(storedW.data.data());
+
+    const auto at = [&](size_t corner, size_t lane) { return static_cast<double>(stored[corner].data[lane]); };
+    for (size_t lane = 0; lane < width; ++lane)
+    {
+        if (storedU.data[lane] != 0.0F && storedV.data[lane] != 0.0F && storedW.data[lane] != 0.0F)
+        {
+            continue;
+        }
+
+        const auto aX = at(0, lane);
+        const auto aY = at(1, lane);
+        const auto bX = at(2, lane);
+        const auto bY = at(3, lane);
+        const auto cX = at(4, lane);
+        const auto cY = at(5, lane);
+        storedU.data[lane] = static_cast<float>(cX * bY - cY * bX);
+        storedV.data[lane] = static_cast<float>(aX * cY - aY * cX);
+        storedW.data[lane] = static_cast<float>(bX * aY - bY * aX);
+    }
+
+    u = PrimitiveLanes::load(storedU.data.data());
+    v = PrimitiveLanes::load(storedV.data.data());
+    w = PrimitiveLanes::load(storedW.data.data());
+}
+
+} // namespace detail
+
+} // namespace eyebeam
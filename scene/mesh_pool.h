@@ -0,0 +1,235 @@
+#ifndef INCLUDED_MESH_POOL_H_
+#define INCLUDED_MESH_POOL_H_
+
+#include "primitive_lanes.h"
+#include "triangle_mesh.h"
+
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "point3.h"
+#include "ray3.h"
+#include "simd_lanes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace eyebeam
+{
+
+enum class MeshVertexFormat : std::uint32_t
+{
+    // Three floats per vertex
+    Float,
+    // Three 16 bit integers per vertex, on a grid spanning the bounds of every vertex of the pool
+    Quantized16
+};
+
+// A ray in the space of the watertight test: translated to the origin, with its axes permuted so that z is the largest
+// component of the direction, and sheared so that the direction becomes +z. Every triangle is tested against the same
+// ray, so this is done once per ray rather than once per triangle.
+struct ShearedRayLanes
+{
+    explicit ShearedRayLanes(const Ray3& ray) noexcept;
+
+    // The world axes that become x, y and z
+    std::array<std::uint8_t, 3> axes;
+    PrimitiveLanes originX;
+    PrimitiveLanes originY;
+    PrimitiveLanes originZ;
+    PrimitiveLanes shearX;
+    PrimitiveLanes shearY;
+    PrimitiveLanes shearZ;
+};
+
+// How quantized vertices map to the world: origin + scale * quantized, per axis
+struct MeshQuantization
+{
+    std::array<float, 3> origin;
+    std::array<float, 3> scale;
+};
+
+// The triangles of any number of meshes, sharing one vertex buffer. Triangles are three vertex indices each, and are
+// followed by zeroed padding triangles so that a full set of lanes can be gathered starting at any triangle. The
+// vertices may be quantized to 16 bits once every mesh has been added, which halves their memory; shared vertices
+// still quantize to the same point, so the meshes stay watertight.
+class MeshPool
+{
+public:
+    static constexpr size_t padding = LaneColumn::padding;
+
+    MeshPool();
+
+    // Adopt vertices and indices, including the padding triangles, as stored in a compiled scene file
+    MeshPool(BorrowableArray<float> vertices, BorrowableArray<std::uint32_t> indices) noexcept;
+    MeshPool(
+        BorrowableArray<std::uint16_t> quantizedVertices,
+        const MeshQuantization& quantization,
+        BorrowableArray<std::uint32_t> indices) noexcept;
+
+    // Throws std::logic_error once the pool is quantized or borrowed, and std::length_error when the vertices no
+    // longer fit 32 bit indices
+    void add(const TriangleMesh& mesh);
+    void append(const MeshPool& other);
+
+    // Replaces the float vertices by quantized ones. Call before the hierarchy is built, since the triangles move by
+    // up to half a quantization step.
+    void quantize();
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_indices.size() / 3 - padding;
+    }
+
+    [[nodiscard]] auto vertexFormat() const noexcept
+    {
+        return m_vertexFormat;
+    }
+
+    [[nodiscard]] size_t vertexCount() const noexcept;
+
+    [[nodiscard]] const auto& vertices() const noexcept
+    {
+        return m_vertices;
+    }
+
+    [[nodiscard]] const auto& quantizedVertices() const noexcept
+    {
+        return m_quantizedVertices;
+    }
+
+    [[nodiscard]] const auto& quantization() const noexcept
+    {
+        return m_quantization;
+    }
+
+    [[nodiscard]] const auto& indices() const noexcept
+    {
+        return m_indices;
+    }
+
+    [[nodiscard]] Point3 vertex(std::uint32_t index) const noexcept;
+
+    [[nodiscard]] Bounds3 bounds(size_t index) const noexcept;
+
+    // Distances to the triangles starting at first, by the watertight test of Woop, Benthin and Wald: a ray through an
+    // edge or vertex shared by several triangles hits at least one of them. Both sides of a triangle are hit.
+    [[nodiscard]] PrimitiveLanes hitTimes(const ShearedRayLanes& ray, size_t first) const noexcept
+    {
+        return m_vertexFormat == MeshVertexFormat::Float ? hitTimes(ray, first, m_vertices.data())
+                                                         : hitTimes(ray, first, m_quantizedVertices.data());
+    }
+
+    // The normal follows the winding of the vertices
+    [[nodiscard]] IntersectionInfo intersectionAt(size_t index, const Ray3& ray, float time) const;
+
+    void reorder(const BorrowableArray<std::uint32_t>& order);
+
+private:
+    template <typename Component>
+    [[nodiscard]] PrimitiveLanes hitTimes(const ShearedRayLanes& ray, size_t first, const Component* vertices)
+        const noexcept;
+
+    void append(const float* vertices, size_t vertexCount, const std::uint32_t* indices, size_t triangleCount);
+
+    MeshVertexFormat m_vertexFormat = MeshVertexFormat::Float;
+    BorrowableArray<float> m_vertices;
+    BorrowableArray<std::uint16_t> m_quantizedVertices;
+    MeshQuantization m_quantization{};
+    BorrowableArray<std::uint32_t> m_indices;
+};
+
+// One pool holding the triangle at order[i] of the parts at position i, as gatherPools does for other pools. The
+// vertices of the parts are copied once, in turn, and the triangles refer to them where they land. Throws
+// std::logic_error for quantized parts and std::length_error when the vertices no longer fit 32 bit indices.
+[[nodiscard]] MeshPool gatherPools(
+    const std::vector<const MeshPool*>& parts,
+    const BorrowableArray<std::uint32_t>& order);
+
+namespace detail
+{
+
+// Recomputes the edge functions of the lanes where one of them is zero in double precision, where the products of
+// floats are exact, so that rays through an edge or vertex are assigned consistently to the triangles sharing it
+void recomputeZeroEdgesInDouble(
+    const std::array<PrimitiveLanes, 6>& corners,
+    PrimitiveLanes& u,
+    PrimitiveLanes& v,
+    PrimitiveLanes& w) noexcept;
+
+} // namespace detail
+
+template <typename Component>
+PrimitiveLanes MeshPool::hitTimes(const ShearedRayLanes& ray, size_t first, const Component* vertices) const noexcept
+{
+    constexpr auto width = PrimitiveLanes::width;
+    using Corners = std::array<const Component*, width>;
+
+    Corners cornersA;
+    Corners cornersB;
+    Corners cornersC;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto* indices = m_indices.data() + 3 * first;
+    for (size_t lane = 0; lane < width; ++lane)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        cornersA[lane] = vertices + size_t{3} * indices[3 * lane];
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        cornersB[lane] = vertices + size_t{3} * indices[3 * lane + 1];
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        cornersC[lane] = vertices + size_t{3} * indices[3 * lane + 2];
+    }
+
+    // One world axis of a corner of every triangle, relative to the ray origin
+    const auto gather = [&](const Corners& corners, std::uint8_t axis, PrimitiveLanes origin) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto coordinate(PrimitiveLanes::generate([&](size_t lane) { return static_cast<float>(corners[lane][axis]); }));
+        if constexpr (std::is_same_v<Component, std::uint16_t>)
+        {
+            coordinate = coordinate * PrimitiveLanes(m_quantization.scale[axis]) +
+                         PrimitiveLanes(m_quantization.origin[axis]);
+        }
+
+        return coordinate - origin;
+    };
+
+    const auto [x, y, z] = ray.axes;
+    const auto aZ(gather(cornersA, z, ray.originZ));
+    const auto bZ(gather(cornersB, z, ray.originZ));
+    const auto cZ(gather(cornersC, z, ray.originZ));
+    const std::array<PrimitiveLanes, 6> corners = {
+        gather(cornersA, x, ray.originX) - ray.shearX * aZ,
+        gather(cornersA, y, ray.originY) - ray.shearY * aZ,
+        gather(cornersB, x, ray.originX) - ray.shearX * bZ,
+        gather(cornersB, y, ray.originY) - ray.shearY * bZ,
+        gather(cornersC, x, ray.originX) - ray.shearX * cZ,
+        gather(cornersC, y, ray.originY) - ray.shearY * cZ};
+    const auto& [shearedAX, shearedAY, shearedBX, shearedBY, shearedCX, shearedCY] = corners;
+
+    // Twice the signed areas of the triangles the ray forms with each edge
+    auto u(shearedCX * shearedBY - shearedCY * shearedBX);
+    auto v(shearedAX * shearedCY - shearedAY * shearedCX);
+    auto w(shearedBX * shearedAY - shearedBY * shearedAX);
+
+    const PrimitiveLanes zero(0.0F);
+    if (((u == zero) | (v == zero) | (w == zero)).bits() != 0)
+    {
+        detail::recomputeZeroEdgesInDouble(corners, u, v, w);
+    }
+
+    // The ray passes inside a triangle when all three edge functions share a sign
+    const auto isOutside = ((u < zero) | (v < zero) | (w < zero)) & ((u > zero) | (v > zero) | (w > zero));
+    const auto determinant(u + v + w);
+    const auto scaledTime(
+        multiplyAdd(u, ray.shearZ * aZ, multiplyAdd(v, ray.shearZ * bZ, w * (ray.shearZ * cZ))));
+    const auto time(scaledTime / determinant);
+
+    return missedToInfinity(!isOutside & !(determinant == zero) & (time > zero), time);
+}
+
+} // namespace eyebeam
+
+#endif // INCLUDED_MESH_POOL_H_
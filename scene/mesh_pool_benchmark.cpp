@@ -0,0 +1,152 @@
+#include "mesh_pool.h"
+#include "primitive_lanes.h"
+#include "triangle_mesh.h"
+#include "triangle_pool.h"
+
+#include "point3.h"
+#include "ray3.h"
+#include "traversal_ray3.h"
+#include "vector3.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr std::uint32_t gridSize = 128;
+constexpr size_t rayCount = 64;
+
+// A rough height field of gridSize x gridSize quads, each split into two triangles that share their diagonal
+TriangleMesh makeTerrain()
+{
+    std::mt19937 engine(1234);
+    std::uniform_real_distribution<float> height(-0.5F, 0.5F);
+
+    TriangleMesh mesh;
+    for (std::uint32_t z = 0; z <= gridSize; ++z)
+    {
+        for (std::uint32_t x = 0; x <= gridSize; ++x)
+        {
+            mesh.addVertex(Point3(static_cast<float>(x), height(engine), static_cast<float>(z)));
+        }
+    }
+
+    for (std::uint32_t z = 0; z < gridSize; ++z)
+    {
+        for (std::uint32_t x = 0; x < gridSize; ++x)
+        {
+            const auto corner = z * (gridSize + 1) + x;
+            mesh.addTriangle(corner, corner + 1, corner + gridSize + 1);
+            mesh.addTriangle(corner + 1, corner + gridSize + 2, corner + gridSize + 1);
+        }
+    }
+
+    return mesh;
+}
+
+std::vector<Ray3> makeRays()
+{
+    std::mt19937 engine(5678);
+    std::uniform_real_distribution<float> position(0.0F, static_cast<float>(gridSize));
+    std::uniform_real_distribution<float> slope(-0.5F, 0.5F);
+
+    std::vector<Ray3> rays;
+    for (size_t i = 0; i < rayCount; ++i)
+    {
+        rays.emplace_back(
+            Point3(position(engine), 10.0F, position(engine)), Vector3(slope(engine), -1.0F, slope(engine)));
+    }
+
+    return rays;
+}
+
+MeshPool makeMeshPool(MeshVertexFormat format)
+{
+    MeshPool pool;
+    pool.add(makeTerrain());
+    if (format == MeshVertexFormat::Quantized16)
+    {
+        pool.quantize();
+    }
+
+    return pool;
+}
+
+// The same triangles as independent triangles, the baseline the shared vertices are compared against
+TrianglePool makeTrianglePool()
+{
+    const auto mesh(makeTerrain());
+    const auto& vertices = mesh.vertices();
+    const auto vertex = [&](std::uint32_t index) {
+        return Point3(vertices[3 * index], vertices[3 * index + 1], vertices[3 * index + 2]);
+    };
+
+    TrianglePool pool;
+    const auto& indices = mesh.indices();
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        pool.add(vertex(indices[i]), vertex(indices[i + 1]), vertex(indices[i + 2]));
+    }
+
+    return pool;
+}
+
+// Every triangle is tested against each ray, without a hierarchy, to measure the intersection test alone
+template <typename Pool, typename Lanes>
+void benchmarkHitTimes(benchmark::State& state, const Pool& pool, const std::vector<Lanes>& rays)
+{
+    size_t ray = 0;
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto hit(findClosestHit(pool, rays[ray], 0, pool.size(), std::numeric_limits<float>::infinity()));
+        benchmark::DoNotOptimize(hit);
+        ray = (ray + 1) % rays.size();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(pool.size()));
+}
+
+void benchmarkTrianglePoolHitTimes(benchmark::State& state)
+{
+    const auto pool(makeTrianglePool());
+    std::vector<RayLanes> rays;
+    for (const auto& ray : makeRays())
+    {
+        rays.emplace_back(TraversalRay3(ray));
+    }
+
+    benchmarkHitTimes(state, pool, rays);
+}
+
+void benchmarkMeshPoolHitTimes(benchmark::State& state, MeshVertexFormat format)
+{
+    const auto pool(makeMeshPool(format));
+    std::vector<ShearedRayLanes> rays;
+    for (const auto& ray : makeRays())
+    {
+        rays.emplace_back(ray);
+    }
+
+    benchmarkHitTimes(state, pool, rays);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkTrianglePoolHitTimes);
+
+// NOLINTNEXTLINE
+BENCHMARK_CAPTURE(benchmarkMeshPoolHitTimes, float, MeshVertexFormat::Float);
+
+// NOLINTNEXTLINE
+BENCHMARK_CAPTURE(benchmarkMeshPoolHitTimes, quantized16, MeshVertexFormat::Quantized16);
+
+} // namespace
+} // namespace eyebeam
@@ -0,0 +1,41 @@
+#include "plane_pool.h"
+
+#include "intersection_info.h"
+#include "normal3.h"
+#include "point3.h"
+#include "ray3.h"
+
+#include <array>
+#include <utility>
+
+namespace eyebeam
+{
+
+PlanePool::PlanePool(std::array<LaneColumn, columnCount> columns) noexcept
+    : m_normalX(std::move(columns[0]))
+    , m_normalY(std::move(columns[1]))
+    , m_normalZ(std::move(columns[2]))
+    , m_offset(std::move(columns[3]))
+{
+}
+
+std::array<const LaneColumn*, PlanePool::columnCount> PlanePool::columns() const noexcept
+{
+    return {&m_normalX, &m_normalY, &m_normalZ, &m_offset};
+}
+
+void PlanePool::add(const Point3& point, const Normal3& normal)
+{
+    const auto unitNormal(norm(normal));
+    m_normalX.push_back(unitNormal.x());
+    m_normalY.push_back(unitNormal.y());
+    m_normalZ.push_back(unitNormal.z());
+    m_offset.push_back(unitNormal.x() * point.x() + unitNormal.y() * point.y() + unitNormal.z() * point.z());
+}
+
+IntersectionInfo PlanePool::intersectionAt(size_t index, const Ray3& ray, float time) const
+{
+    return IntersectionInfo(evaluate(ray, time), Normal3(m_normalX[index], m_normalY[index], m_normalZ[index]), time);
+}
+
+} // namespace eyebeam
@@ -0,0 +1,66 @@
+#ifndef INCLUDED_PLANE_POOL_H_
+#define INCLUDED_PLANE_POOL_H_
+
+#include "primitive_lanes.h"
+
+#include "intersection_info.h"
+#include "normal3.h"
+#include "point3.h"
+#include "ray3.h"
+
+#include <array>
+#include <cstddef>
+
+namespace eyebeam
+{
+
+// Infinite planes stored as structure of arrays. Planes have no bounds, so they are always tested as one batch
+// instead of being placed in a bounding volume hierarchy.
+class PlanePool
+{
+public:
+    static constexpr size_t columnCount = 4;
+
+    PlanePool() = default;
+
+    // Adopts columns in the order columns() returns them
+    explicit PlanePool(std::array<LaneColumn, columnCount> columns) noexcept;
+
+    [[nodiscard]] std::array<const LaneColumn*, columnCount> columns() const noexcept;
+
+    void add(const Point3& point, const Normal3& normal);
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_offset.size();
+    }
+
+    // Distances to the planes starting at first. Rays parallel to a plane divide by zero and miss.
+    [[nodiscard]] auto hitTimes(const RayLanes& ray, size_t first) const noexcept
+    {
+        const auto normalX(m_normalX.load(first));
+        const auto normalY(m_normalY.load(first));
+        const auto normalZ(m_normalZ.load(first));
+
+        const auto originDistance(
+            multiplyAdd(normalX, ray.originX, multiplyAdd(normalY, ray.originY, normalZ * ray.originZ)));
+        const auto speed(
+            multiplyAdd(normalX, ray.directionX, multiplyAdd(normalY, ray.directionY, normalZ * ray.directionZ)));
+        const auto time((m_offset.load(first) - originDistance) / speed);
+
+        return missedToInfinity(time > PrimitiveLanes(0.0F), time);
+    }
+
+    [[nodiscard]] IntersectionInfo intersectionAt(size_t index, const Ray3& ray, float time) const;
+
+private:
+    LaneColumn m_normalX;
+    LaneColumn m_normalY;
+    LaneColumn m_normalZ;
+    // Distance of the plane from the origin along its normal
+    LaneColumn m_offset;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_PLANE_POOL_H_
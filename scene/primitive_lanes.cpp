@@ -0,0 +1,26 @@
+#include "primitive_lanes.h"
+
+#include "borrowable_array.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+void LaneColumn::reorder(const BorrowableArray<std::uint32_t>& order)
+{
+    std::vector<float> reordered;
+    reordered.reserve(m_values.size());
+
+    for (const auto index : order)
+    {
+        reordered.push_back(m_values[index]);
+    }
+
+    reordered.resize(order.size() + padding, 0.0F);
+    m_values = BorrowableArray<float>(std::move(reordered));
+}
+
+} // namespace eyebeam
@@ -0,0 +1,257 @@
+#ifndef INCLUDED_PRIMITIVE_LANES_H_
+#define INCLUDED_PRIMITIVE_LANES_H_
+
+#include "borrowable_array.h"
+#include "bvh.h"
+#include "ray3.h"
+#include "simd_lanes.h"
+#include "traversal_ray3.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+// Primitive pools test this many primitives per instruction, which is one full bounding volume hierarchy leaf
+using PrimitiveLanes = FloatLanes<chooseLaneWidth<Bvh::maxPrimitivesInLeaf>()>;
+
+// One float per primitive, followed by enough zeros that a full set of lanes can be loaded starting at any primitive.
+// The lanes past the last primitive are masked out by the callers.
+class LaneColumn
+{
+public:
+    // PrimitiveLanes are never wider than a leaf, so the padding is the same for every build and columns stored in
+    // compiled scene files can be read by any of them
+    static constexpr size_t padding = Bvh::maxPrimitivesInLeaf - 1;
+
+    LaneColumn() : m_values(std::vector<float>(padding, 0.0F))
+    {
+    }
+
+    // Borrows size values that are followed by padding zeros in memory that outlives the column
+    LaneColumn(const float* borrowed, size_t size) noexcept : m_values(borrowed, size + padding)
+    {
+    }
+
+    // Adopts values and pads them
+    explicit LaneColumn(std::vector<float> values)
+    {
+        values.resize(values.size() + padding, 0.0F);
+        m_values = BorrowableArray<float>(std::move(values));
+    }
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_values.size() - padding;
+    }
+
+    [[nodiscard]] auto data() const noexcept
+    {
+        return m_values.data();
+    }
+
+    [[nodiscard]] auto operator[](size_t index) const noexcept
+    {
+        return m_values[index];
+    }
+
+    [[nodiscard]] auto load(size_t first) const noexcept
+    {
+        return PrimitiveLanes::loadUnaligned(&m_values[first]);
+    }
+
+    void push_back(float value)
+    {
+        auto& values = m_values.owned();
+        values.insert(values.end() - padding, value);
+    }
+
+    // Moves the value at order[i] to position i
+    void reorder(const BorrowableArray<std::uint32_t>& order);
+
+private:
+    BorrowableArray<float> m_values;
+};
+
+// The bounds of every primitive of a pool, ready to build its hierarchy from
+template <typename Pool>
+[[nodiscard]] BvhPrimitiveRun gatherBounds(const Pool& pool)
+{
+    BvhPrimitiveRun run;
+    run.reserve(pool.size());
+    for (size_t i = 0; i < pool.size(); ++i)
+    {
+        run.add(pool.bounds(i));
+    }
+
+    return run;
+}
+
+namespace detail
+{
+
+// Where the primitives of each part start when the parts are numbered in turn, followed by the total
+template <typename Pool>
+[[nodiscard]] std::vector<size_t> firstIndicesOf(const std::vector<const Pool*>& parts)
+{
+    std::vector<size_t> firstIndices(1, 0);
+    for (const auto* part : parts)
+    {
+        firstIndices.push_back(firstIndices.back() + part->size());
+    }
+
+    return firstIndices;
+}
+
+// The part holding a primitive, which is the last part starting at or before it since empty parts start where the
+// next one does
+[[nodiscard]] inline size_t partOf(const std::vector<size_t>& firstIndices, size_t index) noexcept
+{
+    const auto next = std::upper_bound(firstIndices.begin(), firstIndices.end() - 1, index);
+    return static_cast<size_t>(next - firstIndices.begin()) - 1;
+}
+
+} // namespace detail
+
+// One pool holding the primitive at order[i] of the parts at position i, where the primitives of the parts are
+// numbered in turn, such as the pools parsed from the chunks of a scene gathered into the leaf order of their
+// hierarchy. Every value is copied once, straight to its place.
+template <typename Pool>
+[[nodiscard]] Pool gatherPools(const std::vector<const Pool*>& parts, const BorrowableArray<std::uint32_t>& order)
+{
+    const auto firstIndices(detail::firstIndicesOf(parts));
+
+    std::array<std::vector<float>, Pool::columnCount> values;
+    for (auto& column : values)
+    {
+        column.reserve(order.size() + LaneColumn::padding);
+    }
+
+    for (const auto index : order)
+    {
+        const auto part = detail::partOf(firstIndices, index);
+        const auto columns(parts[part]->columns());
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            values[i].push_back((*columns[i])[index - firstIndices[part]]);
+        }
+    }
+
+    std::array<LaneColumn, Pool::columnCount> columns;
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        columns[i] = LaneColumn(std::move(values[i]));
+    }
+
+    return Pool(std::move(columns));
+}
+
+// A ray broadcast to every lane, with its reciprocal direction for slab tests
+struct RayLanes
+{
+    // Reuses the reciprocal direction the traversal ray already holds
+    explicit RayLanes(const TraversalRay3& ray) noexcept
+        : originX(ray.origin()[0])
+        , originY(ray.origin()[1])
+        , originZ(ray.origin()[2])
+        , directionX(ray.ray().direction().x())
+        , directionY(ray.ray().direction().y())
+        , directionZ(ray.ray().direction().z())
+        , inverseDirectionX(ray.inverseDirection()[0])
+        , inverseDirectionY(ray.inverseDirection()[1])
+        , inverseDirectionZ(ray.inverseDirection()[2])
+    {
+    }
+
+    PrimitiveLanes originX;
+    PrimitiveLanes originY;
+    PrimitiveLanes originZ;
+    PrimitiveLanes directionX;
+    PrimitiveLanes directionY;
+    PrimitiveLanes directionZ;
+    PrimitiveLanes inverseDirectionX;
+    PrimitiveLanes inverseDirectionY;
+    PrimitiveLanes inverseDirectionZ;
+};
+
+struct PrimitiveHit
+{
+    size_t index;
+    float time;
+};
+
+// Primitive pools provide hitTimes(ray, first), which returns the distance along the ray to each of the primitives
+// starting at first, or infinity for the ones the ray misses. The ray is RayLanes, or whatever form of it the pool's
+// test prepares once per ray. The helpers below reduce those lanes over a range of primitives.
+
+[[nodiscard]] inline int validLaneBits(size_t remaining) noexcept
+{
+    return remaining >= PrimitiveLanes::width ? (1 << PrimitiveLanes::width) - 1 : (1 << remaining) - 1;
+}
+
+// The nearest primitive in [first, last) hit before maxTime
+template <typename Pool, typename Ray>
+[[nodiscard]] std::optional<PrimitiveHit> findClosestHit(
+    const Pool& pool,
+    const Ray& ray,
+    size_t first,
+    size_t last,
+    float maxTime) noexcept
+{
+    std::optional<PrimitiveHit> closest;
+
+    for (auto i = first; i < last; i += PrimitiveLanes::width)
+    {
+        const auto times(pool.hitTimes(ray, i));
+        auto hits = (times < PrimitiveLanes(maxTime)).bits() & validLaneBits(last - i);
+        if (hits == 0)
+        {
+            continue;
+        }
+
+        AlignedLaneStorage<PrimitiveLanes::width> stored;
+        times.store(stored.data.data());
+
+        for (size_t lane = 0; hits != 0; ++lane, hits >>= 1)
+        {
+            if ((hits & 1) != 0 && stored.data[lane] < maxTime)
+            {
+                maxTime = stored.data[lane];
+                closest = PrimitiveHit{i + lane, maxTime};
+            }
+        }
+    }
+
+    return closest;
+}
+
+// Whether any primitive in [first, last) is hit before maxTime
+template <typename Pool, typename Ray>
+[[nodiscard]] bool isAnyHit(const Pool& pool, const Ray& ray, size_t first, size_t last, float maxTime) noexcept
+{
+    for (auto i = first; i < last; i += PrimitiveLanes::width)
+    {
+        if (((pool.hitTimes(ray, i) < PrimitiveLanes(maxTime)).bits() & validLaneBits(last - i)) != 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+[[nodiscard]] inline auto missedToInfinity(MaskLanes<PrimitiveLanes::width> hit, PrimitiveLanes time) noexcept
+{
+    return select(hit, time, PrimitiveLanes(std::numeric_limits<float>::infinity()));
+}
+
+} // namespace eyebeam
+
+#endif // INCLUDED_PRIMITIVE_LANES_H_
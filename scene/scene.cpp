@@ -1 +1,27 @@
 #include "scene.h"
+
+#include "color.h"
+
+#include "intersection_info.h"
+#include "normal3.h"
+#include "ray3.h"
+
+#include <cmath>
+
+namespace eyebeam
+{
+
+Color Scene::shade(const Ray3& ray) const
+{
+    IntersectionInfo closest;
+    if (!m_geometry.intersect(ray, closest))
+    {
+        return background;
+    }
+
+    // Planes and triangles are hit from either side, so the normal may face away from the ray
+    const auto facing = std::abs(dot(closest.getNormal(), ray.direction()));
+    return Color{facing, facing, facing};
+}
+
+} // namespace eyebeam
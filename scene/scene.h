@@ -1,15 +1,31 @@
 #ifndef INCLUDED_SCENE_H_
 #define INCLUDED_SCENE_H_
 
+#include "camera.h"
+#include "color.h"
+#include "geometry.h"
+#include "ray3.h"
 #include "scene_resolution.h"
 
+#include <utility>
+
 namespace eyebeam
 {
 
 class Scene
 {
 public:
-    explicit constexpr Scene(const SceneResolution& resolution) : m_resolution(resolution)
+    // The camera sits at the origin looking down +z
+    explicit Scene(const SceneResolution& resolution)
+        : m_resolution(resolution)
+        , m_camera(resolution.width(), resolution.height())
+    {
+    }
+
+    Scene(const SceneResolution& resolution, const Camera& camera, Geometry geometry)
+        : m_resolution(resolution)
+        , m_camera(camera)
+        , m_geometry(std::move(geometry))
     {
     }
 
@@ -23,8 +39,32 @@ public:
         return m_resolution.width();
     }
 
+    [[nodiscard]] constexpr const auto& resolution() const noexcept
+    {
+        return m_resolution;
+    }
+
+    [[nodiscard]] const auto& camera() const noexcept
+    {
+        return m_camera;
+    }
+
+    [[nodiscard]] const auto& geometry() const noexcept
+    {
+        return m_geometry;
+    }
+
+    // Rays that miss every primitive see this
+    static constexpr Color background{0.0F, 0.0F, 0.0F};
+
+    // Computes the color seen along a primary ray from the camera. Hits are lit by a light at the camera, so surfaces
+    // are brighter the more directly they face the ray. Renderers may call this concurrently.
+    [[nodiscard]] Color shade(const Ray3& ray) const;
+
 private:
     SceneResolution m_resolution;
+    Camera m_camera;
+    Geometry m_geometry;
 };
 
 } // namespace eyebeam
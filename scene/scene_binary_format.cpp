@@ -0,0 +1,211 @@
+#include "scene_binary_format.h"
+
+#include "geometry.h"
+#include "mesh_pool.h"
+#include "primitive_lanes.h"
+#include "scene.h"
+
+#include "bvh.h"
+#include "camera.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr auto alignUp(size_t offset) noexcept
+{
+    return (offset + binarySceneAlignment - 1) / binarySceneAlignment * binarySceneAlignment;
+}
+
+template <typename Pool>
+auto poolBytes(const Pool& pool) noexcept
+{
+    return Pool::columnCount * binarySceneColumnStride(pool.size(), LaneColumn::padding) * sizeof(float);
+}
+
+class SectionWriter
+{
+public:
+    explicit SectionWriter(std::ostream& os) : m_os(os)
+    {
+    }
+
+    void write(const void* data, size_t bytes)
+    {
+        m_os.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        m_position += bytes;
+    }
+
+    void padTo(size_t position)
+    {
+        constexpr std::array<char, binarySceneAlignment> zeros = {};
+        while (m_position < position)
+        {
+            write(zeros.data(), std::min(position - m_position, zeros.size()));
+        }
+    }
+
+    template <typename Pool>
+    void writePool(const Pool& pool)
+    {
+        const auto stride = binarySceneColumnStride(pool.size(), LaneColumn::padding);
+        for (const auto* column : pool.columns())
+        {
+            const auto columnStart = m_position;
+            write(column->data(), (column->size() + LaneColumn::padding) * sizeof(float));
+            padTo(columnStart + stride * sizeof(float));
+        }
+    }
+
+    // The triangles are written with their padding triangles
+    void writeMeshes(
+        const MeshPool& meshes,
+        const BinarySceneSectionEntry& vertices,
+        const BinarySceneSectionEntry& triangles)
+    {
+        padTo(vertices.offset);
+        if (meshes.vertexFormat() == MeshVertexFormat::Float)
+        {
+            write(meshes.vertices().data(), meshes.vertices().size() * sizeof(float));
+        }
+        else
+        {
+            write(meshes.quantizedVertices().data(), meshes.quantizedVertices().size() * sizeof(std::uint16_t));
+        }
+
+        padTo(triangles.offset);
+        write(meshes.indices().data(), meshes.indices().size() * sizeof(std::uint32_t));
+    }
+
+    void writeHierarchy(
+        const Bvh& hierarchy,
+        const BinarySceneSectionEntry& nodes,
+        const BinarySceneSectionEntry& indices)
+    {
+        padTo(nodes.offset);
+        write(hierarchy.nodes().data(), hierarchy.nodes().size() * sizeof(BvhNode));
+        padTo(indices.offset);
+        write(hierarchy.primitiveIndices().data(), hierarchy.primitiveIndices().size() * sizeof(std::uint32_t));
+    }
+
+private:
+    std::ostream& m_os;
+    size_t m_position = 0;
+};
+
+auto buildHeader(const Scene& scene)
+{
+    const auto& geometry = scene.geometry();
+
+    BinarySceneHeader header = {};
+    header.magic = binarySceneMagic;
+    header.version = binarySceneVersion;
+    header.byteOrderMark = binarySceneByteOrderMark;
+    header.width = scene.width();
+    header.height = scene.height();
+
+    const auto& camera = scene.camera();
+    const auto cameraToWorld(camera.cameraToWorld().getTransformUnaligned());
+    header.verticalFieldOfView = camera.verticalFieldOfView();
+    header.cameraToWorld = cameraToWorld.first;
+    header.worldToCamera = cameraToWorld.second;
+
+    const auto& meshes = geometry.meshes();
+    header.meshVertexFormat = static_cast<std::uint32_t>(meshes.vertexFormat());
+    header.meshQuantizationOrigin = meshes.quantization().origin;
+    header.meshQuantizationScale = meshes.quantization().scale;
+
+    auto offset = alignUp(sizeof(BinarySceneHeader));
+    const auto addSection = [&](BinarySceneSection section, size_t count, size_t bytes) {
+        header.sections.at(static_cast<size_t>(section)) = BinarySceneSectionEntry{offset, count};
+        offset = alignUp(offset + bytes);
+    };
+
+    const auto addHierarchy = [&](BinarySceneSection nodes, BinarySceneSection indices, const Bvh& hierarchy) {
+        addSection(nodes, hierarchy.nodes().size(), hierarchy.nodes().size() * sizeof(BvhNode));
+        addSection(
+            indices, hierarchy.primitiveIndices().size(), hierarchy.primitiveIndices().size() * sizeof(std::uint32_t));
+    };
+
+    addSection(BinarySceneSection::Spheres, geometry.spheres().size(), poolBytes(geometry.spheres()));
+    addSection(BinarySceneSection::Planes, geometry.planes().size(), poolBytes(geometry.planes()));
+    addSection(BinarySceneSection::Boxes, geometry.boxes().size(), poolBytes(geometry.boxes()));
+    addSection(BinarySceneSection::Triangles, geometry.triangles().size(), poolBytes(geometry.triangles()));
+    addSection(
+        BinarySceneSection::MeshVertices,
+        meshes.vertexCount(),
+        meshes.vertexFormat() == MeshVertexFormat::Float ? meshes.vertices().size() * sizeof(float)
+                                                         : meshes.quantizedVertices().size() * sizeof(std::uint16_t));
+    addSection(BinarySceneSection::MeshTriangles, meshes.size(), meshes.indices().size() * sizeof(std::uint32_t));
+    addHierarchy(
+        BinarySceneSection::SphereNodes, BinarySceneSection::SpherePrimitiveIndices, geometry.sphereHierarchy());
+    addHierarchy(BinarySceneSection::BoxNodes, BinarySceneSection::BoxPrimitiveIndices, geometry.boxHierarchy());
+    addHierarchy(
+        BinarySceneSection::TriangleNodes,
+        BinarySceneSection::TrianglePrimitiveIndices,
+        geometry.triangleHierarchy());
+    addHierarchy(BinarySceneSection::MeshNodes, BinarySceneSection::MeshPrimitiveIndices, geometry.meshHierarchy());
+
+    return header;
+}
+
+} // namespace
+
+void writeBinaryScene(const Scene& scene, std::ostream& os)
+{
+    const auto& geometry = scene.geometry();
+    if (geometry.instances().size() != 0)
+    {
+        throw std::runtime_error("Scenes with instances cannot be compiled");
+    }
+
+    const auto header(buildHeader(scene));
+    const auto section = [&header](BinarySceneSection id) { return header.sections.at(static_cast<size_t>(id)); };
+
+    SectionWriter writer(os);
+    writer.write(&header, sizeof(header));
+
+    writer.padTo(section(BinarySceneSection::Spheres).offset);
+    writer.writePool(geometry.spheres());
+    writer.padTo(section(BinarySceneSection::Planes).offset);
+    writer.writePool(geometry.planes());
+    writer.padTo(section(BinarySceneSection::Boxes).offset);
+    writer.writePool(geometry.boxes());
+    writer.padTo(section(BinarySceneSection::Triangles).offset);
+    writer.writePool(geometry.triangles());
+    writer.writeMeshes(
+        geometry.meshes(), section(BinarySceneSection::MeshVertices), section(BinarySceneSection::MeshTriangles));
+
+    writer.writeHierarchy(
+        geometry.sphereHierarchy(),
+        section(BinarySceneSection::SphereNodes),
+        section(BinarySceneSection::SpherePrimitiveIndices));
+    writer.writeHierarchy(
+        geometry.boxHierarchy(),
+        section(BinarySceneSection::BoxNodes),
+        section(BinarySceneSection::BoxPrimitiveIndices));
+    writer.writeHierarchy(
+        geometry.triangleHierarchy(),
+        section(BinarySceneSection::TriangleNodes),
+        section(BinarySceneSection::TrianglePrimitiveIndices));
+    writer.writeHierarchy(
+        geometry.meshHierarchy(),
+        section(BinarySceneSection::MeshNodes),
+        section(BinarySceneSection::MeshPrimitiveIndices));
+
+    if (!os)
+    {
+        throw std::runtime_error("Could not write the compiled scene");
+    }
+}
+
+} // namespace eyebeam
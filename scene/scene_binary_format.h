@@ -0,0 +1,90 @@
+#ifndef INCLUDED_SCENE_BINARY_FORMAT_H_
+#define INCLUDED_SCENE_BINARY_FORMAT_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+#include <type_traits>
+
+namespace eyebeam
+{
+
+class Scene;
+
+// Compiled scenes are a header, which also holds the resolution and camera, followed by sections that hold the
+// primitive pools and their hierarchies exactly as they are laid out in memory, so a mapped file is used in place
+// instead of being parsed. Every section starts on a 64 byte boundary. Pool sections hold their columns one after
+// another, each padded to binarySceneColumnStride floats. The mesh sections hold the shared vertices, as floats or 16
+// bit integers depending on the header, and the vertex indices of every triangle followed by the padding triangles.
+// Files are only read by builds with the same byte order, which the header records.
+
+constexpr std::string_view compiledSceneExtension = ".ebscene";
+constexpr std::array<char, 8> binarySceneMagic = {'E', 'Y', 'E', 'B', 'S', 'C', 'N', '\0'};
+constexpr std::uint32_t binarySceneVersion = 3;
+constexpr std::uint32_t binarySceneByteOrderMark = 0x01020304;
+constexpr size_t binarySceneAlignment = 64;
+
+enum class BinarySceneSection : std::uint8_t
+{
+    Spheres,
+    Planes,
+    Boxes,
+    Triangles,
+    SphereNodes,
+    SpherePrimitiveIndices,
+    BoxNodes,
+    BoxPrimitiveIndices,
+    TriangleNodes,
+    TrianglePrimitiveIndices,
+    MeshVertices,
+    MeshTriangles,
+    MeshNodes,
+    MeshPrimitiveIndices,
+    Count
+};
+
+struct BinarySceneSectionEntry
+{
+    // Bytes from the start of the file
+    std::uint64_t offset;
+    // Primitives for pool sections, vertices and triangles for the mesh sections, elements otherwise
+    std::uint64_t count;
+};
+
+struct BinarySceneHeader
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+    std::int32_t width;
+    std::int32_t height;
+    // In radians
+    float verticalFieldOfView;
+    // A MeshVertexFormat
+    std::uint32_t meshVertexFormat;
+    std::array<float, 16> cameraToWorld;
+    std::array<float, 16> worldToCamera;
+    // How quantized mesh vertices map to the world
+    std::array<float, 3> meshQuantizationOrigin;
+    std::array<float, 3> meshQuantizationScale;
+    std::array<BinarySceneSectionEntry, static_cast<size_t>(BinarySceneSection::Count)> sections;
+};
+
+static_assert(std::is_trivially_copyable_v<BinarySceneHeader>, "BinarySceneHeader is written and read as bytes");
+
+// Floats each column of a pool section occupies, which keeps the padding the lanes read past the last primitive and
+// starts every column on a 64 byte boundary
+[[nodiscard]] constexpr size_t binarySceneColumnStride(size_t count, size_t padding) noexcept
+{
+    constexpr auto floatsPerBoundary = binarySceneAlignment / sizeof(float);
+    return (count + padding + floatsPerBoundary - 1) / floatsPerBoundary * floatsPerBoundary;
+}
+
+// Throws std::runtime_error when the stream fails or the scene has instances, which the format cannot hold
+void writeBinaryScene(const Scene& scene, std::ostream& os);
+
+} // namespace eyebeam
+
+#endif // INCLUDED_SCENE_BINARY_FORMAT_H_
@@ -0,0 +1,47 @@
+#include "scene.h"
+#include "scene_binary_format.h"
+#include "scene_factory_json.h"
+
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iostream>
+
+// Compiles a JSON scene into the binary format that SceneFactoryBinary maps in place
+int main(int argc, char* argv[])
+{
+    using namespace eyebeam;
+
+    if (argc != 3)
+    {
+        std::cerr << "Usage: scenecompiler <inputScene.json> <outputScene" << compiledSceneExtension << ">\n";
+        return 1;
+    }
+
+    const char* const inputFile = argv[1];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const char* const outputFile = argv[2]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    const auto scene(SceneFactoryJson().buildScene(inputFile));
+    if (scene == nullptr)
+    {
+        return 1;
+    }
+
+    try
+    {
+        const auto startTime(std::chrono::steady_clock::now());
+
+        std::ofstream output(outputFile, std::ios::binary);
+        writeBinaryScene(*scene, output);
+
+        const std::chrono::duration<double> duration(std::chrono::steady_clock::now() - startTime);
+        std::cout << "Compiled scene written to " << outputFile << " in " << duration.count() << " seconds\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -1 +1,24 @@
 #include "scene_factory.h"
+
+#include "scene_binary_format.h"
+#include "scene_factory_binary.h"
+#include "scene_factory_json.h"
+
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace eyebeam
+{
+
+std::unique_ptr<SceneFactory> createSceneFactory(std::string_view fileName)
+{
+    if (std::filesystem::path(fileName).extension() == compiledSceneExtension)
+    {
+        return std::make_unique<SceneFactoryBinary>();
+    }
+
+    return std::make_unique<SceneFactoryJson>();
+}
+
+} // namespace eyebeam
@@ -24,6 +24,10 @@ public:
     [[nodiscard]] virtual std::unique_ptr<Scene> buildScene(std::string_view fileName) const = 0;
 };
 
+// Picks the factory for a scene file by its extension. Files ending in compiledSceneExtension are compiled scenes and
+// anything else is read as JSON.
+[[nodiscard]] std::unique_ptr<SceneFactory> createSceneFactory(std::string_view fileName);
+
 } // namespace eyebeam
 
 #endif // INCLUDED_SCENE_FACTORY_H_
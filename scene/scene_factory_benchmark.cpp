@@ -0,0 +1,178 @@
+#include "scene.h"
+#include "scene_binary_format.h"
+#include "scene_factory_binary.h"
+#include "scene_factory_json.h"
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+constexpr int generatedObjectCount = 1000000;
+
+// The factories print their timings, which would interleave with the benchmark table
+class SilencedStandardOutput
+{
+public:
+    SilencedStandardOutput() : m_buffer(std::cout.rdbuf(nullptr))
+    {
+    }
+
+    ~SilencedStandardOutput()
+    {
+        std::cout.rdbuf(m_buffer);
+    }
+
+    SilencedStandardOutput(const SilencedStandardOutput&) = delete;
+    SilencedStandardOutput(SilencedStandardOutput&&) = delete;
+
+    SilencedStandardOutput& operator=(const SilencedStandardOutput&) = delete;
+    SilencedStandardOutput& operator=(SilencedStandardOutput&&) = delete;
+
+private:
+    std::streambuf* m_buffer;
+};
+
+// Spheres, boxes and triangles scattered through a cube, in the proportions of a typical architectural scene
+void writeGeneratedScene(const std::filesystem::path& path)
+{
+    std::ofstream file(path);
+    std::mt19937 engine(1234);
+    std::uniform_real_distribution<float> position(-50.0F, 50.0F);
+    std::uniform_real_distribution<float> size(0.05F, 0.5F);
+
+    const auto point = [&](float dx, float dy, float dz) {
+        return "[" + std::to_string(position(engine) + dx) + "," + std::to_string(position(engine) + dy) + "," +
+               std::to_string(position(engine) + dz) + "]";
+    };
+
+    file << R"({"resolution":{"width":1024,"height":1024},)"
+         << R"("camera":{"position":[0,0,-100],"lookAt":[0,0,0],"up":[0,1,0]},)"
+         << R"("objects":[{"type":"plane","point":[0,-60,0],"normal":[0,1,0]})";
+
+    for (int i = 1; i < generatedObjectCount; ++i)
+    {
+        switch (i % 10)
+        {
+        case 0:
+        case 1:
+        case 2:
+            file << R"(,{"type":"sphere","center":)" << point(0.0F, 0.0F, 0.0F) << R"(,"radius":)" << size(engine)
+                 << "}";
+            break;
+        case 3:
+        case 4:
+        {
+            const auto minimum(point(0.0F, 0.0F, 0.0F));
+            file << R"(,{"type":"box","min":)" << minimum << R"(,"max":)" << point(0.5F, 0.5F, 0.5F) << "}";
+            break;
+        }
+        default:
+            file << R"(,{"type":"triangle","vertices":[)" << point(0.0F, 0.0F, 0.0F) << ","
+                 << point(0.0F, 0.0F, 0.0F) << "," << point(0.0F, 0.0F, 0.0F) << "]}";
+            break;
+        }
+    }
+
+    file << "]}";
+}
+
+// Generated on first use and kept in the temporary directory between runs
+const auto& generatedSceneFile()
+{
+    static const auto path = [] {
+        auto p(std::filesystem::temp_directory_path() / "eyebeam_benchmark_1m_objects.json");
+        if (!std::filesystem::exists(p))
+        {
+            writeGeneratedScene(p);
+        }
+
+        return p;
+    }();
+
+    return path;
+}
+
+const auto& compiledGeneratedSceneFile()
+{
+    static const auto path = [] {
+        auto p(std::filesystem::temp_directory_path() / "eyebeam_benchmark_1m_objects.ebscene");
+        const SilencedStandardOutput silenced;
+        const auto scene(SceneFactoryJson().buildScene(generatedSceneFile().string()));
+        if (scene == nullptr)
+        {
+            throw std::runtime_error("Could not load the generated scene");
+        }
+
+        std::ofstream file(p, std::ios::binary);
+        writeBinaryScene(*scene, file);
+        return p;
+    }();
+
+    return path;
+}
+
+void benchmarkSceneFactoryJson(benchmark::State& state)
+{
+    const auto fileName(generatedSceneFile().string());
+    const SilencedStandardOutput silenced;
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto scene(SceneFactoryJson().buildScene(fileName));
+        benchmark::DoNotOptimize(scene.get());
+    }
+
+    state.SetItemsProcessed(state.iterations() * generatedObjectCount);
+}
+
+// Only the parse into a document that SceneFactoryJson used to perform before reading any object
+void benchmarkJsonDocumentParse(benchmark::State& state)
+{
+    for ([[maybe_unused]] auto s : state)
+    {
+        std::ifstream file(generatedSceneFile());
+        const auto document(nlohmann::json::parse(file));
+        benchmark::DoNotOptimize(document.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * generatedObjectCount);
+}
+
+void benchmarkSceneFactoryBinary(benchmark::State& state)
+{
+    const auto fileName(compiledGeneratedSceneFile().string());
+    const SilencedStandardOutput silenced;
+
+    for ([[maybe_unused]] auto s : state)
+    {
+        const auto scene(SceneFactoryBinary().buildScene(fileName));
+        benchmark::DoNotOptimize(scene.get());
+    }
+
+    state.SetItemsProcessed(state.iterations() * generatedObjectCount);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkSceneFactoryJson)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkJsonDocumentParse)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(benchmarkSceneFactoryBinary)->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace eyebeam
@@ -0,0 +1,258 @@
+#include "scene_factory_binary.h"
+
+#include "box_pool.h"
+#include "geometry.h"
+#include "instance_pool.h"
+#include "mapped_file.h"
+#include "mesh_pool.h"
+#include "plane_pool.h"
+#include "primitive_lanes.h"
+#include "scene.h"
+#include "scene_binary_format.h"
+#include "scene_resolution.h"
+#include "sphere_pool.h"
+#include "triangle_pool.h"
+
+#include "angle.h"
+#include "borrowable_array.h"
+#include "bvh.h"
+#include "camera.h"
+#include "transform.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+[[noreturn]] void throwInvalidFile(const char* reason)
+{
+    using namespace std::string_literals;
+    throw std::runtime_error("Invalid compiled scene file: "s + reason);
+}
+
+auto readHeader(const MappedFile& file)
+{
+    if (file.size() < sizeof(BinarySceneHeader))
+    {
+        throwInvalidFile("too short for the header");
+    }
+
+    BinarySceneHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (header.magic != binarySceneMagic)
+    {
+        throwInvalidFile("not a compiled scene");
+    }
+
+    if (header.version != binarySceneVersion)
+    {
+        throwInvalidFile("unsupported version");
+    }
+
+    if (header.byteOrderMark != binarySceneByteOrderMark)
+    {
+        throwInvalidFile("written with a different byte order");
+    }
+
+    return header;
+}
+
+// Checks that a section lies inside the file and is aligned, without touching its pages
+const std::byte* findSection(const MappedFile& file, const BinarySceneSectionEntry& section, size_t elementBytes)
+{
+    if (section.offset % binarySceneAlignment != 0 || section.offset > file.size())
+    {
+        throwInvalidFile("misplaced section");
+    }
+
+    if (section.count > (file.size() - section.offset) / elementBytes)
+    {
+        throwInvalidFile("section extends past the end of the file");
+    }
+
+    return file.data() + section.offset; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+template <typename Pool>
+auto borrowPool(const MappedFile& file, const BinarySceneSectionEntry& section)
+{
+    constexpr auto rowBytes = Pool::columnCount * sizeof(float);
+
+    // Checking the primitive count on its own first keeps the stride from overflowing
+    findSection(file, section, rowBytes);
+    const auto stride = binarySceneColumnStride(section.count, LaneColumn::padding);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* start = reinterpret_cast<const float*>(findSection(file, {section.offset, stride}, rowBytes));
+
+    std::array<LaneColumn, Pool::columnCount> columns;
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        columns.at(i) = LaneColumn(start + i * stride, section.count);
+    }
+
+    return Pool(std::move(columns));
+}
+
+// Every vertex index of the triangles must name a vertex, and those of the padding triangles the first one, since the
+// intersection kernels gather vertices by these indices without checking them
+void checkMeshIndices(const BorrowableArray<std::uint32_t>& indices, size_t triangleCount, size_t vertexCount)
+{
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        if (i < 3 * triangleCount ? indices[i] >= vertexCount : indices[i] != 0)
+        {
+            throwInvalidFile("mesh vertex index out of range");
+        }
+    }
+}
+
+auto borrowMeshes(
+    const MappedFile& file,
+    const BinarySceneHeader& header,
+    const BinarySceneSectionEntry& vertices,
+    const BinarySceneSectionEntry& triangles)
+{
+    constexpr auto indexBytes = 3 * sizeof(std::uint32_t);
+
+    // Checking the triangle count on its own first keeps the count with padding from overflowing
+    findSection(file, triangles, indexBytes);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* indexStart = reinterpret_cast<const std::uint32_t*>(
+        findSection(file, {triangles.offset, triangles.count + MeshPool::padding}, indexBytes));
+    BorrowableArray<std::uint32_t> indices(indexStart, 3 * (triangles.count + MeshPool::padding));
+    checkMeshIndices(indices, triangles.count, vertices.count);
+
+    if (header.meshVertexFormat == static_cast<std::uint32_t>(MeshVertexFormat::Float))
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto* start = reinterpret_cast<const float*>(findSection(file, vertices, 3 * sizeof(float)));
+        return MeshPool(BorrowableArray<float>(start, 3 * vertices.count), std::move(indices));
+    }
+
+    if (header.meshVertexFormat != static_cast<std::uint32_t>(MeshVertexFormat::Quantized16))
+    {
+        throwInvalidFile("unknown mesh vertex format");
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* start = reinterpret_cast<const std::uint16_t*>(findSection(file, vertices, 3 * sizeof(std::uint16_t)));
+    return MeshPool(
+        BorrowableArray<std::uint16_t>(start, 3 * vertices.count),
+        MeshQuantization{header.meshQuantizationOrigin, header.meshQuantizationScale},
+        std::move(indices));
+}
+
+auto borrowHierarchy(
+    const MappedFile& file,
+    const BinarySceneSectionEntry& nodes,
+    const BinarySceneSectionEntry& indices,
+    size_t primitiveCount)
+{
+    if (indices.count != primitiveCount)
+    {
+        throwInvalidFile("hierarchy does not match its primitives");
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* nodeStart = reinterpret_cast<const BvhNode*>(findSection(file, nodes, sizeof(BvhNode)));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* indexStart = reinterpret_cast<const std::uint32_t*>(findSection(file, indices, sizeof(std::uint32_t)));
+
+    Bvh hierarchy(
+        BorrowableArray<BvhNode>(nodeStart, nodes.count), BorrowableArray<std::uint32_t>(indexStart, indices.count));
+    if (!hierarchy.isWellFormed(primitiveCount))
+    {
+        throwInvalidFile("corrupt hierarchy");
+    }
+
+    return hierarchy;
+}
+
+} // namespace
+
+std::unique_ptr<Scene> SceneFactoryBinary::buildScene(std::string_view fileName) const
+{
+    try
+    {
+        const auto startTime(std::chrono::steady_clock::now());
+
+        auto file(std::make_shared<const MappedFile>(std::filesystem::path(fileName)));
+        const auto header(readHeader(*file));
+        const auto section = [&header](BinarySceneSection id) { return header.sections.at(static_cast<size_t>(id)); };
+
+        auto spheres(borrowPool<SpherePool>(*file, section(BinarySceneSection::Spheres)));
+        auto planes(borrowPool<PlanePool>(*file, section(BinarySceneSection::Planes)));
+        auto boxes(borrowPool<BoxPool>(*file, section(BinarySceneSection::Boxes)));
+        auto triangles(borrowPool<TrianglePool>(*file, section(BinarySceneSection::Triangles)));
+        auto meshes(borrowMeshes(
+            *file, header, section(BinarySceneSection::MeshVertices), section(BinarySceneSection::MeshTriangles)));
+
+        auto sphereHierarchy(borrowHierarchy(
+            *file,
+            section(BinarySceneSection::SphereNodes),
+            section(BinarySceneSection::SpherePrimitiveIndices),
+            spheres.size()));
+        auto boxHierarchy(borrowHierarchy(
+            *file,
+            section(BinarySceneSection::BoxNodes),
+            section(BinarySceneSection::BoxPrimitiveIndices),
+            boxes.size()));
+        auto triangleHierarchy(borrowHierarchy(
+            *file,
+            section(BinarySceneSection::TriangleNodes),
+            section(BinarySceneSection::TrianglePrimitiveIndices),
+            triangles.size()));
+        auto meshHierarchy(borrowHierarchy(
+            *file,
+            section(BinarySceneSection::MeshNodes),
+            section(BinarySceneSection::MeshPrimitiveIndices),
+            meshes.size()));
+
+        Geometry geometry(
+            std::move(spheres),
+            std::move(planes),
+            std::move(boxes),
+            std::move(triangles),
+            std::move(meshes),
+            InstancePool(),
+            std::move(sphereHierarchy),
+            std::move(boxHierarchy),
+            std::move(triangleHierarchy),
+            std::move(meshHierarchy),
+            std::move(file));
+
+        const std::chrono::duration<double> duration(std::chrono::steady_clock::now() - startTime);
+        std::cout << "Compiled scene file mapped in " << duration.count() << " seconds \n";
+
+        const Camera camera(
+            Transform(UnalignedTransformStorage(header.cameraToWorld, header.worldToCamera)),
+            header.width,
+            header.height,
+            Radians(header.verticalFieldOfView));
+
+        return std::make_unique<Scene>(SceneResolution(header.width, header.height), camera, std::move(geometry));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return nullptr;
+    }
+}
+
+} // namespace eyebeam
@@ -0,0 +1,34 @@
+#ifndef INCLUDED_SCENE_FACTORY_BINARY_H_
+#define INCLUDED_SCENE_FACTORY_BINARY_H_
+
+#include "scene_factory.h"
+
+#include <memory>
+#include <string_view>
+
+namespace eyebeam
+{
+
+class Scene;
+
+// Loads scenes compiled by scenecompiler. The file is memory mapped and its primitive pools and hierarchies are used
+// in place, so loading costs a few page faults instead of a parse, and processes loading the same file share its
+// pages.
+class SceneFactoryBinary final : public SceneFactory
+{
+public:
+    SceneFactoryBinary() = default;
+    ~SceneFactoryBinary() final = default;
+
+    SceneFactoryBinary(const SceneFactoryBinary&) = delete;
+    SceneFactoryBinary(SceneFactoryBinary&&) = delete;
+
+    SceneFactoryBinary& operator=(const SceneFactoryBinary&) = delete;
+    SceneFactoryBinary& operator=(SceneFactoryBinary&&) = delete;
+
+    [[nodiscard]] std::unique_ptr<Scene> buildScene(std::string_view fileName) const override;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_SCENE_FACTORY_BINARY_H_
@@ -1,23 +1,40 @@
 #include "scene_factory_json.h"
 
+#include "geometry.h"
+#include "instance_pool.h"
+#include "mapped_file.h"
+#include "mesh_pool.h"
+#include "primitive_lanes.h"
 #include "scene.h"
-#include "scene_resolution.h"
+#include "scene_json_reader.h"
+#include "scene_json_splitter.h"
 
-#include "point3.h"
+#include "angle.h"
+#include "borrowable_array.h"
+#include "bvh.h"
+#include "camera.h"
 #include "transform.h"
-#include "vector3.h"
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
-#include <iostream>
+#include <future>
 #include <iterator>
-#include <optional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace eyebeam
 {
@@ -25,131 +42,402 @@ namespace eyebeam
 namespace
 {
 
-using Json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+// Smaller chunks would spend more time starting parses than parsing
+constexpr size_t minChunkSize = size_t{1} << 20;
+
+// Several chunks per thread let threads that finish early take over work from the others
+constexpr size_t chunksPerThread = 8;
+
+using ChunkReaders = std::vector<std::unique_ptr<SceneJsonReader>>;
 
-auto parseJsonFromFile(std::string_view fileName)
+// The primitives of a chunk, taken from its reader, with their bounds gathered by the thread that parsed the chunk
+// while they are still in its cache
+struct ParsedChunk
 {
-    const std::filesystem::path filePath(fileName);
-    std::ifstream inputFile(filePath);
+    SceneJsonObjects objects;
+    BvhPrimitiveRun sphereBounds;
+    BvhPrimitiveRun boxBounds;
+    BvhPrimitiveRun triangleBounds;
+    BvhPrimitiveRun meshBounds;
+};
+
+auto secondsBetween(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double>(end - start).count();
+}
+
+bool parse(std::string_view text, SceneJsonReader& reader)
+{
+    return nlohmann::json::sax_parse(text.begin(), text.end(), &reader);
+}
 
-    if (!inputFile.is_open())
+// Presents a chunk of the objects array as a JSON array of its own, by reading the comma or bracket on either side of
+// it as brackets, so that the chunk is parsed in place in a single pass
+class ChunkIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = char;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const char*;
+    using reference = char;
+
+    ChunkIterator(const char* position, const char* open, const char* close) noexcept
+        : m_position(position)
+        , m_open(open)
+        , m_close(close)
     {
-        using namespace std::string_literals;
-        throw std::invalid_argument("Could not open scene file "s + std::string(fileName));
     }
 
-    Json parsedJson;
-    inputFile >> parsedJson;
-    return parsedJson;
+    [[nodiscard]] char operator*() const noexcept
+    {
+        return m_position == m_open ? '[' : (m_position == m_close ? ']' : *m_position);
+    }
+
+    ChunkIterator& operator++() noexcept
+    {
+        ++m_position;
+        return *this;
+    }
+
+    ChunkIterator operator++(int) noexcept
+    {
+        auto previous(*this);
+        ++m_position;
+        return previous;
+    }
+
+    [[nodiscard]] bool operator==(const ChunkIterator& other) const noexcept
+    {
+        return m_position == other.m_position;
+    }
+
+    [[nodiscard]] bool operator!=(const ChunkIterator& other) const noexcept
+    {
+        return m_position != other.m_position;
+    }
+
+private:
+    const char* m_position;
+    const char* m_open;
+    const char* m_close;
+};
+
+bool readChunk(std::string_view text, const SceneJsonChunk& chunk, SceneJsonReader& reader)
+{
+    const auto* open = &text[chunk.begin - 1];
+    const auto* close = &text[chunk.end];
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return nlohmann::json::sax_parse(ChunkIterator(open, open, close), ChunkIterator(close + 1, open, close), &reader);
 }
 
-auto readResolution(const Json& sceneJson)
+// Mesh bounds are gathered even when the scene quantizes its meshes, since the outline that says so may not be read
+// yet, and are dropped later in that case
+ParsedChunk takeChunk(SceneJsonReader& reader)
 {
-    const auto resolutionJson(sceneJson.find("resolution"));
-    return resolutionJson != sceneJson.end() ? std::make_optional<SceneResolution>(
-                                                   resolutionJson->at("width").get<int>(),
-                                                   resolutionJson->at("height").get<int>())
-                                             : std::nullopt;
+    ParsedChunk chunk{reader.takeObjects(), {}, {}, {}, {}};
+    chunk.sphereBounds = gatherBounds(chunk.objects.spheres);
+    chunk.boxBounds = gatherBounds(chunk.objects.boxes);
+    chunk.triangleBounds = gatherBounds(chunk.objects.triangles);
+    chunk.meshBounds = gatherBounds(chunk.objects.meshes);
+    return chunk;
 }
 
-template <std::size_t ExpectedSize>
-auto readMathArray(const Json& parent, std::string_view key)
+// Parses the chunks on threadCount threads, one of which is the calling thread, into parsedChunks. It parses outline,
+// which is the scene file with the entries of the objects array cut out, before helping with the chunks. After a
+// chunk fails, the chunks that follow it are skipped, so the first failed chunk is the same however the chunks were
+// scheduled. Returns the reader of every chunk, which holds its error.
+ChunkReaders readChunks(
+    std::string_view text,
+    const std::vector<SceneJsonChunk>& chunks,
+    size_t threadCount,
+    std::string_view outline,
+    SceneJsonReader& outlineReader,
+    const std::filesystem::path& directory,
+    std::vector<ParsedChunk>& parsedChunks)
 {
-    using ComponentStorage = UnalignedComponentStorage<ExpectedSize>;
+    ChunkReaders readers;
+    readers.reserve(chunks.size());
+    for (const auto& chunk : chunks)
+    {
+        readers.push_back(std::make_unique<SceneJsonReader>(chunk.firstObjectIndex, directory));
+    }
 
-    const auto value(parent.find(key));
+    parsedChunks.resize(chunks.size());
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<size_t> firstFailedChunk{std::numeric_limits<size_t>::max()};
+
+    const auto readRemainingChunks = [&] {
+        for (auto i = nextChunk++; i < chunks.size() && i < firstFailedChunk; i = nextChunk++)
+        {
+            if (readChunk(text, chunks[i], *readers[i]))
+            {
+                parsedChunks[i] = takeChunk(*readers[i]);
+                continue;
+            }
+
+            auto failed = firstFailedChunk.load();
+            while (i < failed && !firstFailedChunk.compare_exchange_weak(failed, i))
+            {
+            }
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+    for (size_t i = 1; i < threadCount; ++i)
+    {
+        workers.push_back(std::async(std::launch::async, readRemainingChunks));
+    }
 
-    if (value == parent.end())
+    if (parse(outline, outlineReader))
     {
-        return std::optional<ComponentStorage>();
+        readRemainingChunks();
+    }
+    else
+    {
+        firstFailedChunk = 0;
     }
 
-    if (!value->is_array())
+    for (auto& worker : workers)
     {
-        return std::optional<ComponentStorage>();
+        worker.get();
     }
 
-    if (value->size() != ExpectedSize)
+    return readers;
+}
+
+// The bounds of one primitive type that the chunks gathered, in file order
+std::vector<BvhPrimitiveRun> takeBounds(std::vector<ParsedChunk>& chunks, BvhPrimitiveRun ParsedChunk::*bounds)
+{
+    std::vector<BvhPrimitiveRun> runs;
+    runs.reserve(chunks.size());
+    for (auto& chunk : chunks)
     {
-        return std::optional<ComponentStorage>();
+        runs.push_back(std::move(chunk.*bounds));
     }
 
-    return std::make_optional<ComponentStorage>(value->get<ComponentStorage>());
+    return runs;
 }
 
-auto readPoint(const Json& parent, std::string_view key)
+auto buildInBackground(std::vector<BvhPrimitiveRun> runs)
 {
-    return readMathArray<3>(parent, key);
+    return std::async(std::launch::async, [runs = std::move(runs)]() mutable { return Bvh(std::move(runs)); });
 }
 
-auto readVector(const Json& parent, std::string_view key)
+BorrowableArray<std::uint32_t> fileOrder(size_t size)
 {
-    return readMathArray<3>(parent, key);
+    std::vector<std::uint32_t> order(size);
+    std::iota(order.begin(), order.end(), 0U);
+    return BorrowableArray<std::uint32_t>(std::move(order));
 }
 
-auto readCamera(const Json& sceneJson)
+// One pool of a primitive type holding the primitives of every chunk in order, after which the chunks no longer hold
+// that type, so that only one type is ever held twice
+template <typename Pool>
+Pool gatherChunks(
+    std::vector<ParsedChunk>& chunks,
+    Pool SceneJsonObjects::*pool,
+    const BorrowableArray<std::uint32_t>& order)
 {
-    const auto lookAtJson(sceneJson.find("camera"));
-    if (lookAtJson == sceneJson.end())
+    std::vector<const Pool*> parts;
+    parts.reserve(chunks.size());
+    for (const auto& chunk : chunks)
     {
-        return std::optional<UnalignedTransformStorage>();
+        parts.push_back(&(chunk.objects.*pool));
     }
 
-    const auto optionalPosition(readPoint(*lookAtJson, "position"));
-    if (!optionalPosition.has_value())
+    auto gathered(gatherPools(parts, order));
+    for (auto& chunk : chunks)
     {
-        return std::optional<UnalignedTransformStorage>();
+        chunk.objects.*pool = Pool();
     }
 
-    const auto optionalLookAt(readPoint(*lookAtJson, "lookAt"));
-    if (!optionalLookAt.has_value())
+    return gathered;
+}
+
+template <typename Pool>
+size_t countChunks(const std::vector<ParsedChunk>& chunks, Pool SceneJsonObjects::*pool)
+{
+    size_t count = 0;
+    for (const auto& chunk : chunks)
     {
-        return std::optional<UnalignedTransformStorage>();
+        count += (chunk.objects.*pool).size();
     }
 
-    const auto optionalUp(readVector(*lookAtJson, "up"));
-    if (!optionalUp.has_value())
+    return count;
+}
+
+// Builds the hierarchies from the bounds the chunks gathered, each splitting its root across the chunks, then gathers
+// the primitives of the chunks straight into the leaf order of their hierarchies. Quantized meshes are gathered in
+// file order instead, since their bounds change once the grid over every mesh is known. The instances are read with
+// the rest of the outline, by outlineReader.
+Geometry mergeChunks(std::vector<ParsedChunk>& chunks, const SceneJsonReader& outlineReader)
+{
+    const auto startTime(Clock::now());
+    const auto isQuantized = outlineReader.meshVertexFormat() == MeshVertexFormat::Quantized16;
+
+    auto sphereBuild = buildInBackground(takeBounds(chunks, &ParsedChunk::sphereBounds));
+    auto boxBuild = buildInBackground(takeBounds(chunks, &ParsedChunk::boxBounds));
+    auto meshBuild = buildInBackground(
+        isQuantized ? std::vector<BvhPrimitiveRun>() : takeBounds(chunks, &ParsedChunk::meshBounds));
+    auto triangleHierarchy(Bvh(takeBounds(chunks, &ParsedChunk::triangleBounds)));
+    auto sphereHierarchy(sphereBuild.get());
+    auto boxHierarchy(boxBuild.get());
+    auto meshHierarchy(meshBuild.get());
+
+    const auto builtTime(Clock::now());
+    std::cout << "Bounding volume hierarchies built from the bounds of " << chunks.size() << " chunks in "
+              << secondsBetween(startTime, builtTime) << " seconds\n";
+
+    const auto planeOrder(fileOrder(countChunks(chunks, &SceneJsonObjects::planes)));
+    auto spheres(gatherChunks(chunks, &SceneJsonObjects::spheres, sphereHierarchy.primitiveIndices()));
+    auto planes(gatherChunks(chunks, &SceneJsonObjects::planes, planeOrder));
+    auto boxes(gatherChunks(chunks, &SceneJsonObjects::boxes, boxHierarchy.primitiveIndices()));
+    auto triangles(gatherChunks(chunks, &SceneJsonObjects::triangles, triangleHierarchy.primitiveIndices()));
+
+    MeshPool meshes;
+    if (isQuantized)
     {
-        return std::optional<UnalignedTransformStorage>();
+        const auto meshOrder(fileOrder(countChunks(chunks, &SceneJsonObjects::meshes)));
+        meshes = gatherChunks(chunks, &SceneJsonObjects::meshes, meshOrder);
+        meshes.quantize();
+
+        std::vector<BvhPrimitiveRun> runs;
+        runs.push_back(gatherBounds(meshes));
+        meshHierarchy = Bvh(std::move(runs));
+        meshes.reorder(meshHierarchy.primitiveIndices());
+    }
+    else
+    {
+        meshes = gatherChunks(chunks, &SceneJsonObjects::meshes, meshHierarchy.primitiveIndices());
     }
 
-    const Point3 position(*optionalPosition);
-    const Point3 lookAt(*optionalLookAt);
-    const Vector3 up(*optionalUp);
-
-    return std::make_optional<UnalignedTransformStorage>(
-        Transform::lookAt(position, lookAt, up).getTransformUnaligned());
+    std::cout << "Primitives gathered into the leaf order of their hierarchies in "
+              << secondsBetween(builtTime, Clock::now()) << " seconds\n";
+
+    return Geometry(
+        std::move(spheres),
+        std::move(planes),
+        std::move(boxes),
+        std::move(triangles),
+        std::move(meshes),
+        outlineReader.instances(),
+        std::move(sphereHierarchy),
+        std::move(boxHierarchy),
+        std::move(triangleHierarchy),
+        std::move(meshHierarchy),
+        nullptr);
 }
 
 } // namespace
 
+// Large scenes are loaded in stages that each run on every hardware thread. A quick scan splits the objects array into
+// chunks, which are parsed straight into primitive pools while the calling thread reads the rest of the file before it
+// helps with the chunks. The thread that parses a chunk gathers the bounds and centroids of its primitives right away.
+// The root of a hierarchy is split by the centroid bounds of every chunk, so the hierarchies start once the last chunk
+// is in: each bins and partitions its root across the chunks in parallel, then splits its largest subtrees across
+// threads. The primitives of the chunks are then copied once, straight into the leaf order of their hierarchies, and
+// each primitive type of the chunks is released as soon as it is gathered.
 std::unique_ptr<Scene> SceneFactoryJson::buildScene(std::string_view fileName) const
 {
     try
     {
-        const auto startTime(std::chrono::steady_clock::now());
+        const auto startTime(Clock::now());
+
+        // The parser reads the mapped file in place, so neither the text nor a document is copied into memory
+        const MappedFile file(std::filesystem::path{fileName});
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const std::string_view text(reinterpret_cast<const char*>(file.data()), file.size());
 
-        const auto sceneJson(parseJsonFromFile(fileName));
-        const auto resolution(readResolution(sceneJson));
+        const auto threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        const auto chunkSize =
+            m_chunkSize.value_or(std::max(minChunkSize, text.size() / (threadCount * chunksPerThread)));
+        const auto layout(splitSceneJson(text, chunkSize));
+        const auto isChunked = layout.has_value() && layout->chunks.size() > 1;
 
-        if (!resolution.has_value())
+        const auto splitTime(Clock::now());
+        if (isChunked)
         {
-            std::cerr << "Error loading resolution from " << fileName << "\n";
+            std::cout << "Scene file split into " << layout->chunks.size() << " chunks of objects in "
+                      << secondsBetween(startTime, splitTime) << " seconds\n";
+        }
+
+        const auto directory(std::filesystem::path{fileName}.parent_path());
+        SceneJsonReader reader(directory);
+        ChunkReaders chunkReaders;
+        std::vector<ParsedChunk> parsedChunks;
+        auto parseThreadCount = size_t{1};
+        if (isChunked)
+        {
+            parseThreadCount = std::min(threadCount, layout->chunks.size());
+            const auto outline(
+                std::string(text.substr(0, layout->objectsBegin)).append(text.substr(layout->objectsEnd)));
+            chunkReaders =
+                readChunks(text, layout->chunks, parseThreadCount, outline, reader, directory, parsedChunks);
+        }
+        else
+        {
+            parse(text, reader);
+        }
+
+        const auto* failedReader = reader.error().empty() ? nullptr : &reader;
+        for (const auto& chunkReader : chunkReaders)
+        {
+            if (failedReader == nullptr && !chunkReader->error().empty())
+            {
+                failedReader = chunkReader.get();
+            }
+        }
+
+        if (failedReader != nullptr)
+        {
+            std::cerr << "Error reading " << fileName << ": " << failedReader->error() << "\n";
             return nullptr;
         }
 
-        const auto worldToCameraTransform(readCamera(sceneJson));
+        if (!reader.resolution().has_value())
+        {
+            std::cerr << "Error loading resolution from " << fileName << "\n";
+            return nullptr;
+        }
 
-        if (!worldToCameraTransform.has_value())
+        if (!reader.cameraToWorld().has_value())
         {
             std::cerr << "Error loading look at transform from " << fileName << "\n";
             return nullptr;
         }
 
-        const std::chrono::duration<double> duration(std::chrono::steady_clock::now() - startTime);
-        std::cout << "Scene file parsed in " << duration.count() << " seconds \n";
+        const auto parsedTime(Clock::now());
+        std::cout << (isChunked ? layout->objectCount : reader.objectCount())
+                  << (isChunked ? " objects parsed and their bounds gathered on " : " objects parsed on ")
+                  << parseThreadCount << (parseThreadCount == 1 ? " thread in " : " threads in ")
+                  << secondsBetween(splitTime, parsedTime) << " seconds\n";
+        if (reader.instances().size() != 0)
+        {
+            const auto& instances = reader.instances();
+            std::cout << instances.size() << " instances placed of " << instances.prototypeCount() << " assets, "
+                      << instances.movingCount() << " of them moving\n";
+        }
+
+        chunkReaders.clear();
+        auto geometry(isChunked ? mergeChunks(parsedChunks, reader) : reader.buildGeometry());
+        if (!isChunked)
+        {
+            std::cout << "Primitives gathered and bounding volume hierarchies built in "
+                      << secondsBetween(parsedTime, Clock::now()) << " seconds\n";
+        }
+
+        const auto& resolution = *reader.resolution();
+        const Camera camera(
+            Transform(*reader.cameraToWorld()),
+            resolution.width(),
+            resolution.height(),
+            toRadians(Degrees(reader.fieldOfView().value_or(Camera::defaultVerticalFieldOfView))));
 
-        return std::make_unique<Scene>(*resolution);
+        return std::make_unique<Scene>(resolution, camera, std::move(geometry));
     }
     catch (const std::exception& e)
     {
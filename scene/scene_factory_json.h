@@ -1,5 +1,7 @@
 #include "scene_factory.h"
 
+#include <cstddef>
+#include <optional>
 #include <string_view>
 
 namespace eyebeam
@@ -11,6 +13,13 @@ class SceneFactoryJson final : public SceneFactory
 {
 public:
     SceneFactoryJson() = default;
+
+    // Splits the objects array into chunks of about chunkSize bytes, rather than sizing the chunks by the file and the
+    // hardware threads
+    explicit SceneFactoryJson(size_t chunkSize) noexcept : m_chunkSize(chunkSize)
+    {
+    }
+
     ~SceneFactoryJson() final = default;
 
     SceneFactoryJson(const SceneFactoryJson&) = delete;
@@ -22,6 +31,7 @@ public:
     [[nodiscard]] std::unique_ptr<Scene> buildScene(std::string_view fileName) const override;
 
 private:
+    std::optional<size_t> m_chunkSize;
 };
 
 } // namespace eyebeam
@@ -0,0 +1,342 @@
+#include "scene_factory_binary.h"
+#include "scene_factory_json.h"
+
+#include "geometry.h"
+#include "mesh_pool.h"
+#include "scene.h"
+#include "scene_binary_format.h"
+
+#include "bvh.h"
+#include "intersection_info.h"
+#include "point3.h"
+#include "ray3.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// Objects of every type in a file large enough to be split into many chunks of a few kilobytes, with the meshes stored
+// in meshVertexFormat
+void writeScene(const std::filesystem::path& path, std::string_view meshVertexFormat = "float")
+{
+    std::ofstream file(path);
+    std::mt19937 engine(1234);
+    std::uniform_real_distribution<float> position(-10.0F, 10.0F);
+    std::uniform_real_distribution<float> size(0.1F, 1.0F);
+
+    const auto point = [&](float offset) {
+        return "[" + std::to_string(position(engine) + offset) + "," + std::to_string(position(engine) + offset) +
+               "," + std::to_string(position(engine) + offset) + "]";
+    };
+
+    file << R"({"resolution":{"width":64,"height":48},)"
+         << R"("camera":{"position":[0,0,-30],"lookAt":[0,0,0],"up":[0,1,0],"fieldOfView":50},)"
+         << R"("meshVertexFormat":")" << meshVertexFormat << R"(",)"
+         << R"("objects":[{"type":"plane","point":[0,-12,0],"normal":[0,1,0]})";
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        switch (i % 4)
+        {
+        case 0:
+            file << R"(,{"type":"sphere","center":)" << point(0.0F) << R"(,"radius":)" << size(engine) << "}";
+            break;
+        case 1:
+        {
+            const auto minimum(point(0.0F));
+            file << R"(,{"type":"box","min":)" << minimum << R"(,"max":)" << point(20.0F) << "}";
+            break;
+        }
+        case 2:
+            file << R"(,{"type":"triangle","vertices":[)" << point(0.0F) << "," << point(0.0F) << "," << point(0.0F)
+                 << "]}";
+            break;
+        default:
+            file << R"(,{"type":"mesh","vertices":[)" << point(0.0F) << "," << point(0.0F) << "," << point(0.0F)
+                 << "," << point(0.0F) << R"(],"indices":[0,1,2,0,2,3]})";
+            break;
+        }
+    }
+
+    file << "]}";
+}
+
+class SceneFactoryTestsFixture : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::filesystem::create_directories(m_directory);
+        writeScene(m_jsonFile);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    // The JSON scene compiled next to it
+    [[nodiscard]] std::filesystem::path compileScene() const
+    {
+        const auto json(SceneFactoryJson().buildScene(m_jsonFile.string()));
+        const auto compiledFile(m_directory / ("scene" + std::string(compiledSceneExtension)));
+        std::ofstream file(compiledFile, std::ios::binary);
+        writeBinaryScene(*json, file);
+        return compiledFile;
+    }
+
+    std::filesystem::path m_directory{
+        std::filesystem::temp_directory_path() /
+        ("eyebeam_scene_factory_test_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()))};
+    std::filesystem::path m_jsonFile{m_directory / "scene.json"};
+};
+
+template <typename Pool>
+void expectSameColumns(const Pool& expected, const Pool& actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    const auto expectedColumns(expected.columns());
+    const auto actualColumns(actual.columns());
+    for (size_t column = 0; column < expectedColumns.size(); ++column)
+    {
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            EXPECT_EQ((*expectedColumns[column])[i], (*actualColumns[column])[i]);
+        }
+    }
+}
+
+template <typename Array>
+void expectSameElements(const Array& expected, const Array& actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), actual.begin()));
+}
+
+// Rays through every pixel of the camera find exactly the same hits in both scenes
+void expectSameHits(const Scene& expected, const Scene& actual)
+{
+    for (int y = 0; y < expected.height(); ++y)
+    {
+        for (int x = 0; x < expected.width(); ++x)
+        {
+            const auto ray(expected.camera().generateRay(static_cast<float>(x) + 0.5F, static_cast<float>(y) + 0.5F));
+            IntersectionInfo expectedClosest;
+            IntersectionInfo actualClosest;
+            const auto hasHit = expected.geometry().intersect(ray, expectedClosest);
+            ASSERT_EQ(hasHit, actual.geometry().intersect(ray, actualClosest));
+            if (hasHit)
+            {
+                EXPECT_EQ(expectedClosest.getTime(), actualClosest.getTime());
+                EXPECT_EQ(expectedClosest.getPoint(), actualClosest.getPoint());
+                EXPECT_EQ(expectedClosest.getNormal(), actualClosest.getNormal());
+            }
+        }
+    }
+}
+
+BinarySceneHeader readHeader(const std::filesystem::path& compiledFile)
+{
+    BinarySceneHeader header;
+    std::ifstream file(compiledFile, std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    return header;
+}
+
+template <typename T>
+void overwrite(const std::filesystem::path& compiledFile, std::uint64_t offset, const T& value)
+{
+    std::fstream file(compiledFile, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void expectSameScene(const Scene& expected, const Scene& actual)
+{
+    EXPECT_EQ(expected.width(), actual.width());
+    EXPECT_EQ(expected.height(), actual.height());
+    EXPECT_EQ(expected.camera().cameraToWorld(), actual.camera().cameraToWorld());
+    EXPECT_FLOAT_EQ(expected.camera().verticalFieldOfView(), actual.camera().verticalFieldOfView());
+
+    const auto& expectedGeometry = expected.geometry();
+    const auto& actualGeometry = actual.geometry();
+    expectSameColumns(expectedGeometry.spheres(), actualGeometry.spheres());
+    expectSameColumns(expectedGeometry.planes(), actualGeometry.planes());
+    expectSameColumns(expectedGeometry.boxes(), actualGeometry.boxes());
+    expectSameColumns(expectedGeometry.triangles(), actualGeometry.triangles());
+    expectSameElements(expectedGeometry.meshes().vertices(), actualGeometry.meshes().vertices());
+    expectSameElements(expectedGeometry.meshes().quantizedVertices(), actualGeometry.meshes().quantizedVertices());
+    expectSameElements(expectedGeometry.meshes().indices(), actualGeometry.meshes().indices());
+    EXPECT_EQ(expectedGeometry.bounds(), actualGeometry.bounds());
+
+    expectSameHits(expected, actual);
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST_F(SceneFactoryTestsFixture, ChunkedJsonLoadsTheSameSceneAsAWholeFile)
+{
+    // GIVEN:
+    const auto whole(SceneFactoryJson().buildScene(m_jsonFile.string()));
+
+    // WHEN:
+    const auto chunked(SceneFactoryJson(4096).buildScene(m_jsonFile.string()));
+
+    // THEN:
+    ASSERT_NE(nullptr, whole);
+    ASSERT_NE(nullptr, chunked);
+    EXPECT_EQ(500U, whole->geometry().spheres().size());
+    EXPECT_EQ(1000U, whole->geometry().meshes().size());
+    expectSameScene(*whole, *chunked);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SceneFactoryTestsFixture, ChunkedJsonQuantizesMeshesLikeAWholeFile)
+{
+    // GIVEN:
+    writeScene(m_jsonFile, "quantized16");
+    const auto whole(SceneFactoryJson().buildScene(m_jsonFile.string()));
+
+    // WHEN:
+    const auto chunked(SceneFactoryJson(4096).buildScene(m_jsonFile.string()));
+
+    // THEN:
+    ASSERT_NE(nullptr, whole);
+    ASSERT_NE(nullptr, chunked);
+    EXPECT_EQ(MeshVertexFormat::Quantized16, chunked->geometry().meshes().vertexFormat());
+    expectSameScene(*whole, *chunked);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SceneFactoryTestsFixture, ChunkedJsonNamesTheObjectThatIsInvalid)
+{
+    // GIVEN: a sphere without a radius deep inside a file split into many chunks
+    {
+        std::ofstream file(m_jsonFile);
+        file << R"({"resolution":{"width":4,"height":4},"objects":[)";
+        for (int i = 0; i < 2000; ++i)
+        {
+            file << (i == 0 ? "" : ",") << R"({"type":"sphere","center":[)" << i << ",0,0]"
+                 << (i == 1234 ? "}" : R"(,"radius":0.5})");
+        }
+
+        file << "]}";
+    }
+
+    // WHEN:
+    ::testing::internal::CaptureStderr();
+    const auto whole(SceneFactoryJson().buildScene(m_jsonFile.string()));
+    const auto wholeError(::testing::internal::GetCapturedStderr());
+    ::testing::internal::CaptureStderr();
+    const auto chunked(SceneFactoryJson(1024).buildScene(m_jsonFile.string()));
+    const auto chunkedError(::testing::internal::GetCapturedStderr());
+
+    // THEN:
+    EXPECT_EQ(nullptr, whole);
+    EXPECT_EQ(nullptr, chunked);
+    EXPECT_NE(std::string::npos, wholeError.find("objects[1234] is not a valid sphere")) << wholeError;
+    EXPECT_NE(std::string::npos, chunkedError.find("objects[1234] is not a valid sphere")) << chunkedError;
+}
+
+// NOLINTNEXTLINE
+TEST_F(SceneFactoryTestsFixture, CompiledSceneLoadsTheSameSceneAsItsJson)
+{
+    // GIVEN:
+    const auto json(SceneFactoryJson().buildScene(m_jsonFile.string()));
+    ASSERT_NE(nullptr, json);
+    const auto compiledFile(compileScene());
+
+    // WHEN:
+    const auto compiled(SceneFactoryBinary().buildScene(compiledFile.string()));
+
+    // THEN:
+    ASSERT_NE(nullptr, compiled);
+    expectSameScene(*json, *compiled);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SceneFactoryTestsFixture, CompiledScenesWithCorruptHeadersAreRejected)
+{
+    // GIVEN:
+    const auto compiledFile(compileScene());
+    const auto header(readHeader(compiledFile));
+
+    // WHEN:
+    auto magic(header.magic);
+    magic[0] = 'X';
+    overwrite(compiledFile, offsetof(BinarySceneHeader, magic), magic);
+    const auto badMagic(SceneFactoryBinary().buildScene(compiledFile.string()));
+    overwrite(compiledFile, offsetof(BinarySceneHeader, magic), header.magic);
+    overwrite(compiledFile, offsetof(BinarySceneHeader, version), binarySceneVersion + 1);
+    const auto badVersion(SceneFactoryBinary().buildScene(compiledFile.string()));
+
+    // THEN:
+    EXPECT_EQ(nullptr, badMagic);
+    EXPECT_EQ(nullptr, badVersion);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SceneFactoryTestsFixture, TruncatedCompiledScenesAreRejected)
+{
+    // GIVEN:
+    const auto compiledFile(compileScene());
+    const auto meshTriangles(
+        readHeader(compiledFile).sections.at(static_cast<size_t>(BinarySceneSection::MeshTriangles)));
+
+    // WHEN:
+    std::filesystem::resize_file(compiledFile, meshTriangles.offset + 3 * sizeof(std::uint32_t));
+
+    // THEN:
+    EXPECT_EQ(nullptr, SceneFactoryBinary().buildScene(compiledFile.string()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SceneFactoryTestsFixture, CompiledScenesWithCorruptHierarchiesAreRejected)
+{
+    // GIVEN:
+    const auto compiledFile(compileScene());
+    const auto sphereNodes(readHeader(compiledFile).sections.at(static_cast<size_t>(BinarySceneSection::SphereNodes)));
+
+    // WHEN: the root points its second child past the last node
+    overwrite(
+        compiledFile,
+        sphereNodes.offset + offsetof(BvhNode, offset),
+        static_cast<std::uint32_t>(sphereNodes.count));
+
+    // THEN:
+    EXPECT_EQ(nullptr, SceneFactoryBinary().buildScene(compiledFile.string()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SceneFactoryTestsFixture, CompiledScenesWithMeshIndicesPastTheVerticesAreRejected)
+{
+    // GIVEN:
+    const auto compiledFile(compileScene());
+    const auto header(readHeader(compiledFile));
+    const auto& vertices = header.sections.at(static_cast<size_t>(BinarySceneSection::MeshVertices));
+    const auto& triangles = header.sections.at(static_cast<size_t>(BinarySceneSection::MeshTriangles));
+
+    // WHEN:
+    overwrite(compiledFile, triangles.offset, static_cast<std::uint32_t>(vertices.count));
+
+    // THEN:
+    EXPECT_EQ(nullptr, SceneFactoryBinary().buildScene(compiledFile.string()));
+}
+
+} // namespace eyebeam
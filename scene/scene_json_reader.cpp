@@ -0,0 +1,719 @@
+#include "scene_json_reader.h"
+
+#include "box_pool.h"
+#include "geometry.h"
+#include "instance_pool.h"
+#include "mapped_file.h"
+#include "mesh_pool.h"
+#include "plane_pool.h"
+#include "scene_resolution.h"
+#include "sphere_pool.h"
+#include "triangle_mesh.h"
+#include "triangle_pool.h"
+
+#include "angle.h"
+#include "animated_transform.h"
+#include "bounds3.h"
+#include "normal3.h"
+#include "point3.h"
+#include "quaternion.h"
+#include "transform.h"
+#include "vector3.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+auto toPoint(const std::array<float, 3>& p)
+{
+    return Point3(p[0], p[1], p[2]);
+}
+
+auto toVector(const std::array<float, 3>& v)
+{
+    return Vector3(v[0], v[1], v[2]);
+}
+
+} // namespace
+
+SceneJsonReader::SceneJsonReader(std::filesystem::path directory) noexcept : m_directory(std::move(directory))
+{
+}
+
+SceneJsonReader::SceneJsonReader(size_t firstObjectIndex, std::filesystem::path directory) noexcept
+    : m_depth(1)
+    , m_section(Section::Objects)
+    , m_directory(std::move(directory))
+    , m_firstObjectIndex(firstObjectIndex)
+{
+}
+
+bool SceneJsonReader::null()
+{
+    return value(FieldKind::Other, 0.0F);
+}
+
+bool SceneJsonReader::boolean([[maybe_unused]] bool value)
+{
+    return this->value(FieldKind::Other, 0.0F);
+}
+
+bool SceneJsonReader::number_integer(number_integer_t value)
+{
+    return this->value(FieldKind::Number, static_cast<float>(value));
+}
+
+bool SceneJsonReader::number_unsigned(number_unsigned_t value)
+{
+    return this->value(FieldKind::Number, static_cast<float>(value));
+}
+
+bool SceneJsonReader::number_float(number_float_t value, [[maybe_unused]] const string_t& text)
+{
+    return this->value(FieldKind::Number, static_cast<float>(value));
+}
+
+bool SceneJsonReader::string(string_t& value)
+{
+    if (m_recordDepth != 0 && m_depth == m_recordDepth)
+    {
+        auto& field = m_fields[m_fieldCount - 1];
+        field.kind = FieldKind::String;
+        field.text = std::move(value);
+        return true;
+    }
+
+    if (m_recordDepth == 0 && m_depth == 1 && m_section == Section::MeshVertexFormat)
+    {
+        return finishMeshVertexFormat(value);
+    }
+
+    return this->value(FieldKind::String, 0.0F);
+}
+
+bool SceneJsonReader::binary([[maybe_unused]] binary_t& value)
+{
+    return this->value(FieldKind::Other, 0.0F);
+}
+
+bool SceneJsonReader::start_object([[maybe_unused]] std::size_t elementCount)
+{
+    ++m_depth;
+
+    if (m_recordDepth != 0)
+    {
+        m_fields[m_fieldCount - 1].isMalformed = true;
+        return true;
+    }
+
+    if (m_depth == 2 && (m_section == Section::Objects || m_section == Section::Instances))
+    {
+        return fail(std::string(entryArrayName()) + " must be an array");
+    }
+
+    const auto isSectionRecord = m_depth == 2 && (m_section == Section::Resolution || m_section == Section::Camera);
+    const auto isEntryRecord = m_depth == 3 && m_isInEntryArray;
+    if (isSectionRecord || isEntryRecord)
+    {
+        m_recordDepth = m_depth;
+        m_fieldCount = 0;
+    }
+
+    return true;
+}
+
+bool SceneJsonReader::key(string_t& value)
+{
+    if (m_depth == 1)
+    {
+        m_section = value == "resolution"         ? Section::Resolution
+                    : value == "camera"           ? Section::Camera
+                    : value == "meshVertexFormat" ? Section::MeshVertexFormat
+                    : value == "objects"          ? Section::Objects
+                    : value == "instances"        ? Section::Instances
+                                                  : Section::Other;
+        return m_section != Section::Instances || m_allowsInstances || fail("assets cannot hold instances");
+    }
+
+    if (m_recordDepth == 0 || m_depth != m_recordDepth)
+    {
+        return true;
+    }
+
+    // Fields are reused between objects so that their buffers are allocated once
+    if (m_fieldCount == m_fields.size())
+    {
+        m_fields.emplace_back();
+    }
+
+    auto& field = m_fields[m_fieldCount++];
+    field.name = std::move(value);
+    field.kind = FieldKind::Other;
+    field.text.clear();
+    field.numbers.clear();
+    field.innerArrays = 0;
+    field.numbersBeforeInnerArray = 0;
+    field.isMalformed = false;
+    return true;
+}
+
+bool SceneJsonReader::end_object()
+{
+    if (m_recordDepth == 0 || m_depth != m_recordDepth)
+    {
+        --m_depth;
+        return true;
+    }
+
+    m_recordDepth = 0;
+    --m_depth;
+
+    switch (m_section)
+    {
+    case Section::Resolution:
+        return finishResolution();
+    case Section::Camera:
+        return finishCamera();
+    case Section::Instances:
+        return finishInstance();
+    default:
+        return finishObject();
+    }
+}
+
+bool SceneJsonReader::start_array([[maybe_unused]] std::size_t elementCount)
+{
+    ++m_depth;
+
+    if (m_recordDepth == 0)
+    {
+        if (m_isInEntryArray)
+        {
+            return fail("every entry of " + std::string(entryArrayName()) + " must be an object");
+        }
+
+        m_isInEntryArray = m_depth == 2 && (m_section == Section::Objects || m_section == Section::Instances);
+        return true;
+    }
+
+    auto& field = m_fields[m_fieldCount - 1];
+    if (m_depth == m_recordDepth + 1)
+    {
+        field.kind = FieldKind::Array;
+    }
+    else if (m_depth == m_recordDepth + 2)
+    {
+        ++field.innerArrays;
+        field.numbersBeforeInnerArray = field.numbers.size();
+    }
+    else
+    {
+        field.isMalformed = true;
+    }
+
+    return true;
+}
+
+bool SceneJsonReader::end_array()
+{
+    if (m_recordDepth != 0 && m_depth == m_recordDepth + 2)
+    {
+        auto& field = m_fields[m_fieldCount - 1];
+        field.isMalformed = field.isMalformed || field.numbers.size() - field.numbersBeforeInnerArray != 3;
+    }
+
+    if (m_recordDepth == 0 && m_depth == 2)
+    {
+        m_isInEntryArray = false;
+    }
+
+    --m_depth;
+    return true;
+}
+
+bool SceneJsonReader::parse_error(
+    [[maybe_unused]] std::size_t position,
+    [[maybe_unused]] const std::string& lastToken,
+    const nlohmann::detail::exception& e)
+{
+    return fail(m_isInEntryArray ? describeEntry() + ": " + e.what() : std::string(e.what()));
+}
+
+Geometry SceneJsonReader::buildGeometry()
+{
+    if (m_meshVertexFormat == MeshVertexFormat::Quantized16)
+    {
+        m_meshes.quantize();
+    }
+
+    return Geometry(
+        std::move(m_spheres),
+        std::move(m_planes),
+        std::move(m_boxes),
+        std::move(m_triangles),
+        std::move(m_meshes),
+        std::move(m_instances));
+}
+
+SceneJsonObjects SceneJsonReader::takeObjects()
+{
+    return SceneJsonObjects{
+        std::move(m_spheres), std::move(m_planes), std::move(m_boxes), std::move(m_triangles), std::move(m_meshes)};
+}
+
+bool SceneJsonReader::fail(std::string_view reason)
+{
+    m_error = reason;
+    return false;
+}
+
+std::string_view SceneJsonReader::entryArrayName() const noexcept
+{
+    return m_section == Section::Instances ? "instances" : "objects";
+}
+
+std::string SceneJsonReader::describeEntry() const
+{
+    const auto index = m_section == Section::Instances ? m_instanceCount : m_firstObjectIndex + m_objectCount;
+    return std::string(entryArrayName()) + "[" + std::to_string(index) + "]";
+}
+
+bool SceneJsonReader::value(FieldKind kind, float number)
+{
+    if (m_recordDepth == 0)
+    {
+        if (m_isInEntryArray || (m_depth == 1 && (m_section == Section::Objects || m_section == Section::Instances)))
+        {
+            return fail("every entry of " + std::string(entryArrayName()) + " must be an object");
+        }
+
+        return true;
+    }
+
+    auto& field = m_fields[m_fieldCount - 1];
+    if (m_depth == m_recordDepth)
+    {
+        field.kind = kind;
+        field.numbers.push_back(number);
+        return true;
+    }
+
+    field.isMalformed = field.isMalformed || kind != FieldKind::Number;
+    field.numbers.push_back(number);
+    return true;
+}
+
+const SceneJsonReader::Field* SceneJsonReader::findField(std::string_view name) const noexcept
+{
+    for (size_t i = 0; i < m_fieldCount; ++i)
+    {
+        if (m_fields[i].name == name)
+        {
+            return &m_fields[i];
+        }
+    }
+
+    return nullptr;
+}
+
+std::optional<float> SceneJsonReader::readNumber(std::string_view name) const noexcept
+{
+    const auto* field = findField(name);
+    if (field == nullptr || field->kind != FieldKind::Number)
+    {
+        return std::nullopt;
+    }
+
+    return field->numbers.front();
+}
+
+std::optional<std::array<float, 3>> SceneJsonReader::readTriple(std::string_view name) const noexcept
+{
+    const auto* field = findField(name);
+    if (field == nullptr || field->kind != FieldKind::Array || field->isMalformed || field->innerArrays != 0 ||
+        field->numbers.size() != 3)
+    {
+        return std::nullopt;
+    }
+
+    return std::array<float, 3>{field->numbers[0], field->numbers[1], field->numbers[2]};
+}
+
+const std::vector<float>* SceneJsonReader::readPointList(std::string_view name, size_t pointCount) const noexcept
+{
+    const auto* field = findField(name);
+    if (field == nullptr || field->kind != FieldKind::Array || field->isMalformed ||
+        field->innerArrays != pointCount || field->numbers.size() != 3 * pointCount)
+    {
+        return nullptr;
+    }
+
+    return &field->numbers;
+}
+
+// Vertices are listed like the vertices of a triangle, and indices is a flat array with three entries per triangle
+std::optional<TriangleMesh> SceneJsonReader::readInlineMesh() const
+{
+    const auto* vertexField = findField("vertices");
+    const auto* vertices = vertexField == nullptr ? nullptr : readPointList("vertices", vertexField->innerArrays);
+    const auto* indices = findField("indices");
+    if (vertices == nullptr || vertices->empty() || indices == nullptr || indices->kind != FieldKind::Array ||
+        indices->isMalformed || indices->innerArrays != 0 || indices->numbers.empty() ||
+        indices->numbers.size() % 3 != 0)
+    {
+        return std::nullopt;
+    }
+
+    TriangleMesh mesh;
+    for (size_t i = 0; i < vertices->size(); i += 3)
+    {
+        mesh.addVertex(Point3((*vertices)[i], (*vertices)[i + 1], (*vertices)[i + 2]));
+    }
+
+    const auto vertexCount = static_cast<float>(mesh.vertexCount());
+    for (const auto index : indices->numbers)
+    {
+        if (index < 0.0F || index >= vertexCount || index != std::floor(index))
+        {
+            return std::nullopt;
+        }
+    }
+
+    const auto& numbers = indices->numbers;
+    for (size_t i = 0; i < numbers.size(); i += 3)
+    {
+        mesh.addTriangle(
+            static_cast<std::uint32_t>(numbers[i]),
+            static_cast<std::uint32_t>(numbers[i + 1]),
+            static_cast<std::uint32_t>(numbers[i + 2]));
+    }
+
+    return mesh;
+}
+
+bool SceneJsonReader::finishResolution()
+{
+    const auto width(readNumber("width"));
+    const auto height(readNumber("height"));
+    if (width.has_value() && height.has_value())
+    {
+        m_resolution.emplace(static_cast<int>(*width), static_cast<int>(*height));
+    }
+
+    return true;
+}
+
+bool SceneJsonReader::finishCamera()
+{
+    const auto position(readTriple("position"));
+    const auto lookAt(readTriple("lookAt"));
+    const auto up(readTriple("up"));
+    if (position.has_value() && lookAt.has_value() && up.has_value())
+    {
+        m_cameraToWorld =
+            Transform::lookAt(toPoint(*position), toPoint(*lookAt), toVector(*up)).getTransformUnaligned();
+    }
+
+    if (findField("fieldOfView") != nullptr)
+    {
+        m_fieldOfView = readNumber("fieldOfView");
+        if (!m_fieldOfView.has_value() || *m_fieldOfView <= 0.0F || *m_fieldOfView >= 180.0F)
+        {
+            return fail("camera fieldOfView must be a number of degrees between 0 and 180");
+        }
+    }
+
+    return true;
+}
+
+bool SceneJsonReader::finishMeshVertexFormat(std::string_view format)
+{
+    if (format == "float")
+    {
+        m_meshVertexFormat = MeshVertexFormat::Float;
+    }
+    else if (format == "quantized16")
+    {
+        m_meshVertexFormat = MeshVertexFormat::Quantized16;
+    }
+    else
+    {
+        return fail("meshVertexFormat must be float or quantized16");
+    }
+
+    return true;
+}
+
+bool SceneJsonReader::finishObject()
+{
+    const auto* type = findField("type");
+    if (type == nullptr || type->kind != FieldKind::String)
+    {
+        return fail(describeEntry() + " has no type");
+    }
+
+    auto isValid = false;
+    if (type->text == "sphere")
+    {
+        const auto center(readTriple("center"));
+        const auto radius(readNumber("radius"));
+        isValid = center.has_value() && radius.has_value() && *radius > 0.0F;
+        if (isValid)
+        {
+            m_spheres.add(toPoint(*center), *radius);
+        }
+    }
+    else if (type->text == "plane")
+    {
+        const auto point(readTriple("point"));
+        const auto normal(readTriple("normal"));
+        isValid = point.has_value() && normal.has_value();
+        if (isValid)
+        {
+            m_planes.add(toPoint(*point), Normal3(toVector(*normal)));
+        }
+    }
+    else if (type->text == "box")
+    {
+        const auto minimum(readTriple("min"));
+        const auto maximum(readTriple("max"));
+        isValid = minimum.has_value() && maximum.has_value();
+        if (isValid)
+        {
+            m_boxes.add(Bounds3(toPoint(*minimum), toPoint(*maximum)));
+        }
+    }
+    else if (type->text == "triangle")
+    {
+        const auto* vertices = readPointList("vertices", 3);
+        isValid = vertices != nullptr;
+        if (isValid)
+        {
+            const auto& v = *vertices;
+            m_triangles.add(Point3(v[0], v[1], v[2]), Point3(v[3], v[4], v[5]), Point3(v[6], v[7], v[8]));
+        }
+    }
+    else if (type->text == "mesh")
+    {
+        const auto* file = findField("file");
+        if (file != nullptr && file->kind == FieldKind::String)
+        {
+            try
+            {
+                m_meshes.add(loadTriangleMesh(m_directory / file->text));
+            }
+            catch (const std::exception& e)
+            {
+                return fail(describeEntry() + ": " + e.what());
+            }
+
+            isValid = true;
+        }
+        else
+        {
+            const auto mesh(readInlineMesh());
+            isValid = mesh.has_value();
+            if (isValid)
+            {
+                m_meshes.add(*mesh);
+            }
+        }
+    }
+    else
+    {
+        return fail(describeEntry() + " has unknown type " + type->text);
+    }
+
+    if (!isValid)
+    {
+        return fail(describeEntry() + " is not a valid " + type->text);
+    }
+
+    ++m_objectCount;
+    return true;
+}
+
+// Instances are scaled, then rotated about x, y and z in turn, then translated. Each part is optional, and each may
+// instead list one triple per keyframe of a motion spread evenly over the shutter interval. Parts that do not move
+// give a single triple, and those that move must all list the same number of keyframes.
+std::optional<AnimatedTransform> SceneJsonReader::readInstanceTransform() const
+{
+    const auto readKeyframeTriples =
+        [this](std::string_view name, float defaultValue) -> std::optional<std::vector<std::array<float, 3>>> {
+        const auto* field = findField(name);
+        if (field == nullptr)
+        {
+            return std::vector{std::array<float, 3>{defaultValue, defaultValue, defaultValue}};
+        }
+
+        const auto* points = field->innerArrays != 0 ? readPointList(name, field->innerArrays) : nullptr;
+        if (points == nullptr)
+        {
+            const auto triple(readTriple(name));
+            return triple.has_value() ? std::optional(std::vector{*triple}) : std::nullopt;
+        }
+
+        std::vector<std::array<float, 3>> triples;
+        for (size_t i = 0; i < points->size(); i += 3)
+        {
+            triples.push_back(std::array<float, 3>{(*points)[i], (*points)[i + 1], (*points)[i + 2]});
+        }
+
+        return triples;
+    };
+
+    const auto translate(readKeyframeTriples("translate", 0.0F));
+    const auto rotate(readKeyframeTriples("rotate", 0.0F));
+    const auto uniformScale(readNumber("scale"));
+    const auto scale(
+        uniformScale.has_value()
+            ? std::optional(std::vector{std::array<float, 3>{*uniformScale, *uniformScale, *uniformScale}})
+            : readKeyframeTriples("scale", 1.0F));
+    if (!translate.has_value() || !rotate.has_value() || !scale.has_value())
+    {
+        return std::nullopt;
+    }
+
+    const auto keyframeCount = std::max({translate->size(), rotate->size(), scale->size()});
+    for (const auto* triples : {&*translate, &*rotate, &*scale})
+    {
+        if (triples->size() != 1 && triples->size() != keyframeCount)
+        {
+            return std::nullopt;
+        }
+    }
+
+    for (const auto& s : *scale)
+    {
+        if (s[0] == 0.0F || s[1] == 0.0F || s[2] == 0.0F)
+        {
+            return std::nullopt;
+        }
+    }
+
+    const auto rotation = [](float degrees) { return toRadians(Degrees(degrees)); };
+    std::vector<TransformKeyframe> keyframes;
+    for (size_t i = 0; i < keyframeCount; ++i)
+    {
+        const auto& t = (*translate)[std::min(i, translate->size() - 1)];
+        const auto& r = (*rotate)[std::min(i, rotate->size() - 1)];
+        const auto& s = (*scale)[std::min(i, scale->size() - 1)];
+        keyframes.push_back(TransformKeyframe{
+            keyframeCount == 1 ? 0.0F : static_cast<float>(i) / static_cast<float>(keyframeCount - 1),
+            toVector(t),
+            Quaternion::rotateZ(rotation(r[2]))
+                .multiply(Quaternion::rotateY(rotation(r[1])))
+                .multiply(Quaternion::rotateX(rotation(r[0]))),
+            toVector(s)});
+    }
+
+    return AnimatedTransform(std::move(keyframes));
+}
+
+// Each asset file is loaded once, when the first instance of it is read. OBJ and PLY files become a single mesh in
+// float vertices; JSON files contribute their objects, in the vertex format they ask for. Throws std::runtime_error
+// when the asset cannot be read.
+std::uint32_t SceneJsonReader::loadAsset(const std::string& name)
+{
+    const auto path((m_directory / name).lexically_normal());
+    const auto found = m_assetPrototypes.find(path.string());
+    if (found != m_assetPrototypes.end())
+    {
+        return found->second;
+    }
+
+    std::shared_ptr<const Geometry> prototype;
+    if (path.extension() == ".json")
+    {
+        const MappedFile file(path);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const std::string_view text(reinterpret_cast<const char*>(file.data()), file.size());
+
+        SceneJsonReader assetReader(path.parent_path());
+        assetReader.m_allowsInstances = false;
+        if (!nlohmann::json::sax_parse(text.begin(), text.end(), &assetReader))
+        {
+            throw std::runtime_error(path.string() + ": " + assetReader.error());
+        }
+
+        if (assetReader.planes().size() != 0)
+        {
+            throw std::runtime_error(path.string() + ": assets cannot hold planes, which are unbounded");
+        }
+
+        prototype = std::make_shared<const Geometry>(assetReader.buildGeometry());
+    }
+    else
+    {
+        MeshPool meshes;
+        meshes.add(loadTriangleMesh(path));
+        prototype = std::make_shared<const Geometry>(
+            SpherePool(), PlanePool(), BoxPool(), TrianglePool(), std::move(meshes), InstancePool());
+    }
+
+    if (prototype->bounds().isEmpty())
+    {
+        throw std::runtime_error(path.string() + " holds no objects");
+    }
+
+    const auto index = m_instances.addPrototype(std::move(prototype));
+    m_assetPrototypes.emplace(path.string(), index);
+    return index;
+}
+
+bool SceneJsonReader::finishInstance()
+{
+    const auto* asset = findField("asset");
+    if (asset == nullptr || asset->kind != FieldKind::String)
+    {
+        return fail(describeEntry() + " has no asset");
+    }
+
+    auto objectToWorld(readInstanceTransform());
+    if (!objectToWorld.has_value())
+    {
+        return fail(describeEntry() + " has an invalid transform");
+    }
+
+    try
+    {
+        const auto prototype = loadAsset(asset->text);
+        if (objectToWorld->keyframes().size() == 1)
+        {
+            m_instances.add(prototype, objectToWorld->at(0.0F));
+        }
+        else
+        {
+            m_instances.add(prototype, std::move(*objectToWorld));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        return fail(describeEntry() + ": " + e.what());
+    }
+
+    ++m_instanceCount;
+    return true;
+}
+
+} // namespace eyebeam
@@ -0,0 +1,235 @@
+#ifndef INCLUDED_SCENE_JSON_READER_H_
+#define INCLUDED_SCENE_JSON_READER_H_
+
+#include "box_pool.h"
+#include "geometry.h"
+#include "instance_pool.h"
+#include "mesh_pool.h"
+#include "plane_pool.h"
+#include "scene_resolution.h"
+#include "sphere_pool.h"
+#include "triangle_mesh.h"
+#include "triangle_pool.h"
+
+#include "animated_transform.h"
+#include "transform.h"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace eyebeam
+{
+
+// The primitives of the objects array, by type
+struct SceneJsonObjects
+{
+    SpherePool spheres;
+    PlanePool planes;
+    BoxPool boxes;
+    TrianglePool triangles;
+    MeshPool meshes;
+};
+
+// Receives a JSON scene from nlohmann's SAX parser and writes every object straight into its primitive pool, so the
+// document is never held in memory. Only the fields of the object being read are buffered. Unknown keys are skipped.
+class SceneJsonReader final : public nlohmann::json_sax<nlohmann::json>
+{
+public:
+    // Mesh and asset files are found relative to directory, which is normally the one holding the scene file
+    explicit SceneJsonReader(std::filesystem::path directory = {}) noexcept;
+
+    // Reads a chunk of the objects array split off by splitSceneJson and parsed as an array of its own. Entries are
+    // numbered from firstObjectIndex in error messages.
+    SceneJsonReader(size_t firstObjectIndex, std::filesystem::path directory) noexcept;
+
+    ~SceneJsonReader() final = default;
+
+    SceneJsonReader(const SceneJsonReader&) = delete;
+    SceneJsonReader(SceneJsonReader&&) = delete;
+
+    SceneJsonReader& operator=(const SceneJsonReader&) = delete;
+    SceneJsonReader& operator=(SceneJsonReader&&) = delete;
+
+    bool null() override;
+    bool boolean(bool value) override;
+    bool number_integer(number_integer_t value) override;
+    bool number_unsigned(number_unsigned_t value) override;
+    bool number_float(number_float_t value, const string_t& text) override;
+    bool string(string_t& value) override;
+    bool binary(binary_t& value) override;
+    bool start_object(std::size_t elementCount) override;
+    bool key(string_t& value) override;
+    bool end_object() override;
+    bool start_array(std::size_t elementCount) override;
+    bool end_array() override;
+    bool parse_error(std::size_t position, const std::string& lastToken, const nlohmann::detail::exception& e) override;
+
+    // Describes why the parse stopped early, or is empty
+    [[nodiscard]] const auto& error() const noexcept
+    {
+        return m_error;
+    }
+
+    [[nodiscard]] const auto& resolution() const noexcept
+    {
+        return m_resolution;
+    }
+
+    // The look at transform of the camera section, which maps camera space to the world
+    [[nodiscard]] const auto& cameraToWorld() const noexcept
+    {
+        return m_cameraToWorld;
+    }
+
+    // In degrees, when the camera section sets one
+    [[nodiscard]] const auto& fieldOfView() const noexcept
+    {
+        return m_fieldOfView;
+    }
+
+    // How the vertices of meshes are stored once every object is read, float unless the scene asks otherwise
+    [[nodiscard]] auto meshVertexFormat() const noexcept
+    {
+        return m_meshVertexFormat;
+    }
+
+    [[nodiscard]] auto objectCount() const noexcept
+    {
+        return m_objectCount;
+    }
+
+    [[nodiscard]] const auto& spheres() const noexcept
+    {
+        return m_spheres;
+    }
+
+    [[nodiscard]] const auto& planes() const noexcept
+    {
+        return m_planes;
+    }
+
+    [[nodiscard]] const auto& boxes() const noexcept
+    {
+        return m_boxes;
+    }
+
+    [[nodiscard]] const auto& triangles() const noexcept
+    {
+        return m_triangles;
+    }
+
+    // Always with float vertices, so that chunks can be appended to each other
+    [[nodiscard]] const auto& meshes() const noexcept
+    {
+        return m_meshes;
+    }
+
+    // The instances section, with one prototype per asset file however many instances place it
+    [[nodiscard]] const auto& instances() const noexcept
+    {
+        return m_instances;
+    }
+
+    // Builds the hierarchies over everything read, leaving the reader without objects. Meshes are quantized first when
+    // the scene asks for it.
+    [[nodiscard]] Geometry buildGeometry();
+
+    // Hands over the primitives of the objects read, leaving the reader without objects, so that the chunks of a
+    // large scene can be gathered into one geometry
+    [[nodiscard]] SceneJsonObjects takeObjects();
+
+private:
+    enum class Section : std::uint8_t
+    {
+        Other,
+        Resolution,
+        Camera,
+        MeshVertexFormat,
+        Objects,
+        Instances
+    };
+
+    enum class FieldKind : std::uint8_t
+    {
+        Number,
+        String,
+        Array,
+        Other
+    };
+
+    // One key of the object being read. Arrays of numbers are flattened into numbers; arrays of arrays, which are
+    // lists of points, must hold three numbers in each inner array.
+    struct Field
+    {
+        std::string name;
+        FieldKind kind = FieldKind::Other;
+        std::string text;
+        std::vector<float> numbers;
+        size_t innerArrays = 0;
+        size_t numbersBeforeInnerArray = 0;
+        bool isMalformed = false;
+    };
+
+    [[nodiscard]] bool fail(std::string_view reason);
+    [[nodiscard]] std::string_view entryArrayName() const noexcept;
+    [[nodiscard]] std::string describeEntry() const;
+    [[nodiscard]] bool value(FieldKind kind, float number);
+
+    [[nodiscard]] const Field* findField(std::string_view name) const noexcept;
+    [[nodiscard]] std::optional<float> readNumber(std::string_view name) const noexcept;
+    [[nodiscard]] std::optional<std::array<float, 3>> readTriple(std::string_view name) const noexcept;
+    [[nodiscard]] const std::vector<float>* readPointList(std::string_view name, size_t pointCount) const noexcept;
+    [[nodiscard]] std::optional<TriangleMesh> readInlineMesh() const;
+    [[nodiscard]] std::optional<AnimatedTransform> readInstanceTransform() const;
+    [[nodiscard]] std::uint32_t loadAsset(const std::string& name);
+
+    [[nodiscard]] bool finishResolution();
+    [[nodiscard]] bool finishCamera();
+    [[nodiscard]] bool finishMeshVertexFormat(std::string_view format);
+    [[nodiscard]] bool finishObject();
+    [[nodiscard]] bool finishInstance();
+
+    size_t m_depth = 0;
+    Section m_section = Section::Other;
+    // Whether the entries of the objects or instances array are being read
+    bool m_isInEntryArray = false;
+    // Assets are read with instances disallowed, so that an asset can never place itself
+    bool m_allowsInstances = true;
+
+    // Depth of the object whose fields are being collected, or zero outside of one
+    size_t m_recordDepth = 0;
+    std::vector<Field> m_fields;
+    size_t m_fieldCount = 0;
+
+    std::string m_error;
+    std::optional<SceneResolution> m_resolution;
+    std::optional<UnalignedTransformStorage> m_cameraToWorld;
+    std::optional<float> m_fieldOfView;
+    MeshVertexFormat m_meshVertexFormat = MeshVertexFormat::Float;
+    std::filesystem::path m_directory;
+    size_t m_firstObjectIndex = 0;
+    size_t m_objectCount = 0;
+    size_t m_instanceCount = 0;
+
+    SpherePool m_spheres;
+    PlanePool m_planes;
+    BoxPool m_boxes;
+    TrianglePool m_triangles;
+    MeshPool m_meshes;
+    InstancePool m_instances;
+    // Prototype of each asset file loaded so far, by its path
+    std::unordered_map<std::string, std::uint32_t> m_assetPrototypes;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_SCENE_JSON_READER_H_
@@ -0,0 +1,277 @@
+#include "scene_json_reader.h"
+
+#include <nlohmann/json.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// The error of parsing a scene that must be rejected, or an empty string when it was accepted
+std::string readError(std::string_view json, SceneJsonReader& reader)
+{
+    const auto isRead = nlohmann::json::sax_parse(json.begin(), json.end(), &reader);
+    EXPECT_EQ(isRead, reader.error().empty());
+    return reader.error();
+}
+
+std::string readError(std::string_view json)
+{
+    SceneJsonReader reader;
+    return readError(json, reader);
+}
+
+std::string withObjects(std::string_view objects)
+{
+    return R"({"resolution":{"width":4,"height":4},"objects":[)" + std::string(objects) + "]}";
+}
+
+std::string withInstances(std::string_view instances)
+{
+    return R"({"resolution":{"width":4,"height":4},"instances":[)" + std::string(instances) + "]}";
+}
+
+// Asset files in a directory of their own, which instances are read relative to
+class SceneJsonReaderInstanceTestsFixture : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::filesystem::create_directories(m_directory);
+        writeAsset("tree.obj", "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+        writeAsset("rock.json", R"({"objects":[{"type":"sphere","center":[0,0,0],"radius":1}]})");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    void writeAsset(const std::string& name, std::string_view text) const
+    {
+        std::ofstream(m_directory / name) << text;
+    }
+
+    [[nodiscard]] std::string readError(std::string_view json, SceneJsonReader& reader) const
+    {
+        return eyebeam::readError(json, reader);
+    }
+
+    [[nodiscard]] std::string readError(std::string_view json) const
+    {
+        SceneJsonReader reader(m_directory);
+        return readError(json, reader);
+    }
+
+    std::filesystem::path m_directory{
+        std::filesystem::temp_directory_path() /
+        ("eyebeam_scene_json_reader_test_" +
+         std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()))};
+};
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(SceneJsonReaderTests, ValidObjectsAreRead)
+{
+    // GIVEN:
+    SceneJsonReader reader;
+    const auto json(withObjects(
+        R"({"type":"sphere","center":[0,0,0],"radius":1,"name":"ignored"},)"
+        R"({"type":"triangle","vertices":[[0,0,0],[1,0,0],[0,1,0]]})"));
+
+    // WHEN:
+    const auto error(readError(json, reader));
+
+    // THEN:
+    EXPECT_EQ("", error);
+    EXPECT_EQ(2U, reader.objectCount());
+    EXPECT_EQ(1U, reader.spheres().size());
+    EXPECT_EQ(1U, reader.triangles().size());
+}
+
+// NOLINTNEXTLINE
+TEST(SceneJsonReaderTests, ObjectsWithoutAKnownTypeAreRejected)
+{
+    // GIVEN:
+    const std::string sphere(R"({"type":"sphere","center":[0,0,0],"radius":1},)");
+
+    // WHEN/THEN:
+    EXPECT_EQ("objects[1] has no type", readError(withObjects(sphere + R"({"center":[0,0,0],"radius":1})")));
+    EXPECT_EQ("objects[1] has no type", readError(withObjects(sphere + R"({"type":3})")));
+    EXPECT_EQ("objects[1] has unknown type cone", readError(withObjects(sphere + R"({"type":"cone"})")));
+}
+
+// NOLINTNEXTLINE
+TEST(SceneJsonReaderTests, MalformedTriplesAreRejected)
+{
+    for (const auto* center : {"[0,0]", "[0,0,0,0]", R"([0,"0",0])", "[[0,0,0]]", "[0,[0],0]", "{}", "0"})
+    {
+        // GIVEN:
+        const auto sphere = R"({"type":"sphere","radius":1,"center":)" + std::string(center) + "}";
+
+        // WHEN/THEN:
+        EXPECT_EQ("objects[0] is not a valid sphere", readError(withObjects(sphere))) << center;
+    }
+
+    // WHEN/THEN: a point of a list that is not a triple
+    EXPECT_EQ(
+        "objects[0] is not a valid triangle",
+        readError(withObjects(R"({"type":"triangle","vertices":[[0,0,0],[1,0],[0,1,0]]})")));
+}
+
+// NOLINTNEXTLINE
+TEST(SceneJsonReaderTests, EntriesThatAreNotObjectsAreRejected)
+{
+    // WHEN/THEN:
+    for (const auto* entry : {"1", R"("sphere")", "null", "true", "[]"})
+    {
+        EXPECT_EQ("every entry of objects must be an object", readError(withObjects(entry))) << entry;
+    }
+
+    EXPECT_EQ("every entry of objects must be an object", readError(R"({"objects":1})"));
+    EXPECT_EQ("objects must be an array", readError(R"({"objects":{"type":"sphere"}})"));
+    EXPECT_EQ("every entry of instances must be an object", readError(R"({"instances":["tree.obj"]})"));
+    EXPECT_EQ("instances must be an array", readError(R"({"instances":{"asset":"tree.obj"}})"));
+}
+
+// NOLINTNEXTLINE
+TEST(SceneJsonReaderTests, FieldsOfViewOutsideZeroToHalfATurnAreRejected)
+{
+    const std::string camera(R"({"camera":{"position":[0,0,-5],"lookAt":[0,0,0],"up":[0,1,0],"fieldOfView":)");
+
+    for (const auto* fieldOfView : {"0", "180", "-30", "400", R"("wide")", "[50]"})
+    {
+        // GIVEN:
+        const auto json = camera + fieldOfView + "}}";
+
+        // WHEN/THEN:
+        EXPECT_EQ("camera fieldOfView must be a number of degrees between 0 and 180", readError(json)) << fieldOfView;
+    }
+
+    // GIVEN:
+    SceneJsonReader reader;
+
+    // WHEN:
+    const auto error(readError(camera + "90}}", reader));
+
+    // THEN:
+    EXPECT_EQ("", error);
+    ASSERT_TRUE(reader.fieldOfView().has_value());
+    EXPECT_EQ(90.0F, *reader.fieldOfView());
+}
+
+// NOLINTNEXTLINE
+TEST(SceneJsonReaderTests, UnknownMeshVertexFormatsAreRejected)
+{
+    // GIVEN:
+    SceneJsonReader reader;
+
+    // WHEN:
+    const auto error(readError(R"({"meshVertexFormat":"quantized16"})", reader));
+
+    // THEN:
+    EXPECT_EQ("", error);
+    EXPECT_EQ(MeshVertexFormat::Quantized16, reader.meshVertexFormat());
+    EXPECT_EQ("meshVertexFormat must be float or quantized16", readError(R"({"meshVertexFormat":"half"})"));
+}
+
+// NOLINTNEXTLINE
+TEST(SceneJsonReaderTests, ChunksNameEntriesFromTheirFirstObjectIndex)
+{
+    // GIVEN: the entries of a chunk starting at objects[1000], parsed as an array of their own
+    const std::string sphere(R"({"type":"sphere","center":[0,0,0],"radius":1})");
+    SceneJsonReader invalidReader(1000, {});
+    SceneJsonReader truncatedReader(1000, {});
+
+    // WHEN:
+    const auto invalidError(readError("[" + sphere + R"(,{"type":"sphere","radius":1}])", invalidReader));
+    const auto truncatedError(readError("[" + sphere + R"(,{"type":"sphere","radius":])", truncatedReader));
+
+    // THEN:
+    EXPECT_EQ("objects[1001] is not a valid sphere", invalidError);
+    EXPECT_EQ(0U, truncatedError.find("objects[1001]: ")) << truncatedError;
+}
+
+// NOLINTNEXTLINE
+TEST_F(SceneJsonReaderInstanceTestsFixture, InstancesOfTheSameAssetShareOnePrototype)
+{
+    // GIVEN: the same two assets reached through different spellings of their paths
+    SceneJsonReader reader(m_directory);
+    const auto json(withInstances(
+        R"({"asset":"tree.obj"},{"asset":"rock.json","translate":[2,0,0]},{"asset":"./tree.obj","scale":2},)"
+        R"({"asset":"branches/../tree.obj","rotate":[0,90,0]},{"asset":"rock.json","translate":[[0,0,0],[1,0,0]]})"));
+
+    // WHEN:
+    const auto error(readError(json, reader));
+
+    // THEN:
+    EXPECT_EQ("", error);
+    const auto& instances = reader.instances();
+    EXPECT_EQ(5U, instances.size());
+    EXPECT_EQ(2U, instances.prototypeCount());
+    EXPECT_EQ(1U, instances.movingCount());
+    EXPECT_EQ(&instances.prototype(0), &instances.prototype(2));
+    EXPECT_EQ(&instances.prototype(0), &instances.prototype(3));
+    EXPECT_EQ(&instances.prototype(1), &instances.prototype(4));
+    EXPECT_NE(&instances.prototype(0), &instances.prototype(1));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SceneJsonReaderInstanceTestsFixture, AssetsHoldingInstancesPlanesOrNothingAreRejected)
+{
+    // GIVEN:
+    writeAsset("forest.json", withInstances(R"({"asset":"tree.obj"})"));
+    writeAsset("ground.json", withObjects(R"({"type":"plane","point":[0,0,0],"normal":[0,1,0]})"));
+    writeAsset("empty.json", withObjects(""));
+    const std::string tree(R"({"asset":"tree.obj"},)");
+
+    // WHEN:
+    const auto instancesError(readError(withInstances(tree + R"({"asset":"forest.json"})")));
+    const auto planesError(readError(withInstances(tree + R"({"asset":"ground.json"})")));
+    const auto emptyError(readError(withInstances(tree + R"({"asset":"empty.json"})")));
+    const auto missingError(readError(withInstances(tree + R"({"asset":"missing.obj"})")));
+
+    // THEN:
+    EXPECT_EQ(0U, instancesError.find("instances[1]: ")) << instancesError;
+    EXPECT_NE(std::string::npos, instancesError.find("assets cannot hold instances")) << instancesError;
+    EXPECT_EQ(0U, planesError.find("instances[1]: ")) << planesError;
+    EXPECT_NE(std::string::npos, planesError.find("assets cannot hold planes")) << planesError;
+    EXPECT_EQ(0U, emptyError.find("instances[1]: ")) << emptyError;
+    EXPECT_NE(std::string::npos, emptyError.find("holds no objects")) << emptyError;
+    EXPECT_EQ(0U, missingError.find("instances[1]: ")) << missingError;
+}
+
+// NOLINTNEXTLINE
+TEST_F(SceneJsonReaderInstanceTestsFixture, InvalidTransformsAreReportedByTheirInstance)
+{
+    for (const auto* transform : {
+             R"("translate":[[0,0,0],[1,0,0]],"rotate":[[0,0,0],[0,45,0],[0,90,0]])", // Keyframe counts differ
+             R"("scale":0)",
+             R"("scale":[1,0,1])",
+             R"("scale":[[1,1,1],[1,1,0]])",
+             R"("translate":[1,2])",
+             R"("rotate":"90")",
+         })
+    {
+        // GIVEN:
+        const auto json(withInstances(
+            R"({"asset":"tree.obj"},{"asset":"tree.obj"},{"asset":"tree.obj",)" + std::string(transform) + "}"));
+
+        // WHEN/THEN:
+        EXPECT_EQ("instances[2] has an invalid transform", readError(json)) << transform;
+    }
+
+    // WHEN/THEN:
+    EXPECT_EQ("instances[1] has no asset", readError(withInstances(R"({"asset":"tree.obj"},{"scale":2})")));
+}
+
+} // namespace eyebeam
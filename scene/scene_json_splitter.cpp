@@ -0,0 +1,166 @@
+#include "scene_json_splitter.h"
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+[[nodiscard]] size_t skipWhitespace(std::string_view text, size_t position) noexcept
+{
+    while (position < text.size() &&
+           (text[position] == ' ' || text[position] == '\n' || text[position] == '\r' || text[position] == '\t'))
+    {
+        ++position;
+    }
+
+    return position;
+}
+
+// Offset of the quote closing the string that opens at quote, or text.size() when the text ends first
+[[nodiscard]] size_t findStringEnd(std::string_view text, size_t quote) noexcept
+{
+    for (auto position = quote + 1; position < text.size(); ++position)
+    {
+        if (text[position] == '\\')
+        {
+            ++position;
+        }
+        else if (text[position] == '"')
+        {
+            return position;
+        }
+    }
+
+    return text.size();
+}
+
+// Offset of the comma, or of the unmatched closing bracket or brace, that ends the JSON value starting at begin.
+// Returns text.size() when the text ends first.
+[[nodiscard]] size_t findJsonValueEnd(std::string_view text, size_t begin) noexcept
+{
+    size_t depth = 0;
+
+    for (auto position = begin; position < text.size(); ++position)
+    {
+        switch (text[position])
+        {
+        case '"':
+            position = findStringEnd(text, position);
+            break;
+        case '{':
+        case '[':
+            ++depth;
+            break;
+        case '}':
+        case ']':
+            if (depth == 0)
+            {
+                return position;
+            }
+
+            --depth;
+            break;
+        case ',':
+            if (depth == 0)
+            {
+                return position;
+            }
+
+            break;
+        default:
+            break;
+        }
+    }
+
+    return text.size();
+}
+
+[[nodiscard]] std::optional<SceneJsonLayout> splitObjects(std::string_view text, size_t objectsBegin, size_t chunkSize)
+{
+    SceneJsonLayout layout{objectsBegin, 0, 0, {}};
+
+    const auto first = skipWhitespace(text, objectsBegin);
+    if (first < text.size() && text[first] == ']')
+    {
+        layout.objectsEnd = first;
+        return layout;
+    }
+
+    auto chunkBegin = objectsBegin;
+    size_t chunkFirstObject = 0;
+
+    for (auto position = objectsBegin;;)
+    {
+        const auto end = findJsonValueEnd(text, position);
+        if (end == text.size() || (text[end] != ',' && text[end] != ']'))
+        {
+            return std::nullopt;
+        }
+
+        ++layout.objectCount;
+
+        if (text[end] == ']')
+        {
+            layout.chunks.push_back(SceneJsonChunk{chunkBegin, end, chunkFirstObject});
+            layout.objectsEnd = end;
+            return layout;
+        }
+
+        if (end + 1 - chunkBegin >= chunkSize)
+        {
+            layout.chunks.push_back(SceneJsonChunk{chunkBegin, end, chunkFirstObject});
+            chunkBegin = end + 1;
+            chunkFirstObject = layout.objectCount;
+        }
+
+        position = end + 1;
+    }
+}
+
+} // namespace
+
+std::optional<SceneJsonLayout> splitSceneJson(std::string_view text, size_t chunkSize)
+{
+    auto position = skipWhitespace(text, 0);
+    if (position == text.size() || text[position] != '{')
+    {
+        return std::nullopt;
+    }
+
+    while (true)
+    {
+        position = skipWhitespace(text, position + 1);
+        if (position == text.size() || text[position] != '"')
+        {
+            return std::nullopt;
+        }
+
+        const auto keyEnd = findStringEnd(text, position);
+        const auto key = text.substr(position + 1, keyEnd - position - 1);
+        position = skipWhitespace(text, keyEnd + 1);
+        if (position >= text.size() || text[position] != ':')
+        {
+            return std::nullopt;
+        }
+
+        position = skipWhitespace(text, position + 1);
+        if (key == "objects" && position < text.size() && text[position] == '[')
+        {
+            return splitObjects(text, position + 1, chunkSize);
+        }
+
+        position = findJsonValueEnd(text, position);
+        if (position == text.size() || text[position] != ',')
+        {
+            return std::nullopt;
+        }
+    }
+}
+
+} // namespace eyebeam
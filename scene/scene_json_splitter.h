@@ -0,0 +1,39 @@
+#ifndef INCLUDED_SCENE_JSON_SPLITTER_H_
+#define INCLUDED_SCENE_JSON_SPLITTER_H_
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace eyebeam
+{
+
+// A run of consecutive entries of the objects array, separated by commas, that can be parsed independently
+struct SceneJsonChunk
+{
+    // Offset of the first entry, which always follows a comma or the opening bracket of the array
+    size_t begin;
+    // Offset of the comma or closing bracket that follows the last entry
+    size_t end;
+    size_t firstObjectIndex;
+};
+
+struct SceneJsonLayout
+{
+    // Offset just past the opening bracket of the objects array
+    size_t objectsBegin;
+    // Offset of the closing bracket of the objects array
+    size_t objectsEnd;
+    size_t objectCount;
+    std::vector<SceneJsonChunk> chunks;
+};
+
+// Finds the top level objects array of a scene file and splits its entries into chunks of roughly chunkSize bytes.
+// Only nesting and strings are tracked, which is far quicker than parsing. Returns std::nullopt when the file has no
+// objects array or is malformed, in which case it should be parsed whole so that the parser reports the problem.
+[[nodiscard]] std::optional<SceneJsonLayout> splitSceneJson(std::string_view text, size_t chunkSize);
+
+} // namespace eyebeam
+
+#endif // INCLUDED_SCENE_JSON_SPLITTER_H_
@@ -0,0 +1,104 @@
+#include "scene_json_splitter.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// The text of every chunk, which must start right after a comma or the opening bracket of the objects array
+std::vector<std::string_view> chunkTexts(std::string_view text, const SceneJsonLayout& layout)
+{
+    std::vector<std::string_view> texts;
+    for (const auto& chunk : layout.chunks)
+    {
+        const auto opening = text[chunk.begin - 1];
+        EXPECT_TRUE(opening == ',' || (opening == '[' && chunk.begin == layout.objectsBegin));
+        texts.push_back(text.substr(chunk.begin, chunk.end - chunk.begin));
+    }
+
+    return texts;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(SceneJsonSplitterTests, ChunksHoldWholeEntriesOfRoughlyTheChunkSize)
+{
+    // GIVEN:
+    const std::string_view text(
+        R"({"resolution":{"width":4,"height":4}, "objects": [ {"a":1}, {"b":[2]}, {"c":3} ] })");
+
+    // WHEN:
+    const auto layout(splitSceneJson(text, 16));
+
+    // THEN:
+    ASSERT_TRUE(layout.has_value());
+    EXPECT_EQ(3U, layout->objectCount);
+    EXPECT_EQ('[', text[layout->objectsBegin - 1]);
+    EXPECT_EQ(']', text[layout->objectsEnd]);
+    EXPECT_EQ((std::vector<std::string_view>{R"( {"a":1}, {"b":[2]})", R"( {"c":3} )"}), chunkTexts(text, *layout));
+    EXPECT_EQ(0U, layout->chunks[0].firstObjectIndex);
+    EXPECT_EQ(2U, layout->chunks[1].firstObjectIndex);
+}
+
+// NOLINTNEXTLINE
+TEST(SceneJsonSplitterTests, StringsHoldingBracketsCommasAndQuotesDoNotEndEntries)
+{
+    // GIVEN: strings that would end an entry or the array if they were not skipped, before and inside the objects
+    const std::string_view text(
+        R"({"title":"] , [ } {", "objects\"":[1], "objects":[)"
+        R"({"name":"a,b]"},{"name":"\"],[\""},{"name":"\\"},{"name":"[{"}]})");
+
+    // WHEN:
+    const auto layout(splitSceneJson(text, 1));
+
+    // THEN:
+    ASSERT_TRUE(layout.has_value());
+    EXPECT_EQ(4U, layout->objectCount);
+    EXPECT_EQ(
+        (std::vector<std::string_view>{
+            R"({"name":"a,b]"})", R"({"name":"\"],[\""})", R"({"name":"\\"})", R"({"name":"[{"})"}),
+        chunkTexts(text, *layout));
+}
+
+// NOLINTNEXTLINE
+TEST(SceneJsonSplitterTests, EmptyObjectsArraysHaveNoChunks)
+{
+    // GIVEN:
+    const std::string_view text(R"({"objects": [ ]})");
+
+    // WHEN:
+    const auto layout(splitSceneJson(text, 16));
+
+    // THEN:
+    ASSERT_TRUE(layout.has_value());
+    EXPECT_EQ(0U, layout->objectCount);
+    EXPECT_TRUE(layout->chunks.empty());
+    EXPECT_EQ(']', text[layout->objectsEnd]);
+}
+
+// NOLINTNEXTLINE
+TEST(SceneJsonSplitterTests, FilesWithoutAnObjectsArrayAreNotSplit)
+{
+    for (const auto* text : {
+             R"({"resolution":{"width":4,"height":4},"camera":{"position":[0,0,-5]}})",
+             R"({"objects":{"type":"sphere"}})",
+             R"({"objects":[{"type":"sphere"},)",
+             R"({"title":"no closing quote,"objects":[]})",
+             R"([{"objects":[]}])",
+             "",
+         })
+    {
+        // WHEN/THEN:
+        EXPECT_FALSE(splitSceneJson(text, 16).has_value()) << text;
+    }
+}
+
+} // namespace eyebeam
@@ -0,0 +1,62 @@
+#include "sphere_pool.h"
+
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "normal3.h"
+#include "point3.h"
+#include "ray3.h"
+#include "vector3.h"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace eyebeam
+{
+
+SpherePool::SpherePool(std::array<LaneColumn, columnCount> columns) noexcept
+    : m_centerX(std::move(columns[0]))
+    , m_centerY(std::move(columns[1]))
+    , m_centerZ(std::move(columns[2]))
+    , m_radius(std::move(columns[3]))
+{
+}
+
+std::array<const LaneColumn*, SpherePool::columnCount> SpherePool::columns() const noexcept
+{
+    return {&m_centerX, &m_centerY, &m_centerZ, &m_radius};
+}
+
+void SpherePool::add(const Point3& center, float radius)
+{
+    m_centerX.push_back(center.x());
+    m_centerY.push_back(center.y());
+    m_centerZ.push_back(center.z());
+    m_radius.push_back(radius);
+}
+
+Bounds3 SpherePool::bounds(size_t index) const noexcept
+{
+    const auto radius = m_radius[index];
+    return Bounds3(
+        Point3(m_centerX[index] - radius, m_centerY[index] - radius, m_centerZ[index] - radius),
+        Point3(m_centerX[index] + radius, m_centerY[index] + radius, m_centerZ[index] + radius));
+}
+
+IntersectionInfo SpherePool::intersectionAt(size_t index, const Ray3& ray, float time) const
+{
+    const auto point(evaluate(ray, time));
+    const Vector3 outward(point.x() - m_centerX[index], point.y() - m_centerY[index], point.z() - m_centerZ[index]);
+    return IntersectionInfo(point, Normal3(outward), time);
+}
+
+void SpherePool::reorder(const BorrowableArray<std::uint32_t>& order)
+{
+    m_centerX.reorder(order);
+    m_centerY.reorder(order);
+    m_centerZ.reorder(order);
+    m_radius.reorder(order);
+}
+
+} // namespace eyebeam
@@ -0,0 +1,78 @@
+#ifndef INCLUDED_SPHERE_POOL_H_
+#define INCLUDED_SPHERE_POOL_H_
+
+#include "primitive_lanes.h"
+
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "point3.h"
+#include "quadratic_solver.h"
+#include "ray3.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace eyebeam
+{
+
+// Spheres stored as structure of arrays so that several are intersected at once
+class SpherePool
+{
+public:
+    static constexpr size_t columnCount = 4;
+
+    SpherePool() = default;
+
+    // Adopts columns in the order columns() returns them
+    explicit SpherePool(std::array<LaneColumn, columnCount> columns) noexcept;
+
+    [[nodiscard]] std::array<const LaneColumn*, columnCount> columns() const noexcept;
+
+    void add(const Point3& center, float radius);
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_radius.size();
+    }
+
+    [[nodiscard]] Bounds3 bounds(size_t index) const noexcept;
+
+    // Distances to the spheres starting at first, using the nearer root unless the ray starts inside the sphere
+    [[nodiscard]] auto hitTimes(const RayLanes& ray, size_t first) const noexcept
+    {
+        const auto toOriginX(ray.originX - m_centerX.load(first));
+        const auto toOriginY(ray.originY - m_centerY.load(first));
+        const auto toOriginZ(ray.originZ - m_centerZ.load(first));
+        const auto radius(m_radius.load(first));
+
+        // The direction is normalized, so the quadratic coefficient is one
+        const auto b(
+            PrimitiveLanes(2.0F) *
+            multiplyAdd(toOriginX, ray.directionX, multiplyAdd(toOriginY, ray.directionY, toOriginZ * ray.directionZ)));
+        const auto c(multiplyAdd(
+            toOriginX,
+            toOriginX,
+            multiplyAdd(toOriginY, toOriginY, multiplyAdd(toOriginZ, toOriginZ, -radius * radius))));
+        const auto roots(solveQuadraticLanes(PrimitiveLanes(1.0F), b, c));
+
+        const auto time(select(roots.nearRoots > PrimitiveLanes(0.0F), roots.nearRoots, roots.farRoots));
+
+        return missedToInfinity(roots.hasRoots & (time > PrimitiveLanes(0.0F)), time);
+    }
+
+    [[nodiscard]] IntersectionInfo intersectionAt(size_t index, const Ray3& ray, float time) const;
+
+    void reorder(const BorrowableArray<std::uint32_t>& order);
+
+private:
+    LaneColumn m_centerX;
+    LaneColumn m_centerY;
+    LaneColumn m_centerZ;
+    LaneColumn m_radius;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_SPHERE_POOL_H_
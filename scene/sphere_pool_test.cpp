@@ -0,0 +1,75 @@
+#include "sphere_pool.h"
+
+#include "primitive_lanes.h"
+
+#include "point3.h"
+#include "ray3.h"
+#include "traversal_ray3.h"
+#include "vector3.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+namespace eyebeam
+{
+
+// NOLINTNEXTLINE
+TEST(SpherePoolTests, RaysHitTheNearSideOfSpheresInFrontOfThem)
+{
+    // GIVEN:
+    SpherePool spheres;
+    spheres.add(Point3(0.0F, 0.0F, 5.0F), 1.0F);
+    spheres.add(Point3(0.0F, 3.0F, 5.0F), 1.0F);
+    const TraversalRay3 ray(Ray3(Point3(0.0F, 0.0F, 0.0F), Vector3(0.0F, 0.0F, 1.0F)));
+
+    // WHEN:
+    const auto hit(findClosestHit(spheres, RayLanes(ray), 0, spheres.size(), std::numeric_limits<float>::max()));
+
+    // THEN:
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(0U, hit->index);
+    EXPECT_FLOAT_EQ(4.0F, hit->time);
+}
+
+// NOLINTNEXTLINE
+TEST(SpherePoolTests, RaysStartingInsideASphereHitItsFarSide)
+{
+    // GIVEN:
+    SpherePool spheres;
+    spheres.add(Point3(1.0F, 0.0F, 0.0F), 2.0F);
+    const TraversalRay3 ray(Ray3(Point3(0.0F, 0.0F, 0.0F), Vector3(1.0F, 0.0F, 0.0F)));
+
+    // WHEN:
+    const auto hit(findClosestHit(spheres, RayLanes(ray), 0, spheres.size(), std::numeric_limits<float>::max()));
+
+    // THEN:
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_FLOAT_EQ(3.0F, hit->time);
+}
+
+// NOLINTNEXTLINE
+TEST(SpherePoolTests, NearHitsOnLargeSpheresKeepTheirPrecision)
+{
+    // GIVEN: a ray leaving a point just off the surface of a sphere far larger than the distance to it
+    constexpr auto radius = 1000.0F;
+    const Point3 center(0.0F, 0.0F, 1000.3F);
+    SpherePool spheres;
+    spheres.add(center, radius);
+    const Ray3 ray(Point3(0.0F, 0.0F, 0.0F), Vector3(0.005F, -0.003F, 1.0F));
+
+    // WHEN:
+    const auto hit(findClosestHit(
+        spheres, RayLanes(TraversalRay3(ray)), 0, spheres.size(), std::numeric_limits<float>::max()));
+
+    // THEN:
+    const auto toOriginZ = -static_cast<double>(center.z());
+    const auto b = toOriginZ * static_cast<double>(ray.direction().z());
+    const auto c = toOriginZ * toOriginZ - static_cast<double>(radius) * static_cast<double>(radius);
+    const auto expected = c / (-b + std::sqrt(b * b - c));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NEAR(expected, hit->time, expected * 1e-5);
+}
+
+} // namespace eyebeam
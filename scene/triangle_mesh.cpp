@@ -0,0 +1,487 @@
+#include "triangle_mesh.h"
+
+#include "point3.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+[[noreturn]] void throwMalformed(std::string_view format, size_t lineNumber, std::string_view reason)
+{
+    throw std::runtime_error(
+        std::string(format) + " line " + std::to_string(lineNumber) + ": " + std::string(reason));
+}
+
+// Removes and returns the first whitespace separated token of text, or an empty view when none is left
+std::string_view nextToken(std::string_view& text) noexcept
+{
+    constexpr std::string_view whitespace(" \t\r");
+    const auto begin = text.find_first_not_of(whitespace);
+    if (begin == std::string_view::npos)
+    {
+        text = {};
+        return {};
+    }
+
+    const auto end = std::min(text.find_first_of(whitespace, begin), text.size());
+    const auto token = text.substr(begin, end - begin);
+    text.remove_prefix(end);
+    return token;
+}
+
+template <typename T>
+bool parseNumber(std::string_view token, T& value) noexcept
+{
+    const auto* last = token.data() + token.size(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto result = std::from_chars(token.data(), last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+// Splits the polygon into triangles that share its first vertex
+void addFan(TriangleMesh& mesh, const std::vector<std::uint32_t>& polygon)
+{
+    for (size_t i = 2; i < polygon.size(); ++i)
+    {
+        mesh.addTriangle(polygon[0], polygon[i - 1], polygon[i]);
+    }
+}
+
+enum class PlyFormat : std::uint8_t
+{
+    Ascii,
+    BinaryLittleEndian,
+    BinaryBigEndian
+};
+
+enum class PlyType : std::uint8_t
+{
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+struct PlyProperty
+{
+    std::string name;
+    PlyType type = PlyType::Float32;
+    bool isList = false;
+    PlyType countType = PlyType::UInt8;
+};
+
+struct PlyElement
+{
+    std::string name;
+    size_t count = 0;
+    std::vector<PlyProperty> properties;
+};
+
+struct PlyHeader
+{
+    PlyFormat format = PlyFormat::Ascii;
+    std::vector<PlyElement> elements;
+};
+
+PlyType parsePlyType(std::string_view name, size_t lineNumber)
+{
+    constexpr std::array<std::pair<std::string_view, PlyType>, 16> types = {{
+        {"char", PlyType::Int8},
+        {"int8", PlyType::Int8},
+        {"uchar", PlyType::UInt8},
+        {"uint8", PlyType::UInt8},
+        {"short", PlyType::Int16},
+        {"int16", PlyType::Int16},
+        {"ushort", PlyType::UInt16},
+        {"uint16", PlyType::UInt16},
+        {"int", PlyType::Int32},
+        {"int32", PlyType::Int32},
+        {"uint", PlyType::UInt32},
+        {"uint32", PlyType::UInt32},
+        {"float", PlyType::Float32},
+        {"float32", PlyType::Float32},
+        {"double", PlyType::Float64},
+        {"float64", PlyType::Float64},
+    }};
+
+    for (const auto& [typeName, type] : types)
+    {
+        if (typeName == name)
+        {
+            return type;
+        }
+    }
+
+    throwMalformed("PLY", lineNumber, "unknown property type " + std::string(name));
+}
+
+PlyHeader readPlyHeader(std::istream& is)
+{
+    std::string line;
+    if (!std::getline(is, line) || line.substr(0, line.find_last_not_of('\r') + 1) != "ply")
+    {
+        throwMalformed("PLY", 1, "not a PLY file");
+    }
+
+    PlyHeader header;
+    auto hasFormat = false;
+    for (size_t lineNumber = 2; std::getline(is, line); ++lineNumber)
+    {
+        std::string_view rest(line);
+        const auto keyword(nextToken(rest));
+        if (keyword == "end_header")
+        {
+            if (!hasFormat)
+            {
+                throwMalformed("PLY", lineNumber, "no format line");
+            }
+
+            return header;
+        }
+
+        if (keyword == "format")
+        {
+            const auto format(nextToken(rest));
+            if (format == "ascii")
+            {
+                header.format = PlyFormat::Ascii;
+            }
+            else if (format == "binary_little_endian")
+            {
+                header.format = PlyFormat::BinaryLittleEndian;
+            }
+            else if (format == "binary_big_endian")
+            {
+                header.format = PlyFormat::BinaryBigEndian;
+            }
+            else
+            {
+                throwMalformed("PLY", lineNumber, "unknown format");
+            }
+
+            hasFormat = true;
+        }
+        else if (keyword == "element")
+        {
+            PlyElement element;
+            element.name = nextToken(rest);
+            if (!parseNumber(nextToken(rest), element.count))
+            {
+                throwMalformed("PLY", lineNumber, "element without a count");
+            }
+
+            header.elements.push_back(std::move(element));
+        }
+        else if (keyword == "property")
+        {
+            if (header.elements.empty())
+            {
+                throwMalformed("PLY", lineNumber, "property before any element");
+            }
+
+            PlyProperty property;
+            const auto type(nextToken(rest));
+            if (type == "list")
+            {
+                property.isList = true;
+                property.countType = parsePlyType(nextToken(rest), lineNumber);
+                property.type = parsePlyType(nextToken(rest), lineNumber);
+            }
+            else
+            {
+                property.type = parsePlyType(type, lineNumber);
+            }
+
+            property.name = nextToken(rest);
+            header.elements.back().properties.push_back(std::move(property));
+        }
+        else if (keyword != "comment" && keyword != "obj_info" && !keyword.empty())
+        {
+            throwMalformed("PLY", lineNumber, "unknown header line");
+        }
+    }
+
+    throw std::runtime_error("PLY file ends inside its header");
+}
+
+bool isLittleEndianHost() noexcept
+{
+    const std::uint16_t probe = 1;
+    std::uint8_t firstByte = 0;
+    std::memcpy(&firstByte, &probe, 1);
+    return firstByte == 1;
+}
+
+// Reads the values of the body one at a time, in whichever format the header gave
+class PlyValueReader
+{
+public:
+    PlyValueReader(std::istream& is, PlyFormat format)
+        : m_is(is)
+        , m_format(format)
+        , m_swapBytes(format != PlyFormat::Ascii && (format == PlyFormat::BinaryLittleEndian) != isLittleEndianHost())
+    {
+    }
+
+    double read(PlyType type)
+    {
+        if (m_format == PlyFormat::Ascii)
+        {
+            auto value = 0.0;
+            if (!(m_is >> value))
+            {
+                throw std::runtime_error("PLY file ends early or holds a value that is not a number");
+            }
+
+            return value;
+        }
+
+        switch (type)
+        {
+        case PlyType::Int8:
+            return readBinary<std::int8_t>();
+        case PlyType::UInt8:
+            return readBinary<std::uint8_t>();
+        case PlyType::Int16:
+            return readBinary<std::int16_t>();
+        case PlyType::UInt16:
+            return readBinary<std::uint16_t>();
+        case PlyType::Int32:
+            return readBinary<std::int32_t>();
+        case PlyType::UInt32:
+            return readBinary<std::uint32_t>();
+        case PlyType::Float32:
+            return readBinary<float>();
+        default:
+            return readBinary<double>();
+        }
+    }
+
+private:
+    template <typename T>
+    double readBinary()
+    {
+        std::array<char, sizeof(T)> bytes{};
+        if (!m_is.read(bytes.data(), bytes.size()))
+        {
+            throw std::runtime_error("PLY file ends early");
+        }
+
+        if (m_swapBytes)
+        {
+            std::reverse(bytes.begin(), bytes.end());
+        }
+
+        T value;
+        std::memcpy(&value, bytes.data(), sizeof(T));
+        return static_cast<double>(value);
+    }
+
+    std::istream& m_is;
+    PlyFormat m_format;
+    bool m_swapBytes;
+};
+
+std::uint32_t toVertexIndex(double value)
+{
+    if (!(value >= 0.0) || value > std::numeric_limits<std::uint32_t>::max() ||
+        value != static_cast<double>(static_cast<std::uint32_t>(value)))
+    {
+        throw std::runtime_error("PLY face refers to an invalid vertex index");
+    }
+
+    return static_cast<std::uint32_t>(value);
+}
+
+} // namespace
+
+void TriangleMesh::addVertex(const Point3& vertex)
+{
+    m_vertices.insert(m_vertices.end(), {vertex.x(), vertex.y(), vertex.z()});
+}
+
+void TriangleMesh::addTriangle(std::uint32_t index0, std::uint32_t index1, std::uint32_t index2)
+{
+    if (index0 >= vertexCount() || index1 >= vertexCount() || index2 >= vertexCount())
+    {
+        throw std::out_of_range("Triangle refers to a vertex that does not exist");
+    }
+
+    m_indices.insert(m_indices.end(), {index0, index1, index2});
+}
+
+TriangleMesh readObjMesh(std::istream& is)
+{
+    TriangleMesh mesh;
+    std::string line;
+    std::vector<std::uint32_t> polygon;
+
+    for (size_t lineNumber = 1; std::getline(is, line); ++lineNumber)
+    {
+        std::string_view rest(line);
+        const auto keyword(nextToken(rest));
+        if (keyword == "v")
+        {
+            std::array<float, 3> position{};
+            for (auto& coordinate : position)
+            {
+                if (!parseNumber(nextToken(rest), coordinate))
+                {
+                    throwMalformed("OBJ", lineNumber, "vertex without three coordinates");
+                }
+            }
+
+            mesh.addVertex(Point3(position[0], position[1], position[2]));
+        }
+        else if (keyword == "f")
+        {
+            polygon.clear();
+            for (auto token(nextToken(rest)); !token.empty(); token = nextToken(rest))
+            {
+                // Corners are written v, v/vt, v//vn or v/vt/vn, and negative indices count back from the last vertex
+                long long index = 0;
+                if (!parseNumber(token.substr(0, token.find('/')), index) || index == 0)
+                {
+                    throwMalformed("OBJ", lineNumber, "face with an invalid vertex index");
+                }
+
+                const auto vertexCount = static_cast<long long>(mesh.vertexCount());
+                const auto resolved = index > 0 ? index - 1 : vertexCount + index;
+                if (resolved < 0 || resolved >= vertexCount)
+                {
+                    throwMalformed("OBJ", lineNumber, "face refers to a vertex that has not been read");
+                }
+
+                polygon.push_back(static_cast<std::uint32_t>(resolved));
+            }
+
+            if (polygon.size() < 3)
+            {
+                throwMalformed("OBJ", lineNumber, "face with fewer than three vertices");
+            }
+
+            addFan(mesh, polygon);
+        }
+    }
+
+    if (is.bad())
+    {
+        throw std::runtime_error("Could not read the OBJ file");
+    }
+
+    return mesh;
+}
+
+// Faces are gathered until every element is read, since nothing requires the vertices to come first
+TriangleMesh readPlyMesh(std::istream& is)
+{
+    const auto header(readPlyHeader(is));
+    PlyValueReader reader(is, header.format);
+
+    TriangleMesh mesh;
+    std::vector<std::uint32_t> faceIndices;
+    std::vector<std::uint32_t> polygon;
+
+    for (const auto& element : header.elements)
+    {
+        const auto isVertex = element.name == "vertex";
+        const auto isFace = element.name == "face";
+
+        for (size_t i = 0; i < element.count; ++i)
+        {
+            std::array<double, 3> position{};
+            for (const auto& property : element.properties)
+            {
+                if (!property.isList)
+                {
+                    const auto value = reader.read(property.type);
+                    if (isVertex && property.name.size() == 1 && property.name[0] >= 'x' && property.name[0] <= 'z')
+                    {
+                        position.at(static_cast<size_t>(property.name[0] - 'x')) = value;
+                    }
+
+                    continue;
+                }
+
+                const auto count = toVertexIndex(reader.read(property.countType));
+                const auto isPolygon = isFace && (property.name == "vertex_indices" || property.name == "vertex_index");
+                polygon.clear();
+                for (std::uint32_t j = 0; j < count; ++j)
+                {
+                    const auto value = reader.read(property.type);
+                    if (isPolygon)
+                    {
+                        polygon.push_back(toVertexIndex(value));
+                    }
+                }
+
+                for (size_t j = 2; isPolygon && j < polygon.size(); ++j)
+                {
+                    faceIndices.insert(faceIndices.end(), {polygon[0], polygon[j - 1], polygon[j]});
+                }
+            }
+
+            if (isVertex)
+            {
+                mesh.addVertex(Point3(
+                    static_cast<float>(position[0]),
+                    static_cast<float>(position[1]),
+                    static_cast<float>(position[2])));
+            }
+        }
+    }
+
+    for (size_t i = 0; i < faceIndices.size(); i += 3)
+    {
+        if (faceIndices[i] >= mesh.vertexCount() || faceIndices[i + 1] >= mesh.vertexCount() ||
+            faceIndices[i + 2] >= mesh.vertexCount())
+        {
+            throw std::runtime_error("PLY face refers to a vertex that does not exist");
+        }
+
+        mesh.addTriangle(faceIndices[i], faceIndices[i + 1], faceIndices[i + 2]);
+    }
+
+    return mesh;
+}
+
+TriangleMesh loadTriangleMesh(const std::filesystem::path& path)
+{
+    const auto extension(path.extension().string());
+    if (extension != ".obj" && extension != ".ply")
+    {
+        throw std::runtime_error("Mesh files must end in .obj or .ply: " + path.string());
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Could not open mesh file " + path.string());
+    }
+
+    return extension == ".obj" ? readObjMesh(file) : readPlyMesh(file);
+}
+
+} // namespace eyebeam
@@ -0,0 +1,67 @@
+#ifndef INCLUDED_TRIANGLE_MESH_H_
+#define INCLUDED_TRIANGLE_MESH_H_
+
+#include "point3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <vector>
+
+namespace eyebeam
+{
+
+// Triangles that share their vertices, each stored as the indices of its three vertices. Neighbouring triangles refer
+// to the same vertices rather than holding copies of them, which takes about a third of the memory of independent
+// triangles for a typical closed mesh.
+class TriangleMesh
+{
+public:
+    void addVertex(const Point3& vertex);
+
+    // Throws std::out_of_range when an index does not refer to a vertex added so far
+    void addTriangle(std::uint32_t index0, std::uint32_t index1, std::uint32_t index2);
+
+    [[nodiscard]] auto vertexCount() const noexcept
+    {
+        return m_vertices.size() / 3;
+    }
+
+    [[nodiscard]] auto triangleCount() const noexcept
+    {
+        return m_indices.size() / 3;
+    }
+
+    // x, y and z of each vertex in turn
+    [[nodiscard]] const auto& vertices() const noexcept
+    {
+        return m_vertices;
+    }
+
+    // The three vertex indices of each triangle in turn
+    [[nodiscard]] const auto& indices() const noexcept
+    {
+        return m_indices;
+    }
+
+private:
+    std::vector<float> m_vertices;
+    std::vector<std::uint32_t> m_indices;
+};
+
+// Reads the vertices and faces of a Wavefront OBJ file, splitting polygons into fans of triangles. Texture
+// coordinates, normals, groups and materials are skipped. Throws std::runtime_error when the file is malformed.
+[[nodiscard]] TriangleMesh readObjMesh(std::istream& is);
+
+// Reads the vertex positions and faces of an ASCII or binary PLY file, splitting polygons into fans of triangles.
+// Other elements and properties are skipped. Throws std::runtime_error when the file is malformed.
+[[nodiscard]] TriangleMesh readPlyMesh(std::istream& is);
+
+// Chooses the reader by the extension of the file, .obj or .ply. Throws std::runtime_error when the file cannot be
+// opened or read.
+[[nodiscard]] TriangleMesh loadTriangleMesh(const std::filesystem::path& path);
+
+} // namespace eyebeam
+
+#endif // INCLUDED_TRIANGLE_MESH_H_
@@ -0,0 +1,321 @@
+#include "triangle_mesh.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace eyebeam
+{
+
+namespace
+{
+
+// A unit square in the xy plane, as four vertices
+const std::vector<float> squareVertices = {0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 1.0F, 1.0F, 0.0F, 0.0F, 1.0F, 0.0F};
+
+TriangleMesh readObj(const std::string& text)
+{
+    std::istringstream is(text);
+    return readObjMesh(is);
+}
+
+TriangleMesh readPly(const std::string& text)
+{
+    std::istringstream is(text, std::ios::in | std::ios::binary);
+    return readPlyMesh(is);
+}
+
+enum class ByteOrder : std::uint8_t
+{
+    LittleEndian,
+    BigEndian
+};
+
+bool isLittleEndianHost() noexcept
+{
+    const std::uint16_t probe = 1;
+    std::uint8_t firstByte = 0;
+    std::memcpy(&firstByte, &probe, 1);
+    return firstByte == 1;
+}
+
+template <typename T>
+void appendBinary(std::string& body, T value, ByteOrder order)
+{
+    std::array<char, sizeof(T)> bytes{};
+    std::memcpy(bytes.data(), &value, sizeof(T));
+    if ((order == ByteOrder::LittleEndian) != isLittleEndianHost())
+    {
+        std::reverse(bytes.begin(), bytes.end());
+    }
+
+    body.append(bytes.data(), bytes.size());
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(TriangleMeshTests, ObjCornersMayCarryTextureCoordinatesAndNormals)
+{
+    // GIVEN:
+    const std::string obj = "# square\n"
+                            "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                            "vt 0 0\nvt 1 1\nvn 0 0 1\n"
+                            "g square\nusemtl white\n"
+                            "f 1/1/1 2/2/1 3/2/1\n"
+                            "f 1//1 3//1 4//1\n"
+                            "f 1/1 2/2 4/1\n";
+
+    // WHEN:
+    const auto mesh(readObj(obj));
+
+    // THEN:
+    EXPECT_EQ(squareVertices, mesh.vertices());
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 0, 2, 3, 0, 1, 3}), mesh.indices());
+}
+
+// NOLINTNEXTLINE
+TEST(TriangleMeshTests, ObjNegativeIndicesCountBackFromTheLastVertexRead)
+{
+    // GIVEN:
+    const std::string obj = "v 0 0 0\nv 1 0 0\nv 1 1 0\n"
+                            "f -3 -2 -1\n"
+                            "v 0 1 0\n"
+                            "f -4/-1 -2/-1 -1/-1\n";
+
+    // WHEN:
+    const auto mesh(readObj(obj));
+
+    // THEN:
+    EXPECT_EQ(squareVertices, mesh.vertices());
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 0, 2, 3}), mesh.indices());
+}
+
+// NOLINTNEXTLINE
+TEST(TriangleMeshTests, ObjPolygonsAreSplitIntoFansAroundTheirFirstCorner)
+{
+    // GIVEN:
+    const std::string obj = "v 0 0 0\nv 1 0 0\nv 2 1 0\nv 1 2 0\nv 0 1 0\n"
+                            "f 1 2 3 4 5\n";
+
+    // WHEN:
+    const auto mesh(readObj(obj));
+
+    // THEN:
+    EXPECT_EQ(5U, mesh.vertexCount());
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 0, 2, 3, 0, 3, 4}), mesh.indices());
+}
+
+// NOLINTNEXTLINE
+TEST(TriangleMeshTests, ObjFacesWithInvalidIndicesAreRejected)
+{
+    // GIVEN:
+    const std::string vertices = "v 0 0 0\nv 1 0 0\nv 1 1 0\n";
+
+    for (const auto* face : {
+             "f 0 1 2\n",                   // OBJ indices start at one
+             "f 1 2 4\n",                   // Past the last vertex
+             "f 1 2 5\nv 0 1 0\nv 0 0 1\n", // Refers to a vertex read later
+             "f -1 -2 -4\n",                // Counts back past the first vertex
+             "f 1 2 x\n",                   // Not a number
+             "f 1/1 2/2\n",                 // Fewer than three corners
+         })
+    {
+        // WHEN/THEN:
+        EXPECT_THROW(static_cast<void>(readObj(vertices + face)), std::runtime_error) << face;
+    }
+
+    // A vertex needs all three coordinates
+    EXPECT_THROW(static_cast<void>(readObj("v 0 0\n")), std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST(TriangleMeshTests, AsciiPlySkipsElementsAndPropertiesItDoesNotUse)
+{
+    // GIVEN:
+    const std::string ply = "ply\n"
+                            "format ascii 1.0\n"
+                            "comment made by hand\n"
+                            "element material 1\n"
+                            "property uchar red\n"
+                            "property list uchar float weights\n"
+                            "element vertex 4\n"
+                            "property float x\n"
+                            "property float nx\n"
+                            "property float y\n"
+                            "property float z\n"
+                            "property list uchar int neighbours\n"
+                            "element face 2\n"
+                            "property uchar flags\n"
+                            "property list uchar int vertex_indices\n"
+                            "end_header\n"
+                            "255 2 0.5 0.5\n"
+                            "0 9 0 0 1 1\n"
+                            "1 9 0 0 0\n"
+                            "1 9 1 0 2 0 1\n"
+                            "0 9 1 0 0\n"
+                            "7 3 0 1 2\n"
+                            "7 3 0 2 3\n";
+
+    // WHEN:
+    const auto mesh(readPly(ply));
+
+    // THEN:
+    EXPECT_EQ(squareVertices, mesh.vertices());
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 0, 2, 3}), mesh.indices());
+}
+
+// NOLINTNEXTLINE
+TEST(TriangleMeshTests, BinaryPlyIsReadInEitherByteOrder)
+{
+    for (const auto order : {ByteOrder::LittleEndian, ByteOrder::BigEndian})
+    {
+        // GIVEN: a square as one polygon, with a double coordinate and a colour that are skipped
+        std::string ply = order == ByteOrder::LittleEndian ? "ply\nformat binary_little_endian 1.0\n"
+                                                           : "ply\nformat binary_big_endian 1.0\n";
+        ply += "element vertex 4\n"
+               "property float x\n"
+               "property float y\n"
+               "property double z\n"
+               "property uchar red\n"
+               "element face 1\n"
+               "property list uchar uint vertex_indices\n"
+               "end_header\n";
+
+        for (size_t i = 0; i < squareVertices.size(); i += 3)
+        {
+            appendBinary(ply, squareVertices[i], order);
+            appendBinary(ply, squareVertices[i + 1], order);
+            appendBinary(ply, static_cast<double>(squareVertices[i + 2]), order);
+            appendBinary(ply, std::uint8_t{200}, order);
+        }
+
+        appendBinary(ply, std::uint8_t{4}, order);
+        for (const std::uint32_t index : {0U, 1U, 2U, 3U})
+        {
+            appendBinary(ply, index, order);
+        }
+
+        // WHEN:
+        const auto mesh(readPly(ply));
+
+        // THEN:
+        EXPECT_EQ(squareVertices, mesh.vertices());
+        EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 0, 2, 3}), mesh.indices());
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TriangleMeshTests, BinaryPlyListsMayUseAnyIntegerCountType)
+{
+    for (const auto* countType : {"uchar", "char", "ushort", "short", "uint", "int"})
+    {
+        // GIVEN:
+        std::string ply = "ply\nformat binary_little_endian 1.0\n"
+                          "element vertex 4\nproperty float x\nproperty float y\nproperty float z\n"
+                          "element face 2\nproperty list " +
+                          std::string(countType) +
+                          " ushort vertex_index\n"
+                          "end_header\n";
+
+        for (const auto coordinate : squareVertices)
+        {
+            appendBinary(ply, coordinate, ByteOrder::LittleEndian);
+        }
+
+        for (const auto& triangle : {std::array<std::uint16_t, 3>{0, 1, 2}, std::array<std::uint16_t, 3>{0, 2, 3}})
+        {
+            const std::string type(countType);
+            if (type == "uchar" || type == "char")
+            {
+                appendBinary(ply, std::uint8_t{3}, ByteOrder::LittleEndian);
+            }
+            else if (type == "ushort" || type == "short")
+            {
+                appendBinary(ply, std::uint16_t{3}, ByteOrder::LittleEndian);
+            }
+            else
+            {
+                appendBinary(ply, std::uint32_t{3}, ByteOrder::LittleEndian);
+            }
+
+            for (const auto index : triangle)
+            {
+                appendBinary(ply, index, ByteOrder::LittleEndian);
+            }
+        }
+
+        // WHEN:
+        const auto mesh(readPly(ply));
+
+        // THEN:
+        EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 0, 2, 3}), mesh.indices()) << countType;
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TriangleMeshTests, PlyFacesMayBeListedBeforeTheVertices)
+{
+    // GIVEN:
+    const std::string ply = "ply\nformat ascii 1.0\n"
+                            "element face 2\nproperty list uchar int vertex_indices\n"
+                            "element vertex 4\nproperty float x\nproperty float y\nproperty float z\n"
+                            "end_header\n"
+                            "3 0 1 2\n3 0 2 3\n"
+                            "0 0 0\n1 0 0\n1 1 0\n0 1 0\n";
+
+    // WHEN:
+    const auto mesh(readPly(ply));
+
+    // THEN:
+    EXPECT_EQ(squareVertices, mesh.vertices());
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 0, 2, 3}), mesh.indices());
+}
+
+// NOLINTNEXTLINE
+TEST(TriangleMeshTests, PlyFacesWithInvalidIndicesAreRejected)
+{
+    // GIVEN:
+    const std::string header = "ply\nformat ascii 1.0\n"
+                               "element vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+                               "element face 1\nproperty list uchar int vertex_indices\n"
+                               "end_header\n"
+                               "0 0 0\n1 0 0\n1 1 0\n";
+
+    for (const auto* face : {
+             "3 0 1 3\n",   // Past the last vertex
+             "3 0 1 -1\n",  // Negative
+             "3 0 1 1.5\n", // Not a whole number
+             "3 0 1\n",     // The file ends inside the list
+         })
+    {
+        // WHEN/THEN:
+        EXPECT_THROW(static_cast<void>(readPly(header + face)), std::runtime_error) << face;
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TriangleMeshTests, MalformedPlyHeadersAreRejected)
+{
+    for (const auto* ply : {
+             "obj\nformat ascii 1.0\nend_header\n",
+             "ply\nend_header\n",
+             "ply\nformat utf8 1.0\nend_header\n",
+             "ply\nformat ascii 1.0\nproperty float x\nend_header\n",
+             "ply\nformat ascii 1.0\nelement vertex 1\nproperty half x\nend_header\n",
+             "ply\nformat ascii 1.0\nelement vertex 1\n",
+         })
+    {
+        // WHEN/THEN:
+        EXPECT_THROW(static_cast<void>(readPly(ply)), std::runtime_error) << ply;
+    }
+}
+
+} // namespace eyebeam
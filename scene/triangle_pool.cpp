@@ -0,0 +1,77 @@
+#include "triangle_pool.h"
+
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "normal3.h"
+#include "point3.h"
+#include "ray3.h"
+#include "vector3.h"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace eyebeam
+{
+
+TrianglePool::TrianglePool(std::array<LaneColumn, columnCount> columns) noexcept
+    : m_vertexX(std::move(columns[0]))
+    , m_vertexY(std::move(columns[1]))
+    , m_vertexZ(std::move(columns[2]))
+    , m_edge1X(std::move(columns[3]))
+    , m_edge1Y(std::move(columns[4]))
+    , m_edge1Z(std::move(columns[5]))
+    , m_edge2X(std::move(columns[6]))
+    , m_edge2Y(std::move(columns[7]))
+    , m_edge2Z(std::move(columns[8]))
+{
+}
+
+std::array<const LaneColumn*, TrianglePool::columnCount> TrianglePool::columns() const noexcept
+{
+    return {&m_vertexX, &m_vertexY, &m_vertexZ, &m_edge1X, &m_edge1Y, &m_edge1Z, &m_edge2X, &m_edge2Y, &m_edge2Z};
+}
+
+void TrianglePool::add(const Point3& vertex0, const Point3& vertex1, const Point3& vertex2)
+{
+    m_vertexX.push_back(vertex0.x());
+    m_vertexY.push_back(vertex0.y());
+    m_vertexZ.push_back(vertex0.z());
+    m_edge1X.push_back(vertex1.x() - vertex0.x());
+    m_edge1Y.push_back(vertex1.y() - vertex0.y());
+    m_edge1Z.push_back(vertex1.z() - vertex0.z());
+    m_edge2X.push_back(vertex2.x() - vertex0.x());
+    m_edge2Y.push_back(vertex2.y() - vertex0.y());
+    m_edge2Z.push_back(vertex2.z() - vertex0.z());
+}
+
+Bounds3 TrianglePool::bounds(size_t index) const noexcept
+{
+    const Point3 vertex0(m_vertexX[index], m_vertexY[index], m_vertexZ[index]);
+    return Bounds3(vertex0)
+        .unite(vertex0 + Vector3(m_edge1X[index], m_edge1Y[index], m_edge1Z[index]))
+        .unite(vertex0 + Vector3(m_edge2X[index], m_edge2Y[index], m_edge2Z[index]));
+}
+
+IntersectionInfo TrianglePool::intersectionAt(size_t index, const Ray3& ray, float time) const
+{
+    const Vector3 edge1(m_edge1X[index], m_edge1Y[index], m_edge1Z[index]);
+    const Vector3 edge2(m_edge2X[index], m_edge2Y[index], m_edge2Z[index]);
+    return IntersectionInfo(evaluate(ray, time), Normal3(cross(edge1, edge2)), time);
+}
+
+void TrianglePool::reorder(const BorrowableArray<std::uint32_t>& order)
+{
+    m_vertexX.reorder(order);
+    m_vertexY.reorder(order);
+    m_vertexZ.reorder(order);
+    m_edge1X.reorder(order);
+    m_edge1Y.reorder(order);
+    m_edge1Z.reorder(order);
+    m_edge2X.reorder(order);
+    m_edge2Y.reorder(order);
+    m_edge2Z.reorder(order);
+}
+
+} // namespace eyebeam
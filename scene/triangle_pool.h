@@ -0,0 +1,94 @@
+#ifndef INCLUDED_TRIANGLE_POOL_H_
+#define INCLUDED_TRIANGLE_POOL_H_
+
+#include "primitive_lanes.h"
+
+#include "borrowable_array.h"
+#include "bounds3.h"
+#include "intersection_info.h"
+#include "point3.h"
+#include "ray3.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace eyebeam
+{
+
+// Independent triangles stored as structure of arrays, each as one vertex and the two edges leaving it, which is the
+// form the Moller-Trumbore test works with
+class TrianglePool
+{
+public:
+    static constexpr size_t columnCount = 9;
+
+    TrianglePool() = default;
+
+    // Adopts columns in the order columns() returns them
+    explicit TrianglePool(std::array<LaneColumn, columnCount> columns) noexcept;
+
+    [[nodiscard]] std::array<const LaneColumn*, columnCount> columns() const noexcept;
+
+    void add(const Point3& vertex0, const Point3& vertex1, const Point3& vertex2);
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_vertexX.size();
+    }
+
+    [[nodiscard]] Bounds3 bounds(size_t index) const noexcept;
+
+    // Distances to the triangles starting at first. Both sides of a triangle are hit; a ray in the plane of a triangle
+    // divides by zero and misses.
+    [[nodiscard]] auto hitTimes(const RayLanes& ray, size_t first) const noexcept
+    {
+        const auto edge1X(m_edge1X.load(first));
+        const auto edge1Y(m_edge1Y.load(first));
+        const auto edge1Z(m_edge1Z.load(first));
+        const auto edge2X(m_edge2X.load(first));
+        const auto edge2Y(m_edge2Y.load(first));
+        const auto edge2Z(m_edge2Z.load(first));
+
+        const auto pX(ray.directionY * edge2Z - ray.directionZ * edge2Y);
+        const auto pY(ray.directionZ * edge2X - ray.directionX * edge2Z);
+        const auto pZ(ray.directionX * edge2Y - ray.directionY * edge2X);
+        const auto inverseDeterminant(
+            PrimitiveLanes(1.0F) / multiplyAdd(edge1X, pX, multiplyAdd(edge1Y, pY, edge1Z * pZ)));
+
+        const auto toOriginX(ray.originX - m_vertexX.load(first));
+        const auto toOriginY(ray.originY - m_vertexY.load(first));
+        const auto toOriginZ(ray.originZ - m_vertexZ.load(first));
+        const auto u(multiplyAdd(toOriginX, pX, multiplyAdd(toOriginY, pY, toOriginZ * pZ)) * inverseDeterminant);
+
+        const auto qX(toOriginY * edge1Z - toOriginZ * edge1Y);
+        const auto qY(toOriginZ * edge1X - toOriginX * edge1Z);
+        const auto qZ(toOriginX * edge1Y - toOriginY * edge1X);
+        const auto v(
+            multiplyAdd(ray.directionX, qX, multiplyAdd(ray.directionY, qY, ray.directionZ * qZ)) * inverseDeterminant);
+        const auto time(multiplyAdd(edge2X, qX, multiplyAdd(edge2Y, qY, edge2Z * qZ)) * inverseDeterminant);
+
+        const PrimitiveLanes zero(0.0F);
+        return missedToInfinity((u >= zero) & (v >= zero) & (u + v <= PrimitiveLanes(1.0F)) & (time > zero), time);
+    }
+
+    // The normal follows the winding of the vertices
+    [[nodiscard]] IntersectionInfo intersectionAt(size_t index, const Ray3& ray, float time) const;
+
+    void reorder(const BorrowableArray<std::uint32_t>& order);
+
+private:
+    LaneColumn m_vertexX;
+    LaneColumn m_vertexY;
+    LaneColumn m_vertexZ;
+    LaneColumn m_edge1X;
+    LaneColumn m_edge1Y;
+    LaneColumn m_edge1Z;
+    LaneColumn m_edge2X;
+    LaneColumn m_edge2Y;
+    LaneColumn m_edge2Z;
+};
+
+} // namespace eyebeam
+
+#endif // INCLUDED_TRIANGLE_POOL_H_